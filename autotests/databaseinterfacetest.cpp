@@ -8,6 +8,7 @@
 
 #include "databaseinterface.h"
 #include "datatypes.h"
+#include "stringpool.h"
 
 #include "config-upnp-qt.h"
 
@@ -24,6 +25,7 @@
 #include <QSqlDatabase>
 #include <QSqlQuery>
 #include <QTemporaryFile>
+#include <QElapsedTimer>
 
 #include <QDebug>
 
@@ -37,6 +39,9 @@ using namespace Qt::Literals::StringLiterals;
 namespace
 {
 const QString testConnectionName = u"testDb"_s;
+
+// steps of a query plan that browseQueriesUseIndexes accepts, with the reason they are accepted
+using AllowedPlanSteps = QHash<QString, QString>;
 }
 
 class DatabaseInterfaceTests: public QObject, public DatabaseTestData
@@ -2167,6 +2172,436 @@ private Q_SLOTS:
         QCOMPARE(removedTrackId, qulonglong(0));
     }
 
+    void albumAggregatesFollowTrackChanges()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(testConnectionName);
+
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks);
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        const auto albumId = musicDb.albumIdFromTitleAndArtist(QStringLiteral("album1"), QStringLiteral("Various Artists"), QStringLiteral("/"));
+        QVERIFY(albumId != 0);
+
+        auto findAlbum = [&musicDb, albumId]() {
+            const auto allAlbums = musicDb.allAlbumsData();
+            const auto albumIt = std::find_if(allAlbums.cbegin(), allAlbums.cend(),
+                                              [albumId](const auto &oneAlbum) {return oneAlbum.databaseId() == albumId;});
+            return albumIt != allAlbums.cend() ? *albumIt : DataTypes::AlbumDataType{};
+        };
+
+        auto albumTracks = musicDb.albumData(albumId);
+        QCOMPARE(albumTracks.count(), 4);
+
+        auto highestRating = 0;
+        for (const auto &oneTrack : std::as_const(albumTracks)) {
+            highestRating = std::max(highestRating, oneTrack.rating());
+        }
+
+        auto album = findAlbum();
+        QCOMPARE(album.isValid(), true);
+        QCOMPARE(album[DataTypes::HighestTrackRating].toInt(), highestRating);
+        QCOMPARE(album.isSingleDiscAlbum(), false);
+
+        // the tracks of the album read the same aggregates
+        for (const auto &oneTrack : std::as_const(albumTracks)) {
+            QCOMPARE(oneTrack.isSingleDiscAlbum(), false);
+        }
+
+        auto modifiedTrack = musicDb.trackDataFromDatabaseId(albumTracks.first().databaseId());
+        modifiedTrack[DataTypes::RatingRole] = highestRating + 5;
+
+        musicDb.insertTracksList({modifiedTrack});
+
+        album = findAlbum();
+        QCOMPARE(album[DataTypes::HighestTrackRating].toInt(), highestRating + 5);
+
+        musicDb.removeTracksList({modifiedTrack.resourceURI()});
+
+        album = findAlbum();
+        QCOMPARE(album.isValid(), true);
+        QVERIFY(album[DataTypes::HighestTrackRating].toInt() <= highestRating);
+        QCOMPARE(musicDb.albumData(albumId).count(), 3);
+
+        for (const auto &oneTrack : musicDb.albumData(albumId)) {
+            QCOMPARE(oneTrack.isSingleDiscAlbum(), album.isSingleDiscAlbum());
+        }
+
+        for (const auto &oneTrack : musicDb.albumData(albumId)) {
+            musicDb.removeTracksList({oneTrack.resourceURI()});
+        }
+
+        QCOMPARE(findAlbum().isValid(), false);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void searchTracksAlbumsAndArtists()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(testConnectionName);
+
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks);
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        QCOMPARE(musicDb.tracksDataFromSearch({}, 0, 100).count(), 0);
+        QCOMPARE(musicDb.tracksDataFromSearch(QStringLiteral("   "), 0, 100).count(), 0);
+
+        auto foundTracks = musicDb.tracksDataFromSearch(QStringLiteral("album4"), 0, 100);
+        QCOMPARE(foundTracks.count(), 5);
+        for (const auto &oneTrack : std::as_const(foundTracks)) {
+            QCOMPARE(oneTrack.album(), QStringLiteral("album4"));
+        }
+
+        auto foundAlbums = musicDb.albumsDataFromSearch(QStringLiteral("album4"), 0, 100);
+        QCOMPARE(foundAlbums.count(), 1);
+        QCOMPARE(foundAlbums.first().title(), QStringLiteral("album4"));
+
+        auto foundArtists = musicDb.artistsDataFromSearch(QStringLiteral("album4"), 0, 100);
+        QVERIFY(foundArtists.isEmpty());
+
+        foundArtists = musicDb.artistsDataFromSearch(QStringLiteral("ARTIST3"), 0, 100);
+        QCOMPARE(foundArtists.count(), 1);
+        QCOMPARE(foundArtists.first().name(), QStringLiteral("artist3"));
+
+        foundTracks = musicDb.tracksDataFromSearch(QStringLiteral("ARTIST7"), 0, 100);
+        QCOMPARE(foundTracks.count(), 4);
+
+        auto firstPage = musicDb.tracksDataFromSearch(QStringLiteral("album4"), 0, 2);
+        QCOMPARE(firstPage.count(), 2);
+        auto secondPage = musicDb.tracksDataFromSearch(QStringLiteral("album4"), firstPage.last().databaseId(), 2);
+        QCOMPARE(secondPage.count(), 2);
+        auto lastPage = musicDb.tracksDataFromSearch(QStringLiteral("album4"), secondPage.last().databaseId(), 2);
+        QCOMPARE(lastPage.count(), 1);
+        QVERIFY(firstPage.last().databaseId() < secondPage.first().databaseId());
+        QVERIFY(secondPage.last().databaseId() < lastPage.first().databaseId());
+
+        auto modifiedTrack = musicDb.trackDataFromDatabaseId(lastPage.first().databaseId());
+        modifiedTrack[DataTypes::TitleRole] = QStringLiteral("renamedTrack");
+
+        musicDb.insertTracksList({modifiedTrack});
+
+        foundTracks = musicDb.tracksDataFromSearch(QStringLiteral("renamedTrack"), 0, 100);
+        QCOMPARE(foundTracks.count(), 1);
+        QCOMPARE(foundTracks.first().databaseId(), modifiedTrack.databaseId());
+
+        musicDb.removeTracksList({modifiedTrack.resourceURI()});
+
+        QCOMPARE(musicDb.tracksDataFromSearch(QStringLiteral("renamedTrack"), 0, 100).count(), 0);
+        QCOMPARE(musicDb.tracksDataFromSearch(QStringLiteral("album4"), 0, 100).count(), 4);
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void readAllTracksDataByPages()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(testConnectionName);
+
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks);
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        const auto allTracks = musicDb.allTracksData();
+
+        auto allTracksIds = QList<qulonglong>{};
+        for (const auto &oneTrack : allTracks) {
+            allTracksIds.push_back(oneTrack.databaseId());
+        }
+        std::sort(allTracksIds.begin(), allTracksIds.end());
+
+        constexpr int pageSize = 5;
+
+        auto pagedTracksIds = QList<qulonglong>{};
+        auto onePage = musicDb.allTracksDataPage(0, pageSize);
+        while (true) {
+            QVERIFY(onePage.count() <= pageSize);
+
+            for (const auto &oneTrack : std::as_const(onePage)) {
+                QVERIFY(pagedTracksIds.isEmpty() || pagedTracksIds.constLast() < oneTrack.databaseId());
+                pagedTracksIds.push_back(oneTrack.databaseId());
+            }
+
+            if (onePage.count() < pageSize) {
+                break;
+            }
+
+            onePage = musicDb.allTracksDataPage(onePage.constLast().databaseId(), pageSize);
+        }
+
+        QVERIFY(allTracksIds.count() > pageSize);
+        QCOMPARE(pagedTracksIds, allTracksIds);
+
+        QCOMPARE(musicDb.allTracksDataPage(allTracksIds.constLast(), pageSize).count(), 0);
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void bulkImportEndsWithTheScanOfItsRootPath()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(testConnectionName);
+
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        const auto rootPath = QStringLiteral("/music");
+
+        musicDb.beginBulkImport();
+        musicDb.insertScanCheckpoint(rootPath);
+        musicDb.insertTracksList(mNewTracks);
+
+        auto connection = QSqlDatabase::database(testConnectionName);
+        QVERIFY(connection.isOpen());
+
+        const auto hasComposerIndex = [&connection]() {
+            QSqlQuery indexQuery(connection);
+            indexQuery.exec(u"SELECT 1 FROM `sqlite_master` WHERE `type` = 'index' AND `name` = 'TracksComposerIndex'"_s);
+            return indexQuery.next();
+        };
+
+        QVERIFY(!hasComposerIndex());
+
+        musicDb.removeScanCheckpoint(rootPath);
+
+        QVERIFY(hasComposerIndex());
+        QVERIFY(!musicDb.tracksDataFromSearch(QStringLiteral("album4"), 0, 100).isEmpty());
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void bulkImportMatchesTrackByTrackImport()
+    {
+        const auto bulkConnectionName = u"bulkImportDb"_s;
+
+        {
+            DatabaseInterface musicDb;
+            DatabaseInterface bulkDb;
+
+            musicDb.init(testConnectionName);
+            bulkDb.init(bulkConnectionName);
+
+            QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+            QSignalSpy bulkDbDatabaseErrorSpy(&bulkDb, &DatabaseInterface::databaseError);
+            QSignalSpy bulkDbTracksAddedSpy(&bulkDb, &DatabaseInterface::tracksAdded);
+            QSignalSpy bulkDbAlbumsAddedSpy(&bulkDb, &DatabaseInterface::albumsAdded);
+
+            musicDb.insertTracksList(mNewTracks);
+
+            // albums spread over both batches are found again in the database by the second one
+            bulkDb.beginBulkImport();
+            bulkDb.insertTracksList(mNewTracks.mid(0, 10));
+            bulkDb.insertTracksList(mNewTracks.mid(10));
+            bulkDb.insertTracksList(mNewTracks.mid(0, 3));
+            bulkDb.endBulkImport();
+
+            QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+            QCOMPARE(bulkDbDatabaseErrorSpy.count(), 0);
+            QCOMPARE(bulkDbTracksAddedSpy.count(), 2);
+            QVERIFY(bulkDbAlbumsAddedSpy.count() > 0);
+
+            const auto byFileName = [](const auto &oneTrack, const auto &otherTrack) {
+                return oneTrack.resourceURI().toString() < otherTrack.resourceURI().toString();
+            };
+
+            auto tracks = musicDb.allTracksData();
+            auto bulkTracks = bulkDb.allTracksData();
+            std::sort(tracks.begin(), tracks.end(), byFileName);
+            std::sort(bulkTracks.begin(), bulkTracks.end(), byFileName);
+
+            QCOMPARE(bulkTracks.count(), tracks.count());
+            for (int trackIndex = 0; trackIndex < tracks.count(); ++trackIndex) {
+                const auto &oneTrack = tracks.at(trackIndex);
+                const auto &bulkTrack = bulkTracks.at(trackIndex);
+
+                QCOMPARE(bulkTrack.resourceURI(), oneTrack.resourceURI());
+                QCOMPARE(bulkTrack.title(), oneTrack.title());
+                QCOMPARE(bulkTrack.artist(), oneTrack.artist());
+                QCOMPARE(bulkTrack.album(), oneTrack.album());
+                QCOMPARE(bulkTrack.albumArtist(), oneTrack.albumArtist());
+                QCOMPARE(bulkTrack.trackNumber(), oneTrack.trackNumber());
+                QCOMPARE(bulkTrack.discNumber(), oneTrack.discNumber());
+                QCOMPARE(bulkTrack.duration(), oneTrack.duration());
+                QCOMPARE(bulkTrack.genre(), oneTrack.genre());
+                QCOMPARE(bulkTrack.composer(), oneTrack.composer());
+                QCOMPARE(bulkTrack.lyricist(), oneTrack.lyricist());
+                QCOMPARE(bulkTrack.albumCover(), oneTrack.albumCover());
+                QCOMPARE(bulkTrack.isSingleDiscAlbum(), oneTrack.isSingleDiscAlbum());
+            }
+
+            const auto byTitleAndArtist = [](const auto &oneAlbum, const auto &otherAlbum) {
+                return std::make_pair(oneAlbum.title(), oneAlbum.artist()) < std::make_pair(otherAlbum.title(), otherAlbum.artist());
+            };
+
+            auto albums = musicDb.allAlbumsData();
+            auto bulkAlbums = bulkDb.allAlbumsData();
+            std::sort(albums.begin(), albums.end(), byTitleAndArtist);
+            std::sort(bulkAlbums.begin(), bulkAlbums.end(), byTitleAndArtist);
+
+            QCOMPARE(bulkAlbums.count(), albums.count());
+            for (int albumIndex = 0; albumIndex < albums.count(); ++albumIndex) {
+                QCOMPARE(bulkAlbums.at(albumIndex).title(), albums.at(albumIndex).title());
+                QCOMPARE(bulkAlbums.at(albumIndex).artist(), albums.at(albumIndex).artist());
+                QCOMPARE(bulkAlbums.at(albumIndex).albumArtURI(), albums.at(albumIndex).albumArtURI());
+                QCOMPARE(bulkAlbums.at(albumIndex).isSingleDiscAlbum(), albums.at(albumIndex).isSingleDiscAlbum());
+            }
+
+            auto artistNames = QStringList{};
+            for (const auto &oneArtist : musicDb.allArtistsData()) {
+                artistNames.push_back(oneArtist.name());
+            }
+            auto bulkArtistNames = QStringList{};
+            for (const auto &oneArtist : bulkDb.allArtistsData()) {
+                bulkArtistNames.push_back(oneArtist.name());
+            }
+            artistNames.sort();
+            bulkArtistNames.sort();
+            QCOMPARE(bulkArtistNames, artistNames);
+
+            auto genreNames = QStringList{};
+            for (const auto &oneGenre : musicDb.allGenresData()) {
+                genreNames.push_back(oneGenre.title());
+            }
+            auto bulkGenreNames = QStringList{};
+            for (const auto &oneGenre : bulkDb.allGenresData()) {
+                bulkGenreNames.push_back(oneGenre.title());
+            }
+            genreNames.sort();
+            bulkGenreNames.sort();
+            QCOMPARE(bulkGenreNames, genreNames);
+
+            // the search index is rebuilt at the end of the bulk import
+            QCOMPARE(bulkDb.tracksDataFromSearch(QStringLiteral("album4"), 0, 100).count(), 5);
+
+            QCOMPARE(bulkDbDatabaseErrorSpy.count(), 0);
+        }
+
+        QSqlDatabase::removeDatabase(bulkConnectionName);
+    }
+
+    void browseQueriesUseIndexes_data()
+    {
+        QTest::addColumn<QString>("queryName");
+        QTest::addColumn<AllowedPlanSteps>("allowedSteps");
+
+        // each full scan or temporary b-tree allowed in a plan comes with the reason why it is bounded or needed
+        const auto albumDiscsCount = u"counts the disc numbers of the tracks of one album"_s;
+        const auto sortsFilteredRows = u"sorts only the rows matching the filter, found through an index"_s;
+        const auto likeSearch = u"without the full text search index, a search has to read every track"_s;
+
+        QTest::newRow("allAlbums") << u"allAlbums"_s << AllowedPlanSteps{};
+        QTest::newRow("albumsByArtist") << u"albumsByArtist"_s
+                                        << AllowedPlanSteps{{u"USE TEMP B-TREE FOR count(DISTINCT)"_s, albumDiscsCount},
+                                                            {u"USE TEMP B-TREE FOR ORDER BY"_s, sortsFilteredRows}};
+        QTest::newRow("albumsByGenreAndArtist") << u"albumsByGenreAndArtist"_s
+                                                << AllowedPlanSteps{{u"USE TEMP B-TREE FOR count(DISTINCT)"_s, albumDiscsCount},
+                                                                    {u"USE TEMP B-TREE FOR ORDER BY"_s, sortsFilteredRows}};
+        QTest::newRow("albumsFromSearch") << u"albumsFromSearch"_s << AllowedPlanSteps{{u"SCAN likeTracks"_s, likeSearch}};
+        QTest::newRow("allArtists") << u"allArtists"_s << AllowedPlanSteps{};
+        QTest::newRow("artistsByGenre") << u"artistsByGenre"_s << AllowedPlanSteps{{u"USE TEMP B-TREE FOR ORDER BY"_s, sortsFilteredRows}};
+        QTest::newRow("artistMatchGenre") << u"artistMatchGenre"_s << AllowedPlanSteps{};
+        QTest::newRow("artistsFromSearch") << u"artistsFromSearch"_s << AllowedPlanSteps{};
+        QTest::newRow("allGenres") << u"allGenres"_s << AllowedPlanSteps{};
+        QTest::newRow("allComposers") << u"allComposers"_s << AllowedPlanSteps{};
+        QTest::newRow("allLyricists") << u"allLyricists"_s << AllowedPlanSteps{};
+        QTest::newRow("allTracksPage") << u"allTracksPage"_s << AllowedPlanSteps{{u"USE TEMP B-TREE FOR count(DISTINCT)"_s, albumDiscsCount}};
+        QTest::newRow("albumTracks") << u"albumTracks"_s << AllowedPlanSteps{};
+        QTest::newRow("tracksFromArtist") << u"tracksFromArtist"_s
+                                          << AllowedPlanSteps{{u"USE TEMP B-TREE FOR count(DISTINCT)"_s, albumDiscsCount},
+                                                              {u"USE TEMP B-TREE FOR ORDER BY"_s, sortsFilteredRows}};
+        QTest::newRow("tracksFromGenre") << u"tracksFromGenre"_s
+                                         << AllowedPlanSteps{{u"USE TEMP B-TREE FOR count(DISTINCT)"_s, albumDiscsCount},
+                                                             {u"USE TEMP B-TREE FOR ORDER BY"_s, sortsFilteredRows}};
+        QTest::newRow("tracksFromArtistAndGenre") << u"tracksFromArtistAndGenre"_s
+                                                  << AllowedPlanSteps{{u"USE TEMP B-TREE FOR count(DISTINCT)"_s, albumDiscsCount},
+                                                                      {u"USE TEMP B-TREE FOR ORDER BY"_s, sortsFilteredRows}};
+        QTest::newRow("tracksFromSearch") << u"tracksFromSearch"_s
+                                          << AllowedPlanSteps{{u"USE TEMP B-TREE FOR count(DISTINCT)"_s, albumDiscsCount},
+                                                              {u"SCAN likeTracks"_s, likeSearch}};
+        QTest::newRow("trackFromIdAndUrl") << u"trackFromIdAndUrl"_s << AllowedPlanSteps{{u"USE TEMP B-TREE FOR count(DISTINCT)"_s, albumDiscsCount}};
+        QTest::newRow("trackIdFromFileName") << u"trackIdFromFileName"_s << AllowedPlanSteps{};
+        QTest::newRow("trackIdFromTitleAlbumTrackDiscNumber") << u"trackIdFromTitleAlbumTrackDiscNumber"_s << AllowedPlanSteps{};
+        QTest::newRow("recentlyPlayed") << u"recentlyPlayed"_s << AllowedPlanSteps{{u"USE TEMP B-TREE FOR count(DISTINCT)"_s, albumDiscsCount}};
+        QTest::newRow("frequentlyPlayed") << u"frequentlyPlayed"_s << AllowedPlanSteps{{u"USE TEMP B-TREE FOR count(DISTINCT)"_s, albumDiscsCount}};
+        QTest::newRow("allRadios") << u"allRadios"_s << AllowedPlanSteps{{u"SCAN radios"_s, u"lists every radio, in no particular order"_s}};
+        QTest::newRow("radioFromId") << u"radioFromId"_s << AllowedPlanSteps{};
+        QTest::newRow("radioIdFromHttpAddress") << u"radioIdFromHttpAddress"_s << AllowedPlanSteps{};
+        QTest::newRow("composerAlbumsCount") << u"composerAlbumsCount"_s
+                                             << AllowedPlanSteps{{u"USE TEMP B-TREE FOR DISTINCT"_s, u"counts the albums of the tracks of one composer"_s}};
+        QTest::newRow("lyricistAlbumsCount") << u"lyricistAlbumsCount"_s
+                                             << AllowedPlanSteps{{u"USE TEMP B-TREE FOR DISTINCT"_s, u"counts the albums of the tracks of one lyricist"_s}};
+        QTest::newRow("pruneArtists") << u"pruneArtists"_s << AllowedPlanSteps{};
+        QTest::newRow("pruneGenres") << u"pruneGenres"_s << AllowedPlanSteps{};
+        QTest::newRow("pruneComposers") << u"pruneComposers"_s << AllowedPlanSteps{};
+        QTest::newRow("pruneLyricists") << u"pruneLyricists"_s << AllowedPlanSteps{};
+    }
+
+    void browseQueriesUseIndexes()
+    {
+        QFETCH(QString, queryName);
+        QFETCH(AllowedPlanSteps, allowedSteps);
+
+        for (const auto &[oneStep, justification] : allowedSteps.asKeyValueRange()) {
+            QVERIFY2(!justification.trimmed().isEmpty(), qPrintable(oneStep + u" is allowed without a justification"_s));
+        }
+
+        DatabaseInterface musicDb;
+
+        musicDb.init(testConnectionName);
+
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks);
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        // the text of the queries prepared by the database, not a copy of it
+        const auto queryText = musicDb.browseQueriesText().value(queryName);
+
+        QVERIFY(!queryText.isEmpty());
+
+        auto connection = QSqlDatabase::database(testConnectionName);
+        QVERIFY(connection.isOpen());
+
+        QSqlQuery planQuery(connection);
+        QVERIFY(planQuery.prepare(u"EXPLAIN QUERY PLAN "_s + queryText));
+
+        const auto boundValues = planQuery.boundValueNames();
+        for (const auto &oneName : boundValues) {
+            planQuery.bindValue(oneName, 0);
+        }
+
+        QVERIFY2(planQuery.exec(), qPrintable(planQuery.lastError().text()));
+
+        auto planSteps = QStringList{};
+        while (planQuery.next()) {
+            planSteps.push_back(planQuery.value(3).toString());
+        }
+        planQuery.finish();
+
+        QVERIFY(!planSteps.isEmpty());
+
+        for (const auto &oneStep : std::as_const(planSteps)) {
+            // the virtual tables are the full text search index and the list of ids bound to a query
+            const auto isFullScan = oneStep.startsWith(u"SCAN "_s) && !oneStep.contains(u" USING "_s) &&
+                                    !oneStep.contains(u" VIRTUAL TABLE "_s) && oneStep != u"SCAN CONSTANT ROW"_s;
+            const auto isTemporaryBTree = oneStep.startsWith(u"USE TEMP B-TREE"_s);
+
+            QVERIFY2((!isFullScan && !isTemporaryBTree) || allowedSteps.contains(oneStep),
+                     qPrintable(oneStep + u" in "_s + planSteps.join(u" | "_s)));
+        }
+    }
+
     void removeOneTrackAndModifyIt()
     {
         DatabaseInterface musicDb;
@@ -2864,6 +3299,57 @@ private Q_SLOTS:
         QVERIFY(musicDb.allGenresData().isEmpty());
     }
 
+    void removeManyTracksPrunesCollections()
+    {
+        DatabaseInterface musicDb;
+        musicDb.init(testConnectionName);
+
+        QSignalSpy trackRemovedSpy(&musicDb, &DatabaseInterface::trackRemoved);
+        QSignalSpy albumRemovedSpy(&musicDb, &DatabaseInterface::albumRemoved);
+        QSignalSpy artistRemovedSpy(&musicDb, &DatabaseInterface::artistRemoved);
+        QSignalSpy genreRemovedSpy(&musicDb, &DatabaseInterface::genreRemoved);
+        QSignalSpy composerRemovedSpy(&musicDb, &DatabaseInterface::composerRemoved);
+        QSignalSpy lyricistRemovedSpy(&musicDb, &DatabaseInterface::lyricistRemoved);
+        QSignalSpy databaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        const auto newTracks = generatedTracks(0, 4000);
+
+        musicDb.insertTracksList(newTracks);
+
+        QCOMPARE(databaseErrorSpy.count(), 0);
+        QCOMPARE(musicDb.allArtistsData().count(), 50);
+        QCOMPARE(musicDb.allGenresData().count(), 20);
+
+        // removing every even track leaves every even artist, genre, composer and lyricist without tracks
+        auto removedTracks = QList<QUrl>{};
+        for (int trackIndex = 0; trackIndex < newTracks.size(); trackIndex += 2) {
+            removedTracks.push_back(newTracks[trackIndex].resourceURI());
+        }
+
+        musicDb.removeTracksList(removedTracks);
+
+        QCOMPARE(databaseErrorSpy.count(), 0);
+        QCOMPARE(trackRemovedSpy.count(), 2000);
+        QCOMPARE(albumRemovedSpy.count(), 200);
+        QCOMPARE(artistRemovedSpy.count(), 25);
+        QCOMPARE(genreRemovedSpy.count(), 10);
+        QCOMPARE(composerRemovedSpy.count(), 15);
+        QCOMPARE(lyricistRemovedSpy.count(), 15);
+
+        const auto remainingArtists = musicDb.allArtistsData();
+        QCOMPARE(remainingArtists.count(), 25);
+        for (const auto &oneArtist : remainingArtists) {
+            QVERIFY(oneArtist.name().mid(6).toInt() % 2 == 1);
+        }
+        QCOMPARE(musicDb.allGenresData().count(), 10);
+
+        for (const auto &removedArtist : artistRemovedSpy) {
+            QVERIFY(std::none_of(remainingArtists.begin(), remainingArtists.end(), [&removedArtist](const auto &oneArtist) {
+                return oneArtist.databaseId() == removedArtist.at(0).toULongLong();
+            }));
+        }
+    }
+
     void addOneTrack()
     {
         DatabaseInterface musicDb;
@@ -4945,6 +5431,102 @@ private Q_SLOTS:
         QCOMPARE(restoredTracks.count(), 23);
     }
 
+    void checkRestoredDirectoryFingerprints()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(testConnectionName);
+
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+        QSignalSpy musicDbRestoredFingerprintsSpy(&musicDb, &DatabaseInterface::restoredDirectoryFingerprints);
+        QSignalSpy musicDbRestoredTracksSpy(&musicDb, &DatabaseInterface::restoredTracks);
+
+        const auto modifiedTime = QDateTime::fromString(QStringLiteral("2026-10-18T12:34:56.789"), Qt::ISODateWithMs);
+
+        auto fingerprints = DataTypes::DirectoryFingerprints{};
+        fingerprints[QUrl::fromLocalFile(QStringLiteral("/music"))] = {modifiedTime, 3, QByteArray::fromHex("00112233445566778899aabbccddeeff")};
+        fingerprints[QUrl::fromLocalFile(QStringLiteral("/music/album"))] = {modifiedTime.addSecs(60), 12, QByteArray::fromHex("ffeeddccbbaa99887766554433221100")};
+
+        musicDb.insertDirectoryFingerprints(fingerprints);
+        musicDb.askRestoredTracks();
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+        QCOMPARE(musicDbRestoredTracksSpy.count(), 1);
+        QCOMPARE(musicDbRestoredFingerprintsSpy.count(), 1);
+        QCOMPARE(musicDbRestoredFingerprintsSpy.at(0).at(0).value<DataTypes::DirectoryFingerprints>(), fingerprints);
+
+        musicDb.removeDirectoryFingerprints({QUrl::fromLocalFile(QStringLiteral("/music/album"))});
+        musicDb.askRestoredTracks();
+
+        fingerprints.remove(QUrl::fromLocalFile(QStringLiteral("/music/album")));
+
+        QCOMPARE(musicDbRestoredFingerprintsSpy.count(), 2);
+        QCOMPARE(musicDbRestoredFingerprintsSpy.at(1).at(0).value<DataTypes::DirectoryFingerprints>(), fingerprints);
+
+        // clearing the database forgets the fingerprints, so that the next scan checks every file
+        musicDb.clearData();
+        musicDb.askRestoredTracks();
+
+        QCOMPARE(musicDbRestoredFingerprintsSpy.count(), 3);
+        QVERIFY(musicDbRestoredFingerprintsSpy.at(2).at(0).value<DataTypes::DirectoryFingerprints>().isEmpty());
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
+    void checkRestoredScanCheckpoints()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(testConnectionName);
+
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+        QSignalSpy musicDbRestoredCheckpointsSpy(&musicDb, &DatabaseInterface::restoredScanCheckpoints);
+
+        const auto musicDirectory = QUrl::fromLocalFile(QStringLiteral("/music/album1"));
+        const auto otherMusicDirectory = QUrl::fromLocalFile(QStringLiteral("/other music/album2"));
+
+        musicDb.insertScanCheckpoint(QStringLiteral("/music"));
+        musicDb.insertScanCheckpoint(QStringLiteral("/other music"));
+        musicDb.insertScanCheckpoint(QStringLiteral("/music"));
+        musicDb.insertScanCheckpointDirectories(QStringLiteral("/music"), {musicDirectory});
+        musicDb.insertScanCheckpointDirectories(QStringLiteral("/other music"), {otherMusicDirectory});
+        musicDb.askScanCheckpoints();
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+        QCOMPARE(musicDbRestoredCheckpointsSpy.count(), 1);
+
+        auto rootPaths = musicDbRestoredCheckpointsSpy.at(0).at(0).toStringList();
+        rootPaths.sort();
+        QCOMPARE(rootPaths, QStringList({QStringLiteral("/music"), QStringLiteral("/other music")}));
+
+        auto finishedDirectories = musicDbRestoredCheckpointsSpy.at(0).at(1).value<QList<QUrl>>();
+        std::sort(finishedDirectories.begin(), finishedDirectories.end());
+        QCOMPARE(finishedDirectories, QList<QUrl>({musicDirectory, otherMusicDirectory}));
+
+        musicDb.removeScanCheckpoint(QStringLiteral("/music"));
+        musicDb.askScanCheckpoints();
+
+        QCOMPARE(musicDbRestoredCheckpointsSpy.count(), 2);
+        QCOMPARE(musicDbRestoredCheckpointsSpy.at(1).at(0).toStringList(), QStringList({QStringLiteral("/other music")}));
+        QCOMPARE(musicDbRestoredCheckpointsSpy.at(1).at(1).value<QList<QUrl>>(), QList<QUrl>({otherMusicDirectory}));
+
+        musicDb.clearData();
+        musicDb.askScanCheckpoints();
+
+        QCOMPARE(musicDbRestoredCheckpointsSpy.count(), 3);
+        QVERIFY(musicDbRestoredCheckpointsSpy.at(2).at(0).toStringList().isEmpty());
+        QVERIFY(musicDbRestoredCheckpointsSpy.at(2).at(1).value<QList<QUrl>>().isEmpty());
+
+        // after a stop request, the checkpoints stay as they are
+        musicDb.insertScanCheckpoint(QStringLiteral("/music"));
+        musicDb.applicationAboutToQuit();
+        musicDb.removeScanCheckpoint(QStringLiteral("/music"));
+        musicDb.askScanCheckpoints();
+
+        QCOMPARE(musicDbRestoredCheckpointsSpy.count(), 4);
+        QCOMPARE(musicDbRestoredCheckpointsSpy.at(3).at(0).toStringList(), QStringList({QStringLiteral("/music")}));
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
     void addOneTrackWithParticularPath()
     {
         DatabaseInterface musicDb;
@@ -5001,6 +5583,36 @@ private Q_SLOTS:
         QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
     }
 
+    void addTracksWithoutChangesNotification()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.setChangesNotificationEnabled(false);
+        musicDb.init(testConnectionName);
+
+        QSignalSpy musicDbArtistAddedSpy(&musicDb, &DatabaseInterface::artistsAdded);
+        QSignalSpy musicDbAlbumAddedSpy(&musicDb, &DatabaseInterface::albumsAdded);
+        QSignalSpy musicDbTrackAddedSpy(&musicDb, &DatabaseInterface::tracksAdded);
+        QSignalSpy musicDbTrackRemovedSpy(&musicDb, &DatabaseInterface::trackRemoved);
+        QSignalSpy musicDbFinishInsertingSpy(&musicDb, &DatabaseInterface::finishInsertingTracksList);
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(mNewTracks);
+
+        // the tracks are inserted but not sent to the models
+        QCOMPARE(musicDbFinishInsertingSpy.count(), 1);
+        QCOMPARE(musicDb.allTracksData().count(), 22);
+        QCOMPARE(musicDbArtistAddedSpy.count(), 0);
+        QCOMPARE(musicDbAlbumAddedSpy.count(), 0);
+        QCOMPARE(musicDbTrackAddedSpy.count(), 0);
+
+        musicDb.removeTracksList({mNewTracks.constFirst().resourceURI()});
+
+        QCOMPARE(musicDb.allTracksData().count(), 21);
+        QCOMPARE(musicDbTrackRemovedSpy.count(), 0);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+    }
+
     void readRecentlyPlayedTracksData()
     {
         DatabaseInterface musicDb;
@@ -6077,6 +6689,537 @@ private Q_SLOTS:
 
         databaseFile.remove();
     }
+
+    void benchmarkReadLatencyUnderWriteLoad()
+    {
+        constexpr int batchesCount = 20;
+        constexpr int batchSize = 500;
+
+        const auto writerConnectionName = u"benchmarkWriterDb"_s;
+        const auto readerConnectionName = u"benchmarkReaderDb"_s;
+
+        QTemporaryFile databaseFile;
+        QVERIFY(databaseFile.open());
+
+        {
+            QThread writerThread;
+            DatabaseInterface writerDb;
+            DatabaseInterface readerDb;
+
+            QAtomicInt finishedBatches = 0;
+            QAtomicInt writerErrors = 0;
+
+            connect(&writerDb, &DatabaseInterface::finishInsertingTracksList,
+                    &writerDb, [&finishedBatches]() {finishedBatches.fetchAndAddOrdered(1);}, Qt::DirectConnection);
+            connect(&writerDb, &DatabaseInterface::databaseError,
+                    &writerDb, [&writerErrors]() {writerErrors.fetchAndAddOrdered(1);}, Qt::DirectConnection);
+
+            writerDb.moveToThread(&writerThread);
+            writerThread.start();
+
+            QMetaObject::invokeMethod(&writerDb, [&]() {
+                writerDb.init(writerConnectionName, databaseFile.fileName());
+            }, Qt::BlockingQueuedConnection);
+
+            QSignalSpy readerErrorSpy(&readerDb, &DatabaseInterface::databaseError);
+            readerDb.initReadOnly(readerConnectionName, databaseFile.fileName());
+            QCOMPARE(readerErrorSpy.count(), 0);
+
+            for (int batch = 0; batch < batchesCount; ++batch) {
+                const auto newTracks = generatedTracks(batch * batchSize, batchSize);
+
+                QMetaObject::invokeMethod(&writerDb, [&writerDb, newTracks]() {
+                    writerDb.insertTracksList(newTracks);
+                }, Qt::QueuedConnection);
+            }
+
+            auto latencies = QList<qint64>{};
+            QElapsedTimer readTimer;
+            QElapsedTimer totalTimer;
+            totalTimer.start();
+
+            while (finishedBatches.loadAcquire() < batchesCount && totalTimer.elapsed() < 300000) {
+                readTimer.start();
+                const auto allAlbums = readerDb.allAlbumsData();
+                const auto allTracks = readerDb.allTracksData();
+                latencies.push_back(readTimer.nsecsElapsed());
+            }
+
+            QCOMPARE(finishedBatches.loadAcquire(), batchesCount);
+            QCOMPARE(writerErrors.loadAcquire(), 0);
+            QCOMPARE(readerErrorSpy.count(), 0);
+            QVERIFY(!latencies.isEmpty());
+
+            std::sort(latencies.begin(), latencies.end());
+            qInfo() << "read latency under write load:" << latencies.size() << "reads during" << totalTimer.elapsed() << "ms of writes,"
+                    << "median" << latencies.at(latencies.size() / 2) / 1000 << "us,"
+                    << "p95" << latencies.at(latencies.size() * 95 / 100) / 1000 << "us,"
+                    << "max" << latencies.last() / 1000 << "us";
+
+            QCOMPARE(readerDb.allTracksData().count(), batchesCount * batchSize);
+
+            writerThread.quit();
+            writerThread.wait();
+        }
+
+        QSqlDatabase::removeDatabase(writerConnectionName);
+        QSqlDatabase::removeDatabase(readerConnectionName);
+    }
+
+    void benchmarkBulkImport()
+    {
+        if (qEnvironmentVariableIsEmpty("ELISA_LARGE_BENCHMARKS")) {
+            QSKIP("set ELISA_LARGE_BENCHMARKS to run the benchmark on a large collection");
+        }
+
+        constexpr int batchesCount = 20;
+        constexpr int batchSize = 500;
+
+        const auto bulkConnectionName = u"benchmarkBulkImportDb"_s;
+
+        {
+            DatabaseInterface musicDb;
+            DatabaseInterface bulkDb;
+
+            musicDb.init(testConnectionName);
+            bulkDb.init(bulkConnectionName);
+
+            QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+            QSignalSpy bulkDbDatabaseErrorSpy(&bulkDb, &DatabaseInterface::databaseError);
+
+            auto allBatches = QList<DataTypes::ListTrackDataType>{};
+            for (int batch = 0; batch < batchesCount; ++batch) {
+                allBatches.push_back(generatedTracks(batch * batchSize, batchSize));
+            }
+
+            QElapsedTimer importTimer;
+
+            importTimer.start();
+            for (const auto &oneBatch : std::as_const(allBatches)) {
+                musicDb.insertTracksList(oneBatch);
+            }
+            const auto trackByTrackDuration = importTimer.elapsed();
+
+            importTimer.start();
+            bulkDb.beginBulkImport();
+            for (const auto &oneBatch : std::as_const(allBatches)) {
+                bulkDb.insertTracksList(oneBatch);
+            }
+            bulkDb.endBulkImport();
+            const auto bulkDuration = importTimer.elapsed();
+
+            QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+            QCOMPARE(bulkDbDatabaseErrorSpy.count(), 0);
+            QCOMPARE(musicDb.allTracksData().count(), batchesCount * batchSize);
+            QCOMPARE(bulkDb.allTracksData().count(), batchesCount * batchSize);
+            QCOMPARE(bulkDb.allAlbumsData().count(), musicDb.allAlbumsData().count());
+
+            qInfo() << "import of" << batchesCount * batchSize << "tracks:"
+                    << "track by track" << trackByTrackDuration << "ms,"
+                    << "bulk" << bulkDuration << "ms,"
+                    << "speedup" << double(trackByTrackDuration) / std::max<qint64>(bulkDuration, 1);
+        }
+
+        QSqlDatabase::removeDatabase(bulkConnectionName);
+    }
+
+    void benchmarkIntegerJoins_data()
+    {
+        QTest::addColumn<int>("tracksCount");
+
+        QTest::newRow("10k") << 10000;
+        QTest::newRow("100k") << 100000;
+        QTest::newRow("500k") << 500000;
+    }
+
+    void benchmarkIntegerJoins()
+    {
+        QFETCH(int, tracksCount);
+
+        if (tracksCount > 10000 && qEnvironmentVariableIsEmpty("ELISA_LARGE_BENCHMARKS")) {
+            QSKIP("set ELISA_LARGE_BENCHMARKS to run the benchmark on a large collection");
+        }
+
+        constexpr int batchSize = 5000;
+
+        DatabaseInterface musicDb;
+
+        musicDb.init(testConnectionName);
+
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.beginBulkImport();
+        for (int firstTrack = 0; firstTrack < tracksCount; firstTrack += batchSize) {
+            musicDb.insertTracksList(generatedTracks(firstTrack, std::min(batchSize, tracksCount - firstTrack)));
+        }
+        musicDb.endBulkImport();
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        auto connection = QSqlDatabase::database(testConnectionName);
+        QVERIFY(connection.isOpen());
+
+        // the index used by the name joins before the schema had integer keys
+        QSqlQuery legacyIndexQuery(connection);
+        QVERIFY(legacyIndexQuery.exec(
+            u"CREATE INDEX `TracksAlbumDiscIndex` ON `Tracks` (`AlbumTitle`, `AlbumArtistName`, `AlbumPath`, `DiscNumber`, `TrackNumber`)"_s));
+
+        const auto albums = musicDb.allAlbumsData();
+        QVERIFY(!albums.isEmpty());
+
+        const auto timeAlbumTracks = [&connection, &albums](const QString &queryText, qint64 &duration) {
+            QSqlQuery albumTracksQuery(connection);
+            auto tracksCount = 0;
+
+            if (!albumTracksQuery.prepare(queryText)) {
+                return -1;
+            }
+
+            QElapsedTimer queryTimer;
+            queryTimer.start();
+
+            for (const auto &oneAlbum : albums) {
+                albumTracksQuery.bindValue(u":albumId"_s, oneAlbum.databaseId());
+
+                if (!albumTracksQuery.exec()) {
+                    return -1;
+                }
+
+                while (albumTracksQuery.next()) {
+                    ++tracksCount;
+                }
+
+                albumTracksQuery.finish();
+            }
+
+            duration = queryTimer.nsecsElapsed();
+
+            return tracksCount;
+        };
+
+        // the album tracks query as prepared before the integer keys, with its NULL-aware artist matches
+        auto namesDuration = qint64{0};
+        const auto namesTracksCount = timeAlbumTracks(uR"(
+SELECT 
+tracks.`ID`, 
+tracks.`Title`, 
+album.`ID`, 
+tracks.`ArtistName`, 
+( 
+SELECT 
+COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) 
+FROM 
+`Tracks` tracksFromAlbum1 
+WHERE 
+tracksFromAlbum1.`AlbumTitle` = album.`Title` AND 
+(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR 
+(tracksFromAlbum1.`AlbumArtistName` IS NULL AND 
+album.`ArtistName` IS NULL 
+) 
+) AND 
+tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` 
+) AS ArtistsCount, 
+( 
+SELECT 
+GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) 
+FROM 
+`Tracks` tracksFromAlbum2 
+WHERE 
+tracksFromAlbum2.`AlbumTitle` = album.`Title` AND 
+(tracksFromAlbum2.`AlbumArtistName` = album.`ArtistName` OR 
+(tracksFromAlbum2.`AlbumArtistName` IS NULL AND 
+album.`ArtistName` IS NULL 
+) 
+) AND 
+tracksFromAlbum2.`AlbumPath` = album.`AlbumPath` 
+) AS AllArtists, 
+tracks.`AlbumArtistName`, 
+tracksMapping.`FileName`, 
+tracksMapping.`FileModifiedTime`, 
+tracks.`TrackNumber`, 
+tracks.`DiscNumber`, 
+tracks.`Duration`, 
+tracks.`AlbumTitle`, 
+tracks.`Rating`, 
+album.`CoverFileName`, 
+(
+SELECT 
+COUNT(DISTINCT tracks2.DiscNumber) <= 1 
+FROM 
+`Tracks` tracks2 
+WHERE 
+tracks2.`AlbumTitle` = album.`Title` AND 
+(tracks2.`AlbumArtistName` = album.`ArtistName` OR 
+(tracks2.`AlbumArtistName` IS NULL AND 
+album.`ArtistName` IS NULL
+)
+) AND 
+tracks2.`AlbumPath` = album.`AlbumPath` 
+) as `IsSingleDiscAlbum`, 
+trackGenre.`Name`, 
+trackComposer.`Name`, 
+trackLyricist.`Name`, 
+tracks.`Comment`, 
+tracks.`Year`, 
+tracks.`Channels`, 
+tracks.`BitRate`, 
+tracks.`SampleRate`, 
+tracks.`HasEmbeddedCover`, 
+tracksMapping.`ImportDate`, 
+tracksMapping.`FirstPlayDate`, 
+tracksMapping.`LastPlayDate`, 
+tracksMapping.`PlayCounter`, 
+( 
+SELECT tracksCover.`FileName` 
+FROM 
+`Tracks` tracksCover 
+WHERE 
+tracksCover.`HasEmbeddedCover` = 1 AND 
+( 
+(tracksCover.`AlbumTitle` IS NULL AND 
+tracksCover.`FileName` = tracks.`FileName` ) OR 
+( 
+tracksCover.`AlbumTitle` = album.`Title` AND 
+(tracksCover.`AlbumArtistName` = album.`ArtistName` OR 
+(tracksCover.`AlbumArtistName` IS NULL AND 
+album.`ArtistName` IS NULL 
+) 
+) AND 
+tracksCover.`AlbumPath` = album.`AlbumPath` 
+) 
+) 
+) as EmbeddedCover 
+FROM 
+`Tracks` tracks, 
+`TracksData` tracksMapping 
+LEFT JOIN 
+`Albums` album 
+ON 
+album.`ID` = :albumId AND 
+tracks.`AlbumTitle` = album.`Title` AND 
+(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND 
+tracks.`AlbumPath` = album.`AlbumPath` 
+LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` 
+LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` 
+LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` 
+WHERE 
+tracksMapping.`FileName` = tracks.`FileName` AND 
+album.`ID` = :albumId AND 
+tracks.`Priority` = (
+     SELECT 
+     MIN(`Priority`) 
+     FROM 
+     `Tracks` tracks2 
+     WHERE 
+     tracks.`Title` = tracks2.`Title` AND 
+     (tracks.`ArtistName` IS NULL OR tracks.`ArtistName` = tracks2.`ArtistName`) AND 
+     (tracks.`AlbumTitle` IS NULL OR tracks.`AlbumTitle` = tracks2.`AlbumTitle`) AND 
+     (tracks.`AlbumArtistName` IS NULL OR tracks.`AlbumArtistName` = tracks2.`AlbumArtistName`) AND 
+     (tracks.`AlbumPath` IS NULL OR tracks.`AlbumPath` = tracks2.`AlbumPath`)
+)
+ORDER BY tracks.`DiscNumber` ASC, 
+tracks.`TrackNumber` ASC
+)"_s, namesDuration);
+
+        auto idsDuration = qint64{0};
+        const auto idsTracksCount = timeAlbumTracks(musicDb.browseQueriesText().value(u"albumTracks"_s), idsDuration);
+
+        QCOMPARE(namesTracksCount, tracksCount);
+        QCOMPARE(idsTracksCount, tracksCount);
+
+        qInfo() << "tracks of" << albums.size() << "albums in a collection of" << tracksCount << "tracks:"
+                << "name joins" << namesDuration / 1000 << "us,"
+                << "integer joins" << idsDuration / 1000 << "us,"
+                << "speedup" << double(namesDuration) / std::max<qint64>(idsDuration, 1);
+    }
+
+    void benchmarkAllTracksFirstPage_data()
+    {
+        QTest::addColumn<int>("tracksCount");
+
+        QTest::newRow("10k") << 10000;
+        QTest::newRow("400k") << 400000;
+    }
+
+    void benchmarkAllTracksFirstPage()
+    {
+        QFETCH(int, tracksCount);
+
+        if (tracksCount > 10000 && qEnvironmentVariableIsEmpty("ELISA_LARGE_BENCHMARKS")) {
+            QSKIP("set ELISA_LARGE_BENCHMARKS to run the benchmark on a large collection");
+        }
+
+        constexpr int batchSize = 5000;
+        constexpr int pageSize = 500;
+
+        DatabaseInterface musicDb;
+
+        musicDb.init(testConnectionName);
+
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.beginBulkImport();
+        for (int firstTrack = 0; firstTrack < tracksCount; firstTrack += batchSize) {
+            musicDb.insertTracksList(generatedTracks(firstTrack, std::min(batchSize, tracksCount - firstTrack)));
+        }
+        musicDb.endBulkImport();
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        QElapsedTimer readTimer;
+        readTimer.start();
+
+        const auto allTracks = musicDb.allTracksData();
+        const auto allTracksDuration = readTimer.nsecsElapsed();
+
+        QCOMPARE(allTracks.count(), tracksCount);
+
+        readTimer.restart();
+
+        auto onePage = musicDb.allTracksDataPage(0, pageSize);
+        const auto firstPageDuration = readTimer.nsecsElapsed();
+        auto pagedTracksCount = onePage.count();
+
+        while (onePage.count() == pageSize) {
+            onePage = musicDb.allTracksDataPage(onePage.constLast().databaseId(), pageSize);
+            pagedTracksCount += onePage.count();
+        }
+
+        const auto allPagesDuration = readTimer.nsecsElapsed();
+
+        QCOMPARE(pagedTracksCount, tracksCount);
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        qInfo() << "all tracks of a collection of" << tracksCount << "tracks:"
+                << "single read" << allTracksDuration / 1000 << "us,"
+                << "first page of" << pageSize << firstPageDuration / 1000 << "us,"
+                << "all pages" << allPagesDuration / 1000 << "us";
+    }
+
+    void stringPoolSharesTrackStrings()
+    {
+        DatabaseInterface musicDb;
+
+        musicDb.init(testConnectionName);
+
+        QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+        musicDb.insertTracksList(generatedTracks(0, 100));
+
+        QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+        const auto allTracks = musicDb.allTracksData();
+
+        QCOMPARE(allTracks.count(), 100);
+
+        const auto trackWithTitle = [&allTracks](const QString &title) {
+            return *std::find_if(allTracks.cbegin(), allTracks.cend(), [&title](const auto &oneTrack) {
+                return oneTrack.title() == title;
+            });
+        };
+
+        // track3 and track53 have the same artist, track3 and track23 the same genre
+        const auto firstTrack = trackWithTitle(u"track3"_s);
+
+        QCOMPARE(firstTrack.artist(), u"artist3"_s);
+        QCOMPARE(trackWithTitle(u"track53"_s).artist().constData(), firstTrack.artist().constData());
+        QCOMPARE(trackWithTitle(u"track23"_s).genre().constData(), firstTrack.genre().constData());
+    }
+
+    void stringPoolIsThreadSafe()
+    {
+        constexpr int threadsCount = 8;
+        constexpr int valuesCount = 2000;
+
+        auto internedValues = QList<QStringList>(threadsCount);
+        auto threads = QList<QThread*>{};
+
+        for (int threadIndex = 0; threadIndex < threadsCount; ++threadIndex) {
+            threads.push_back(QThread::create([&internedValues, threadIndex]() {
+                auto &values = internedValues[threadIndex];
+                values.reserve(valuesCount);
+
+                for (int valueIndex = 0; valueIndex < valuesCount; ++valueIndex) {
+                    values.push_back(StringPool::intern(u"threadedValue%1"_s.arg(valueIndex)));
+                }
+            }));
+        }
+
+        for (auto *oneThread : std::as_const(threads)) {
+            oneThread->start();
+        }
+
+        for (auto *oneThread : std::as_const(threads)) {
+            QVERIFY(oneThread->wait());
+            delete oneThread;
+        }
+
+        for (int valueIndex = 0; valueIndex < valuesCount; ++valueIndex) {
+            for (int threadIndex = 1; threadIndex < threadsCount; ++threadIndex) {
+                QCOMPARE(internedValues[threadIndex][valueIndex], internedValues[0][valueIndex]);
+                QCOMPARE(internedValues[threadIndex][valueIndex].constData(), internedValues[0][valueIndex].constData());
+            }
+        }
+    }
+
+    void stringPoolReleasesUnusedStrings()
+    {
+        constexpr int valuesCount = 100000;
+
+        // a value built at run time: a literal is static and never released
+        const auto keptValue = StringPool::intern(u"keptPooledValue%1"_s.arg(valuesCount));
+
+        for (int valueIndex = 0; valueIndex < valuesCount; ++valueIndex) {
+            const auto transientValue = StringPool::intern(u"transientValue%1"_s.arg(valueIndex));
+            QVERIFY(!transientValue.isEmpty());
+        }
+
+        QVERIFY(StringPool::statistics().mStringsCount < valuesCount / 4);
+        QCOMPARE(StringPool::intern(u"keptPooledValue%1"_s.arg(valuesCount)).constData(), keptValue.constData());
+    }
+
+    void benchmarkStringPool()
+    {
+        // point ELISA_BENCHMARK_DATABASE to the database of a real collection to measure it
+        const auto databaseFileName = qEnvironmentVariable("ELISA_BENCHMARK_DATABASE");
+
+        const auto poolConnectionName = u"benchmarkStringPoolDb"_s;
+
+        {
+            DatabaseInterface musicDb;
+
+            QSignalSpy musicDbDatabaseErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+
+            if (databaseFileName.isEmpty()) {
+                musicDb.init(poolConnectionName);
+                musicDb.insertTracksList(generatedTracks(0, 10000));
+            } else {
+                musicDb.initReadOnly(poolConnectionName, databaseFileName);
+            }
+
+            QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+            StringPool::resetStatistics();
+
+            const auto allTracks = musicDb.allTracksData();
+            const auto allAlbums = musicDb.allAlbumsData();
+
+            QCOMPARE(musicDbDatabaseErrorSpy.count(), 0);
+
+            const auto poolStatistics = StringPool::statistics();
+
+            qInfo() << "string pool for" << allTracks.size() << "tracks and" << allAlbums.size() << "albums:"
+                    << poolStatistics.mLookupsCount << "lookups,"
+                    << poolStatistics.mSharedCount << "shared strings,"
+                    << poolStatistics.mSavedBytes / 1024 << "KiB of duplicated characters saved,"
+                    << poolStatistics.mStringsCount << "distinct strings using"
+                    << poolStatistics.mPoolBytes / 1024 << "KiB";
+
+            QVERIFY(poolStatistics.mSharedCount > 0 || allTracks.isEmpty());
+        }
+
+        QSqlDatabase::removeDatabase(poolConnectionName);
+    }
 };
 
 QTEST_GUILESS_MAIN(DatabaseInterfaceTests)
@@ -20,6 +20,26 @@ class DatabaseTestData
 public:
     DatabaseTestData() = default;
 
+    // tracks spread over 400 albums, 50 artists and 20 genres for the benchmarks
+    static DataTypes::ListTrackDataType generatedTracks(int firstTrackIndex, int tracksCount)
+    {
+        auto newTracks = DataTypes::ListTrackDataType{};
+        newTracks.reserve(tracksCount);
+
+        for (int trackIndex = firstTrackIndex; trackIndex < firstTrackIndex + tracksCount; ++trackIndex) {
+            newTracks.push_back({true, QString::number(trackIndex), QStringLiteral("0"), QStringLiteral("track%1").arg(trackIndex),
+                                 QStringLiteral("artist%1").arg(trackIndex % 50), QStringLiteral("album%1").arg(trackIndex % 400),
+                                 QStringLiteral("artist%1").arg(trackIndex % 400 % 50), 1 + trackIndex % 12, 1,
+                                 QTime::fromMSecsSinceStartOfDay(1000 + trackIndex),
+                                 QUrl::fromLocalFile(QStringLiteral("/benchmark/%1/%2.ogg").arg(trackIndex % 400).arg(trackIndex)),
+                                 QDateTime::fromMSecsSinceEpoch(trackIndex), {}, 0, false,
+                                 QStringLiteral("genre%1").arg(trackIndex % 20), QStringLiteral("composer%1").arg(trackIndex % 30),
+                                 QStringLiteral("lyricist%1").arg(trackIndex % 30), false});
+        }
+
+        return newTracks;
+    }
+
 protected:
     DataTypes::ListTrackDataType mNewTracks = {
         {true,
@@ -16,15 +16,57 @@
 #include <QString>
 #include <QHash>
 #include <QList>
+#include <QSet>
 #include <QThread>
 #include <QStandardPaths>
 #include <QAbstractItemModelTester>
+#include <QElapsedTimer>
+#include <QFile>
 
 #include <QDebug>
 
 #include <QSignalSpy>
 #include <QTest>
 
+#include <algorithm>
+
+namespace
+{
+// the generated tracks with the data the database adds when it reads them back
+DataTypes::ListTrackDataType databaseTracks(int tracksCount)
+{
+    auto newTracks = DatabaseTestData::generatedTracks(0, tracksCount);
+
+    for (int trackIndex = 0; trackIndex < tracksCount; ++trackIndex) {
+        auto &newTrack = newTracks[trackIndex];
+        newTrack[DataTypes::DatabaseIdRole] = qulonglong(trackIndex + 1);
+        newTrack[DataTypes::AlbumIdRole] = qulonglong(trackIndex % 400 + 1);
+        newTrack[DataTypes::YearRole] = 2000 + trackIndex % 20;
+        newTrack[DataTypes::PlayCounter] = 0;
+        newTrack[DataTypes::IsValidAlbumArtistRole] = true;
+    }
+
+    return newTracks;
+}
+
+qint64 residentMemory()
+{
+    QFile statusFile(QStringLiteral("/proc/self/status"));
+    if (!statusFile.open(QIODevice::ReadOnly)) {
+        return -1;
+    }
+
+    const auto statusLines = statusFile.readAll().split('\n');
+    for (const auto &oneLine : statusLines) {
+        if (oneLine.startsWith("VmRSS:")) {
+            return oneLine.mid(6).trimmed().split(' ').constFirst().toLongLong() * 1024;
+        }
+    }
+
+    return -1;
+}
+}
+
 class DataModelTests: public QObject, public DatabaseTestData
 {
     Q_OBJECT
@@ -566,6 +608,41 @@ private Q_SLOTS:
         QCOMPARE(tracksModel.rowCount(), 24);
     }
 
+    void loadAllTracksPagesWithNewTrack()
+    {
+        constexpr int tracksCount = 1200;
+
+        DatabaseInterface musicDb;
+        DataModel tracksModel;
+        QAbstractItemModelTester testModel(&tracksModel);
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        auto allTracks = databaseTracks(tracksCount + 1);
+        const auto newTrack = allTracks.takeLast();
+
+        musicDb.insertTracksList(allTracks);
+
+        // the new track is added to the collection after the first page: it is also part of the last one
+        connect(&tracksModel, &DataModel::rowsInserted, &musicDb, [&musicDb, &newTrack]() {
+            musicDb.insertTracksList({newTrack});
+        }, Qt::SingleShotConnection);
+
+        QSignalSpy endInsertRowsSpy(&tracksModel, &DataModel::rowsInserted);
+
+        tracksModel.initialize(nullptr, &musicDb, ElisaUtils::Track, ElisaUtils::NoFilter, {}, {}, 0, {});
+
+        QVERIFY(endInsertRowsSpy.count() > 2);
+        QCOMPARE(tracksModel.rowCount(), tracksCount + 1);
+
+        auto allTracksIds = QSet<qulonglong>{};
+        for (int row = 0; row < tracksModel.rowCount(); ++row) {
+            allTracksIds.insert(tracksModel.data(tracksModel.index(row, 0), DataTypes::DatabaseIdRole).toULongLong());
+        }
+
+        QCOMPARE(allTracksIds.size(), tracksCount + 1);
+    }
+
     void addOneAlbumAllTracks()
     {
         DatabaseInterface musicDb;
@@ -1060,6 +1137,82 @@ private Q_SLOTS:
         QCOMPARE(dataChangedSpy.count(), 0);
     }
 
+    void addStaleSnapshotsAllAlbums()
+    {
+        DatabaseInterface musicDb;
+        DataModel albumsModel;
+        QAbstractItemModelTester testModel(&albumsModel);
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        musicDb.insertTracksList(mNewTracks);
+
+        // the snapshot of the load is read before one album is removed, its notifications are received before it
+        const auto albumsSnapshot = musicDb.allAlbumsData();
+        QVERIFY(albumsSnapshot.size() > 2);
+
+        const auto removedAlbumId = albumsSnapshot.constFirst().databaseId();
+
+        albumsModel.initialize(nullptr, nullptr, ElisaUtils::Album, ElisaUtils::NoFilter, {}, {}, 0, {});
+
+        albumsModel.albumsAdded({albumsSnapshot.constLast()});
+        albumsModel.albumRemoved(removedAlbumId);
+        albumsModel.albumsAdded(albumsSnapshot);
+        albumsModel.albumsAdded({albumsSnapshot.constLast()});
+
+        QCOMPARE(albumsModel.rowCount(), albumsSnapshot.size() - 1);
+
+        auto shownAlbumsIds = QSet<qulonglong>{};
+        for (int row = 0; row < albumsModel.rowCount(); ++row) {
+            shownAlbumsIds.insert(albumsModel.data(albumsModel.index(row, 0), DataTypes::DatabaseIdRole).toULongLong());
+        }
+
+        QCOMPARE(shownAlbumsIds.size(), albumsSnapshot.size() - 1);
+        QVERIFY(!shownAlbumsIds.contains(removedAlbumId));
+    }
+
+    void addStaleSnapshotsAllArtistsAndGenres()
+    {
+        DatabaseInterface musicDb;
+        DataModel artistsModel;
+        DataModel genresModel;
+        QAbstractItemModelTester artistsTestModel(&artistsModel);
+        QAbstractItemModelTester genresTestModel(&genresModel);
+
+        musicDb.init(QStringLiteral("testDb"));
+
+        musicDb.insertTracksList(mNewTracks);
+
+        const auto artistsSnapshot = musicDb.allArtistsData();
+        const auto genresSnapshot = musicDb.allGenresData();
+        QVERIFY(artistsSnapshot.size() > 2);
+        QVERIFY(genresSnapshot.size() > 2);
+
+        artistsModel.initialize(nullptr, nullptr, ElisaUtils::Artist, ElisaUtils::NoFilter, {}, {}, 0, {});
+        genresModel.initialize(nullptr, nullptr, ElisaUtils::Genre, ElisaUtils::NoFilter, {}, {}, 0, {});
+
+        artistsModel.artistsAdded({artistsSnapshot.constLast()});
+        artistsModel.artistRemoved(artistsSnapshot.constFirst().databaseId());
+        artistsModel.artistsAdded(artistsSnapshot);
+
+        genresModel.genresAdded({genresSnapshot.constLast()});
+        genresModel.genreRemoved(genresSnapshot.constFirst().databaseId());
+        genresModel.genresAdded(genresSnapshot);
+
+        QCOMPARE(artistsModel.rowCount(), artistsSnapshot.size() - 1);
+        QCOMPARE(genresModel.rowCount(), genresSnapshot.size() - 1);
+        QCOMPARE(artistsModel.data(artistsModel.index(0, 0), DataTypes::DatabaseIdRole).toULongLong(), artistsSnapshot.constLast().databaseId());
+        QCOMPARE(genresModel.data(genresModel.index(0, 0), DataTypes::DatabaseIdRole).toULongLong(), genresSnapshot.constLast().databaseId());
+
+        for (int row = 1; row < artistsModel.rowCount(); ++row) {
+            QCOMPARE(artistsModel.data(artistsModel.index(row, 0), DataTypes::DatabaseIdRole).toULongLong(), artistsSnapshot[row].databaseId());
+        }
+
+        for (int row = 1; row < genresModel.rowCount(); ++row) {
+            QCOMPARE(genresModel.data(genresModel.index(row, 0), DataTypes::DatabaseIdRole).toULongLong(), genresSnapshot[row].databaseId());
+        }
+    }
+
     void removeOneArtistAllArtists()
     {
         DatabaseInterface musicDb;
@@ -1558,6 +1711,291 @@ private Q_SLOTS:
         QCOMPARE(beginInsertRowsSpy.at(1).at(1).toInt(), 2);
         QCOMPARE(beginInsertRowsSpy.at(1).at(2).toInt(), 2);
     }
+
+    void addTracksInAlbumOrder()
+    {
+        DataModel albumModel;
+        QAbstractItemModelTester testModel(&albumModel);
+
+        albumModel.initialize(nullptr, nullptr, ElisaUtils::Track, ElisaUtils::FilterById, {}, {}, 1, {});
+
+        // tracks 1 to 12 of the same disc
+        const auto albumTracks = databaseTracks(12);
+
+        albumModel.tracksAdded({albumTracks[2], albumTracks[3], albumTracks[8]});
+
+        QCOMPARE(albumModel.rowCount(), 3);
+
+        QSignalSpy beginInsertRowsSpy(&albumModel, &DataModel::rowsAboutToBeInserted);
+        QSignalSpy endInsertRowsSpy(&albumModel, &DataModel::rowsInserted);
+
+        albumModel.tracksAdded({albumTracks[11], albumTracks[5], albumTracks[0], albumTracks[9], albumTracks[3],
+                                albumTracks[4], albumTracks[1], albumTracks[10], albumTracks[0]});
+
+        QCOMPARE(albumModel.rowCount(), 10);
+        QCOMPARE(beginInsertRowsSpy.count(), 3);
+        QCOMPARE(endInsertRowsSpy.count(), 3);
+
+        QCOMPARE(beginInsertRowsSpy.at(0).at(1).toInt(), 0);
+        QCOMPARE(beginInsertRowsSpy.at(0).at(2).toInt(), 1);
+        QCOMPARE(beginInsertRowsSpy.at(1).at(1).toInt(), 4);
+        QCOMPARE(beginInsertRowsSpy.at(1).at(2).toInt(), 5);
+        QCOMPARE(beginInsertRowsSpy.at(2).at(1).toInt(), 7);
+        QCOMPARE(beginInsertRowsSpy.at(2).at(2).toInt(), 9);
+
+        const auto expectedTrackNumbers = QList<int>{1, 2, 3, 4, 5, 6, 9, 10, 11, 12};
+        for (int row = 0; row < albumModel.rowCount(); ++row) {
+            QCOMPARE(albumModel.data(albumModel.index(row, 0), DataTypes::TrackNumberRole).toInt(), expectedTrackNumbers[row]);
+        }
+    }
+
+    void trackRecordKeepsTrackData()
+    {
+        auto newTracks = databaseTracks(51);
+        newTracks[0][DataTypes::LyricsRole] = QStringLiteral("lyrics");
+        newTracks[0][DataTypes::CommentRole] = QStringLiteral("comment");
+        newTracks[0].remove(DataTypes::ComposerRole);
+
+        const auto firstRecord = DataTypes::TrackRecord{newTracks[0]};
+        const auto lastRecord = DataTypes::TrackRecord{newTracks[50]};
+
+        const auto firstTrack = firstRecord.toTrackData();
+
+        QCOMPARE(firstTrack.count(), newTracks[0].count());
+        QVERIFY(firstTrack.isSameTrack(newTracks[0]));
+        QCOMPARE(firstTrack.databaseId(), newTracks[0].databaseId());
+        QCOMPARE(firstTrack.albumId(), newTracks[0].albumId());
+        QCOMPARE(firstTrack.elementType(), ElisaUtils::Track);
+        QCOMPARE(firstTrack.fileModificationTime(), newTracks[0].fileModificationTime());
+        QCOMPARE(firstTrack.lyrics(), QStringLiteral("lyrics"));
+        QCOMPARE(firstTrack.hasComposer(), false);
+        QCOMPARE(firstRecord.hasRole(DataTypes::ComposerRole), false);
+        QCOMPARE(firstRecord.data(DataTypes::ComposerRole), QVariant{});
+        QCOMPARE(firstRecord.data(DataTypes::ArtistRole).toString(), QStringLiteral("artist0"));
+
+        // tracks 0 and 50 have the same artist: both records share one string
+        QCOMPARE(lastRecord.data(DataTypes::ArtistRole).toString().constData(),
+                 firstRecord.data(DataTypes::ArtistRole).toString().constData());
+    }
+
+    void modifyTracksAfterRemovingRows()
+    {
+        DataModel tracksModel;
+        QAbstractItemModelTester testModel(&tracksModel);
+
+        tracksModel.initialize(nullptr, nullptr, ElisaUtils::Track, ElisaUtils::NoFilter, {}, {}, 0, {});
+
+        auto newTracks = databaseTracks(100);
+
+        tracksModel.tracksAdded(newTracks.mid(0, 60));
+        tracksModel.tracksAdded(newTracks.mid(60));
+
+        QCOMPARE(tracksModel.rowCount(), 100);
+
+        QSignalSpy dataChangedSpy(&tracksModel, &DataModel::dataChanged);
+
+        tracksModel.trackModified(newTracks[49]);
+
+        QCOMPARE(dataChangedSpy.count(), 1);
+        QCOMPARE(dataChangedSpy.at(0).at(0).toModelIndex().row(), 49);
+
+        tracksModel.trackRemoved(newTracks[10].databaseId());
+        tracksModel.trackRemoved(newTracks[0].databaseId());
+        tracksModel.trackRemoved(newTracks[0].databaseId());
+
+        QCOMPARE(tracksModel.rowCount(), 98);
+
+        newTracks[49][DataTypes::TitleRole] = QStringLiteral("modified");
+        tracksModel.trackModified(newTracks[49]);
+
+        QCOMPARE(dataChangedSpy.count(), 2);
+        QCOMPARE(dataChangedSpy.at(1).at(0).toModelIndex().row(), 47);
+        QCOMPARE(tracksModel.data(tracksModel.index(47, 0), DataTypes::TitleRole).toString(), QStringLiteral("modified"));
+
+        tracksModel.trackModified(newTracks[99]);
+
+        QCOMPARE(dataChangedSpy.count(), 3);
+        QCOMPARE(dataChangedSpy.at(2).at(0).toModelIndex().row(), 97);
+
+        tracksModel.trackModified(newTracks[10]);
+
+        QCOMPARE(dataChangedSpy.count(), 3);
+    }
+
+    void benchmarkModifyTracks_data()
+    {
+        QTest::addColumn<int>("tracksCount");
+
+        QTest::newRow("40k") << 40000;
+    }
+
+    void benchmarkModifyTracks()
+    {
+        QFETCH(int, tracksCount);
+
+        const auto newTracks = databaseTracks(tracksCount);
+
+        DataModel tracksModel;
+        tracksModel.initialize(nullptr, nullptr, ElisaUtils::Track, ElisaUtils::NoFilter, {}, {}, 0, {});
+        tracksModel.tracksAdded(newTracks);
+
+        QSignalSpy dataChangedSpy(&tracksModel, &DataModel::dataChanged);
+
+        // a retag of the end of the collection is the worst case of a linear search
+        QBENCHMARK {
+            for (int trackIndex = tracksCount - 1000; trackIndex < tracksCount; ++trackIndex) {
+                tracksModel.trackModified(newTracks[trackIndex]);
+            }
+        }
+
+        QVERIFY(dataChangedSpy.count() >= 1000);
+    }
+
+    void benchmarkRemoveTracks_data()
+    {
+        QTest::addColumn<int>("tracksCount");
+        QTest::addColumn<bool>("fromHead");
+
+        // removing from the tail never moved the indexed rows: it is the baseline of a removal from the head
+        QTest::newRow("40k tail") << 40000 << false;
+        QTest::newRow("40k head") << 40000 << true;
+    }
+
+    void benchmarkRemoveTracks()
+    {
+        QFETCH(int, tracksCount);
+        QFETCH(bool, fromHead);
+
+        const auto newTracks = databaseTracks(tracksCount);
+
+        DataModel tracksModel;
+        tracksModel.initialize(nullptr, nullptr, ElisaUtils::Track, ElisaUtils::NoFilter, {}, {}, 0, {});
+        tracksModel.tracksAdded(newTracks);
+
+        const auto removedCount = tracksCount / 4;
+
+        QBENCHMARK_ONCE {
+            for (int removedIndex = 0; removedIndex < removedCount; ++removedIndex) {
+                const auto trackIndex = fromHead ? removedIndex : tracksCount - 1 - removedIndex;
+                tracksModel.trackRemoved(newTracks[trackIndex].databaseId());
+            }
+        }
+
+        QCOMPARE(tracksModel.rowCount(), tracksCount - removedCount);
+
+        QSignalSpy dataChangedSpy(&tracksModel, &DataModel::dataChanged);
+
+        tracksModel.trackModified(newTracks[fromHead ? tracksCount - 1 : tracksCount - removedCount - 1]);
+
+        QCOMPARE(dataChangedSpy.count(), 1);
+        QCOMPARE(dataChangedSpy.at(0).at(0).toModelIndex().row(), tracksCount - removedCount - 1);
+    }
+
+    void benchmarkInsertTracks_data()
+    {
+        QTest::addColumn<int>("tracksCount");
+        QTest::addColumn<bool>("atHead");
+
+        // appending to the tail never moved the indexed rows: it is the baseline of an insertion at the head
+        QTest::newRow("40k tail") << 40000 << false;
+        QTest::newRow("40k head") << 40000 << true;
+    }
+
+    void benchmarkInsertTracks()
+    {
+        QFETCH(int, tracksCount);
+        QFETCH(bool, atHead);
+
+        auto newTracks = databaseTracks(tracksCount);
+        for (int trackIndex = 0; trackIndex < tracksCount; ++trackIndex) {
+            newTracks[trackIndex][DataTypes::TrackNumberRole] = trackIndex + 1;
+        }
+
+        // the walk of the shown tracks to find where a track goes is linear in both cases
+        const auto insertedCount = 1000;
+        const auto firstShownTrack = atHead ? insertedCount : 0;
+
+        DataModel albumModel;
+        albumModel.initialize(nullptr, nullptr, ElisaUtils::Track, ElisaUtils::FilterById, {}, {}, 1, {});
+        albumModel.tracksAdded(newTracks.mid(firstShownTrack, tracksCount - insertedCount));
+
+        // each new track is added on its own, as when the files of an album are indexed
+        QBENCHMARK_ONCE {
+            for (int insertedIndex = 0; insertedIndex < insertedCount; ++insertedIndex) {
+                const auto trackIndex = atHead ? insertedCount - 1 - insertedIndex : tracksCount - insertedCount + insertedIndex;
+                albumModel.tracksAdded({newTracks[trackIndex]});
+            }
+        }
+
+        QCOMPARE(albumModel.rowCount(), tracksCount);
+
+        QSignalSpy dataChangedSpy(&albumModel, &DataModel::dataChanged);
+
+        albumModel.trackModified(newTracks[tracksCount - 1]);
+
+        QCOMPARE(dataChangedSpy.count(), 1);
+        QCOMPARE(dataChangedSpy.at(0).at(0).toModelIndex().row(), tracksCount - 1);
+    }
+
+    void benchmarkTracksModelMemory_data()
+    {
+        QTest::addColumn<int>("tracksCount");
+
+        QTest::newRow("40k") << 40000;
+        QTest::newRow("400k") << 400000;
+    }
+
+    void benchmarkTracksModelMemory()
+    {
+        QFETCH(int, tracksCount);
+
+        if (tracksCount > 40000 && qEnvironmentVariableIsEmpty("ELISA_LARGE_BENCHMARKS")) {
+            QSKIP("set ELISA_LARGE_BENCHMARKS to run the benchmark on a large collection");
+        }
+
+        if (residentMemory() < 0) {
+            QSKIP("resident memory is not available on this platform");
+        }
+
+        const auto startMemory = residentMemory();
+
+        QElapsedTimer benchmarkTimer;
+        benchmarkTimer.start();
+
+        const auto newTracks = databaseTracks(tracksCount);
+
+        const auto tracksDataDuration = benchmarkTimer.elapsed();
+        const auto tracksDataMemory = residentMemory() - startMemory;
+
+        DataModel tracksModel;
+        tracksModel.initialize(nullptr, nullptr, ElisaUtils::Track, ElisaUtils::NoFilter, {}, {}, 0, {});
+
+        benchmarkTimer.start();
+
+        tracksModel.tracksAdded(newTracks);
+
+        const auto populateDuration = benchmarkTimer.elapsed();
+        const auto modelMemory = residentMemory() - startMemory - tracksDataMemory;
+
+        QCOMPARE(tracksModel.rowCount(), tracksCount);
+
+        benchmarkTimer.start();
+
+        for (int row = 0; row < tracksModel.rowCount(); ++row) {
+            const auto rowIndex = tracksModel.index(row, 0);
+            QVERIFY(!tracksModel.data(rowIndex, DataTypes::TitleRole).toString().isEmpty());
+            QVERIFY(!tracksModel.data(rowIndex, DataTypes::ArtistRole).toString().isEmpty());
+            QVERIFY(!tracksModel.data(rowIndex, DataTypes::StringDurationRole).toString().isEmpty());
+        }
+
+        const auto readDuration = benchmarkTimer.elapsed();
+
+        qInfo() << tracksCount << "tracks:"
+                << "track maps" << tracksDataMemory / 1024 << "KiB built in" << tracksDataDuration << "ms,"
+                << "model rows" << modelMemory / 1024 << "KiB populated in" << populateDuration << "ms,"
+                << "roles read in" << readDuration << "ms,"
+                << "ratio" << double(tracksDataMemory) / std::max<qint64>(modelMemory, 1);
+    }
 };
 
 QTEST_GUILESS_MAIN(DataModelTests)
@@ -5,8 +5,11 @@
  */
 
 #include "filescanner.h"
+#include "coverfilecache.h"
 #include "config-upnp-qt.h"
 
+#include <QDir>
+#include <QFileInfo>
 #include <QObject>
 #include <QList>
 #include <QUrl>
@@ -71,8 +74,10 @@ private Q_SLOTS:
         QCOMPARE(scannedTrackCover2.hasEmbeddedCover(), true);
 
         auto scannedTrackCover3 = fileScanner.scanOneFile(QUrl::fromLocalFile(mTestTracksForMetaData.at(2)));
-        QCOMPARE(scannedTrackCover2.hasEmbeddedCover(), true);
+        QCOMPARE(scannedTrackCover3.hasEmbeddedCover(), true);
 
+        auto scannedTrackNoCover = fileScanner.scanOneFile(QUrl::fromLocalFile(QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music/test.ogg")));
+        QCOMPARE(scannedTrackNoCover.hasEmbeddedCover(), false);
     }
 
     void testFindCoverInDirectory()
@@ -99,6 +104,75 @@ private Q_SLOTS:
         QVERIFY(!fileScanner.searchForCoverFile(mTestTracksForDirectory.at(8)).isEmpty());
     }
 
+    void testCoverFromDirectoryListing()
+    {
+        FileScanner fileScanner;
+
+        for (const auto &oneTrack : std::as_const(mTestTracksForDirectory)) {
+            const auto directoryPath = QFileInfo(oneTrack).absoluteDir().path();
+
+            CoverFileCache::clear();
+            const auto searchedCover = fileScanner.searchForCoverFile(oneTrack);
+
+            CoverFileCache::clear();
+            const auto listedCover = fileScanner.cacheCoverFile(directoryPath, QDir(directoryPath).entryList(QDir::Files));
+
+            QCOMPARE(listedCover, searchedCover);
+            QCOMPARE(fileScanner.searchForCoverFile(oneTrack), searchedCover);
+        }
+
+        CoverFileCache::clear();
+    }
+
+    void testCoverFileCacheStatistics()
+    {
+        FileScanner fileScanner;
+
+        CoverFileCache::clear();
+        CoverFileCache::resetStatistics();
+
+        const auto firstCover = fileScanner.searchForCoverFile(mTestTracksForDirectory.at(0));
+
+        QCOMPARE(CoverFileCache::statistics().mMissesCount, 1);
+        QCOMPARE(CoverFileCache::statistics().mHitsCount, 0);
+
+        QCOMPARE(fileScanner.searchForCoverFile(mTestTracksForDirectory.at(0)), firstCover);
+
+        QCOMPARE(CoverFileCache::statistics().mMissesCount, 1);
+        QCOMPARE(CoverFileCache::statistics().mHitsCount, 1);
+
+        CoverFileCache::invalidate(QFileInfo(mTestTracksForDirectory.at(0)).absoluteDir().path());
+
+        QCOMPARE(fileScanner.searchForCoverFile(mTestTracksForDirectory.at(0)), firstCover);
+
+        QCOMPARE(CoverFileCache::statistics().mMissesCount, 2);
+        QCOMPARE(CoverFileCache::statistics().mHitsCount, 1);
+        QCOMPARE(CoverFileCache::statistics().mDirectoriesCount, 1);
+
+        CoverFileCache::clear();
+    }
+
+    void testCoverFileCacheIsBounded()
+    {
+        constexpr int directoriesCount = 100000;
+
+        CoverFileCache::clear();
+
+        for (int i = 0; i < directoriesCount; ++i) {
+            const auto directoryPath = QStringLiteral("/music/artist%1/album").arg(i);
+            CoverFileCache::insert(directoryPath, QUrl::fromLocalFile(directoryPath + QStringLiteral("/cover.jpg")));
+        }
+
+        const auto statistics = CoverFileCache::statistics();
+
+        QVERIFY(statistics.mCacheBytes <= CoverFileCache::maximumBytes());
+        QVERIFY(statistics.mDirectoriesCount < directoriesCount);
+        QVERIFY(CoverFileCache::find(QStringLiteral("/music/artist%1/album").arg(directoriesCount - 1)).has_value());
+        QVERIFY(!CoverFileCache::find(QStringLiteral("/music/artist0/album")).has_value());
+
+        CoverFileCache::clear();
+    }
+
     void benchmarkFileScan()
     {
         FileScanner fileScanner;
@@ -111,6 +185,18 @@ private Q_SLOTS:
         }
     }
 
+    void benchmarkFileScanWithEmbeddedCover()
+    {
+        FileScanner fileScanner;
+        QBENCHMARK {
+            for (int i = 0; i < 100; i++) {
+                for (const auto &oneTrack : std::as_const(mTestTracksForMetaData)) {
+                    auto scannedTrack = fileScanner.scanOneFile(QUrl::fromLocalFile(oneTrack));
+                }
+            }
+        }
+    }
+
     void benchmarkCoverInDirectory()
     {
         FileScanner fileScanner;
@@ -0,0 +1,78 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) Elisa contributors
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "filesystemcallscounter.h"
+
+// no C library header declaring realpath must be included here: with
+// _FORTIFY_SOURCE it is an inline wrapper that cannot be redefined
+#if defined(__linux__)
+#include <dlfcn.h>
+#include <sys/stat.h>
+#endif
+
+#if defined(__linux__) && defined(__GLIBC__)
+
+namespace
+{
+
+long long fileSystemCalls = 0;
+
+void countFileSystemCall()
+{
+    __atomic_fetch_add(&fileSystemCalls, 1, __ATOMIC_RELAXED);
+}
+
+}
+
+extern "C" {
+
+#if defined(STATX_BASIC_STATS)
+int statx(int directoryFd, const char *__restrict path, int flags, unsigned int mask, struct statx *__restrict buffer) __THROW
+{
+    using StatxFunction = int (*)(int, const char *, int, unsigned int, struct statx *);
+    static const auto nextStatx = reinterpret_cast<StatxFunction>(dlsym(RTLD_NEXT, "statx"));
+
+    countFileSystemCall();
+
+    return nextStatx(directoryFd, path, flags, mask, buffer);
+}
+#endif
+
+char *realpath(const char *__restrict name, char *__restrict resolved) __THROW
+{
+    using RealpathFunction = char *(*)(const char *, char *);
+    static const auto nextRealpath = reinterpret_cast<RealpathFunction>(dlsym(RTLD_NEXT, "realpath"));
+
+    countFileSystemCall();
+
+    return nextRealpath(name, resolved);
+}
+
+}
+
+bool fileSystemCallsCountIsAvailable()
+{
+    return true;
+}
+
+long long fileSystemCallsCount()
+{
+    return __atomic_load_n(&fileSystemCalls, __ATOMIC_RELAXED);
+}
+
+#else
+
+bool fileSystemCallsCountIsAvailable()
+{
+    return false;
+}
+
+long long fileSystemCallsCount()
+{
+    return 0;
+}
+
+#endif
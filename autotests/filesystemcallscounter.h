@@ -0,0 +1,20 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) Elisa contributors
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef FILESYSTEMCALLSCOUNTER_H
+#define FILESYSTEMCALLSCOUNTER_H
+
+/**
+ * Count the file metadata lookups (statx) and path resolutions (realpath) made
+ * by the test process, including the ones made by Qt.
+ * Only available on Linux with the GNU C library: the test executable defines
+ * both functions, counts the calls and forwards them to the C library.
+ */
+bool fileSystemCallsCountIsAvailable();
+
+long long fileSystemCallsCount();
+
+#endif // FILESYSTEMCALLSCOUNTER_H
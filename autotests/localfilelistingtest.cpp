@@ -5,8 +5,10 @@
  */
 
 #include "databasetestdata.h"
+#include "filesystemcallscounter.h"
 
 #include "file/localfilelisting.h"
+#include "databaseinterface.h"
 #include "elisa_settings.h"
 
 #include "config-upnp-qt.h"
@@ -21,6 +23,10 @@
 #include <QStandardPaths>
 #include <QDir>
 #include <QFile>
+#include <QFileInfo>
+#include <QSet>
+#include <QElapsedTimer>
+#include <QProcess>
 
 #include <QSignalSpy>
 #include <QTest>
@@ -29,6 +35,22 @@
 
 using namespace Qt::Literals::StringLiterals;
 
+class ExtractionCountingListing : public LocalFileListing
+{
+public:
+
+    QHash<QUrl, int> mExtractedFiles;
+
+protected:
+
+    DataTypes::TrackDataType scannedOneFile(const QUrl &scanFile, const DataTypes::TrackDataType &scannedTrack) override
+    {
+        ++mExtractedFiles[scanFile];
+
+        return AbstractFileListing::scannedOneFile(scanFile, scannedTrack);
+    }
+};
+
 class LocalFileListingTests: public QObject, public DatabaseTestData
 {
     Q_OBJECT
@@ -99,6 +121,7 @@ private Q_SLOTS:
 
         QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
         QSignalSpy askRestoredTracksSpy(&myListing, &LocalFileListing::askRestoredTracks);
+        QSignalSpy askScanCheckpointsSpy(&myListing, &LocalFileListing::askScanCheckpoints);
 
         QCOMPARE(tracksListSpy.count(), 0);
         QCOMPARE(askRestoredTracksSpy.count(), 0);
@@ -107,6 +130,17 @@ private Q_SLOTS:
 
         QCOMPARE(tracksListSpy.count(), 0);
         QCOMPARE(askRestoredTracksSpy.count(), 0);
+        QCOMPARE(askScanCheckpointsSpy.count(), 1);
+
+        // only an interrupted scan of one of the root paths is resumed
+        myListing.setAllRootPaths({QStringLiteral("/music/")});
+        myListing.setScanCheckpoints({QStringLiteral("/other music/")}, {});
+
+        QCOMPARE(askRestoredTracksSpy.count(), 0);
+
+        myListing.setScanCheckpoints({QStringLiteral("/music/")}, {});
+
+        QCOMPARE(askRestoredTracksSpy.count(), 1);
     }
 
     void initialTestWithTracks()
@@ -166,6 +200,286 @@ private Q_SLOTS:
         QVERIFY(removedTracksListSpy.isEmpty());
     }
 
+    void parallelScanMatchesSerialScan()
+    {
+        const QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+
+        const auto scanAllTracks = [&musicPath](int workersCount) {
+            Elisa::ElisaConfiguration::self()->setDefaults();
+            Elisa::ElisaConfiguration::self()->setIndexerWorkersCount(workersCount);
+
+            LocalFileListing myListing;
+
+            QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+
+            myListing.init();
+            myListing.setAllRootPaths({musicPath});
+            myListing.refreshContent();
+
+            auto allNewTracks = QList<DataTypes::ListTrackDataType>{};
+            for (const auto &oneSignal : std::as_const(tracksListSpy)) {
+                allNewTracks.push_back(oneSignal.at(0).value<DataTypes::ListTrackDataType>());
+            }
+
+            return allNewTracks;
+        };
+
+        const auto serialTracks = scanAllTracks(1);
+        const auto parallelTracks = scanAllTracks(4);
+
+        Elisa::ElisaConfiguration::self()->setDefaults();
+
+        QVERIFY(!serialTracks.isEmpty());
+        QCOMPARE(parallelTracks.count(), serialTracks.count());
+        QCOMPARE(parallelTracks, serialTracks);
+    }
+
+    void benchmarkRescanFileSystemCalls()
+    {
+        if (!fileSystemCallsCountIsAvailable()) {
+            QSKIP("counting file system calls needs Linux and the GNU C library");
+        }
+
+        constexpr int directoriesCount = 10;
+        constexpr int filesPerDirectory = 20;
+        constexpr int filesCount = directoriesCount * filesPerDirectory;
+
+        const QString musicOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+        const QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/manyFiles");
+
+        QDir musicDirectory(musicPath);
+        musicDirectory.removeRecursively();
+
+        for (int directoryIndex = 0; directoryIndex < directoriesCount; ++directoryIndex) {
+            const auto directoryPath = musicPath + QStringLiteral("/album%1").arg(directoryIndex);
+            QVERIFY(QDir().mkpath(directoryPath));
+
+            for (int fileIndex = 0; fileIndex < filesPerDirectory; ++fileIndex) {
+                QVERIFY(QFile::copy(musicOriginPath + QStringLiteral("/test.ogg"), directoryPath + QStringLiteral("/track%1.ogg").arg(fileIndex)));
+            }
+        }
+
+        Elisa::ElisaConfiguration::self()->setDefaults();
+
+        LocalFileListing myListing;
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+
+        myListing.init();
+        myListing.setAllRootPaths({musicPath});
+        myListing.refreshContent();
+
+        auto scannedFilesCount = 0;
+        for (const auto &oneSignal : std::as_const(tracksListSpy)) {
+            scannedFilesCount += oneSignal.at(0).value<DataTypes::ListTrackDataType>().count();
+        }
+        QCOMPARE(scannedFilesCount, filesCount);
+
+        // no file changed: the rescan only walks the directories
+        tracksListSpy.clear();
+        const auto rescanStart = fileSystemCallsCount();
+        myListing.refreshContent();
+        const auto rescanCalls = fileSystemCallsCount() - rescanStart;
+        QCOMPARE(tracksListSpy.count(), 0);
+
+        qInfo() << "statx and realpath calls per file during a rescan of" << filesCount << "files:" << double(rescanCalls) / filesCount;
+
+        // the walk re-reading each entry made a realpath call and a statx call for every file
+        constexpr int baselineCallsPerFile = 2;
+
+        // the change time of each file is read once from the file info of the listing
+        QVERIFY2(rescanCalls > 0, "the file system calls are not counted");
+        QVERIFY2(rescanCalls < baselineCallsPerFile * filesCount, qPrintable(QString::number(rescanCalls)));
+        QVERIFY2(rescanCalls <= filesCount + 8 * (directoriesCount + 1), qPrintable(QString::number(rescanCalls)));
+
+        musicDirectory.removeRecursively();
+    }
+
+    void startupScanSkipsUnchangedDirectories()
+    {
+        const QString musicOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+        const QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/fingerprints");
+
+        QDir musicDirectory(musicPath);
+        musicDirectory.removeRecursively();
+
+        QVERIFY(QDir().mkpath(musicPath + QStringLiteral("/album1")));
+        QVERIFY(QDir().mkpath(musicPath + QStringLiteral("/album2")));
+        QVERIFY(QFile::copy(musicOriginPath + QStringLiteral("/test.ogg"), musicPath + QStringLiteral("/album1/track1.ogg")));
+        QVERIFY(QFile::copy(musicOriginPath + QStringLiteral("/test.ogg"), musicPath + QStringLiteral("/album2/track1.ogg")));
+
+        Elisa::ElisaConfiguration::self()->setDefaults();
+
+        auto allTracks = QHash<QUrl, QDateTime>();
+        auto fingerprints = DataTypes::DirectoryFingerprints();
+
+        {
+            LocalFileListing myListing;
+
+            QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+            QSignalSpy directoryFingerprintsSpy(&myListing, &LocalFileListing::directoryFingerprints);
+
+            myListing.init();
+            myListing.setAllRootPaths({musicPath});
+            myListing.setIndexedTracks({});
+
+            for (const auto &oneSignal : std::as_const(tracksListSpy)) {
+                const auto tracks = oneSignal.at(0).value<DataTypes::ListTrackDataType>();
+                for (const auto &oneTrack : tracks) {
+                    allTracks[oneTrack.resourceURI()] = oneTrack.fileModificationTime();
+                }
+            }
+
+            QCOMPARE(allTracks.count(), 2);
+
+            // the fingerprints are sent as soon as the tracks of their directories have been sent
+            QVERIFY(directoryFingerprintsSpy.count() >= 1);
+            for (const auto &oneSignal : std::as_const(directoryFingerprintsSpy)) {
+                fingerprints.insert(oneSignal.at(0).value<DataTypes::DirectoryFingerprints>());
+            }
+            QCOMPARE(fingerprints.count(), 3);
+        }
+
+        QVERIFY(QFile::copy(musicOriginPath + QStringLiteral("/test.ogg"), musicPath + QStringLiteral("/album2/track2.ogg")));
+
+        LocalFileListing myListing;
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+        QSignalSpy removedTracksListSpy(&myListing, &LocalFileListing::removedTracksList);
+        QSignalSpy directoryFingerprintsSpy(&myListing, &LocalFileListing::directoryFingerprints);
+
+        myListing.init();
+        myListing.setAllRootPaths({musicPath});
+        myListing.setDirectoryFingerprints(fingerprints);
+        myListing.setIndexedTracks(allTracks);
+
+        // only the directory that got a new file is scanned again
+        QCOMPARE(removedTracksListSpy.count(), 0);
+        QCOMPARE(tracksListSpy.count(), 1);
+
+        const auto newTracks = tracksListSpy.at(0).at(0).value<DataTypes::ListTrackDataType>();
+        QCOMPARE(newTracks.count(), 1);
+        QCOMPARE(newTracks.at(0).resourceURI(), QUrl::fromLocalFile(musicPath + QStringLiteral("/album2/track2.ogg")));
+
+        QCOMPARE(directoryFingerprintsSpy.count(), 1);
+
+        const auto changedFingerprints = directoryFingerprintsSpy.at(0).at(0).value<DataTypes::DirectoryFingerprints>();
+        QCOMPARE(changedFingerprints.keys(), QList<QUrl>{QUrl::fromLocalFile(musicPath + QStringLiteral("/album2"))});
+
+        // the root directories are no longer indexed: their fingerprints are forgotten
+        QSignalSpy removedDirectoryFingerprintsSpy(&myListing, &LocalFileListing::removedDirectoryFingerprints);
+
+        myListing.setAllRootPaths({QStringLiteral("/directoryNotExist")});
+        myListing.setIndexedTracks({});
+
+        QCOMPARE(removedDirectoryFingerprintsSpy.count(), 1);
+        QCOMPARE(removedDirectoryFingerprintsSpy.at(0).at(0).value<QList<QUrl>>().count(), 3);
+
+        musicDirectory.removeRecursively();
+    }
+
+    void benchmarkStartupScanWithDirectoryFingerprints_data()
+    {
+        QTest::addColumn<int>("directoriesCount");
+        QTest::addColumn<int>("filesPerDirectory");
+
+        QTest::newRow("4k") << 40 << 100;
+        QTest::newRow("400k") << 2000 << 200;
+    }
+
+    void benchmarkStartupScanWithDirectoryFingerprints()
+    {
+        QFETCH(int, directoriesCount);
+        QFETCH(int, filesPerDirectory);
+
+        const auto filesCount = directoriesCount * filesPerDirectory;
+
+        if (filesCount > 4000 && qEnvironmentVariableIsEmpty("ELISA_LARGE_BENCHMARKS")) {
+            QSKIP("set ELISA_LARGE_BENCHMARKS to run the benchmark on a large collection");
+        }
+
+        const QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/startupScan");
+
+        QDir musicDirectory(musicPath);
+        musicDirectory.removeRecursively();
+
+        // the files are already indexed: their content is never read and they can stay empty
+        auto allTracks = QHash<QUrl, QDateTime>();
+        allTracks.reserve(filesCount);
+
+        for (int directoryIndex = 0; directoryIndex < directoriesCount; ++directoryIndex) {
+            const auto directoryPath = musicPath + QStringLiteral("/album%1").arg(directoryIndex);
+            QVERIFY(QDir().mkpath(directoryPath));
+
+            for (int fileIndex = 0; fileIndex < filesPerDirectory; ++fileIndex) {
+                const auto filePath = directoryPath + QStringLiteral("/track%1.ogg").arg(fileIndex);
+
+                QFile oneFile(filePath);
+                QVERIFY(oneFile.open(QIODevice::WriteOnly));
+                oneFile.close();
+
+                allTracks[QUrl::fromLocalFile(filePath)] = QFileInfo(filePath).metadataChangeTime();
+            }
+        }
+
+        Elisa::ElisaConfiguration::self()->setDefaults();
+
+        const auto timeStartupScan = [&musicPath, &allTracks](const DataTypes::DirectoryFingerprints &fingerprints,
+                                                              DataTypes::DirectoryFingerprints &newFingerprints,
+                                                              qint64 &duration, long long &fileSystemCalls) {
+            LocalFileListing myListing;
+
+            QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+            QSignalSpy directoryFingerprintsSpy(&myListing, &LocalFileListing::directoryFingerprints);
+
+            myListing.init();
+            myListing.setAllRootPaths({musicPath});
+            myListing.setDirectoryFingerprints(fingerprints);
+
+            QElapsedTimer scanTimer;
+            scanTimer.start();
+            const auto scanStart = fileSystemCallsCount();
+
+            myListing.setIndexedTracks(allTracks);
+
+            fileSystemCalls = fileSystemCallsCount() - scanStart;
+            duration = scanTimer.elapsed();
+
+            if (!directoryFingerprintsSpy.isEmpty()) {
+                newFingerprints = directoryFingerprintsSpy.at(0).at(0).value<DataTypes::DirectoryFingerprints>();
+            }
+
+            return tracksListSpy.count();
+        };
+
+        auto fingerprints = DataTypes::DirectoryFingerprints();
+        auto unusedFingerprints = DataTypes::DirectoryFingerprints();
+        auto withoutFingerprintsDuration = qint64{0};
+        auto withFingerprintsDuration = qint64{0};
+        auto withoutFingerprintsCalls = 0LL;
+        auto withFingerprintsCalls = 0LL;
+
+        QCOMPARE(timeStartupScan({}, fingerprints, withoutFingerprintsDuration, withoutFingerprintsCalls), 0);
+        QCOMPARE(fingerprints.count(), directoriesCount + 1);
+
+        QCOMPARE(timeStartupScan(fingerprints, unusedFingerprints, withFingerprintsDuration, withFingerprintsCalls), 0);
+        QVERIFY(unusedFingerprints.isEmpty());
+
+        qInfo() << "startup scan of" << filesCount << "unchanged files in" << directoriesCount << "directories:"
+                << "without fingerprints" << withoutFingerprintsDuration << "ms,"
+                << "with fingerprints" << withFingerprintsDuration << "ms";
+
+        if (fileSystemCallsCountIsAvailable()) {
+            qInfo() << "statx and realpath calls per file:"
+                    << "without fingerprints" << double(withoutFingerprintsCalls) / filesCount << ","
+                    << "with fingerprints" << double(withFingerprintsCalls) / filesCount;
+
+            QVERIFY(withFingerprintsCalls < withoutFingerprintsCalls);
+        }
+
+        musicDirectory.removeRecursively();
+    }
+
     void addAndRemoveTracks()
     {
         LocalFileListing myListing;
@@ -446,6 +760,449 @@ private Q_SLOTS:
         QCOMPARE(newTracksLast.count(), 1);
     }
 
+    void replaceTrackOnlyScansReplacedFile()
+    {
+#if !defined(Q_OS_LINUX)
+        QSKIP("the names of the changed files are only reported by inotify");
+#endif
+
+        LocalFileListing myListing;
+
+        QString musicOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+
+        QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music4/data");
+
+        QString musicParentPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music4");
+        QDir musicParentDirectory(musicParentPath);
+        QDir rootDirectory(QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH));
+
+        musicParentDirectory.removeRecursively();
+        rootDirectory.mkpath(QStringLiteral("music4/data"));
+
+        QFile myTrack(musicOriginPath + QStringLiteral("/test.ogg"));
+        QCOMPARE(myTrack.copy(musicPath + QStringLiteral("/test.ogg")), true);
+        QFile myOtherTrack(musicOriginPath + QStringLiteral("/test.mp3"));
+        QCOMPARE(myOtherTrack.copy(musicPath + QStringLiteral("/test.mp3")), true);
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+        QSignalSpy removedTracksListSpy(&myListing, &LocalFileListing::removedTracksList);
+        QSignalSpy modifiedTracksListSpy(&myListing, &LocalFileListing::modifyTracksList);
+        QSignalSpy errorWatchingFileSystemChangesSpy(&myListing, &LocalFileListing::errorWatchingFileSystemChanges);
+
+        myListing.init();
+        myListing.setAllRootPaths({musicParentPath});
+        myListing.refreshContent();
+
+        QCOMPARE(tracksListSpy.count(), 1);
+        QCOMPARE(tracksListSpy.at(0).at(0).value<DataTypes::ListTrackDataType>().count(), 2);
+
+        QCOMPARE(QFile::remove(musicPath + QStringLiteral("/test.ogg")), true);
+        QCOMPARE(myTrack.copy(musicPath + QStringLiteral("/test.ogg")), true);
+
+        // the modified track is sent with the new ones
+        auto modifiedFilesWorking = tracksListSpy.wait();
+
+        if (!modifiedFilesWorking && errorWatchingFileSystemChangesSpy.count()) {
+            QEXPECT_FAIL("", "Impossible watching file system for changes", Abort);
+        }
+        QCOMPARE(modifiedFilesWorking, true);
+
+        QCOMPARE(tracksListSpy.count(), 2);
+        QCOMPARE(removedTracksListSpy.count(), 0);
+        QCOMPARE(modifiedTracksListSpy.count(), 0);
+
+        auto modifiedTracks = tracksListSpy.at(1).at(0).value<DataTypes::ListTrackDataType>();
+
+        QCOMPARE(modifiedTracks.count(), 1);
+        QCOMPARE(modifiedTracks.at(0).resourceURI(), QUrl::fromLocalFile(QFileInfo(musicPath + QStringLiteral("/test.ogg")).canonicalFilePath()));
+
+        musicParentDirectory.removeRecursively();
+    }
+
+    void changesAreSentInOneBatch()
+    {
+#if !defined(Q_OS_LINUX)
+        QSKIP("the names of the changed files are only reported by inotify");
+#endif
+
+        Elisa::ElisaConfiguration::self()->setDefaults();
+        Elisa::ElisaConfiguration::self()->setFileSystemChangesDelay(1000);
+
+        LocalFileListing myListing;
+
+        QString musicOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+
+        QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music5/data");
+
+        QString musicParentPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music5");
+        QDir musicParentDirectory(musicParentPath);
+        QDir rootDirectory(QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH));
+
+        musicParentDirectory.removeRecursively();
+        rootDirectory.mkpath(QStringLiteral("music5/data"));
+
+        const auto fileNames = QStringList{QStringLiteral("test.ogg"), QStringLiteral("test.mp3")};
+        for (const auto &oneFileName : fileNames) {
+            QCOMPARE(QFile::copy(musicOriginPath + u'/' + oneFileName, musicPath + u'/' + oneFileName), true);
+        }
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+        QSignalSpy removedTracksListSpy(&myListing, &LocalFileListing::removedTracksList);
+        QSignalSpy modifiedTracksListSpy(&myListing, &LocalFileListing::modifyTracksList);
+        QSignalSpy errorWatchingFileSystemChangesSpy(&myListing, &LocalFileListing::errorWatchingFileSystemChanges);
+
+        myListing.init();
+        myListing.setAllRootPaths({musicParentPath});
+        myListing.refreshContent();
+
+        QCOMPARE(tracksListSpy.count(), 1);
+
+        // every file is replaced, one of them twice, and a new file is added
+        for (const auto &oneFileName : fileNames) {
+            QCOMPARE(QFile::remove(musicPath + u'/' + oneFileName), true);
+            QCOMPARE(QFile::copy(musicOriginPath + u'/' + oneFileName, musicPath + u'/' + oneFileName), true);
+        }
+        QCOMPARE(QFile::remove(musicPath + QStringLiteral("/test.ogg")), true);
+        QCOMPARE(QFile::copy(musicOriginPath + QStringLiteral("/test.ogg"), musicPath + QStringLiteral("/test.ogg")), true);
+        QCOMPARE(QFile::copy(musicOriginPath + QStringLiteral("/test.m4a"), musicPath + QStringLiteral("/test.m4a")), true);
+
+        // the two modified tracks and the new one are one insertion
+        auto modifiedFilesWorking = tracksListSpy.wait();
+
+        if (!modifiedFilesWorking && errorWatchingFileSystemChangesSpy.count()) {
+            QEXPECT_FAIL("", "Impossible watching file system for changes", Abort);
+        }
+        QCOMPARE(modifiedFilesWorking, true);
+
+        QCOMPARE(tracksListSpy.count(), 2);
+        QCOMPARE(removedTracksListSpy.count(), 0);
+        QCOMPARE(modifiedTracksListSpy.count(), 0);
+        QCOMPARE(tracksListSpy.at(1).at(0).value<DataTypes::ListTrackDataType>().count(), 3);
+
+        Elisa::ElisaConfiguration::self()->setDefaults();
+        musicParentDirectory.removeRecursively();
+    }
+
+    void changesWithoutTracksDoNotStartIndexing()
+    {
+#if !defined(Q_OS_LINUX)
+        QSKIP("the names of the changed files are only reported by inotify");
+#endif
+
+        Elisa::ElisaConfiguration::self()->setDefaults();
+        Elisa::ElisaConfiguration::self()->setFileSystemChangesDelay(100);
+
+        LocalFileListing myListing;
+
+        QString musicOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+
+        QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music8/data");
+
+        QString musicParentPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music8");
+        QDir musicParentDirectory(musicParentPath);
+        QDir rootDirectory(QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH));
+
+        musicParentDirectory.removeRecursively();
+        rootDirectory.mkpath(QStringLiteral("music8/data"));
+
+        QCOMPARE(QFile::copy(musicOriginPath + QStringLiteral("/test.ogg"), musicPath + QStringLiteral("/test.ogg")), true);
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+        QSignalSpy indexingStartedSpy(&myListing, &LocalFileListing::indexingStarted);
+        QSignalSpy indexingFinishedSpy(&myListing, &LocalFileListing::indexingFinished);
+        QSignalSpy errorWatchingFileSystemChangesSpy(&myListing, &LocalFileListing::errorWatchingFileSystemChanges);
+
+        myListing.init();
+        myListing.setAllRootPaths({musicParentPath});
+        myListing.refreshContent();
+
+        QCOMPARE(tracksListSpy.count(), 1);
+        indexingStartedSpy.clear();
+        indexingFinishedSpy.clear();
+
+        // a file that is not a track changes nothing in the collection
+        QFile notesFile(musicPath + QStringLiteral("/notes.txt"));
+        QVERIFY(notesFile.open(QIODevice::WriteOnly));
+        notesFile.write("notes");
+        notesFile.close();
+
+        QTest::qWait(500);
+
+        QCOMPARE(indexingStartedSpy.count(), 0);
+        QCOMPARE(indexingFinishedSpy.count(), 0);
+
+        QCOMPARE(QFile::copy(musicOriginPath + QStringLiteral("/test.mp3"), musicPath + QStringLiteral("/test.mp3")), true);
+
+        auto newFilesWorking = tracksListSpy.wait();
+
+        if (!newFilesWorking && errorWatchingFileSystemChangesSpy.count()) {
+            QEXPECT_FAIL("", "Impossible watching file system for changes", Abort);
+        }
+        QCOMPARE(newFilesWorking, true);
+
+        QCOMPARE(indexingStartedSpy.count(), 1);
+        QCOMPARE(indexingFinishedSpy.count(), 1);
+
+        Elisa::ElisaConfiguration::self()->setDefaults();
+        musicParentDirectory.removeRecursively();
+    }
+
+    void insertionFlowControlBoundsInFlightBatches()
+    {
+        Elisa::ElisaConfiguration::self()->setDefaults();
+
+        LocalFileListing myListing;
+
+        QString musicOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+
+        QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music6/data");
+
+        QString musicParentPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music6");
+        QDir musicParentDirectory(musicParentPath);
+        QDir rootDirectory(QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH));
+
+        musicParentDirectory.removeRecursively();
+        rootDirectory.mkpath(QStringLiteral("music6/data"));
+
+        constexpr int tracksCount = 60;
+        for (int i = 0; i < tracksCount; ++i) {
+            QCOMPARE(QFile::copy(musicOriginPath + QStringLiteral("/test.ogg"), musicPath + QStringLiteral("/track%1.ogg").arg(i)), true);
+        }
+
+        // a database slower than the scan, on its own thread
+        QThread databaseThread;
+        QObject slowDatabase;
+        slowDatabase.moveToThread(&databaseThread);
+        databaseThread.start();
+
+        QAtomicInt insertedTracksCount = 0;
+        QAtomicInt finishedBatchesCount = 0;
+        int sentBatchesCount = 0;
+        int maximumInFlightBatches = 0;
+
+        connect(&myListing, &LocalFileListing::tracksList, &myListing, [&sentBatchesCount, &finishedBatchesCount, &maximumInFlightBatches](const DataTypes::ListTrackDataType &) {
+            ++sentBatchesCount;
+            maximumInFlightBatches = std::max(maximumInFlightBatches, sentBatchesCount - finishedBatchesCount.loadAcquire());
+        }, Qt::DirectConnection);
+        connect(&myListing, &LocalFileListing::tracksList, &slowDatabase, [&myListing, &slowDatabase, &insertedTracksCount, &finishedBatchesCount](const DataTypes::ListTrackDataType &tracks) {
+            // the insertions asked by other senders do not free a slot
+            myListing.databaseFinishedInsertingTracksList(&slowDatabase);
+            QThread::msleep(20);
+            insertedTracksCount.fetchAndAddRelaxed(static_cast<int>(tracks.size()));
+            finishedBatchesCount.fetchAndAddRelease(1);
+            myListing.databaseFinishedInsertingTracksList(&myListing);
+        });
+
+        myListing.setInsertionFlowControlEnabled(true);
+        myListing.init();
+        myListing.setAllRootPaths({musicParentPath});
+        myListing.refreshContent();
+
+        QVERIFY(maximumInFlightBatches > 0);
+        QVERIFY(maximumInFlightBatches <= InsertionFlowControl::maximumInFlightBatches);
+
+        QTRY_COMPARE(myListing.insertionStatistics().mInFlightBatches, 0);
+        QCOMPARE(insertedTracksCount.loadRelaxed(), tracksCount);
+
+        const auto statistics = myListing.insertionStatistics();
+        QCOMPARE(statistics.mInsertedTracks, static_cast<qint64>(tracksCount));
+        QCOMPARE(statistics.mInFlightTracks, 0);
+        QVERIFY(statistics.mBatchSize > 0);
+        QVERIFY(statistics.mTracksPerSecond > 0.);
+
+        databaseThread.quit();
+        databaseThread.wait();
+
+        musicParentDirectory.removeRecursively();
+    }
+
+    void interruptedScanIsResumed()
+    {
+        Elisa::ElisaConfiguration::self()->setDefaults();
+        Elisa::ElisaConfiguration::self()->setScanAtStartup(false);
+
+        const QString musicOriginPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+        const QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/music7");
+
+        QDir musicDirectory(musicPath);
+        musicDirectory.removeRecursively();
+
+        // each directory also has a file that is not a track: it is never inserted in the database
+        auto allFiles = QSet<QUrl>();
+        for (int directoryIndex = 1; directoryIndex <= 3; ++directoryIndex) {
+            const auto directoryPath = musicPath + QStringLiteral("/album%1").arg(directoryIndex);
+            QVERIFY(QDir().mkpath(directoryPath));
+
+            for (int trackIndex = 1; trackIndex <= 4; ++trackIndex) {
+                const auto trackPath = directoryPath + QStringLiteral("/track%1.ogg").arg(trackIndex);
+                QVERIFY(QFile::copy(musicOriginPath + QStringLiteral("/test.ogg"), trackPath));
+                allFiles.insert(QUrl::fromLocalFile(trackPath));
+            }
+
+            QFile notesFile(directoryPath + QStringLiteral("/tracklist.txt"));
+            QVERIFY(notesFile.open(QIODevice::WriteOnly));
+            notesFile.write("track1\ntrack2\ntrack3\ntrack4\n");
+            notesFile.close();
+            allFiles.insert(QUrl::fromLocalFile(notesFile.fileName()));
+        }
+
+        DatabaseInterface musicDb;
+        musicDb.init(QStringLiteral("scanCheckpointsDb"));
+
+        QSignalSpy musicDbErrorSpy(&musicDb, &DatabaseInterface::databaseError);
+        QSignalSpy restoredTracksSpy(&musicDb, &DatabaseInterface::restoredTracks);
+        QSignalSpy restoredScanCheckpointsSpy(&musicDb, &DatabaseInterface::restoredScanCheckpoints);
+
+        const auto connectToDatabase = [&musicDb](LocalFileListing &listing) {
+            connect(&listing, &LocalFileListing::tracksList, &musicDb, &DatabaseInterface::insertTracksList);
+            connect(&listing, &LocalFileListing::removedTracksList, &musicDb, &DatabaseInterface::removeTracksList);
+            connect(&listing, &LocalFileListing::modifyTracksList, &musicDb, &DatabaseInterface::insertTracksList);
+            connect(&listing, &LocalFileListing::askRestoredTracks, &musicDb, &DatabaseInterface::askRestoredTracks);
+            connect(&musicDb, &DatabaseInterface::restoredDirectoryFingerprints, &listing, &LocalFileListing::setDirectoryFingerprints);
+            connect(&musicDb, &DatabaseInterface::restoredTracks, &listing, &LocalFileListing::setIndexedTracks);
+            connect(&listing, &LocalFileListing::directoryFingerprints, &musicDb, &DatabaseInterface::insertDirectoryFingerprints);
+            connect(&listing, &LocalFileListing::removedDirectoryFingerprints, &musicDb, &DatabaseInterface::removeDirectoryFingerprints);
+            connect(&listing, &LocalFileListing::askScanCheckpoints, &musicDb, &DatabaseInterface::askScanCheckpoints);
+            connect(&musicDb, &DatabaseInterface::restoredScanCheckpoints, &listing, &LocalFileListing::setScanCheckpoints);
+            connect(&listing, &LocalFileListing::scanCheckpointAdded, &musicDb, &DatabaseInterface::insertScanCheckpoint);
+            connect(&listing, &LocalFileListing::scanCheckpointRemoved, &musicDb, &DatabaseInterface::removeScanCheckpoint);
+            connect(&listing, &LocalFileListing::scanCheckpointDirectoriesAdded, &musicDb, &DatabaseInterface::insertScanCheckpointDirectories);
+            connect(&listing, &LocalFileListing::indexingFinished, &musicDb, &DatabaseInterface::endBulkImport);
+        };
+
+        auto extractedFiles = QHash<QUrl, int>();
+
+        {
+            ExtractionCountingListing myListing;
+            connectToDatabase(myListing);
+
+            // the application is killed while the second batch is sent
+            int sentBatchesCount = 0;
+            connect(&myListing, &LocalFileListing::tracksList, &myListing, [&myListing, &sentBatchesCount]() {
+                ++sentBatchesCount;
+                if (sentBatchesCount == 2) {
+                    myListing.applicationAboutToQuit();
+                }
+            });
+
+            myListing.setAllRootPaths({musicPath});
+            myListing.init();
+
+            QCOMPARE(restoredScanCheckpointsSpy.count(), 1);
+            QVERIFY(restoredScanCheckpointsSpy.at(0).at(0).toStringList().isEmpty());
+
+            // the first scan is asked by the user
+            musicDb.askRestoredTracks();
+
+            QCOMPARE(sentBatchesCount, 2);
+
+            extractedFiles = myListing.mExtractedFiles;
+        }
+
+        musicDb.askScanCheckpoints();
+
+        // the first directory was finished before the interruption
+        const auto finishedDirectory = QUrl::fromLocalFile(musicPath + QStringLiteral("/album1"));
+
+        QCOMPARE(restoredScanCheckpointsSpy.count(), 2);
+        QCOMPARE(restoredScanCheckpointsSpy.at(1).at(0).toStringList(), QStringList{musicPath});
+        QCOMPARE(restoredScanCheckpointsSpy.at(1).at(1).value<QList<QUrl>>(), QList<QUrl>{finishedDirectory});
+
+        QSignalSpy directoryFingerprintsSpy(&musicDb, &DatabaseInterface::restoredDirectoryFingerprints);
+
+        ExtractionCountingListing myListing;
+        connectToDatabase(myListing);
+
+        QSignalSpy tracksListSpy(&myListing, &LocalFileListing::tracksList);
+
+        // the next start resumes the scan without being asked
+        myListing.setAllRootPaths({musicPath});
+        myListing.init();
+
+        QCOMPARE(restoredScanCheckpointsSpy.count(), 3);
+        QCOMPARE(restoredTracksSpy.count(), 2);
+        QCOMPARE(directoryFingerprintsSpy.count(), 1);
+
+        const auto restoredFingerprints = directoryFingerprintsSpy.at(0).at(0).value<DataTypes::DirectoryFingerprints>();
+        QCOMPARE(restoredFingerprints.keys(), QList<QUrl>{finishedDirectory});
+
+        auto resumedTracksCount = restoredTracksSpy.at(1).at(0).value<QHash<QUrl, QDateTime>>().count();
+        for (const auto &oneSignal : std::as_const(tracksListSpy)) {
+            resumedTracksCount += oneSignal.at(0).value<DataTypes::ListTrackDataType>().count();
+        }
+        QCOMPARE(resumedTracksCount, 12);
+
+        // the workers may have extracted files that were not sent yet: only the finished directory is skipped
+        for (const auto &[oneFile, extractionsCount] : myListing.mExtractedFiles.asKeyValueRange()) {
+            QVERIFY(!oneFile.toLocalFile().startsWith(finishedDirectory.toLocalFile() + u'/'));
+            extractedFiles[oneFile] += extractionsCount;
+        }
+
+        QCOMPARE(QSet<QUrl>(extractedFiles.keyBegin(), extractedFiles.keyEnd()), allFiles);
+
+        musicDb.askScanCheckpoints();
+
+        QCOMPARE(restoredScanCheckpointsSpy.count(), 4);
+        QVERIFY(restoredScanCheckpointsSpy.at(3).at(0).toStringList().isEmpty());
+        QVERIFY(restoredScanCheckpointsSpy.at(3).at(1).value<QList<QUrl>>().isEmpty());
+        QCOMPARE(musicDbErrorSpy.count(), 0);
+
+        Elisa::ElisaConfiguration::self()->setDefaults();
+        musicDirectory.removeRecursively();
+    }
+
+    void importToolIndexesInBatchMode()
+    {
+        const QString musicPath = QStringLiteral(LOCAL_FILE_TESTS_SAMPLE_FILES_PATH) + QStringLiteral("/music");
+        const QString importPath = QStringLiteral(LOCAL_FILE_TESTS_WORKING_PATH) + QStringLiteral("/elisaImport");
+        const QString databasePath = importPath + QStringLiteral("/elisaDatabase.db");
+
+        QDir importDirectory(importPath);
+        importDirectory.removeRecursively();
+
+        // an invalid option value stops the tool before it creates the database
+        QProcess invalidImport;
+        invalidImport.start(QStringLiteral(ELISA_IMPORT_EXECUTABLE), {QStringLiteral("--database"), databasePath,
+                                                                      QStringLiteral("--workers"), QStringLiteral("many")});
+        QVERIFY(invalidImport.waitForFinished(30000));
+        QCOMPARE(invalidImport.exitStatus(), QProcess::NormalExit);
+        QCOMPARE(invalidImport.exitCode(), 1);
+        QVERIFY(!QFile::exists(databasePath));
+
+        // the statistics are translated
+        auto untranslatedEnvironment = QProcessEnvironment::systemEnvironment();
+        untranslatedEnvironment.insert(QStringLiteral("LANGUAGE"), QStringLiteral("C"));
+
+        QProcess batchImport;
+        batchImport.setProcessEnvironment(untranslatedEnvironment);
+        batchImport.start(QStringLiteral(ELISA_IMPORT_EXECUTABLE), {QStringLiteral("--root-path"), musicPath,
+                                                                    QStringLiteral("--database"), databasePath,
+                                                                    QStringLiteral("--batch-size"), QStringLiteral("2")});
+        QVERIFY(batchImport.waitForFinished(60000));
+        QCOMPARE(batchImport.exitStatus(), QProcess::NormalExit);
+        QCOMPARE(batchImport.exitCode(), 0);
+        QVERIFY(QString::fromLocal8Bit(batchImport.readAllStandardOutput()).contains(QStringLiteral(" tracks/s")));
+
+        // every track has been inserted when the tool quits
+        DatabaseInterface musicDb;
+        musicDb.init(QStringLiteral("importToolDb"), databasePath);
+
+        QSignalSpy restoredTracksSpy(&musicDb, &DatabaseInterface::restoredTracks);
+
+        musicDb.askRestoredTracks();
+
+        QCOMPARE(restoredTracksSpy.count(), 1);
+
+        const auto importedTracks = restoredTracksSpy.at(0).at(0).value<QHash<QUrl, QDateTime>>();
+        const auto canonicalMusicPath = QFileInfo(musicPath).canonicalFilePath() + u'/';
+        QVERIFY(!importedTracks.isEmpty());
+        for (const auto &oneTrack : importedTracks.keys()) {
+            QVERIFY(oneTrack.toLocalFile().startsWith(canonicalMusicPath));
+        }
+
+        importDirectory.removeRecursively();
+    }
+
     void restoreRemovedTracks()
     {
         LocalFileListing myListing;
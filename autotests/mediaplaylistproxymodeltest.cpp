@@ -19,6 +19,7 @@
 
 #include "config-upnp-qt.h"
 
+#include <QSet>
 #include <QSignalSpy>
 #include <QTest>
 #include <QUrl>
@@ -54,6 +55,23 @@ static QUrl createTemporaryFile(const QString &fileName, const QString &contents
     return url;
 }
 
+static DataTypes::EntryDataList generatedEntries(int entriesCount, const QString &directory)
+{
+    DataTypes::EntryDataList newEntries;
+    newEntries.reserve(entriesCount);
+    for (int entryIndex = 0; entryIndex < entriesCount; ++entryIndex) {
+        auto newTrack = DataTypes::TrackDataType{};
+        newTrack[DataTypes::ElementTypeRole] = ElisaUtils::Track;
+        newTrack[DataTypes::DatabaseIdRole] = qulonglong(entryIndex + 1);
+        newTrack[DataTypes::TitleRole] = QStringLiteral("track%1").arg(entryIndex);
+        newTrack[DataTypes::DurationRole] = QTime::fromMSecsSinceStartOfDay(1000 + entryIndex);
+        newTrack[DataTypes::ResourceRole] = QUrl::fromLocalFile(QStringLiteral("/%1/%2.ogg").arg(directory).arg(entryIndex));
+        newEntries.push_back({newTrack, newTrack.title(), {}});
+    }
+
+    return newEntries;
+}
+
 MediaPlayListProxyModelTest::MediaPlayListProxyModelTest(QObject *parent) : QObject(parent)
 {
 }
@@ -2137,6 +2155,59 @@ void MediaPlayListProxyModelTest::remainingTracksTest()
     QCOMPARE(mPlayListProxyModel->remainingTracks(), -1);
 }
 
+void MediaPlayListProxyModelTest::tracksDurationAggregatesTest()
+{
+    const auto durationFromRow = [this](int firstRow) {
+        auto duration = 0;
+        for (int row = std::max(firstRow, 0); row < mPlayListProxyModel->rowCount(); ++row) {
+            duration += mPlayListProxyModel->data(mPlayListProxyModel->index(row, 0), MediaPlayList::DurationRole).toTime().msecsSinceStartOfDay();
+        }
+        return duration;
+    };
+
+    mPlayListProxyModel->enqueue({{{{DataTypes::ElementTypeRole, ElisaUtils::Album},
+                                    {DataTypes::DatabaseIdRole, mDatabaseContent->albumIdFromTitleAndArtist(QStringLiteral("album2"), QStringLiteral("artist1"), QStringLiteral("/"))}},
+                                   QStringLiteral("album2"), {}}}, {}, {});
+
+    QVERIFY(mRowsAboutToBeInsertedSpy->wait());
+
+    QCOMPARE(mPlayListProxyModel->rowCount(), 6);
+    QVERIFY(mPlayListProxyModel->totalTracksDuration() > 0);
+    QCOMPARE(mPlayListProxyModel->totalTracksDuration(), durationFromRow(0));
+    QCOMPARE(mPlayListProxyModel->remainingTracksDuration(), durationFromRow(mPlayListProxyModel->currentTrackRow()));
+    QCOMPARE(mPlayListProxyModel->radioCount(), 0);
+
+    mPlayListProxyModel->skipNextTrack();
+
+    QCOMPARE(mPlayListProxyModel->remainingTracksDuration(), durationFromRow(1));
+
+    mPlayListProxyModel->setShuffleMode(MediaPlayListProxyModel::Shuffle::Track);
+
+    QCOMPARE(mPlayListProxyModel->totalTracksDuration(), durationFromRow(0));
+    QCOMPARE(mPlayListProxyModel->remainingTracksDuration(), durationFromRow(mPlayListProxyModel->currentTrackRow()));
+
+    mPlayListProxyModel->moveRow(4, 1);
+
+    QCOMPARE(mPlayListProxyModel->remainingTracksDuration(), durationFromRow(mPlayListProxyModel->currentTrackRow()));
+
+    mPlayListProxyModel->removeRow(3);
+
+    QCOMPARE(mPlayListProxyModel->rowCount(), 5);
+    QCOMPARE(mPlayListProxyModel->totalTracksDuration(), durationFromRow(0));
+    QCOMPARE(mPlayListProxyModel->remainingTracksDuration(), durationFromRow(mPlayListProxyModel->currentTrackRow()));
+
+    mPlayListProxyModel->setShuffleMode(MediaPlayListProxyModel::Shuffle::NoShuffle);
+    mPlayListProxyModel->moveRow(0, 3);
+
+    QCOMPARE(mPlayListProxyModel->totalTracksDuration(), durationFromRow(0));
+    QCOMPARE(mPlayListProxyModel->remainingTracksDuration(), durationFromRow(mPlayListProxyModel->currentTrackRow()));
+
+    mPlayListProxyModel->clearPlayList();
+
+    QCOMPARE(mPlayListProxyModel->totalTracksDuration(), 0);
+    QCOMPARE(mPlayListProxyModel->remainingTracksDuration(), 0);
+}
+
 void MediaPlayListProxyModelTest::clearPlayListCase()
 {
     mPlayListProxyModel->enqueue({{{{DataTypes::ElementTypeRole, ElisaUtils::Album},
@@ -5350,6 +5421,178 @@ void MediaPlayListProxyModelTest::testMoveCurrentTrack()
     QCOMPARE(mPlayListProxyModel->nextTrack().isValid(), false);
 }
 
+void MediaPlayListProxyModelTest::lazyTrackShuffleTest()
+{
+    constexpr int entriesCount = 1000;
+
+    MediaPlayList playList;
+    MediaPlayListProxyModel playListProxyModel;
+    playListProxyModel.setPlayListModel(&playList);
+
+    const auto newEntries = generatedEntries(entriesCount, QStringLiteral("lazy"));
+
+    playListProxyModel.enqueue(newEntries, ElisaUtils::AppendPlayList, ElisaUtils::DoNotTriggerPlay);
+    playListProxyModel.switchTo(42);
+
+    QCOMPARE(playListProxyModel.currentTrackRow(), 42);
+
+    playListProxyModel.setShuffleMode(MediaPlayListProxyModel::Shuffle::Track);
+
+    QCOMPARE(playListProxyModel.rowCount(), entriesCount);
+    QCOMPARE(playListProxyModel.currentTrackRow(), 0);
+    QCOMPARE(playListProxyModel.mapToSource(playListProxyModel.currentTrack()).row(), 42);
+
+    QList<int> shuffledSourceRows;
+    QSet<int> seenSourceRows;
+    for (int proxyRow = 0; proxyRow < entriesCount; ++proxyRow) {
+        const auto sourceRow = playListProxyModel.mapToSource(playListProxyModel.index(proxyRow, 0)).row();
+        QVERIFY(sourceRow >= 0 && sourceRow < entriesCount);
+        QVERIFY(!seenSourceRows.contains(sourceRow));
+        QCOMPARE(playListProxyModel.mapRowFromSource(sourceRow), proxyRow);
+        seenSourceRows.insert(sourceRow);
+        shuffledSourceRows.push_back(sourceRow);
+    }
+
+    const auto savedState = playListProxyModel.persistentState();
+
+    QVERIFY(savedState[QStringLiteral("randomMapping")].toList().isEmpty());
+    QVERIFY(savedState[QStringLiteral("shuffleSeed")].toULongLong() < (quint64{1} << 53));
+
+    MediaPlayList restoredPlayList;
+    MediaPlayListProxyModel restoredPlayListProxyModel;
+    restoredPlayListProxyModel.setPlayListModel(&restoredPlayList);
+    restoredPlayListProxyModel.enqueue(newEntries, ElisaUtils::AppendPlayList, ElisaUtils::DoNotTriggerPlay);
+    // QML keeps the state as JavaScript values: the seed comes back as a double
+    restoredPlayListProxyModel.setPersistentState({{QStringLiteral("shuffleMode"), savedState[QStringLiteral("shuffleMode")]},
+                                                   {QStringLiteral("randomMapping"), savedState[QStringLiteral("randomMapping")]},
+                                                   {QStringLiteral("shuffleSeed"), savedState[QStringLiteral("shuffleSeed")].toDouble()},
+                                                   {QStringLiteral("shuffleFirstRow"), savedState[QStringLiteral("shuffleFirstRow")]},
+                                                   {QStringLiteral("currentTrack"), savedState[QStringLiteral("currentTrack")]}});
+
+    QCOMPARE(restoredPlayListProxyModel.shuffleMode(), MediaPlayListProxyModel::Shuffle::Track);
+    QCOMPARE(restoredPlayListProxyModel.currentTrackRow(), 0);
+    for (int proxyRow = 0; proxyRow < entriesCount; ++proxyRow) {
+        QCOMPARE(restoredPlayListProxyModel.mapToSource(restoredPlayListProxyModel.index(proxyRow, 0)).row(), shuffledSourceRows.at(proxyRow));
+    }
+
+    playListProxyModel.moveRow(10, 2);
+
+    QCOMPARE(playListProxyModel.mapToSource(playListProxyModel.index(2, 0)).row(), shuffledSourceRows.at(10));
+    QCOMPARE(playListProxyModel.mapToSource(playListProxyModel.index(3, 0)).row(), shuffledSourceRows.at(2));
+    QCOMPARE(playListProxyModel.persistentState()[QStringLiteral("randomMapping")].toList().size(), qsizetype(entriesCount));
+
+    playListProxyModel.setShuffleMode(MediaPlayListProxyModel::Shuffle::NoShuffle);
+
+    QCOMPARE(playListProxyModel.currentTrackRow(), 42);
+    for (int row = 0; row < entriesCount; ++row) {
+        QCOMPARE(playListProxyModel.mapToSource(playListProxyModel.index(row, 0)).row(), row);
+    }
+}
+
+void MediaPlayListProxyModelTest::shuffledRowsChangedByRanges()
+{
+    constexpr int entriesCount = 200;
+
+    MediaPlayList playList;
+    MediaPlayListProxyModel playListProxyModel;
+    playListProxyModel.setPlayListModel(&playList);
+    QAbstractItemModelTester testProxyModel(&playListProxyModel);
+
+    const auto newEntries = generatedEntries(entriesCount, QStringLiteral("ranges"));
+
+    playListProxyModel.enqueue(newEntries.mid(0, entriesCount / 2), ElisaUtils::AppendPlayList, ElisaUtils::DoNotTriggerPlay);
+    playListProxyModel.setShuffleMode(MediaPlayListProxyModel::Shuffle::Track);
+
+    QSignalSpy rowsRemovedSpy(&playListProxyModel, &MediaPlayListProxyModel::rowsRemoved);
+    QSignalSpy rowsInsertedSpy(&playListProxyModel, &MediaPlayListProxyModel::rowsInserted);
+
+    const auto rangesRowsCount = [](const QSignalSpy &rangesSpy) {
+        int rowsCount = 0;
+        for (int rangeIndex = 0; rangeIndex < rangesSpy.count(); ++rangeIndex) {
+            rowsCount += rangesSpy.at(rangeIndex).at(2).toInt() - rangesSpy.at(rangeIndex).at(1).toInt() + 1;
+        }
+        return rowsCount;
+    };
+
+    const auto checkShuffledRows = [&playListProxyModel](int rowsCount) {
+        QCOMPARE(playListProxyModel.rowCount(), rowsCount);
+
+        QSet<int> seenSourceRows;
+        for (int proxyRow = 0; proxyRow < rowsCount; ++proxyRow) {
+            const auto sourceRow = playListProxyModel.mapToSource(playListProxyModel.index(proxyRow, 0)).row();
+            QVERIFY(sourceRow >= 0 && sourceRow < rowsCount);
+            QVERIFY(!seenSourceRows.contains(sourceRow));
+            QCOMPARE(playListProxyModel.mapRowFromSource(sourceRow), proxyRow);
+            seenSourceRows.insert(sourceRow);
+        }
+    };
+
+    // the removed source rows are scattered in the shuffled order
+    playList.removeRows(20, 50);
+
+    QVERIFY(rowsRemovedSpy.count() >= 1);
+    QCOMPARE(rangesRowsCount(rowsRemovedSpy), 50);
+    checkShuffledRows(entriesCount / 2 - 50);
+
+    // the appended rows go at random positions after the current track
+    playListProxyModel.enqueue(newEntries.mid(entriesCount / 2), ElisaUtils::AppendPlayList, ElisaUtils::DoNotTriggerPlay);
+
+    QVERIFY(rowsInsertedSpy.count() >= 1);
+    QCOMPARE(rangesRowsCount(rowsInsertedSpy), entriesCount / 2);
+    checkShuffledRows(entriesCount - 50);
+}
+
+void MediaPlayListProxyModelTest::benchmarkShuffledMapFromSource()
+{
+    constexpr int entriesCount = 50000;
+
+    MediaPlayList playList;
+    MediaPlayListProxyModel playListProxyModel;
+    playListProxyModel.setPlayListModel(&playList);
+
+    playListProxyModel.enqueue(generatedEntries(entriesCount, QStringLiteral("benchmark")), ElisaUtils::AppendPlayList, ElisaUtils::DoNotTriggerPlay);
+    playListProxyModel.setShuffleMode(MediaPlayListProxyModel::Shuffle::Track);
+
+    QCOMPARE(playListProxyModel.rowCount(), entriesCount);
+
+    QBENCHMARK {
+        for (int sourceRow = 0; sourceRow < entriesCount; ++sourceRow) {
+            const auto proxyIndex = playListProxyModel.mapFromSource(playList.index(sourceRow, 0));
+            QCOMPARE(playListProxyModel.mapToSource(proxyIndex).row(), sourceRow);
+        }
+    }
+}
+
+void MediaPlayListProxyModelTest::benchmarkToggleTrackShuffle_data()
+{
+    QTest::addColumn<int>("entriesCount");
+
+    QTest::newRow("10k") << 10000;
+    QTest::newRow("100k") << 100000;
+}
+
+void MediaPlayListProxyModelTest::benchmarkToggleTrackShuffle()
+{
+    QFETCH(int, entriesCount);
+
+    if (entriesCount > 10000 && qEnvironmentVariableIsEmpty("ELISA_LARGE_BENCHMARKS")) {
+        QSKIP("set ELISA_LARGE_BENCHMARKS to run the benchmark on a large playlist");
+    }
+
+    MediaPlayList playList;
+    MediaPlayListProxyModel playListProxyModel;
+    playListProxyModel.setPlayListModel(&playList);
+
+    playListProxyModel.enqueue(generatedEntries(entriesCount, QStringLiteral("benchmark")), ElisaUtils::AppendPlayList, ElisaUtils::DoNotTriggerPlay);
+
+    QCOMPARE(playListProxyModel.rowCount(), entriesCount);
+
+    QBENCHMARK {
+        playListProxyModel.setShuffleMode(MediaPlayListProxyModel::Shuffle::Track);
+        playListProxyModel.setShuffleMode(MediaPlayListProxyModel::Shuffle::NoShuffle);
+    }
+}
+
 QTEST_GUILESS_MAIN(MediaPlayListProxyModelTest)
 
 
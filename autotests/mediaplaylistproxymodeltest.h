@@ -138,6 +138,8 @@ private Q_SLOTS:
 
     void remainingTracksTest();
 
+    void tracksDurationAggregatesTest();
+
     void clearPlayListCase();
 
     void undoClearPlayListCase();
@@ -172,6 +174,16 @@ private Q_SLOTS:
 
     void testMoveCurrentTrack();
 
+    void lazyTrackShuffleTest();
+
+    void shuffledRowsChangedByRanges();
+
+    void benchmarkShuffledMapFromSource();
+
+    void benchmarkToggleTrackShuffle_data();
+
+    void benchmarkToggleTrackShuffle();
+
 private:
 
     MediaPlayList *mPlayList = nullptr;
@@ -48,14 +48,34 @@ void AbstractFileListener::setDatabaseInterface(DatabaseInterface *model)
                 model, &DatabaseInterface::insertTracksList);
         connect(d->mFileListing, &AbstractFileListing::askRestoredTracks,
                 model, &DatabaseInterface::askRestoredTracks);
+        connect(model, &DatabaseInterface::restoredDirectoryFingerprints,
+                d->mFileListing, &AbstractFileListing::setDirectoryFingerprints);
         connect(model, &DatabaseInterface::restoredTracks,
                 d->mFileListing, &AbstractFileListing::setIndexedTracks);
+        connect(d->mFileListing, &AbstractFileListing::directoryFingerprints,
+                model, &DatabaseInterface::insertDirectoryFingerprints);
+        connect(d->mFileListing, &AbstractFileListing::removedDirectoryFingerprints,
+                model, &DatabaseInterface::removeDirectoryFingerprints);
+        connect(d->mFileListing, &AbstractFileListing::askScanCheckpoints,
+                model, &DatabaseInterface::askScanCheckpoints);
+        connect(model, &DatabaseInterface::restoredScanCheckpoints,
+                d->mFileListing, &AbstractFileListing::setScanCheckpoints);
+        connect(d->mFileListing, &AbstractFileListing::scanCheckpointAdded,
+                model, &DatabaseInterface::insertScanCheckpoint);
+        connect(d->mFileListing, &AbstractFileListing::scanCheckpointRemoved,
+                model, &DatabaseInterface::removeScanCheckpoint);
+        connect(d->mFileListing, &AbstractFileListing::scanCheckpointDirectoriesAdded,
+                model, &DatabaseInterface::insertScanCheckpointDirectories);
         connect(model, &DatabaseInterface::cleanedDatabase,
                 d->mFileListing, &AbstractFileListing::resetAndRefreshContent);
         connect(model, &DatabaseInterface::finishRemovingTracksList,
                 d->mFileListing, &AbstractFileListing::databaseFinishedRemovingTracksList);
+        // the listing may be blocked waiting for the end of an insertion: it is told from the database thread
         connect(model, &DatabaseInterface::finishInsertingTracksList,
-                d->mFileListing, &AbstractFileListing::databaseFinishedInsertingTracksList);
+                d->mFileListing, &AbstractFileListing::databaseFinishedInsertingTracksList, Qt::DirectConnection);
+        d->mFileListing->setInsertionFlowControlEnabled(true);
+        connect(d->mFileListing, &AbstractFileListing::indexingFinished,
+                model, &DatabaseInterface::endBulkImport);
     }
 
     Q_EMIT databaseInterfaceChanged();
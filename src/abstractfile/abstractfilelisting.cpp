@@ -10,14 +10,18 @@
 
 #include "abstractfile/indexercommon.h"
 
+#include "coverfilecache.h"
+#include "directorywatcher.h"
 #include "filescanner.h"
+#include "filescannerpool.h"
+#include "insertionflowcontrol.h"
 #include "elisa_settings.h"
 
 #include <QThread>
+#include <QCryptographicHash>
 #include <QFileInfo>
 #include <QFile>
 #include <QDir>
-#include <QFileSystemWatcher>
 #include <QSet>
 #include <QAtomicInt>
 
@@ -30,6 +34,17 @@ static QUrl getParentDirectory(const QUrl &filePath)
     return QUrl::fromLocalFile(QFileInfo{filePath.toLocalFile()}.absolutePath());
 }
 
+static DataTypes::DirectoryFingerprint directoryFingerprint(const QDateTime &modifiedTime, const QFileInfoList &entryList)
+{
+    QCryptographicHash namesHash(QCryptographicHash::Md5);
+    for (const auto &oneEntry : entryList) {
+        namesHash.addData(oneEntry.fileName().toUtf8());
+        namesHash.addData(QByteArrayView("/"));
+    }
+
+    return {modifiedTime, static_cast<int>(entryList.size()), namesHash.result()};
+}
+
 struct FileSystemPath {
     QUrl path;
     bool isFile;
@@ -52,20 +67,47 @@ public:
 
     QStringList mAllRootPaths;
 
-    QFileSystemWatcher mFileSystemWatcher;
+    DirectoryWatcher *mDirectoryWatcher = nullptr;
 
     QHash<QString, QUrl> mAllAlbumCover;
 
     QHash<QUrl, QSet<FileSystemPath>> mDiscoveredDirectories;
 
+    DataTypes::DirectoryFingerprints mDirectoryFingerprints;
+
+    struct PendingFingerprint {
+        QUrl mDirectory;
+        DataTypes::DirectoryFingerprint mFingerprint;
+        qint64 mQueuedFilesCount = 0;
+        bool mIsChanged = true;
+    };
+
+    // the scanned directories, in the order their scan finished
+    QList<PendingFingerprint> mPendingDirectoryFingerprints;
+
+    // the root path being scanned by scanRootDirectoryTree() and the directories its interrupted scan finished
+    QString mScanCheckpointRootPath;
+
+    QSet<QUrl> mScanCheckpointDirectories;
+
+    QList<QUrl> mRemovedDirectories;
+
     FileScanner mFileScanner;
 
+    std::unique_ptr<FileScannerPool> mFileScannerPool;
+
+    InsertionFlowControl mInsertionFlowControl;
+
     QAtomicInt mStopRequest = 0;
 
     int mImportedTracksCount = 0;
 
     int mNewFilesEmitInterval = 1;
 
+    qint64 mQueuedFilesCount = 0;
+
+    qint64 mProcessedFilesCount = 0;
+
     bool mHandleNewFiles = true;
 
     bool mWaitEndTrackRemoval = false;
@@ -74,14 +116,27 @@ public:
 
     bool mIsActive = false;
 
+    bool mSkipUnchangedDirectories = false;
+
+    bool mFileSystemWatchingEnabled = true;
+
+    bool mCollectChanges = false;
+
+    QList<QUrl> mCollectedRemovedTracks;
+
+    DataTypes::ListTrackDataType mCollectedNewFiles;
+
 };
 
 AbstractFileListing::AbstractFileListing(QObject *parent) : QObject(parent), d(std::make_unique<AbstractFileListingPrivate>())
 {
-    connect(&d->mFileSystemWatcher, &QFileSystemWatcher::directoryChanged,
-            this, &AbstractFileListing::directoryChanged);
-    connect(&d->mFileSystemWatcher, &QFileSystemWatcher::fileChanged,
-            this, &AbstractFileListing::fileChanged);
+    // a child follows the listing when it is moved to its thread
+    d->mDirectoryWatcher = new DirectoryWatcher(this);
+
+    connect(d->mDirectoryWatcher, &DirectoryWatcher::filesChanged,
+            this, &AbstractFileListing::filesChanged);
+    connect(d->mDirectoryWatcher, &DirectoryWatcher::changesLost,
+            this, &AbstractFileListing::refreshContent);
 }
 
 AbstractFileListing::~AbstractFileListing()
@@ -92,9 +147,15 @@ void AbstractFileListing::init()
     qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::init";
     d->mIsActive = true;
 
+    d->mDirectoryWatcher->setChangesDelay(Elisa::ElisaConfiguration::self()->fileSystemChangesDelay());
+
     const bool autoScan = Elisa::ElisaConfiguration::self()->scanAtStartup();
     if (autoScan) {
+        d->mSkipUnchangedDirectories = true;
         Q_EMIT askRestoredTracks();
+    } else {
+        // a scan interrupted by the end of the previous session is resumed anyway
+        Q_EMIT askScanCheckpoints();
     }
 }
 
@@ -111,7 +172,7 @@ void AbstractFileListing::newTrackFile(const DataTypes::TrackDataType &partialTr
     const auto &newTrack = scanOneFile(partialTrack.resourceURI(), scanFileInfo, WatchChangedDirectories | WatchChangedFiles);
 
     if (newTrack.isValid() && newTrack != partialTrack) {
-        Q_EMIT modifyTracksList({newTrack});
+        emitModifiedTracks({newTrack});
     }
 }
 
@@ -121,13 +182,47 @@ void AbstractFileListing::setIndexedTracks(const QHash<QUrl, QDateTime> &allTrac
     refreshContent();
 }
 
+void AbstractFileListing::setDirectoryFingerprints(const DataTypes::DirectoryFingerprints &fingerprints)
+{
+    d->mDirectoryFingerprints = fingerprints;
+}
+
+void AbstractFileListing::setScanCheckpoints(const QStringList &rootPaths, const QList<QUrl> &finishedDirectories)
+{
+    auto interruptedRootPaths = QStringList{};
+
+    for (const auto &oneRootPath : rootPaths) {
+        if (d->mAllRootPaths.contains(oneRootPath)) {
+            interruptedRootPaths.push_back(oneRootPath);
+        } else {
+            Q_EMIT scanCheckpointRemoved(oneRootPath);
+        }
+    }
+
+    if (interruptedRootPaths.isEmpty() || !d->mIsActive) {
+        return;
+    }
+
+    qCInfo(orgKdeElisaIndexer()) << "AbstractFileListing::setScanCheckpoints" << "resume the interrupted scan of" << interruptedRootPaths;
+
+    // the tracks already inserted are not extracted again, nor the files of the directories the interrupted scan finished
+    d->mScanCheckpointDirectories = QSet<QUrl>{finishedDirectories.begin(), finishedDirectories.end()};
+    Q_EMIT askRestoredTracks();
+}
+
 void AbstractFileListing::setAllRootPaths(const QStringList &allRootPaths)
 {
     d->mAllRootPaths = allRootPaths;
 }
 
-void AbstractFileListing::databaseFinishedInsertingTracksList()
+void AbstractFileListing::databaseFinishedInsertingTracksList(QObject *tracksSender)
 {
+    // the tracks inserted for other senders are not in the batches of this listing
+    if (tracksSender != this) {
+        return;
+    }
+
+    d->mInsertionFlowControl.batchFinished();
 }
 
 void AbstractFileListing::databaseFinishedRemovingTracksList()
@@ -143,6 +238,26 @@ void AbstractFileListing::applicationAboutToQuit()
     d->mStopRequest = 1;
 }
 
+void AbstractFileListing::setInsertionFlowControlEnabled(bool enabled)
+{
+    d->mInsertionFlowControl.setEnabled(enabled);
+}
+
+void AbstractFileListing::setInsertionBatchSize(int size)
+{
+    d->mInsertionFlowControl.setFixedBatchSize(size);
+}
+
+void AbstractFileListing::setFileSystemWatchingEnabled(bool enabled)
+{
+    d->mFileSystemWatchingEnabled = enabled;
+}
+
+InsertionFlowControl::Statistics AbstractFileListing::insertionStatistics() const
+{
+    return d->mInsertionFlowControl.statistics();
+}
+
 const QStringList &AbstractFileListing::allRootPaths() const
 {
     return d->mAllRootPaths;
@@ -171,7 +286,24 @@ void AbstractFileListing::scanDirectory(QSet<QString> &guard,
     // we check for existence, too (canonicalPath might be empty, too, in that case)
     const QDir rootDirectory(path.toLocalFile());
     const QString canonicalDirectoryPath = rootDirectory.canonicalPath();
-    if (!rootDirectory.exists() || canonicalDirectoryPath.isEmpty() || guard.contains(canonicalDirectoryPath)) {
+    if (!rootDirectory.exists() || canonicalDirectoryPath.isEmpty()) {
+        return;
+    }
+
+    scanCanonicalDirectory(guard, newFiles, path, canonicalDirectoryPath, watchForFileSystemChanges);
+}
+
+void AbstractFileListing::scanCanonicalDirectory(QSet<QString> &guard,
+                                                 DataTypes::ListTrackDataType &newFiles,
+                                                 const QUrl &path,
+                                                 const QString &canonicalDirectoryPath,
+                                                 FileSystemWatchingModes watchForFileSystemChanges)
+{
+    if (d->mStopRequest == 1) {
+        return;
+    }
+
+    if (guard.contains(canonicalDirectoryPath)) {
         return;
     }
     guard.insert(canonicalDirectoryPath);
@@ -180,16 +312,53 @@ void AbstractFileListing::scanDirectory(QSet<QString> &guard,
         watchPath(path.toLocalFile());
     }
 
+    // the directory listing gives the type of each entry, its file info is kept for the change time check
+    // only symbolic links are resolved, every other entry is the canonical directory path and its name
     auto currentFilesList = QSet<QUrl>();
-    const auto entryList = rootDirectory.entryInfoList(QDir::NoDotAndDotDot | QDir::Files | QDir::Dirs);
+    auto currentEntries = QList<std::pair<QUrl, QFileInfo>>();
+    auto directoryFileNames = QStringList();
+    const auto entriesPrefix = canonicalDirectoryPath.endsWith(QLatin1Char('/')) ? canonicalDirectoryPath : canonicalDirectoryPath + QLatin1Char('/');
+    const auto directoryModifiedTime = QFileInfo(canonicalDirectoryPath).lastModified();
+    const QDir currentDirectory(path.toLocalFile());
+    const auto entryList = currentDirectory.entryInfoList(QDir::NoDotAndDotDot | QDir::Files | QDir::Dirs);
+    currentEntries.reserve(entryList.size());
     for (const auto &oneEntry : entryList) {
-        auto newFilePath = QUrl::fromLocalFile(oneEntry.canonicalFilePath());
+        if (!oneEntry.isDir() && !oneEntry.isFile()) {
+            continue;
+        }
+
+        const auto isSymLink = oneEntry.isSymLink();
+        auto newFilePath = QUrl::fromLocalFile(isSymLink ? oneEntry.canonicalFilePath() : entriesPrefix + oneEntry.fileName());
 
-        if (oneEntry.isDir() || oneEntry.isFile()) {
-            currentFilesList.insert(newFilePath);
+        // several links may lead to the same file
+        if (currentFilesList.contains(newFilePath)) {
+            continue;
+        }
+
+        currentFilesList.insert(newFilePath);
+
+        if (oneEntry.isFile()) {
+            directoryFileNames.push_back(oneEntry.fileName());
+        }
+
+        if (isSymLink) {
+            currentEntries.push_back({newFilePath, QFileInfo(newFilePath.toLocalFile())});
+        } else {
+            currentEntries.push_back({newFilePath, oneEntry});
         }
     }
 
+    // the names hash catches the changes made within the resolution of the modification time
+    const auto currentFingerprint = directoryFingerprint(directoryModifiedTime, entryList);
+    const auto itPreviousFingerprint = d->mDirectoryFingerprints.constFind(path);
+    const auto isUnchangedDirectory = itPreviousFingerprint != d->mDirectoryFingerprints.cend() && *itPreviousFingerprint == currentFingerprint;
+    const auto skipFiles = isUnchangedDirectory && (d->mSkipUnchangedDirectories || d->mScanCheckpointDirectories.contains(path));
+
+    // the tracks of this directory get their cover file from this listing
+    if (!directoryFileNames.isEmpty() && !skipFiles) {
+        d->mFileScanner.cacheCoverFile(canonicalDirectoryPath, directoryFileNames);
+    }
+
     auto &currentDirectoryListingFiles = d->mDiscoveredDirectories[path];
     auto allRemovedTracks = QList<QUrl>();
 
@@ -208,19 +377,17 @@ void AbstractFileListing::scanDirectory(QSet<QString> &guard,
     }
 
     if (!allRemovedTracks.isEmpty()) {
-        Q_EMIT removedTracksList(allRemovedTracks);
+        emitRemovedTracks(allRemovedTracks);
     }
 
     if (!d->mHandleNewFiles) {
         return;
     }
 
-    for (const auto &newFilePath : std::as_const(currentFilesList)) {
-        QFileInfo oneEntry(newFilePath.toLocalFile());
-
+    for (const auto &[newFilePath, oneEntry] : std::as_const(currentEntries)) {
         if (oneEntry.isDir()) {
-            addFileInDirectory(newFilePath, path, WatchChangedDirectories | WatchChangedFiles);
-            scanDirectory(guard, newFiles, newFilePath, WatchChangedDirectories | WatchChangedFiles);
+            addFileInDirectory(newFilePath, path, false, {}, WatchChangedDirectories | WatchChangedFiles);
+            scanCanonicalDirectory(guard, newFiles, newFilePath, newFilePath.toLocalFile(), WatchChangedDirectories | WatchChangedFiles);
 
             if (d->mStopRequest == 1) {
                 break;
@@ -228,7 +395,8 @@ void AbstractFileListing::scanDirectory(QSet<QString> &guard,
 
             continue;
         }
-        if (!oneEntry.isFile()) {
+
+        if (skipFiles) {
             continue;
         }
 
@@ -237,52 +405,229 @@ void AbstractFileListing::scanDirectory(QSet<QString> &guard,
             continue;
         }
 
-        auto newTrack = scanOneFile(newFilePath, oneEntry, WatchChangedDirectories | WatchChangedFiles);
+        ++d->mQueuedFilesCount;
 
-        if (newTrack.isValid() && d->mStopRequest == 0) {
-            addFileInDirectory(newTrack.resourceURI(), path, WatchChangedDirectories | WatchChangedFiles);
-            newFiles.push_back(newTrack);
+        if (d->mFileScannerPool) {
+            d->mFileScannerPool->scanFile(newFilePath, path);
+            takeScannedFiles(newFiles, d->mFileScannerPool->isFull());
+        } else {
+            auto newTrack = scanOneFile(newFilePath, oneEntry, WatchChangedDirectories | WatchChangedFiles);
+            addScannedTrack(newFiles, newFilePath, path, newTrack);
+        }
 
-            ++d->mImportedTracksCount;
+        if (d->mStopRequest == 1) {
+            break;
+        }
+    }
+
+    // the fingerprint is kept once the files queued until now have been sent to the database
+    if (d->mStopRequest == 0) {
+        d->mPendingDirectoryFingerprints.push_back({path, currentFingerprint, d->mQueuedFilesCount, !isUnchangedDirectory});
+    }
+}
+
+void AbstractFileListing::addScannedTrack(DataTypes::ListTrackDataType &newFiles, const QUrl &newFilePath,
+                                          const QUrl &path, const DataTypes::TrackDataType &newTrack)
+{
+    // the files are handed back in the order they were queued
+    ++d->mProcessedFilesCount;
+
+    if (newTrack.isValid() && d->mStopRequest == 0) {
+        addFileInDirectory(newTrack.resourceURI(), path, true, newTrack.fileModificationTime(), WatchChangedDirectories | WatchChangedFiles);
+        newFiles.push_back(newTrack);
 
-            if (newFiles.size() > d->mNewFilesEmitInterval && d->mStopRequest == 0) {
+        ++d->mImportedTracksCount;
+
+        // batches grow quickly until the database reports how long it takes to insert them
+        const auto measuredBatchSize = d->mInsertionFlowControl.batchSize();
+        const auto isBatchFull = measuredBatchSize > 0 ? newFiles.size() >= measuredBatchSize : newFiles.size() > d->mNewFilesEmitInterval;
+        if (isBatchFull && d->mStopRequest == 0) {
+            if (measuredBatchSize == 0) {
                 d->mNewFilesEmitInterval = std::min(50, 1 + d->mNewFilesEmitInterval * d->mNewFilesEmitInterval);
-                emitNewFiles(newFiles);
-                newFiles.clear();
             }
-        } else {
-            qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::scanDirectory" << newFilePath << "is not a valid track";
+            emitNewFiles(newFiles);
+            newFiles.clear();
         }
+    } else {
+        qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::scanDirectory" << newFilePath << "is not a valid track";
+    }
+}
 
-        if (d->mStopRequest == 1) {
-            break;
+void AbstractFileListing::takeScannedFiles(DataTypes::ListTrackDataType &newFiles, bool waitForOne)
+{
+    const auto scannedFiles = d->mFileScannerPool->takeScannedFiles(waitForOne);
+
+    for (const auto &oneScannedFile : scannedFiles) {
+        const auto newTrack = scannedOneFile(oneScannedFile.mFile, oneScannedFile.mTrack);
+
+        if (newTrack.isValid() && oneScannedFile.mFileExists) {
+            watchFile(oneScannedFile.mFile.toLocalFile());
         }
+
+        addScannedTrack(newFiles, oneScannedFile.mFile, oneScannedFile.mDirectory, newTrack);
+    }
+}
+
+void AbstractFileListing::updateFileScannerPool()
+{
+    auto workersCount = Elisa::ElisaConfiguration::self()->indexerWorkersCount();
+    if (workersCount <= 0) {
+        workersCount = QThread::idealThreadCount();
+    }
+
+    if (workersCount <= 1) {
+        d->mFileScannerPool.reset();
+    } else if (!d->mFileScannerPool || d->mFileScannerPool->workersCount() != workersCount) {
+        d->mFileScannerPool = std::make_unique<FileScannerPool>(workersCount);
     }
 }
 
-void AbstractFileListing::directoryChanged(const QString &path)
+void AbstractFileListing::filesChanged(const QStringList &createdPaths, const QStringList &modifiedPaths,
+                                       const QStringList &removedPaths, const QStringList &changedDirectories)
 {
-    if (!d->mDiscoveredDirectories.contains(QUrl::fromLocalFile(path))) {
+    if (d->mStopRequest == 1) {
+        return;
+    }
+
+    if (createdPaths.isEmpty() && modifiedPaths.isEmpty() && removedPaths.isEmpty() && changedDirectories.isEmpty()) {
+        return;
+    }
+
+    // the whole batch is sent as one list of removed tracks, one of modified tracks and one of new tracks
+    d->mCollectChanges = true;
+
+    auto allRemovedTracks = QList<QUrl>();
+    auto modifiedTracks = DataTypes::ListTrackDataType();
+    auto newFiles = DataTypes::ListTrackDataType();
+    auto scannedDirectories = QStringList();
+    auto coverDirectories = QSet<QString>();
+
+    // the watched path of a directory is the key of its entries, whose paths are canonical
+    const auto changedEntry = [&coverDirectories](const QString &changedPath, QUrl &parentDirectory) {
+        const QFileInfo changedPathInfo(changedPath);
+        const auto parentPath = changedPathInfo.path();
+        const auto canonicalParentPath = QDir(parentPath).canonicalPath();
+
+        parentDirectory = QUrl::fromLocalFile(parentPath);
+        coverDirectories.insert(canonicalParentPath.isEmpty() ? parentPath : canonicalParentPath);
+
+        if (canonicalParentPath.isEmpty()) {
+            return QUrl::fromLocalFile(changedPath);
+        }
+        return QUrl::fromLocalFile(canonicalParentPath + QLatin1Char('/') + changedPathInfo.fileName());
+    };
+
+    for (const auto &removedPath : removedPaths) {
+        auto parentDirectory = QUrl();
+        const auto removedEntry = changedEntry(removedPath, parentDirectory);
+
+        auto itParentDirectory = d->mDiscoveredDirectories.find(parentDirectory);
+        if (itParentDirectory == d->mDiscoveredDirectories.end()) {
+            continue;
+        }
+
+        if (itParentDirectory->remove({removedEntry, true, {}})) {
+            allRemovedTracks.push_back(removedEntry);
+        } else if (itParentDirectory->remove({removedEntry, false, {}})) {
+            removeFile(removedEntry, allRemovedTracks);
+        }
+    }
+
+    if (d->mHandleNewFiles) {
+        const auto allChangedPaths = createdPaths + modifiedPaths;
+        for (const auto &changedPath : allChangedPaths) {
+            auto parentDirectory = QUrl();
+            const auto changedFile = changedEntry(changedPath, parentDirectory);
+
+            if (!d->mDiscoveredDirectories.contains(parentDirectory) || !isInRootPaths(changedFile)) {
+                continue;
+            }
+
+            const QFileInfo changedFileInfo(changedFile.toLocalFile());
+
+            if (changedFileInfo.isDir()) {
+                addFileInDirectory(changedFile, parentDirectory, false, {}, WatchChangedDirectories | WatchChangedFiles);
+                scannedDirectories.push_back(changedFile.toLocalFile());
+                continue;
+            }
+
+            if (!changedFileInfo.isFile() || !fileModifiedSinceLastScan(changedFile, parentDirectory, changedFileInfo.metadataChangeTime())) {
+                continue;
+            }
+
+            auto &parentDirectoryListingFiles = d->mDiscoveredDirectories[parentDirectory];
+            const auto isKnownFile = parentDirectoryListingFiles.contains({changedFile, true, {}});
+            const auto changedTrack = scanOneFile(changedFile, changedFileInfo, WatchChangedDirectories | WatchChangedFiles);
+
+            if (!changedTrack.isValid()) {
+                if (isKnownFile) {
+                    parentDirectoryListingFiles.remove({changedFile, true, {}});
+                    allRemovedTracks.push_back(changedFile);
+                }
+                continue;
+            }
+
+            addFileInDirectory(changedTrack.resourceURI(), parentDirectory, true, changedTrack.fileModificationTime(), WatchChangedDirectories | WatchChangedFiles);
+
+            if (isKnownFile) {
+                modifiedTracks.push_back(changedTrack);
+            } else {
+                newFiles.push_back(changedTrack);
+            }
+        }
+    }
+
+    // the changed entries of these directories are not known: they are scanned again
+    for (const auto &oneDirectory : changedDirectories) {
+        if (!d->mDiscoveredDirectories.contains(QUrl::fromLocalFile(oneDirectory))) {
+            continue;
+        }
+
+        const auto canonicalPath = QDir(oneDirectory).canonicalPath();
+        coverDirectories.insert(canonicalPath.isEmpty() ? oneDirectory : canonicalPath);
+
+        if (!scannedDirectories.contains(oneDirectory)) {
+            scannedDirectories.push_back(oneDirectory);
+        }
+    }
+
+    // a cover file may have been added or removed
+    for (const auto &oneDirectory : std::as_const(coverDirectories)) {
+        CoverFileCache::invalidate(oneDirectory);
+    }
+
+    // changes outside of the known directories or of tracks do not start an indexing
+    if (scannedDirectories.isEmpty() && allRemovedTracks.isEmpty() && modifiedTracks.isEmpty() && newFiles.isEmpty()) {
+        d->mCollectChanges = false;
+        emitDirectoryFingerprintChanges();
         return;
     }
 
     Q_EMIT indexingStarted();
 
-    scanDirectoryTree(path);
+    for (const auto &oneDirectory : std::as_const(scannedDirectories)) {
+        scanDirectoryTree(oneDirectory);
+    }
+
+    d->mCollectChanges = false;
 
-    Q_EMIT indexingFinished();
-}
+    allRemovedTracks.append(std::exchange(d->mCollectedRemovedTracks, {}));
+    newFiles.append(std::exchange(d->mCollectedNewFiles, {}));
 
-void AbstractFileListing::fileChanged(const QString &modifiedFileName)
-{
-    QFileInfo modifiedFileInfo(modifiedFileName);
-    auto modifiedFile = QUrl::fromLocalFile(modifiedFileName);
+    // modified tracks are inserted like new ones: the whole batch is one insertion
+    newFiles.append(modifiedTracks);
 
-    auto modifiedTrack = scanOneFile(modifiedFile, modifiedFileInfo, WatchChangedDirectories | WatchChangedFiles);
+    if (!allRemovedTracks.isEmpty()) {
+        Q_EMIT removedTracksList(allRemovedTracks);
+    }
 
-    if (modifiedTrack.isValid()) {
-        Q_EMIT modifyTracksList({modifiedTrack});
+    if (!newFiles.isEmpty() && d->mStopRequest == 0) {
+        emitNewFiles(newFiles);
     }
+
+    emitDirectoryFingerprintChanges();
+
+    Q_EMIT indexingFinished();
 }
 
 void AbstractFileListing::executeInit(const QHash<QUrl, QDateTime> &allFiles)
@@ -310,6 +655,29 @@ void AbstractFileListing::executeInit(const QHash<QUrl, QDateTime> &allFiles)
     if (!removedPaths.isEmpty()) {
         Q_EMIT removedTracksList(removedPaths);
     }
+
+    // the tracks of a directory that is no longer indexed are removed: its fingerprint must go with them
+    QList<QUrl> removedDirectories;
+
+    for (auto itFingerprint = d->mDirectoryFingerprints.begin(); itFingerprint != d->mDirectoryFingerprints.end();) {
+        const auto &directory = itFingerprint.key();
+        bool indexThisDirectory = std::any_of(d->mAllRootPaths.cbegin(), d->mAllRootPaths.cend(),
+                                              [&](const auto &rootPath) {
+            const auto rootDirectory = QUrl::fromLocalFile(rootPath);
+            return rootDirectory == directory || rootDirectory.isParentOf(directory);
+        });
+
+        if (indexThisDirectory) {
+            ++itFingerprint;
+        } else {
+            removedDirectories.push_back(directory);
+            itFingerprint = d->mDirectoryFingerprints.erase(itFingerprint);
+        }
+    }
+
+    if (!removedDirectories.isEmpty()) {
+        Q_EMIT removedDirectoryFingerprints(removedDirectories);
+    }
 }
 
 void AbstractFileListing::triggerStop()
@@ -323,52 +691,80 @@ void AbstractFileListing::triggerRefreshOfContent()
 
 void AbstractFileListing::resetAndRefreshContent()
 {
+    d->mDirectoryFingerprints.clear();
     executeInit({});
     refreshContent();
 }
 
 void AbstractFileListing::refreshContent()
 {
+    d->mDirectoryWatcher->setChangesDelay(Elisa::ElisaConfiguration::self()->fileSystemChangesDelay());
+
     triggerRefreshOfContent();
+
+    // a file rewritten in place does not change its directory: only the scan following
+    // init() trusts the directory fingerprints, a refresh asked later checks every file
+    d->mSkipUnchangedDirectories = false;
+    d->mScanCheckpointDirectories.clear();
 }
 
 DataTypes::TrackDataType AbstractFileListing::scanOneFile(const QUrl &scanFile, const QFileInfo &scanFileInfo, FileSystemWatchingModes watchForFileSystemChanges)
 {
-    DataTypes::TrackDataType newTrack;
-
     qCDebug(orgKdeElisaIndexer) << "AbstractFileListing::scanOneFile" << scanFile;
 
-    auto localFileName = scanFile.toLocalFile();
-
-    if (!d->mFileScanner.shouldScanFile(localFileName)) {
-        qCDebug(orgKdeElisaIndexer) << "AbstractFileListing::scanOneFile" << "invalid mime type";
-        return newTrack;
-    }
-
-    newTrack = d->mFileScanner.scanOneFile(scanFile, scanFileInfo);
+    // files that are not audio files give an invalid track
+    auto newTrack = scannedOneFile(scanFile, d->mFileScanner.scanOneFile(scanFile, scanFileInfo));
 
     if (newTrack.isValid() && scanFileInfo.exists()) {
         if (watchForFileSystemChanges & WatchChangedFiles) {
-            watchPath(scanFile.toLocalFile());
+            watchFile(scanFile.toLocalFile());
         }
     }
 
     return newTrack;
 }
 
+DataTypes::TrackDataType AbstractFileListing::scannedOneFile(const QUrl &scanFile, const DataTypes::TrackDataType &scannedTrack)
+{
+    Q_UNUSED(scanFile)
+
+    return scannedTrack;
+}
+
 void AbstractFileListing::watchPath(const QString &pathName)
 {
-    if (!d->mFileSystemWatcher.addPath(pathName)) {
-        qCDebug(orgKdeElisaIndexer) << "AbstractFileListing::watchPath" << "fail for" << pathName;
+    if (!d->mFileSystemWatchingEnabled) {
+        return;
+    }
+
+    if (!d->mDirectoryWatcher->watchDirectory(pathName)) {
+        watchFailed(pathName);
+    }
+}
+
+void AbstractFileListing::watchFile(const QString &fileName)
+{
+    if (!d->mFileSystemWatchingEnabled) {
+        return;
+    }
 
-        if (!d->mErrorWatchingFileSystemChanges) {
-            d->mErrorWatchingFileSystemChanges = true;
-            Q_EMIT errorWatchingFileSystemChanges();
-        }
+    if (!d->mDirectoryWatcher->watchFile(fileName)) {
+        watchFailed(fileName);
     }
 }
 
-void AbstractFileListing::addFileInDirectory(const QUrl &newFile, const QUrl &directoryName, FileSystemWatchingModes watchForFileSystemChanges)
+void AbstractFileListing::watchFailed(const QString &pathName)
+{
+    qCDebug(orgKdeElisaIndexer) << "AbstractFileListing::watchPath" << "fail for" << pathName;
+
+    if (!d->mErrorWatchingFileSystemChanges) {
+        d->mErrorWatchingFileSystemChanges = true;
+        Q_EMIT errorWatchingFileSystemChanges();
+    }
+}
+
+void AbstractFileListing::addFileInDirectory(const QUrl &newFile, const QUrl &directoryName, bool isFile,
+                                             const QDateTime &lastModified, FileSystemWatchingModes watchForFileSystemChanges)
 {
     if (!d->mDiscoveredDirectories.contains(directoryName)) {
         if (watchForFileSystemChanges & WatchChangedDirectories) {
@@ -392,8 +788,9 @@ void AbstractFileListing::addFileInDirectory(const QUrl &newFile, const QUrl &di
     }
     auto &currentDirectoryListingFiles = d->mDiscoveredDirectories[directoryName];
 
-    QFileInfo newFileInfo(newFile.toLocalFile());
-    currentDirectoryListingFiles.insert({newFile, newFileInfo.isFile(), newFileInfo.metadataChangeTime()});
+    // inserting an entry already in the set would keep its previous modification time
+    currentDirectoryListingFiles.remove({newFile, isFile, lastModified});
+    currentDirectoryListingFiles.insert({newFile, isFile, lastModified});
 }
 
 void AbstractFileListing::scanDirectoryTree(const QString &path)
@@ -402,12 +799,97 @@ void AbstractFileListing::scanDirectoryTree(const QString &path)
 
     qCDebug(orgKdeElisaIndexer()) << "AbstractFileListing::scanDirectoryTree" << path;
 
+    updateFileScannerPool();
+
     QSet<QString> guard;
     scanDirectory(guard, newFiles, QUrl::fromLocalFile(path), WatchChangedDirectories | WatchChangedFiles);
 
+    if (d->mFileScannerPool) {
+        while (d->mFileScannerPool->hasPendingFiles() && d->mStopRequest == 0) {
+            takeScannedFiles(newFiles, true);
+        }
+
+        d->mFileScannerPool->cancel();
+    }
+
     if (!newFiles.isEmpty() && d->mStopRequest == 0) {
         emitNewFiles(newFiles);
     }
+
+    emitDirectoryFingerprintChanges();
+
+    if (d->mInsertionFlowControl.isEnabled() && !d->mCollectChanges) {
+        const auto statistics = d->mInsertionFlowControl.statistics();
+        qCInfo(orgKdeElisaIndexer()) << "AbstractFileListing::scanDirectoryTree" << path
+                                     << "in flight:" << statistics.mInFlightBatches << "batches" << statistics.mInFlightTracks << "tracks"
+                                     << "batch size:" << statistics.mBatchSize << "last latency:" << statistics.mLastBatchLatency << "ms"
+                                     << "throughput:" << statistics.mTracksPerSecond << "tracks/s" << "waiting:" << statistics.mWaitingTime << "ms";
+    }
+}
+
+void AbstractFileListing::scanRootDirectoryTree(const QString &rootPath)
+{
+    // the checkpoint stays in the database until all the tracks of the root path have been sent
+    Q_EMIT scanCheckpointAdded(rootPath);
+
+    d->mScanCheckpointRootPath = rootPath;
+    scanDirectoryTree(rootPath);
+    d->mScanCheckpointRootPath.clear();
+
+    if (d->mStopRequest == 0) {
+        Q_EMIT scanCheckpointRemoved(rootPath);
+    }
+}
+
+void AbstractFileListing::emitDirectoryFingerprintChanges()
+{
+    if (!d->mRemovedDirectories.isEmpty()) {
+        Q_EMIT removedDirectoryFingerprints(d->mRemovedDirectories);
+        d->mRemovedDirectories.clear();
+    }
+
+    // a batch of changes sends the fingerprints after its tracks
+    if (d->mCollectChanges) {
+        return;
+    }
+
+    // the fingerprints follow the tracks of their directories: an interrupted scan keeps the previous ones
+    if (d->mStopRequest == 1) {
+        d->mPendingDirectoryFingerprints.clear();
+        return;
+    }
+
+    emitReadyDirectoryFingerprints();
+}
+
+void AbstractFileListing::emitReadyDirectoryFingerprints()
+{
+    auto readyFingerprints = DataTypes::DirectoryFingerprints{};
+    auto finishedDirectories = QList<QUrl>{};
+
+    auto itPending = d->mPendingDirectoryFingerprints.begin();
+    for (; itPending != d->mPendingDirectoryFingerprints.end(); ++itPending) {
+        if (itPending->mQueuedFilesCount > d->mProcessedFilesCount) {
+            break;
+        }
+
+        if (itPending->mIsChanged) {
+            readyFingerprints[itPending->mDirectory] = itPending->mFingerprint;
+        }
+        finishedDirectories.push_back(itPending->mDirectory);
+    }
+
+    d->mPendingDirectoryFingerprints.erase(d->mPendingDirectoryFingerprints.begin(), itPending);
+
+    if (!readyFingerprints.isEmpty()) {
+        d->mDirectoryFingerprints.insert(readyFingerprints);
+        Q_EMIT directoryFingerprints(readyFingerprints);
+    }
+
+    // the database records them after the tracks sent before: they are the frontier of the interrupted scan
+    if (!finishedDirectories.isEmpty() && !d->mScanCheckpointRootPath.isEmpty()) {
+        Q_EMIT scanCheckpointDirectoriesAdded(d->mScanCheckpointRootPath, finishedDirectories);
+    }
 }
 
 void AbstractFileListing::setHandleNewFiles(bool handleThem)
@@ -417,7 +899,38 @@ void AbstractFileListing::setHandleNewFiles(bool handleThem)
 
 void AbstractFileListing::emitNewFiles(const DataTypes::ListTrackDataType &tracks)
 {
+    if (d->mCollectChanges) {
+        d->mCollectedNewFiles.append(tracks);
+        return;
+    }
+
+    d->mInsertionFlowControl.waitForFreeSlot(d->mStopRequest);
+    d->mInsertionFlowControl.batchSent(static_cast<int>(tracks.size()));
+
     Q_EMIT tracksList(tracks);
+
+    // every file processed until now is in this batch or is not a track: an interrupted
+    // scan does not extract again the files of the directories already sent
+    emitReadyDirectoryFingerprints();
+}
+
+void AbstractFileListing::emitModifiedTracks(const DataTypes::ListTrackDataType &tracks)
+{
+    // modified tracks are inserted like new ones
+    d->mInsertionFlowControl.waitForFreeSlot(d->mStopRequest);
+    d->mInsertionFlowControl.batchSent(static_cast<int>(tracks.size()));
+
+    Q_EMIT modifyTracksList(tracks);
+}
+
+void AbstractFileListing::emitRemovedTracks(const QList<QUrl> &removedTracks)
+{
+    if (d->mCollectChanges) {
+        d->mCollectedRemovedTracks.append(removedTracks);
+        return;
+    }
+
+    Q_EMIT removedTracksList(removedTracks);
 }
 
 void AbstractFileListing::removeDirectory(const QUrl &removedDirectory, QList<QUrl> &allRemovedFiles)
@@ -439,6 +952,10 @@ void AbstractFileListing::removeDirectory(const QUrl &removedDirectory, QList<QU
     }
 
     d->mDiscoveredDirectories.erase(itRemovedDirectory);
+
+    if (d->mDirectoryFingerprints.remove(removedDirectory)) {
+        d->mRemovedDirectories.push_back(removedDirectory);
+    }
 }
 
 void AbstractFileListing::removeFile(const QUrl &oneRemovedTrack, QList<QUrl> &allRemovedFiles)
@@ -468,6 +985,14 @@ bool AbstractFileListing::isActive() const
     return d->mIsActive;
 }
 
+bool AbstractFileListing::isInRootPaths(const QUrl &path) const
+{
+    return std::any_of(d->mAllRootPaths.cbegin(), d->mAllRootPaths.cend(), [&path](const auto &rootPath) {
+        const auto rootDirectory = QUrl::fromLocalFile(rootPath);
+        return rootDirectory == path || rootDirectory.isParentOf(path);
+    });
+}
+
 bool AbstractFileListing::fileModifiedSinceLastScan(const QUrl &path, const QUrl &parentPath, const QDateTime &lastModified) const
 {
     const auto parentDir = d->mDiscoveredDirectories.constFind(parentPath);
@@ -475,8 +1000,7 @@ bool AbstractFileListing::fileModifiedSinceLastScan(const QUrl &path, const QUrl
         return true;
     }
 
-    const auto itPath = std::find_if(parentDir->cbegin(), parentDir->cend(),
-                                     [&](const auto &onePath) { return onePath.path == path; });
+    const auto itPath = parentDir->constFind({path, true, QDateTime()});
     if (itPath == parentDir->cend()) {
         return true;
     }
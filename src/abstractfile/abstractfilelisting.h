@@ -9,6 +9,7 @@
 
 #include "elisaLib_export.h"
 #include "datatypes.h"
+#include "insertionflowcontrol.h"
 
 #include <QObject>
 #include <QString>
@@ -47,6 +48,30 @@ public:
 
     [[nodiscard]] virtual bool canHandleRootPaths() const;
 
+    /**
+     * Bound the track batches waiting for their insertion by the database
+     * Requires that databaseFinishedInsertingTracksList() is called once per insertion with
+     * the listing as sender, it is then thread safe and can be called from the thread of the database.
+     */
+    void setInsertionFlowControlEnabled(bool enabled);
+
+    /**
+     * Send the new tracks in batches of this size, 0 to size them by the insertion latency
+     * Thread safe.
+     */
+    void setInsertionBatchSize(int size);
+
+    /**
+     * Watch the scanned directories and files for changes, enabled by default
+     * A listing that only indexes once does not need the watches. Call it before init().
+     */
+    void setFileSystemWatchingEnabled(bool enabled);
+
+    /**
+     * Monitoring of the insertion of the track batches, thread safe
+     */
+    [[nodiscard]] InsertionFlowControl::Statistics insertionStatistics() const;
+
 Q_SIGNALS:
 
     void tracksList(const DataTypes::ListTrackDataType &tracks);
@@ -61,6 +86,24 @@ Q_SIGNALS:
 
     void askRestoredTracks();
 
+    void directoryFingerprints(const DataTypes::DirectoryFingerprints &fingerprints);
+
+    void removedDirectoryFingerprints(const QList<QUrl> &directories);
+
+    /**
+     * Emitted before the scan of a root path, the checkpoint is removed when the scan finishes
+     */
+    void scanCheckpointAdded(const QString &rootPath);
+
+    void scanCheckpointRemoved(const QString &rootPath);
+
+    /**
+     * Emitted during the scan of a root path with the directories whose files have all been sent
+     */
+    void scanCheckpointDirectoriesAdded(const QString &rootPath, const QList<QUrl> &finishedDirectories);
+
+    void askScanCheckpoints();
+
     void errorWatchingFileSystemChanges();
 
 public Q_SLOTS:
@@ -70,6 +113,19 @@ public Q_SLOTS:
      */
     void setIndexedTracks(const QHash<QUrl, QDateTime> &allTracks);
 
+    /**
+     * Set the fingerprints of the directories seen by the previous scans
+     * The scan that follows init() does not check the files of the directories whose fingerprint did not change.
+     */
+    void setDirectoryFingerprints(const DataTypes::DirectoryFingerprints &fingerprints);
+
+    /**
+     * Set the root paths whose scan was interrupted and the directories that scan finished
+     * If one of them is still indexed, the scan is resumed even when the scan at startup is disabled.
+     * The resumed scan does not check the files of the finished directories whose fingerprint did not change.
+     */
+    void setScanCheckpoints(const QStringList &rootPaths, const QList<QUrl> &finishedDirectories);
+
     /**
      * Re-scan all root directories after clearing the indexed tracks
      */
@@ -88,15 +144,19 @@ public Q_SLOTS:
 
     void setAllRootPaths(const QStringList &allRootPaths);
 
-    void databaseFinishedInsertingTracksList();
+    void databaseFinishedInsertingTracksList(QObject *tracksSender);
 
     void databaseFinishedRemovingTracksList();
 
 protected Q_SLOTS:
 
-    void directoryChanged(const QString &path);
-
-    void fileChanged(const QString &modifiedFileName);
+    /**
+     * Handle one batch of changes reported by the directory watcher
+     * Only the named files are scanned, a created or changed directory is scanned with its content.
+     * The tracks of the whole batch are sent with at most one signal of each kind.
+     */
+    void filesChanged(const QStringList &createdPaths, const QStringList &modifiedPaths,
+                      const QStringList &removedPaths, const QStringList &changedDirectories);
 
 protected:
 
@@ -108,14 +168,33 @@ protected:
 
     void scanDirectory(QSet<QString> &guard, DataTypes::ListTrackDataType &newFiles, const QUrl &path, FileSystemWatchingModes watchForFileSystemChanges);
 
-    virtual DataTypes::TrackDataType scanOneFile(const QUrl &scanFile, const QFileInfo &scanFileInfo, FileSystemWatchingModes watchForFileSystemChanges);
+    /**
+     * Scan one file on the thread of the listing
+     * Directory scans only use it when a single worker is configured: otherwise the
+     * files found by scanDirectory() are scanned by a pool of worker threads.
+     */
+    DataTypes::TrackDataType scanOneFile(const QUrl &scanFile, const QFileInfo &scanFileInfo, FileSystemWatchingModes watchForFileSystemChanges);
+
+    /**
+     * Called on the thread of the listing with the track extracted from each scanned file
+     * Both scanOneFile() and the pool of worker threads go through it, the returned track is the one kept.
+     */
+    virtual DataTypes::TrackDataType scannedOneFile(const QUrl &scanFile, const DataTypes::TrackDataType &scannedTrack);
 
     void watchPath(const QString &pathName);
 
-    void addFileInDirectory(const QUrl &newFile, const QUrl &directoryName, FileSystemWatchingModes watchForFileSystemChanges);
+    void watchFile(const QString &fileName);
+
+    void addFileInDirectory(const QUrl &newFile, const QUrl &directoryName, bool isFile,
+                            const QDateTime &lastModified, FileSystemWatchingModes watchForFileSystemChanges);
 
     void scanDirectoryTree(const QString &path);
 
+    /**
+     * Scan one root path between two checkpoints, so that an interrupted scan is resumed by init()
+     */
+    void scanRootDirectoryTree(const QString &rootPath);
+
     void setHandleNewFiles(bool handleThem);
 
     void emitNewFiles(const DataTypes::ListTrackDataType &tracks);
@@ -136,6 +215,28 @@ protected:
 
 private:
 
+    void scanCanonicalDirectory(QSet<QString> &guard, DataTypes::ListTrackDataType &newFiles, const QUrl &path,
+                                const QString &canonicalDirectoryPath, FileSystemWatchingModes watchForFileSystemChanges);
+
+    void addScannedTrack(DataTypes::ListTrackDataType &newFiles, const QUrl &newFilePath,
+                         const QUrl &path, const DataTypes::TrackDataType &newTrack);
+
+    void takeScannedFiles(DataTypes::ListTrackDataType &newFiles, bool waitForOne);
+
+    void updateFileScannerPool();
+
+    void emitDirectoryFingerprintChanges();
+
+    void emitReadyDirectoryFingerprints();
+
+    void emitRemovedTracks(const QList<QUrl> &removedTracks);
+
+    void emitModifiedTracks(const DataTypes::ListTrackDataType &tracks);
+
+    void watchFailed(const QString &pathName);
+
+    [[nodiscard]] bool isInRootPaths(const QUrl &path) const;
+
     std::unique_ptr<AbstractFileListingPrivate> d;
 
 };
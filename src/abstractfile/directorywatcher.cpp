@@ -0,0 +1,350 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) Elisa contributors
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "directorywatcher.h"
+
+#include "abstractfile/indexercommon.h"
+
+#include <QElapsedTimer>
+#include <QFile>
+#include <QFileInfo>
+#include <QFileSystemWatcher>
+#include <QHash>
+#include <QSocketNotifier>
+#include <QTimer>
+
+#include <algorithm>
+#include <utility>
+
+#if defined(Q_OS_LINUX)
+#include <sys/inotify.h>
+#include <unistd.h>
+#endif
+
+namespace {
+
+// same as the default of the FileSystemChangesDelay setting
+constexpr int defaultChangesDelay = 500;
+
+// a continuous flow of changes is still reported after this many delays
+constexpr int maximumChangesDelays = 10;
+
+#if defined(Q_OS_LINUX)
+constexpr uint32_t directoryEventsMask = IN_CREATE | IN_DELETE | IN_MOVED_FROM | IN_MOVED_TO | IN_CLOSE_WRITE |
+        IN_DELETE_SELF | IN_MOVE_SELF | IN_ONLYDIR;
+#endif
+
+}
+
+class DirectoryWatcherPrivate
+{
+public:
+
+    enum class EntryChange {
+        Created,
+        Modified,
+        Removed,
+    };
+
+    void addChange(const QString &path, EntryChange change);
+
+    void addChangedDirectory(const QString &path);
+
+    void scheduleChanges();
+
+    int mInotifyDescriptor = -1;
+
+    QSocketNotifier *mInotifyNotifier = nullptr;
+
+    QHash<int, QString> mWatchedDirectories;
+
+    QHash<QString, int> mWatchDescriptors;
+
+    QFileSystemWatcher *mFallbackWatcher = nullptr;
+
+    QTimer *mChangesTimer = nullptr;
+
+    QElapsedTimer mPendingChangesAge;
+
+    QStringList mChangedPaths;
+
+    QHash<QString, EntryChange> mChanges;
+
+    QStringList mChangedDirectories;
+
+    bool mChangesLost = false;
+
+};
+
+void DirectoryWatcherPrivate::addChange(const QString &path, EntryChange change)
+{
+    auto itChange = mChanges.find(path);
+    if (itChange == mChanges.end()) {
+        mChanges.insert(path, change);
+        mChangedPaths.push_back(path);
+        return;
+    }
+
+    // an entry removed and created again has been replaced: it is modified
+    if (change == EntryChange::Removed) {
+        *itChange = EntryChange::Removed;
+    } else if (*itChange == EntryChange::Removed) {
+        *itChange = EntryChange::Modified;
+    }
+}
+
+void DirectoryWatcherPrivate::addChangedDirectory(const QString &path)
+{
+    if (!mChangedDirectories.contains(path)) {
+        mChangedDirectories.push_back(path);
+    }
+}
+
+void DirectoryWatcherPrivate::scheduleChanges()
+{
+    // each change starts the delay again until the oldest pending change is too old
+    if (!mChangesTimer->isActive()) {
+        mPendingChangesAge.start();
+    } else if (mPendingChangesAge.elapsed() >= maximumChangesDelays * static_cast<qint64>(mChangesTimer->interval())) {
+        return;
+    }
+
+    mChangesTimer->start();
+}
+
+DirectoryWatcher::DirectoryWatcher(QObject *parent) : QObject(parent), d(std::make_unique<DirectoryWatcherPrivate>())
+{
+#if defined(Q_OS_LINUX)
+    d->mInotifyDescriptor = inotify_init1(IN_NONBLOCK | IN_CLOEXEC);
+    if (d->mInotifyDescriptor == -1) {
+        qCInfo(orgKdeElisaIndexer()) << "DirectoryWatcher::DirectoryWatcher" << "inotify is not available, fall back to QFileSystemWatcher";
+    }
+#endif
+
+    d->mChangesTimer = new QTimer(this);
+    d->mChangesTimer->setSingleShot(true);
+    d->mChangesTimer->setInterval(defaultChangesDelay);
+    connect(d->mChangesTimer, &QTimer::timeout, this, &DirectoryWatcher::emitChanges);
+}
+
+DirectoryWatcher::~DirectoryWatcher()
+{
+#if defined(Q_OS_LINUX)
+    delete d->mInotifyNotifier;
+
+    if (d->mInotifyDescriptor != -1) {
+        ::close(d->mInotifyDescriptor);
+    }
+#endif
+}
+
+void DirectoryWatcher::setChangesDelay(int delay)
+{
+    d->mChangesTimer->setInterval(std::max(0, delay));
+}
+
+int DirectoryWatcher::changesDelay() const
+{
+    return d->mChangesTimer->interval();
+}
+
+bool DirectoryWatcher::reportsFileChanges() const
+{
+    return d->mInotifyDescriptor != -1;
+}
+
+bool DirectoryWatcher::watchDirectory(const QString &directoryPath)
+{
+#if defined(Q_OS_LINUX)
+    if (d->mInotifyDescriptor != -1) {
+        // created on first use, in the thread the watcher then lives in
+        if (!d->mInotifyNotifier) {
+            d->mInotifyNotifier = new QSocketNotifier(d->mInotifyDescriptor, QSocketNotifier::Read, this);
+            connect(d->mInotifyNotifier, &QSocketNotifier::activated, this, &DirectoryWatcher::readEvents);
+        }
+
+        const auto watchDescriptor = inotify_add_watch(d->mInotifyDescriptor, QFile::encodeName(directoryPath).constData(), directoryEventsMask);
+        if (watchDescriptor == -1) {
+            return false;
+        }
+
+        // a directory moved away keeps its watch while another directory now has its path
+        const auto previousDescriptor = d->mWatchDescriptors.value(directoryPath, -1);
+        if (previousDescriptor != -1 && previousDescriptor != watchDescriptor) {
+            inotify_rm_watch(d->mInotifyDescriptor, previousDescriptor);
+            d->mWatchedDirectories.remove(previousDescriptor);
+        }
+
+        const auto previousPath = d->mWatchedDirectories.value(watchDescriptor);
+        if (!previousPath.isEmpty() && previousPath != directoryPath) {
+            d->mWatchDescriptors.remove(previousPath);
+        }
+
+        d->mWatchedDirectories[watchDescriptor] = directoryPath;
+        d->mWatchDescriptors[directoryPath] = watchDescriptor;
+
+        return true;
+    }
+#endif
+
+    return watchWithFallback(directoryPath);
+}
+
+bool DirectoryWatcher::watchFile(const QString &filePath)
+{
+    if (reportsFileChanges()) {
+        return true;
+    }
+
+    return watchWithFallback(filePath);
+}
+
+int DirectoryWatcher::watchesCount() const
+{
+    if (d->mFallbackWatcher) {
+        return static_cast<int>(d->mFallbackWatcher->directories().size() + d->mFallbackWatcher->files().size());
+    }
+
+    return static_cast<int>(d->mWatchedDirectories.size());
+}
+
+void DirectoryWatcher::readEvents()
+{
+#if defined(Q_OS_LINUX)
+    alignas(inotify_event) char eventsBuffer[4096];
+
+    while (true) {
+        const auto readLength = ::read(d->mInotifyDescriptor, eventsBuffer, sizeof(eventsBuffer));
+        if (readLength <= 0) {
+            break;
+        }
+
+        for (auto eventPosition = eventsBuffer; eventPosition < eventsBuffer + readLength;) {
+            const auto *oneEvent = reinterpret_cast<const inotify_event *>(eventPosition);
+            eventPosition += sizeof(inotify_event) + oneEvent->len;
+
+            if (oneEvent->mask & IN_Q_OVERFLOW) {
+                d->mChangesLost = true;
+                continue;
+            }
+
+            const auto itDirectory = d->mWatchedDirectories.constFind(oneEvent->wd);
+            if (itDirectory == d->mWatchedDirectories.cend()) {
+                continue;
+            }
+
+            const auto directoryPath = *itDirectory;
+
+            if (oneEvent->mask & IN_IGNORED) {
+                if (d->mWatchDescriptors.value(directoryPath, -1) == oneEvent->wd) {
+                    d->mWatchDescriptors.remove(directoryPath);
+                }
+                d->mWatchedDirectories.erase(itDirectory);
+                continue;
+            }
+
+            if (oneEvent->mask & (IN_DELETE_SELF | IN_MOVE_SELF)) {
+                d->addChange(directoryPath, DirectoryWatcherPrivate::EntryChange::Removed);
+
+                // the watch follows a moved directory: its entries would be reported under the old path
+                if (oneEvent->mask & IN_MOVE_SELF) {
+                    inotify_rm_watch(d->mInotifyDescriptor, oneEvent->wd);
+                }
+                continue;
+            }
+
+            if (oneEvent->len == 0) {
+                continue;
+            }
+
+            const auto entryName = QFile::decodeName(oneEvent->name);
+            const auto entryPath = directoryPath.endsWith(QLatin1Char('/')) ? directoryPath + entryName : directoryPath + QLatin1Char('/') + entryName;
+
+            if (oneEvent->mask & (IN_DELETE | IN_MOVED_FROM)) {
+                d->addChange(entryPath, DirectoryWatcherPrivate::EntryChange::Removed);
+            } else if (oneEvent->mask & (IN_CREATE | IN_MOVED_TO)) {
+                d->addChange(entryPath, DirectoryWatcherPrivate::EntryChange::Created);
+            } else if (oneEvent->mask & IN_CLOSE_WRITE) {
+                d->addChange(entryPath, DirectoryWatcherPrivate::EntryChange::Modified);
+            }
+        }
+    }
+
+    if (!d->mChangedPaths.isEmpty() || d->mChangesLost) {
+        d->scheduleChanges();
+    }
+#endif
+}
+
+void DirectoryWatcher::emitChanges()
+{
+    if (d->mChangesLost) {
+        qCInfo(orgKdeElisaIndexer()) << "DirectoryWatcher::emitChanges" << "file system events were lost";
+
+        d->mChangesLost = false;
+        d->mChangedPaths.clear();
+        d->mChanges.clear();
+        d->mChangedDirectories.clear();
+
+        Q_EMIT changesLost();
+        return;
+    }
+
+    auto createdPaths = QStringList{};
+    auto modifiedPaths = QStringList{};
+    auto removedPaths = QStringList{};
+
+    // a path changed several times is in the list several times but only has its last state
+    for (const auto &onePath : std::as_const(d->mChangedPaths)) {
+        const auto itChange = d->mChanges.constFind(onePath);
+        if (itChange == d->mChanges.cend()) {
+            continue;
+        }
+
+        switch (*itChange)
+        {
+        case DirectoryWatcherPrivate::EntryChange::Created:
+            createdPaths.push_back(onePath);
+            break;
+        case DirectoryWatcherPrivate::EntryChange::Modified:
+            modifiedPaths.push_back(onePath);
+            break;
+        case DirectoryWatcherPrivate::EntryChange::Removed:
+            removedPaths.push_back(onePath);
+            break;
+        }
+
+        d->mChanges.erase(itChange);
+    }
+
+    d->mChangedPaths.clear();
+
+    const auto changedDirectories = std::exchange(d->mChangedDirectories, {});
+
+    Q_EMIT filesChanged(createdPaths, modifiedPaths, removedPaths, changedDirectories);
+}
+
+bool DirectoryWatcher::watchWithFallback(const QString &path)
+{
+    if (!d->mFallbackWatcher) {
+        d->mFallbackWatcher = new QFileSystemWatcher(this);
+
+        // only the changed path is known: its changes are merged with the others
+        connect(d->mFallbackWatcher, &QFileSystemWatcher::directoryChanged, this, [this](const QString &path) {
+            d->addChangedDirectory(path);
+            d->scheduleChanges();
+        });
+        connect(d->mFallbackWatcher, &QFileSystemWatcher::fileChanged, this, [this](const QString &path) {
+            d->addChange(path, QFileInfo::exists(path) ? DirectoryWatcherPrivate::EntryChange::Modified : DirectoryWatcherPrivate::EntryChange::Removed);
+            d->scheduleChanges();
+        });
+    }
+
+    return d->mFallbackWatcher->addPath(path);
+}
+
+
+#include "moc_directorywatcher.cpp"
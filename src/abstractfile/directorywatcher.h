@@ -0,0 +1,87 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) Elisa contributors
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef DIRECTORYWATCHER_H
+#define DIRECTORYWATCHER_H
+
+#include <QObject>
+#include <QString>
+#include <QStringList>
+
+#include <memory>
+
+class DirectoryWatcherPrivate;
+
+/**
+ * Watch directories for changes of their entries.
+ *
+ * On Linux, one inotify watch per directory reports the names of the entries
+ * that were created, written or removed in it: files need no watch of their own.
+ *
+ * Elsewhere, or when inotify cannot be used, a QFileSystemWatcher is used: the
+ * changed files are reported but a changed directory has to be scanned again.
+ *
+ * Changes are merged until none happened during the changes delay (500 ms unless
+ * setChangesDelay() is called) and are then reported by one filesChanged() signal,
+ * with each path only once.
+ */
+class DirectoryWatcher : public QObject
+{
+    Q_OBJECT
+
+public:
+
+    explicit DirectoryWatcher(QObject *parent = nullptr);
+
+    ~DirectoryWatcher() override;
+
+    /**
+     * Set the delay in milliseconds without changes after which pending changes are reported
+     */
+    void setChangesDelay(int delay);
+
+    [[nodiscard]] int changesDelay() const;
+
+    /**
+     * true when changes are reported by filesChanged()
+     * Files then do not need to be watched with watchFile().
+     */
+    [[nodiscard]] bool reportsFileChanges() const;
+
+    bool watchDirectory(const QString &directoryPath);
+
+    bool watchFile(const QString &filePath);
+
+    [[nodiscard]] int watchesCount() const;
+
+Q_SIGNALS:
+
+    /**
+     * Entries of the watched directories that changed, as absolute paths
+     * A path is in only one of the lists. Directories are reported like files,
+     * except the directories whose changed entries are not known.
+     */
+    void filesChanged(const QStringList &createdPaths, const QStringList &modifiedPaths,
+                      const QStringList &removedPaths, const QStringList &changedDirectories);
+
+    /**
+     * Some events were dropped by the system: any watched directory may have changed
+     */
+    void changesLost();
+
+private:
+
+    void readEvents();
+
+    void emitChanges();
+
+    bool watchWithFallback(const QString &path);
+
+    std::unique_ptr<DirectoryWatcherPrivate> d;
+
+};
+
+#endif // DIRECTORYWATCHER_H
@@ -0,0 +1,178 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) Elisa contributors
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "filescannerpool.h"
+
+#include "filescanner.h"
+
+#include <QFileInfo>
+#include <QMap>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QThread>
+#include <QWaitCondition>
+
+#include <algorithm>
+#include <memory>
+#include <vector>
+
+namespace {
+
+// files queued per worker before the queuing thread has to take results back
+constexpr int queuedFilesPerWorker = 16;
+
+}
+
+class FileScannerPoolPrivate
+{
+public:
+
+    struct QueuedFile {
+        qint64 mIndex = 0;
+        QUrl mFile;
+        QUrl mDirectory;
+    };
+
+    void runWorker();
+
+    std::vector<std::unique_ptr<QThread>> mWorkers;
+
+    mutable QMutex mLock;
+
+    QWaitCondition mFileQueued;
+
+    QWaitCondition mFileScanned;
+
+    QList<QueuedFile> mQueuedFiles;
+
+    QMap<qint64, FileScannerPool::ScannedFile> mScannedFiles;
+
+    qint64 mNextQueuedIndex = 0;
+
+    qint64 mNextTakenIndex = 0;
+
+    bool mStopping = false;
+
+};
+
+void FileScannerPoolPrivate::runWorker()
+{
+    FileScanner fileScanner;
+
+    QMutexLocker locker(&mLock);
+
+    while (true) {
+        while (!mStopping && mQueuedFiles.isEmpty()) {
+            mFileQueued.wait(&mLock);
+        }
+
+        if (mStopping) {
+            return;
+        }
+
+        auto oneFile = mQueuedFiles.takeFirst();
+
+        locker.unlock();
+
+        // QFileInfo is not safe to share between threads, each worker builds its own
+        const auto fileInfo = QFileInfo{oneFile.mFile.toLocalFile()};
+
+        // files that are not audio files give an invalid track
+        auto newTrack = fileScanner.scanOneFile(oneFile.mFile, fileInfo);
+
+        const auto fileExists = fileInfo.exists();
+
+        locker.relock();
+
+        // files queued before a cancel are not expected anymore
+        if (oneFile.mIndex >= mNextTakenIndex) {
+            mScannedFiles.insert(oneFile.mIndex, {oneFile.mFile, oneFile.mDirectory, std::move(newTrack), fileExists});
+            mFileScanned.wakeAll();
+        }
+    }
+}
+
+FileScannerPool::FileScannerPool(int workersCount) : d(std::make_unique<FileScannerPoolPrivate>())
+{
+    for (int i = 0; i < std::max(workersCount, 1); ++i) {
+        auto oneWorker = std::unique_ptr<QThread>{QThread::create([this]() { d->runWorker(); })};
+        oneWorker->start();
+        d->mWorkers.push_back(std::move(oneWorker));
+    }
+}
+
+FileScannerPool::~FileScannerPool()
+{
+    {
+        QMutexLocker locker(&d->mLock);
+        d->mStopping = true;
+        d->mFileQueued.wakeAll();
+    }
+
+    for (const auto &oneWorker : d->mWorkers) {
+        oneWorker->wait();
+    }
+}
+
+int FileScannerPool::workersCount() const
+{
+    return static_cast<int>(d->mWorkers.size());
+}
+
+void FileScannerPool::scanFile(const QUrl &file, const QUrl &directory)
+{
+    QMutexLocker locker(&d->mLock);
+
+    d->mQueuedFiles.push_back({d->mNextQueuedIndex, file, directory});
+    ++d->mNextQueuedIndex;
+
+    d->mFileQueued.wakeOne();
+}
+
+bool FileScannerPool::isFull() const
+{
+    QMutexLocker locker(&d->mLock);
+
+    return d->mNextQueuedIndex - d->mNextTakenIndex >= qint64{queuedFilesPerWorker} * workersCount();
+}
+
+bool FileScannerPool::hasPendingFiles() const
+{
+    QMutexLocker locker(&d->mLock);
+
+    return d->mNextTakenIndex < d->mNextQueuedIndex;
+}
+
+QList<FileScannerPool::ScannedFile> FileScannerPool::takeScannedFiles(bool waitForOne)
+{
+    auto result = QList<ScannedFile>{};
+
+    QMutexLocker locker(&d->mLock);
+
+    if (waitForOne) {
+        while (d->mNextTakenIndex < d->mNextQueuedIndex && !d->mScannedFiles.contains(d->mNextTakenIndex)) {
+            d->mFileScanned.wait(&d->mLock);
+        }
+    }
+
+    auto itScannedFile = d->mScannedFiles.begin();
+    while (itScannedFile != d->mScannedFiles.end() && itScannedFile.key() == d->mNextTakenIndex) {
+        result.push_back(std::move(itScannedFile.value()));
+        itScannedFile = d->mScannedFiles.erase(itScannedFile);
+        ++d->mNextTakenIndex;
+    }
+
+    return result;
+}
+
+void FileScannerPool::cancel()
+{
+    QMutexLocker locker(&d->mLock);
+
+    d->mQueuedFiles.clear();
+    d->mScannedFiles.clear();
+    d->mNextTakenIndex = d->mNextQueuedIndex;
+}
@@ -0,0 +1,77 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) Elisa contributors
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef FILESCANNERPOOL_H
+#define FILESCANNERPOOL_H
+
+#include "datatypes.h"
+
+#include <QList>
+#include <QUrl>
+
+#include <memory>
+
+class FileScannerPoolPrivate;
+
+/**
+ * Extract the metadata of files on a set of worker threads.
+ *
+ * Every worker owns its own FileScanner (and its own set of metadata extractors).
+ * Files are queued from one thread and their tracks are handed back to that
+ * thread in the order the files were queued, so that a parallel scan produces
+ * the same sequence of tracks as a serial one.
+ */
+class FileScannerPool
+{
+public:
+
+    struct ScannedFile {
+        QUrl mFile;
+        QUrl mDirectory;
+        DataTypes::TrackDataType mTrack;
+        bool mFileExists = false;
+    };
+
+    explicit FileScannerPool(int workersCount);
+
+    ~FileScannerPool();
+
+    [[nodiscard]] int workersCount() const;
+
+    /**
+     * Queue one local file to be scanned
+     * The worker reads the file information itself from the path of the file.
+     */
+    void scanFile(const QUrl &file, const QUrl &directory);
+
+    /**
+     * true when enough files are queued to keep every worker busy
+     */
+    [[nodiscard]] bool isFull() const;
+
+    /**
+     * true while queued files have not been taken back with takeScannedFiles()
+     */
+    [[nodiscard]] bool hasPendingFiles() const;
+
+    /**
+     * Take the scanned files that are ready, in queuing order
+     * If waitForOne is true, block until at least one file is ready or nothing is pending.
+     */
+    [[nodiscard]] QList<ScannedFile> takeScannedFiles(bool waitForOne);
+
+    /**
+     * Drop all queued files and the results not yet taken
+     */
+    void cancel();
+
+private:
+
+    std::unique_ptr<FileScannerPoolPrivate> d;
+
+};
+
+#endif // FILESCANNERPOOL_H
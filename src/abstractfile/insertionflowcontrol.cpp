@@ -0,0 +1,196 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) Elisa contributors
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "insertionflowcontrol.h"
+
+#include "abstractfile/indexercommon.h"
+
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QMutexLocker>
+#include <QQueue>
+#include <QWaitCondition>
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// a stop request is noticed after at most this delay while waiting
+constexpr int waitStep = 100;
+
+// sending goes on if the database did not finish any batch during this delay
+constexpr qint64 maximumWaitWithoutProgress = 10000;
+
+// weight of the last measure in the averages
+constexpr double averageWeight = 0.3;
+
+}
+
+class InsertionFlowControlPrivate
+{
+public:
+
+    struct SentBatch {
+        int mTracksCount = 0;
+        qint64 mSentTime = 0;
+    };
+
+    mutable QMutex mLock;
+
+    QWaitCondition mBatchFinished;
+
+    QElapsedTimer mClock;
+
+    QQueue<SentBatch> mInFlightBatches;
+
+    int mInFlightTracks = 0;
+
+    int mBatchSize = 0;
+
+    int mFixedBatchSize = 0;
+
+    double mTrackLatency = 0.;
+
+    double mTracksPerSecond = 0.;
+
+    qint64 mLastFinishTime = 0;
+
+    qint64 mLastBatchLatency = 0;
+
+    qint64 mInsertedTracks = 0;
+
+    qint64 mWaitingTime = 0;
+
+    bool mEnabled = false;
+
+};
+
+InsertionFlowControl::InsertionFlowControl() : d(std::make_unique<InsertionFlowControlPrivate>())
+{
+    d->mClock.start();
+}
+
+InsertionFlowControl::~InsertionFlowControl()
+= default;
+
+void InsertionFlowControl::setEnabled(bool enabled)
+{
+    QMutexLocker locker(&d->mLock);
+
+    d->mEnabled = enabled;
+
+    if (!enabled) {
+        d->mInFlightBatches.clear();
+        d->mInFlightTracks = 0;
+        d->mBatchFinished.wakeAll();
+    }
+}
+
+bool InsertionFlowControl::isEnabled() const
+{
+    QMutexLocker locker(&d->mLock);
+
+    return d->mEnabled;
+}
+
+int InsertionFlowControl::batchSize() const
+{
+    QMutexLocker locker(&d->mLock);
+
+    return d->mFixedBatchSize > 0 ? d->mFixedBatchSize : d->mBatchSize;
+}
+
+void InsertionFlowControl::setFixedBatchSize(int size)
+{
+    QMutexLocker locker(&d->mLock);
+
+    d->mFixedBatchSize = std::max(0, size);
+}
+
+void InsertionFlowControl::waitForFreeSlot(const QAtomicInt &stopRequest)
+{
+    QMutexLocker locker(&d->mLock);
+
+    if (!d->mEnabled || d->mInFlightBatches.size() < maximumInFlightBatches) {
+        return;
+    }
+
+    const auto waitStart = d->mClock.elapsed();
+
+    while (d->mEnabled && d->mInFlightBatches.size() >= maximumInFlightBatches && stopRequest.loadRelaxed() == 0) {
+        d->mBatchFinished.wait(&d->mLock, waitStep);
+
+        const auto lastProgress = std::max(waitStart, d->mLastFinishTime);
+        if (d->mClock.elapsed() - lastProgress > maximumWaitWithoutProgress) {
+            qCInfo(orgKdeElisaIndexer()) << "InsertionFlowControl::waitForFreeSlot" << "no batch finished since" << maximumWaitWithoutProgress << "ms";
+            break;
+        }
+    }
+
+    d->mWaitingTime += d->mClock.elapsed() - waitStart;
+}
+
+void InsertionFlowControl::batchSent(int tracksCount)
+{
+    QMutexLocker locker(&d->mLock);
+
+    if (!d->mEnabled) {
+        return;
+    }
+
+    d->mInFlightBatches.enqueue({tracksCount, d->mClock.elapsed()});
+    d->mInFlightTracks += tracksCount;
+}
+
+void InsertionFlowControl::batchFinished()
+{
+    QMutexLocker locker(&d->mLock);
+
+    if (!d->mEnabled || d->mInFlightBatches.isEmpty()) {
+        return;
+    }
+
+    const auto finishedBatch = d->mInFlightBatches.dequeue();
+    const auto finishTime = d->mClock.elapsed();
+
+    // batches are inserted in order: the insertion started when the previous one finished
+    const auto insertionStart = std::max(finishedBatch.mSentTime, d->mLastFinishTime);
+    const auto latency = std::max<qint64>(1, finishTime - insertionStart);
+    const auto tracksCount = std::max(1, finishedBatch.mTracksCount);
+
+    d->mInFlightTracks -= finishedBatch.mTracksCount;
+    d->mInsertedTracks += finishedBatch.mTracksCount;
+    d->mLastFinishTime = finishTime;
+    d->mLastBatchLatency = latency;
+
+    const auto trackLatency = static_cast<double>(latency) / tracksCount;
+    const auto tracksPerSecond = 1000. * tracksCount / latency;
+
+    if (d->mBatchSize == 0) {
+        d->mTrackLatency = trackLatency;
+        d->mTracksPerSecond = tracksPerSecond;
+    } else {
+        d->mTrackLatency = averageWeight * trackLatency + (1. - averageWeight) * d->mTrackLatency;
+        d->mTracksPerSecond = averageWeight * tracksPerSecond + (1. - averageWeight) * d->mTracksPerSecond;
+    }
+
+    // the size at most doubles from one batch to the next one
+    const auto targetSize = static_cast<int>(std::lround(targetBatchLatency / d->mTrackLatency));
+    const auto growthLimit = d->mBatchSize == 0 ? 2 * tracksCount : 2 * d->mBatchSize;
+    d->mBatchSize = std::clamp(std::min(targetSize, growthLimit), 1, maximumBatchSize);
+
+    d->mBatchFinished.wakeAll();
+}
+
+InsertionFlowControl::Statistics InsertionFlowControl::statistics() const
+{
+    QMutexLocker locker(&d->mLock);
+
+    return {static_cast<int>(d->mInFlightBatches.size()), d->mInFlightTracks,
+            d->mFixedBatchSize > 0 ? d->mFixedBatchSize : d->mBatchSize, d->mInsertedTracks,
+            d->mLastBatchLatency, d->mTracksPerSecond, d->mWaitingTime};
+}
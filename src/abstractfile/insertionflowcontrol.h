@@ -0,0 +1,88 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) Elisa contributors
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef INSERTIONFLOWCONTROL_H
+#define INSERTIONFLOWCONTROL_H
+
+#include <QAtomicInt>
+#include <QtGlobal>
+
+#include <memory>
+
+class InsertionFlowControlPrivate;
+
+/**
+ * Control the flow of track batches sent by a file listing to the database.
+ *
+ * Each batch sent is recorded and stays in flight until the database reports
+ * the end of its insertion. Sending blocks while too many batches are in flight,
+ * so the queued copies of the tracks cannot grow without limit when the database
+ * is slower than the scan.
+ *
+ * The time the database takes for each batch gives the size of the next batches:
+ * one insertion transaction takes about targetBatchLatency milliseconds.
+ *
+ * batchFinished() may be called from any thread.
+ */
+class InsertionFlowControl
+{
+public:
+
+    struct Statistics {
+        int mInFlightBatches = 0;
+        int mInFlightTracks = 0;
+        int mBatchSize = 0;
+        qint64 mInsertedTracks = 0;
+        qint64 mLastBatchLatency = 0;
+        double mTracksPerSecond = 0.;
+        qint64 mWaitingTime = 0;
+    };
+
+    static constexpr int maximumInFlightBatches = 4;
+
+    static constexpr int targetBatchLatency = 200;
+
+    static constexpr int maximumBatchSize = 500;
+
+    InsertionFlowControl();
+
+    ~InsertionFlowControl();
+
+    /**
+     * Enable the flow control when the end of each insertion is reported with batchFinished()
+     */
+    void setEnabled(bool enabled);
+
+    [[nodiscard]] bool isEnabled() const;
+
+    /**
+     * Size of the next batches, 0 until the database has reported the latency of one batch
+     */
+    [[nodiscard]] int batchSize() const;
+
+    /**
+     * Use batches of this size instead of the size given by the latency, 0 to measure it again
+     */
+    void setFixedBatchSize(int size);
+
+    /**
+     * Block until one more batch may be sent or a stop is requested
+     */
+    void waitForFreeSlot(const QAtomicInt &stopRequest);
+
+    void batchSent(int tracksCount);
+
+    void batchFinished();
+
+    [[nodiscard]] Statistics statistics() const;
+
+private:
+
+    std::unique_ptr<InsertionFlowControlPrivate> d;
+
+};
+
+#endif // INSERTIONFLOWCONTROL_H
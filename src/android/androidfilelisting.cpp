@@ -150,11 +150,10 @@ void AndroidFileListing::triggerRefreshOfContent()
     Q_EMIT indexingFinished();
 }
 
-DataTypes::TrackDataType AndroidFileListing::scanOneFile(const QUrl &scanFile, const QFileInfo &scanFileInfo, FileSystemWatchingModes watchForFileSystemChanges)
+DataTypes::TrackDataType AndroidFileListing::scannedOneFile(const QUrl &scanFile, const DataTypes::TrackDataType &scannedTrack)
 {
     Q_UNUSED(scanFile)
-    Q_UNUSED(scanFileInfo)
-    Q_UNUSED(watchForFileSystemChanges)
+    Q_UNUSED(scannedTrack)
     auto newTrack = DataTypes::TrackDataType{};
 
     return newTrack;
@@ -64,7 +64,7 @@ private:
 
     void triggerRefreshOfContent() override;
 
-    DataTypes::TrackDataType scanOneFile(const QUrl &scanFile, const QFileInfo &scanFileInfo, FileSystemWatchingModes watchForFileSystemChanges) override;
+    DataTypes::TrackDataType scannedOneFile(const QUrl &scanFile, const DataTypes::TrackDataType &scannedTrack) override;
 
     static AndroidFileListing* mCurrentInstance;
 
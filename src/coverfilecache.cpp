@@ -0,0 +1,119 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) Elisa contributors
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "coverfilecache.h"
+
+#include <QCache>
+#include <QMutex>
+#include <QMutexLocker>
+
+namespace
+{
+
+constexpr qint64 coverCacheMaximumBytes = 1024 * 1024;
+
+struct CoverFileCacheData
+{
+    QMutex mLock;
+
+    QCache<QString, QUrl> mCovers{coverCacheMaximumBytes};
+
+    qint64 mHitsCount = 0;
+
+    qint64 mMissesCount = 0;
+};
+
+CoverFileCacheData &coverFileCacheData()
+{
+    static CoverFileCacheData cacheData;
+
+    return cacheData;
+}
+
+// the directory path is stored twice: as key and as prefix of the cover file path
+qint64 entryBytes(const QString &directoryPath, const QUrl &coverFile)
+{
+    return qint64(sizeof(QChar)) * (2 * directoryPath.size() + coverFile.fileName().size())
+        + qint64(sizeof(QUrl)) + qint64(sizeof(QString));
+}
+
+}
+
+std::optional<QUrl> CoverFileCache::find(const QString &directoryPath)
+{
+    auto &cacheData = coverFileCacheData();
+
+    QMutexLocker locker(&cacheData.mLock);
+
+    // looking up an entry makes it the most recently used one
+    const auto *coverFile = cacheData.mCovers.object(directoryPath);
+    if (!coverFile) {
+        ++cacheData.mMissesCount;
+        return std::nullopt;
+    }
+
+    ++cacheData.mHitsCount;
+
+    return *coverFile;
+}
+
+void CoverFileCache::insert(const QString &directoryPath, const QUrl &coverFile)
+{
+    auto &cacheData = coverFileCacheData();
+
+    QMutexLocker locker(&cacheData.mLock);
+
+    cacheData.mCovers.insert(directoryPath, new QUrl{coverFile}, entryBytes(directoryPath, coverFile));
+}
+
+void CoverFileCache::invalidate(const QString &directoryPath)
+{
+    auto &cacheData = coverFileCacheData();
+
+    QMutexLocker locker(&cacheData.mLock);
+
+    cacheData.mCovers.remove(directoryPath);
+}
+
+void CoverFileCache::clear()
+{
+    auto &cacheData = coverFileCacheData();
+
+    QMutexLocker locker(&cacheData.mLock);
+
+    cacheData.mCovers.clear();
+}
+
+qint64 CoverFileCache::maximumBytes()
+{
+    return coverCacheMaximumBytes;
+}
+
+CoverFileCache::Statistics CoverFileCache::statistics()
+{
+    auto &cacheData = coverFileCacheData();
+
+    QMutexLocker locker(&cacheData.mLock);
+
+    auto result = Statistics{};
+
+    result.mHitsCount = cacheData.mHitsCount;
+    result.mMissesCount = cacheData.mMissesCount;
+    result.mDirectoriesCount = cacheData.mCovers.count();
+    result.mCacheBytes = cacheData.mCovers.totalCost();
+
+    return result;
+}
+
+void CoverFileCache::resetStatistics()
+{
+    auto &cacheData = coverFileCacheData();
+
+    QMutexLocker locker(&cacheData.mLock);
+
+    cacheData.mHitsCount = 0;
+    cacheData.mMissesCount = 0;
+}
@@ -0,0 +1,55 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) Elisa contributors
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef COVERFILECACHE_H
+#define COVERFILECACHE_H
+
+#include "elisaLib_export.h"
+
+#include <QString>
+#include <QUrl>
+
+#include <optional>
+
+/**
+ * Process wide cache of the cover file found in each directory of the collection.
+ *
+ * An empty url records a directory without cover file. The least recently used
+ * directories are dropped when the cache grows over maximumBytes(). It can be
+ * used from any thread.
+ */
+class ELISALIB_EXPORT CoverFileCache
+{
+public:
+
+    struct Statistics
+    {
+        qint64 mHitsCount = 0;
+
+        qint64 mMissesCount = 0;
+
+        qint64 mDirectoriesCount = 0;
+
+        qint64 mCacheBytes = 0;
+    };
+
+    [[nodiscard]] static std::optional<QUrl> find(const QString &directoryPath);
+
+    static void insert(const QString &directoryPath, const QUrl &coverFile);
+
+    static void invalidate(const QString &directoryPath);
+
+    static void clear();
+
+    [[nodiscard]] static qint64 maximumBytes();
+
+    [[nodiscard]] static Statistics statistics();
+
+    static void resetStatistics();
+
+};
+
+#endif // COVERFILECACHE_H
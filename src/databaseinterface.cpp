@@ -8,6 +8,8 @@
 
 #include "databaseLogging.h"
 
+#include "stringpool.h"
+
 #include <KLocalizedString>
 
 #include <QCoreApplication>
@@ -23,6 +25,7 @@
 #include <QVariant>
 #include <QAtomicInt>
 #include <QElapsedTimer>
+#include <QVersionNumber>
 #include <QDebug>
 
 #ifdef Q_OS_ANDROID
@@ -141,11 +144,12 @@ public:
         , mUpdateTrackFinishedStatistics(mTracksDatabase)
         , mRemoveTrackQuery(mTracksDatabase)
         , mRemoveAlbumQuery(mTracksDatabase)
-        , mRemoveArtistQuery(mTracksDatabase)
-        , mRemoveGenreQuery(mTracksDatabase)
-        , mRemoveComposerQuery(mTracksDatabase)
-        , mRemoveLyricistQuery(mTracksDatabase)
+        , mPruneArtistsQuery(mTracksDatabase)
+        , mPruneGenresQuery(mTracksDatabase)
+        , mPruneComposersQuery(mTracksDatabase)
+        , mPruneLyricistsQuery(mTracksDatabase)
         , mSelectAllTracksQuery(mTracksDatabase)
+        , mSelectAllTracksPageQuery(mTracksDatabase)
         , mSelectAllRadiosQuery(mTracksDatabase)
         , mInsertTrackMapping(mTracksDatabase)
         , mUpdateTrackFirstPlayStatistics(mTracksDatabase)
@@ -215,10 +219,24 @@ public:
         , mSelectTrackFromIdAndUrlQuery(mTracksDatabase)
         , mUpdateDatabaseVersionQuery(mTracksDatabase)
         , mSelectDatabaseVersionQuery(mTracksDatabase)
-        , mArtistHasTracksQuery(mTracksDatabase)
-        , mGenreHasTracksQuery(mTracksDatabase)
-        , mComposerHasTracksQuery(mTracksDatabase)
-        , mLyricistHasTracksQuery(mTracksDatabase)
+        , mRemoveAlbumAggregatesQuery(mTracksDatabase)
+        , mUpdateAlbumAggregatesQuery(mTracksDatabase)
+        , mSelectTracksFromSearchQuery(mTracksDatabase)
+        , mSelectAlbumsFromSearchQuery(mTracksDatabase)
+        , mSelectArtistsFromSearchQuery(mTracksDatabase)
+        , mSelectAlbumsFromTitleAndPathQuery(mTracksDatabase)
+        , mSelectAllDirectoryFingerprintsQuery(mTracksDatabase)
+        , mInsertDirectoryFingerprintQuery(mTracksDatabase)
+        , mRemoveDirectoryFingerprintQuery(mTracksDatabase)
+        , mClearDirectoryFingerprintsTable(mTracksDatabase)
+        , mSelectAllScanCheckpointsQuery(mTracksDatabase)
+        , mInsertScanCheckpointQuery(mTracksDatabase)
+        , mRemoveScanCheckpointQuery(mTracksDatabase)
+        , mClearScanCheckpointsTable(mTracksDatabase)
+        , mSelectAllScanCheckpointDirectoriesQuery(mTracksDatabase)
+        , mInsertScanCheckpointDirectoryQuery(mTracksDatabase)
+        , mRemoveScanCheckpointDirectoriesQuery(mTracksDatabase)
+        , mClearScanCheckpointDirectoriesTable(mTracksDatabase)
     {
     }
 
@@ -270,13 +288,15 @@ public:
 
     QSqlQuery mRemoveTrackQuery;
     QSqlQuery mRemoveAlbumQuery;
-    QSqlQuery mRemoveArtistQuery;
-    QSqlQuery mRemoveGenreQuery;
-    QSqlQuery mRemoveComposerQuery;
-    QSqlQuery mRemoveLyricistQuery;
+    QSqlQuery mPruneArtistsQuery;
+    QSqlQuery mPruneGenresQuery;
+    QSqlQuery mPruneComposersQuery;
+    QSqlQuery mPruneLyricistsQuery;
 
     QSqlQuery mSelectAllTracksQuery;
 
+    QSqlQuery mSelectAllTracksPageQuery;
+
     QSqlQuery mSelectAllRadiosQuery;
 
     QSqlQuery mInsertTrackMapping;
@@ -415,10 +435,41 @@ public:
 
     QSqlQuery mSelectDatabaseVersionQuery;
 
-    QSqlQuery mArtistHasTracksQuery;
-    QSqlQuery mGenreHasTracksQuery;
-    QSqlQuery mComposerHasTracksQuery;
-    QSqlQuery mLyricistHasTracksQuery;
+    QSqlQuery mRemoveAlbumAggregatesQuery;
+
+    QSqlQuery mUpdateAlbumAggregatesQuery;
+
+    QSqlQuery mSelectTracksFromSearchQuery;
+
+    QSqlQuery mSelectAlbumsFromSearchQuery;
+
+    QSqlQuery mSelectArtistsFromSearchQuery;
+
+    QSqlQuery mSelectAlbumsFromTitleAndPathQuery;
+
+    QSqlQuery mSelectAllDirectoryFingerprintsQuery;
+
+    QSqlQuery mInsertDirectoryFingerprintQuery;
+
+    QSqlQuery mRemoveDirectoryFingerprintQuery;
+
+    QSqlQuery mClearDirectoryFingerprintsTable;
+
+    QSqlQuery mSelectAllScanCheckpointsQuery;
+
+    QSqlQuery mInsertScanCheckpointQuery;
+
+    QSqlQuery mRemoveScanCheckpointQuery;
+
+    QSqlQuery mClearScanCheckpointsTable;
+
+    QSqlQuery mSelectAllScanCheckpointDirectoriesQuery;
+
+    QSqlQuery mInsertScanCheckpointDirectoryQuery;
+
+    QSqlQuery mRemoveScanCheckpointDirectoriesQuery;
+
+    QSqlQuery mClearScanCheckpointDirectoriesTable;
 
     QSet<qulonglong> mInsertedTracks;
     QSet<qulonglong> mInsertedRadios;
@@ -445,6 +496,8 @@ public:
     QSet<qulonglong> mRemovedComposerIds;
     QSet<qulonglong> mRemovedLyricistIds;
 
+    QSet<qulonglong> mAlbumsWithStaleAggregates;
+
     qulonglong mAlbumId = 1;
 
     qulonglong mArtistId = 1;
@@ -461,7 +514,18 @@ public:
 
     bool mInitFinished = false;
 
-    const DatabaseInterface::DatabaseVersion mLatestDatabaseVersion = DatabaseInterface::V17;
+    bool mHasSearchIndex = false;
+
+    bool mHasSetBasedPruning = false;
+
+    bool mBulkImport = false;
+
+    // the directories finished by a scan and their fingerprints are only recorded when the tracks sent before them are committed
+    bool mFailedInsertionSinceScanCheckpoint = false;
+
+    bool mChangesNotificationEnabled = true;
+
+    const DatabaseInterface::DatabaseVersion mLatestDatabaseVersion = DatabaseInterface::V24;
 
     struct TableSchema {
         QString name;
@@ -474,12 +538,23 @@ public:
             QStringLiteral("ArtistName"), QStringLiteral("AlbumPath"),
             QStringLiteral("CoverFileName")}},
 
+        {QStringLiteral("AlbumAggregates"), {
+            QStringLiteral("AlbumId"), QStringLiteral("TracksCount"),
+            QStringLiteral("DiscsCount"), QStringLiteral("HighestRating"),
+            QStringLiteral("Years"), QStringLiteral("ArtistsCount"),
+            QStringLiteral("AllArtists"), QStringLiteral("AllGenres"),
+            QStringLiteral("EmbeddedCoverFileName")}},
+
         {QStringLiteral("Artists"), {
             QStringLiteral("ID"), QStringLiteral("Name")}},
 
         {QStringLiteral("Composer"), {
             QStringLiteral("ID"), QStringLiteral("Name")}},
 
+        {QStringLiteral("DirectoryFingerprints"), {
+            QStringLiteral("DirectoryPath"), QStringLiteral("ModifiedTime"),
+            QStringLiteral("EntriesCount"), QStringLiteral("NamesHash")}},
+
         {QStringLiteral("Genre"), {
             QStringLiteral("ID"), QStringLiteral("Name")}},
 
@@ -492,6 +567,12 @@ public:
             QStringLiteral("Rating"), QStringLiteral("Genre"),
             QStringLiteral("Comment")}},
 
+        {QStringLiteral("ScanCheckpointDirectories"), {
+            QStringLiteral("DirectoryPath"), QStringLiteral("RootPath")}},
+
+        {QStringLiteral("ScanCheckpoints"), {
+            QStringLiteral("RootPath")}},
+
         {QStringLiteral("Tracks"), {
             QStringLiteral("ID"), QStringLiteral("FileName"),
             QStringLiteral("Priority"), QStringLiteral("Title"),
@@ -503,7 +584,9 @@ public:
             QStringLiteral("Lyricist"), QStringLiteral("Comment"),
             QStringLiteral("Year"), QStringLiteral("Channels"),
             QStringLiteral("BitRate"), QStringLiteral("SampleRate"),
-            QStringLiteral("HasEmbeddedCover")}},
+            QStringLiteral("HasEmbeddedCover"), QStringLiteral("AlbumId"),
+            QStringLiteral("ArtistId"), QStringLiteral("AlbumArtistId"),
+            QStringLiteral("GenreId")}},
 
         {QStringLiteral("TracksData"), {
             QStringLiteral("FileName"), QStringLiteral("FileModifiedTime"),
@@ -523,6 +606,11 @@ DatabaseInterface::~DatabaseInterface()
     }
 }
 
+void DatabaseInterface::setChangesNotificationEnabled(bool enabled)
+{
+    d->mChangesNotificationEnabled = enabled;
+}
+
 void DatabaseInterface::init(const QString &dbName, const QString &databaseFileName)
 {
     initConnection(dbName, databaseFileName);
@@ -535,11 +623,30 @@ void DatabaseInterface::init(const QString &dbName, const QString &databaseFileN
     }
     initDataQueries();
 
+    restoreDeferredIndexes();
+
     if (!databaseFileName.isEmpty()) {
         reloadExistingDatabase();
     }
 }
 
+void DatabaseInterface::initReadOnly(const QString &dbName, const QString &databaseFileName)
+{
+    if (databaseFileName.isEmpty()) {
+        qCCritical(orgKdeElisaDatabase()) << "DatabaseInterface::initReadOnly" << "read-only connections need a database file";
+        return;
+    }
+
+    initConnection(dbName, databaseFileName, ConnectionMode::ReadOnly);
+
+    if (!d->mTracksDatabase.isOpen()) {
+        qCCritical(orgKdeElisaDatabase()) << "DatabaseInterface::initReadOnly" << "Database cannot be opened";
+        return;
+    }
+
+    initDataQueries();
+}
+
 qulonglong DatabaseInterface::albumIdFromTitleAndArtist(const QString &title, const QString &artist, const QString &albumPath)
 {
     auto result = qulonglong{0};
@@ -582,6 +689,40 @@ DataTypes::ListTrackDataType DatabaseInterface::allTracksData()
     return result;
 }
 
+DataTypes::ListTrackDataType DatabaseInterface::allTracksDataPage(qulonglong afterDatabaseId, int count)
+{
+    auto result = DataTypes::ListTrackDataType{};
+
+    if (!d) {
+        return result;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    d->mSelectAllTracksPageQuery.bindValue(QStringLiteral(":afterDatabaseId"), afterDatabaseId);
+    d->mSelectAllTracksPageQuery.bindValue(QStringLiteral(":maximumResults"), count);
+
+    if (internalGenericPartialData(d->mSelectAllTracksPageQuery)) {
+        while (d->mSelectAllTracksPageQuery.next()) {
+            const auto &currentRecord = d->mSelectAllTracksPageQuery.record();
+
+            result.push_back(buildTrackDataFromDatabaseRecord(currentRecord));
+        }
+
+        d->mSelectAllTracksPageQuery.finish();
+    }
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
 DataTypes::ListRadioDataType DatabaseInterface::allRadiosData()
 {
     auto result = DataTypes::ListRadioDataType{};
@@ -982,6 +1123,95 @@ DataTypes::ListTrackDataType DatabaseInterface::tracksDataFromGenreAndAuthor(con
     return allTracks;
 }
 
+DataTypes::ListTrackDataType DatabaseInterface::tracksDataFromSearch(const QString &searchText, qulonglong afterDatabaseId, int count)
+{
+    auto allTracks = DataTypes::ListTrackDataType{};
+
+    if (!d || searchText.simplified().isEmpty()) {
+        return allTracks;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return allTracks;
+    }
+
+    bindSearchValues(d->mSelectTracksFromSearchQuery, searchText, afterDatabaseId, count);
+
+    if (internalGenericPartialData(d->mSelectTracksFromSearchQuery)) {
+        while (d->mSelectTracksFromSearchQuery.next()) {
+            const auto &currentRecord = d->mSelectTracksFromSearchQuery.record();
+
+            allTracks.push_back(buildTrackDataFromDatabaseRecord(currentRecord));
+        }
+
+        d->mSelectTracksFromSearchQuery.finish();
+    }
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return allTracks;
+    }
+
+    return allTracks;
+}
+
+DataTypes::ListAlbumDataType DatabaseInterface::albumsDataFromSearch(const QString &searchText, qulonglong afterDatabaseId, int count)
+{
+    auto result = DataTypes::ListAlbumDataType{};
+
+    if (!d || searchText.simplified().isEmpty()) {
+        return result;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    bindSearchValues(d->mSelectAlbumsFromSearchQuery, searchText, afterDatabaseId, count);
+
+    result = internalAllAlbumsPartialData(d->mSelectAlbumsFromSearchQuery);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
+DataTypes::ListArtistDataType DatabaseInterface::artistsDataFromSearch(const QString &searchText, qulonglong afterDatabaseId, int count)
+{
+    auto result = DataTypes::ListArtistDataType{};
+
+    if (!d || searchText.simplified().isEmpty()) {
+        return result;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    // artists are searched by name only, like the filter of the views
+    auto searchedName = searchText.simplified();
+    searchedName.replace(u"\\"_s, u"\\\\"_s).replace(u"%"_s, u"\\%"_s).replace(u"_"_s, u"\\_"_s);
+
+    d->mSelectArtistsFromSearchQuery.bindValue(QStringLiteral(":searchText"), QString{u'%' + searchedName + u'%'});
+    d->mSelectArtistsFromSearchQuery.bindValue(QStringLiteral(":afterDatabaseId"), afterDatabaseId);
+    d->mSelectArtistsFromSearchQuery.bindValue(QStringLiteral(":maximumResults"), count);
+
+    result = internalAllArtistsPartialData(d->mSelectArtistsFromSearchQuery);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return result;
+    }
+
+    return result;
+}
+
 DataTypes::TrackDataType DatabaseInterface::trackDataFromDatabaseId(qulonglong id)
 {
     auto result = DataTypes::TrackDataType();
@@ -1126,23 +1356,74 @@ void DatabaseInterface::applicationAboutToQuit()
     d->mStopRequest = 1;
 }
 
+QHash<QString, QString> DatabaseInterface::browseQueriesText() const
+{
+    return {
+        {u"allAlbums"_s, d->mSelectAllAlbumsShortQuery.lastQuery()},
+        {u"albumsByArtist"_s, d->mSelectAllAlbumsShortWithArtistFilterQuery.lastQuery()},
+        {u"albumsByGenreAndArtist"_s, d->mSelectAllAlbumsShortWithGenreArtistFilterQuery.lastQuery()},
+        {u"albumsFromSearch"_s, d->mSelectAlbumsFromSearchQuery.lastQuery()},
+        {u"allArtists"_s, d->mSelectAllArtistsQuery.lastQuery()},
+        {u"artistsByGenre"_s, d->mSelectAllArtistsWithGenreFilterQuery.lastQuery()},
+        {u"artistMatchGenre"_s, d->mArtistMatchGenreQuery.lastQuery()},
+        {u"artistsFromSearch"_s, d->mSelectArtistsFromSearchQuery.lastQuery()},
+        {u"allGenres"_s, d->mSelectAllGenresQuery.lastQuery()},
+        {u"allComposers"_s, d->mSelectAllComposersQuery.lastQuery()},
+        {u"allLyricists"_s, d->mSelectAllLyricistsQuery.lastQuery()},
+        {u"allTracksPage"_s, d->mSelectAllTracksPageQuery.lastQuery()},
+        {u"albumTracks"_s, d->mSelectTrackQuery.lastQuery()},
+        {u"tracksFromArtist"_s, d->mSelectTracksFromArtist.lastQuery()},
+        {u"tracksFromGenre"_s, d->mSelectTracksFromGenre.lastQuery()},
+        {u"tracksFromArtistAndGenre"_s, d->mSelectTracksFromArtistAndGenre.lastQuery()},
+        {u"tracksFromSearch"_s, d->mSelectTracksFromSearchQuery.lastQuery()},
+        {u"trackFromIdAndUrl"_s, d->mSelectTrackFromIdAndUrlQuery.lastQuery()},
+        {u"trackIdFromFileName"_s, d->mSelectTracksMapping.lastQuery()},
+        {u"trackIdFromTitleAlbumTrackDiscNumber"_s, d->mSelectTrackIdFromTitleAlbumTrackDiscNumberQuery.lastQuery()},
+        {u"recentlyPlayed"_s, d->mSelectAllRecentlyPlayedTracksQuery.lastQuery()},
+        {u"frequentlyPlayed"_s, d->mSelectAllFrequentlyPlayedTracksQuery.lastQuery()},
+        {u"allRadios"_s, d->mSelectAllRadiosQuery.lastQuery()},
+        {u"radioFromId"_s, d->mSelectRadioFromIdQuery.lastQuery()},
+        {u"radioIdFromHttpAddress"_s, d->mSelectRadioIdFromHttpAddress.lastQuery()},
+        {u"composerAlbumsCount"_s, d->mSelectCountAlbumsForComposerQuery.lastQuery()},
+        {u"lyricistAlbumsCount"_s, d->mSelectCountAlbumsForLyricistQuery.lastQuery()},
+        {u"pruneArtists"_s, d->mPruneArtistsQuery.lastQuery()},
+        {u"pruneGenres"_s, d->mPruneGenresQuery.lastQuery()},
+        {u"pruneComposers"_s, d->mPruneComposersQuery.lastQuery()},
+        {u"pruneLyricists"_s, d->mPruneLyricistsQuery.lastQuery()},
+    };
+}
+
 void DatabaseInterface::insertTracksList(const DataTypes::ListTrackDataType &tracks)
 {
     qCDebug(orgKdeElisaDatabase()) << "DatabaseInterface::insertTracksList" << tracks.count();
+
+    // the file listing only counts the end of the insertions it asked for
+    const auto tracksSender = sender();
     if (d->mStopRequest == 1) {
-        Q_EMIT finishInsertingTracksList();
+        Q_EMIT finishInsertingTracksList(tracksSender);
         return;
     }
 
     auto transactionResult = startTransaction();
     if (!transactionResult) {
-        Q_EMIT finishInsertingTracksList();
+        d->mFailedInsertionSinceScanCheckpoint = true;
+        Q_EMIT finishInsertingTracksList(tracksSender);
         return;
     }
 
     initChangesTrackers();
 
-    for(const auto &oneTrack : tracks) {
+    // the bulk import path hands back the tracks it cannot insert on its own
+    const auto tracksToInsert = d->mBulkImport ? internalBulkInsertTracks(tracks) : std::optional<DataTypes::ListTrackDataType>{tracks};
+
+    if (!tracksToInsert) {
+        rollBackTransaction();
+        d->mFailedInsertionSinceScanCheckpoint = true;
+        Q_EMIT finishInsertingTracksList(tracksSender);
+        return;
+    }
+
+    for(const auto &oneTrack : *tracksToInsert) {
         switch (oneTrack.elementType())
         {
         case ElisaUtils::Track:
@@ -1171,69 +1452,81 @@ void DatabaseInterface::insertTracksList(const DataTypes::ListTrackDataType &tra
         }
 
         if (d->mStopRequest == 1) {
+            updateAlbumAggregates();
+
             transactionResult = finishTransaction();
             if (!transactionResult) {
-                Q_EMIT finishInsertingTracksList();
+                d->mFailedInsertionSinceScanCheckpoint = true;
+                Q_EMIT finishInsertingTracksList(tracksSender);
                 return;
             }
-            Q_EMIT finishInsertingTracksList();
+            Q_EMIT finishInsertingTracksList(tracksSender);
             return;
         }
     }
 
-    pruneCollections();
+    updateAlbumAggregates();
 
-    DataTypes::ListTrackDataType newTracks;
-    for (auto trackId : std::as_const(d->mInsertedTracks)) {
-        newTracks.push_back(internalOneTrackPartialData(trackId));
-        d->mModifiedTrackIds.remove(trackId);
+    if (!d->mBulkImport) {
+        pruneCollections();
     }
 
+    DataTypes::ListTrackDataType newTracks;
     DataTypes::ListRadioDataType newRadios;
-    for (auto radioId : std::as_const(d->mInsertedRadios)) {
-        newRadios.push_back(internalOneRadioPartialData(radioId));
-        d->mModifiedRadioIds.remove(radioId);
-    }
-
     DataTypes::ListAlbumDataType newAlbums;
-    for (auto albumId : std::as_const(d->mInsertedAlbums)) {
-        newAlbums.push_back(internalOneAlbumPartialData(albumId));
-        d->mModifiedAlbumIds.remove(albumId);
-    }
-
     DataTypes::ListArtistDataType newArtists;
-    for (auto newArtistId : std::as_const(d->mInsertedArtists)) {
-        newArtists.push_back(internalOneArtistPartialData(newArtistId));
-    }
-
     DataTypes::ListGenreDataType newGenres;
-    for (auto newGenreId : std::as_const(d->mInsertedGenres)) {
-        newGenres.push_back(internalOneGenrePartialData(newGenreId));
-    }
-
     DataTypes::ListArtistDataType newComposers;
-    for (auto newComposerId : std::as_const(d->mInsertedComposers)) {
-        newComposers.push_back(internalOneComposerPartialData(newComposerId));
-    }
-
     DataTypes::ListArtistDataType newLyricists;
-    for (auto newComposerId : std::as_const(d->mInsertedLyricists)) {
-        newLyricists.push_back(internalOneLyricistPartialData(newComposerId));
-    }
-
     DataTypes::ListTrackDataType modifiedTracks;
-    for (auto trackId : std::as_const(d->mModifiedTrackIds)) {
-        modifiedTracks.push_back(internalOneTrackPartialData(trackId));
-    }
-
     DataTypes::ListRadioDataType modifiedRadios;
-    for (auto radioId : std::as_const(d->mModifiedRadioIds)) {
-        modifiedRadios.push_back(internalOneRadioPartialData(radioId));
+
+    // without any model to update, the inserted data is not read back
+    if (d->mChangesNotificationEnabled) {
+        for (auto trackId : std::as_const(d->mInsertedTracks)) {
+            newTracks.push_back(internalOneTrackPartialData(trackId));
+            d->mModifiedTrackIds.remove(trackId);
+        }
+
+        for (auto radioId : std::as_const(d->mInsertedRadios)) {
+            newRadios.push_back(internalOneRadioPartialData(radioId));
+            d->mModifiedRadioIds.remove(radioId);
+        }
+
+        for (auto albumId : std::as_const(d->mInsertedAlbums)) {
+            newAlbums.push_back(internalOneAlbumPartialData(albumId));
+            d->mModifiedAlbumIds.remove(albumId);
+        }
+
+        for (auto newArtistId : std::as_const(d->mInsertedArtists)) {
+            newArtists.push_back(internalOneArtistPartialData(newArtistId));
+        }
+
+        for (auto newGenreId : std::as_const(d->mInsertedGenres)) {
+            newGenres.push_back(internalOneGenrePartialData(newGenreId));
+        }
+
+        for (auto newComposerId : std::as_const(d->mInsertedComposers)) {
+            newComposers.push_back(internalOneComposerPartialData(newComposerId));
+        }
+
+        for (auto newComposerId : std::as_const(d->mInsertedLyricists)) {
+            newLyricists.push_back(internalOneLyricistPartialData(newComposerId));
+        }
+
+        for (auto trackId : std::as_const(d->mModifiedTrackIds)) {
+            modifiedTracks.push_back(internalOneTrackPartialData(trackId));
+        }
+
+        for (auto radioId : std::as_const(d->mModifiedRadioIds)) {
+            modifiedRadios.push_back(internalOneRadioPartialData(radioId));
+        }
     }
 
     transactionResult = finishTransaction();
     if (!transactionResult) {
-        Q_EMIT finishInsertingTracksList();
+        d->mFailedInsertionSinceScanCheckpoint = true;
+        Q_EMIT finishInsertingTracksList(tracksSender);
         return;
     }
 
@@ -1280,7 +1573,7 @@ void DatabaseInterface::insertTracksList(const DataTypes::ListTrackDataType &tra
     }
 
     emitTrackerChanges();
-    Q_EMIT finishInsertingTracksList();
+    Q_EMIT finishInsertingTracksList(tracksSender);
 }
 
 void DatabaseInterface::removeTracksList(const QList<QUrl> &removedTracks)
@@ -1295,6 +1588,8 @@ void DatabaseInterface::removeTracksList(const QList<QUrl> &removedTracks)
 
     internalRemoveTracksList(removedTracks);
 
+    updateAlbumAggregates();
+
     pruneCollections();
 
     transactionResult = finishTransaction();
@@ -1316,90 +1611,340 @@ void DatabaseInterface::askRestoredTracks()
 
     auto result = internalAllFileName();
 
+    const auto directoryFingerprints = internalAllDirectoryFingerprints();
+
     transactionResult = finishTransaction();
     if (!transactionResult) {
         return;
     }
 
+    if (result.isEmpty()) {
+        beginBulkImport();
+    }
+
+    Q_EMIT restoredDirectoryFingerprints(directoryFingerprints);
+
     Q_EMIT restoredTracks(result);
 }
 
-void DatabaseInterface::trackHasStartedPlaying(const QUrl &fileName, const QDateTime &time)
+void DatabaseInterface::insertDirectoryFingerprints(const DataTypes::DirectoryFingerprints &fingerprints)
 {
+    // the tracks of these directories may not all have been inserted: the next scan lists them again
+    if (d->mStopRequest == 1 || d->mFailedInsertionSinceScanCheckpoint) {
+        return;
+    }
+
     auto transactionResult = startTransaction();
     if (!transactionResult) {
         return;
     }
 
-    updateTrackStartedStatistics(fileName, time);
+    for (const auto &[directoryPath, oneFingerprint] : fingerprints.asKeyValueRange()) {
+        d->mInsertDirectoryFingerprintQuery.bindValue(QStringLiteral(":directoryPath"), directoryPath);
+        d->mInsertDirectoryFingerprintQuery.bindValue(QStringLiteral(":modifiedTime"), oneFingerprint.mModifiedTime);
+        d->mInsertDirectoryFingerprintQuery.bindValue(QStringLiteral(":entriesCount"), oneFingerprint.mEntriesCount);
+        d->mInsertDirectoryFingerprintQuery.bindValue(QStringLiteral(":namesHash"), oneFingerprint.mNamesHash);
 
-    transactionResult = finishTransaction();
+        auto queryResult = execQuery(d->mInsertDirectoryFingerprintQuery);
+
+        if (!queryResult || !d->mInsertDirectoryFingerprintQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::insertDirectoryFingerprints" << d->mInsertDirectoryFingerprintQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::insertDirectoryFingerprints" << d->mInsertDirectoryFingerprintQuery.boundValues();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::insertDirectoryFingerprints" << d->mInsertDirectoryFingerprintQuery.lastError();
+        }
+
+        d->mInsertDirectoryFingerprintQuery.finish();
+    }
+
+    finishTransaction();
+}
+
+void DatabaseInterface::removeDirectoryFingerprints(const QList<QUrl> &directories)
+{
+    auto transactionResult = startTransaction();
     if (!transactionResult) {
         return;
     }
+
+    for (const auto &oneDirectory : directories) {
+        d->mRemoveDirectoryFingerprintQuery.bindValue(QStringLiteral(":directoryPath"), oneDirectory);
+
+        auto queryResult = execQuery(d->mRemoveDirectoryFingerprintQuery);
+
+        if (!queryResult || !d->mRemoveDirectoryFingerprintQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeDirectoryFingerprints" << d->mRemoveDirectoryFingerprintQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeDirectoryFingerprints" << d->mRemoveDirectoryFingerprintQuery.boundValues();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeDirectoryFingerprints" << d->mRemoveDirectoryFingerprintQuery.lastError();
+        }
+
+        d->mRemoveDirectoryFingerprintQuery.finish();
+    }
+
+    finishTransaction();
 }
 
-void DatabaseInterface::trackHasFinishedPlaying(const QUrl &fileName, const QDateTime &time)
+void DatabaseInterface::askScanCheckpoints()
 {
     auto transactionResult = startTransaction();
     if (!transactionResult) {
         return;
     }
 
-    updateTrackFinishedStatistics(fileName, time);
+    const auto result = internalAllScanCheckpoints();
+    const auto finishedDirectories = internalAllScanCheckpointDirectories();
 
     transactionResult = finishTransaction();
     if (!transactionResult) {
         return;
     }
+
+    Q_EMIT restoredScanCheckpoints(result, finishedDirectories);
 }
 
-void DatabaseInterface::clearData()
+void DatabaseInterface::insertScanCheckpoint(const QString &rootPath)
 {
+    if (d->mStopRequest == 1) {
+        return;
+    }
+
     auto transactionResult = startTransaction();
     if (!transactionResult) {
         return;
     }
 
-    auto queryResult = execQuery(d->mClearTracksTable);
+    d->mInsertScanCheckpointQuery.bindValue(QStringLiteral(":rootPath"), rootPath);
 
-    if (!queryResult || !d->mClearTracksTable.isActive()) {
+    auto queryResult = execQuery(d->mInsertScanCheckpointQuery);
+
+    if (!queryResult || !d->mInsertScanCheckpointQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksTable.lastQuery();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksTable.boundValues();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksTable.lastError();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::insertScanCheckpoint" << d->mInsertScanCheckpointQuery.lastQuery();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::insertScanCheckpoint" << d->mInsertScanCheckpointQuery.boundValues();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::insertScanCheckpoint" << d->mInsertScanCheckpointQuery.lastError();
     }
 
-    d->mClearTracksTable.finish();
+    d->mInsertScanCheckpointQuery.finish();
 
-    queryResult = execQuery(d->mClearTracksDataTable);
+    finishTransaction();
 
-    if (!queryResult || !d->mClearTracksDataTable.isActive()) {
-        Q_EMIT databaseError();
+    d->mFailedInsertionSinceScanCheckpoint = false;
+}
 
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksDataTable.lastQuery();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksDataTable.boundValues();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksDataTable.lastError();
+void DatabaseInterface::removeScanCheckpoint(const QString &rootPath)
+{
+    // the scan of this root path is only finished when all its tracks have been inserted
+    if (d->mStopRequest == 1) {
+        return;
     }
 
-    d->mClearTracksDataTable.finish();
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
 
-    queryResult = execQuery(d->mClearAlbumsTable);
+    d->mRemoveScanCheckpointQuery.bindValue(QStringLiteral(":rootPath"), rootPath);
 
-    if (!queryResult || !d->mClearAlbumsTable.isActive()) {
+    auto queryResult = execQuery(d->mRemoveScanCheckpointQuery);
+
+    if (!queryResult || !d->mRemoveScanCheckpointQuery.isActive()) {
         Q_EMIT databaseError();
 
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearAlbumsTable.lastQuery();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearAlbumsTable.boundValues();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearAlbumsTable.lastError();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeScanCheckpoint" << d->mRemoveScanCheckpointQuery.lastQuery();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeScanCheckpoint" << d->mRemoveScanCheckpointQuery.boundValues();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeScanCheckpoint" << d->mRemoveScanCheckpointQuery.lastError();
     }
 
-    d->mClearAlbumsTable.finish();
+    d->mRemoveScanCheckpointQuery.finish();
 
-    queryResult = execQuery(d->mClearComposerTable);
+    d->mRemoveScanCheckpointDirectoriesQuery.bindValue(QStringLiteral(":rootPath"), rootPath);
 
-    if (!queryResult || !d->mClearComposerTable.isActive()) {
+    queryResult = execQuery(d->mRemoveScanCheckpointDirectoriesQuery);
+
+    if (!queryResult || !d->mRemoveScanCheckpointDirectoriesQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeScanCheckpoint" << d->mRemoveScanCheckpointDirectoriesQuery.lastQuery();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeScanCheckpoint" << d->mRemoveScanCheckpointDirectoriesQuery.boundValues();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeScanCheckpoint" << d->mRemoveScanCheckpointDirectoriesQuery.lastError();
+    }
+
+    d->mRemoveScanCheckpointDirectoriesQuery.finish();
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    // all the batches of the initial scan of this root path are committed: the collection
+    // is pruned and searchable without waiting for the end of the indexing
+    endBulkImport();
+}
+
+void DatabaseInterface::insertScanCheckpointDirectories(const QString &rootPath, const QList<QUrl> &finishedDirectories)
+{
+    // a resumed scan extracts again the files of these directories
+    if (d->mStopRequest == 1 || d->mFailedInsertionSinceScanCheckpoint) {
+        return;
+    }
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    for (const auto &oneDirectory : finishedDirectories) {
+        d->mInsertScanCheckpointDirectoryQuery.bindValue(QStringLiteral(":directoryPath"), oneDirectory);
+        d->mInsertScanCheckpointDirectoryQuery.bindValue(QStringLiteral(":rootPath"), rootPath);
+
+        auto queryResult = execQuery(d->mInsertScanCheckpointDirectoryQuery);
+
+        if (!queryResult || !d->mInsertScanCheckpointDirectoryQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::insertScanCheckpointDirectories" << d->mInsertScanCheckpointDirectoryQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::insertScanCheckpointDirectories" << d->mInsertScanCheckpointDirectoryQuery.boundValues();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::insertScanCheckpointDirectories" << d->mInsertScanCheckpointDirectoryQuery.lastError();
+        }
+
+        d->mInsertScanCheckpointDirectoryQuery.finish();
+    }
+
+    finishTransaction();
+}
+
+void DatabaseInterface::beginBulkImport()
+{
+    if (d->mBulkImport) {
+        return;
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::beginBulkImport";
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    dropDeferredIndexes();
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    d->mBulkImport = true;
+}
+
+void DatabaseInterface::endBulkImport()
+{
+    if (!d->mBulkImport) {
+        return;
+    }
+
+    qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::endBulkImport";
+
+    d->mBulkImport = false;
+
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    initChangesTrackers();
+
+    restoreDeferredIndexes();
+
+    pruneCollections();
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    emitTrackerChanges();
+}
+
+void DatabaseInterface::trackHasStartedPlaying(const QUrl &fileName, const QDateTime &time)
+{
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    updateTrackStartedStatistics(fileName, time);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+}
+
+void DatabaseInterface::trackHasFinishedPlaying(const QUrl &fileName, const QDateTime &time)
+{
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    updateTrackFinishedStatistics(fileName, time);
+
+    transactionResult = finishTransaction();
+    if (!transactionResult) {
+        return;
+    }
+}
+
+void DatabaseInterface::clearData()
+{
+    auto transactionResult = startTransaction();
+    if (!transactionResult) {
+        return;
+    }
+
+    auto queryResult = execQuery(d->mClearTracksTable);
+
+    if (!queryResult || !d->mClearTracksTable.isActive()) {
+        Q_EMIT databaseError();
+
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksTable.lastQuery();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksTable.boundValues();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksTable.lastError();
+    }
+
+    d->mClearTracksTable.finish();
+
+    queryResult = execQuery(d->mClearTracksDataTable);
+
+    if (!queryResult || !d->mClearTracksDataTable.isActive()) {
+        Q_EMIT databaseError();
+
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksDataTable.lastQuery();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksDataTable.boundValues();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearTracksDataTable.lastError();
+    }
+
+    d->mClearTracksDataTable.finish();
+
+    queryResult = execQuery(d->mClearAlbumsTable);
+
+    if (!queryResult || !d->mClearAlbumsTable.isActive()) {
+        Q_EMIT databaseError();
+
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearAlbumsTable.lastQuery();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearAlbumsTable.boundValues();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearAlbumsTable.lastError();
+    }
+
+    d->mClearAlbumsTable.finish();
+
+    queryResult = execQuery(d->mClearComposerTable);
+
+    if (!queryResult || !d->mClearComposerTable.isActive()) {
         Q_EMIT databaseError();
 
         qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearComposerTable.lastQuery();
@@ -1445,6 +1990,42 @@ void DatabaseInterface::clearData()
 
     d->mClearArtistsTable.finish();
 
+    queryResult = execQuery(d->mClearDirectoryFingerprintsTable);
+
+    if (!queryResult || !d->mClearDirectoryFingerprintsTable.isActive()) {
+        Q_EMIT databaseError();
+
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearDirectoryFingerprintsTable.lastQuery();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearDirectoryFingerprintsTable.boundValues();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearDirectoryFingerprintsTable.lastError();
+    }
+
+    d->mClearDirectoryFingerprintsTable.finish();
+
+    queryResult = execQuery(d->mClearScanCheckpointsTable);
+
+    if (!queryResult || !d->mClearScanCheckpointsTable.isActive()) {
+        Q_EMIT databaseError();
+
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearScanCheckpointsTable.lastQuery();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearScanCheckpointsTable.boundValues();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearScanCheckpointsTable.lastError();
+    }
+
+    d->mClearScanCheckpointsTable.finish();
+
+    queryResult = execQuery(d->mClearScanCheckpointDirectoriesTable);
+
+    if (!queryResult || !d->mClearScanCheckpointDirectoriesTable.isActive()) {
+        Q_EMIT databaseError();
+
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearScanCheckpointDirectoriesTable.lastQuery();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearScanCheckpointDirectoriesTable.boundValues();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::clearData" << d->mClearScanCheckpointDirectoriesTable.lastError();
+    }
+
+    d->mClearScanCheckpointDirectoriesTable.finish();
+
     transactionResult = finishTransaction();
     if (!transactionResult) {
         return;
@@ -1455,7 +2036,7 @@ void DatabaseInterface::clearData()
 
 /********* Init and upgrade methods *********/
 
-void DatabaseInterface::initConnection(const QString &connectionName, const QString &databaseFileName)
+void DatabaseInterface::initConnection(const QString &connectionName, const QString &databaseFileName, ConnectionMode mode)
 {
     QSqlDatabase tracksDatabase = QSqlDatabase::addDatabase(QStringLiteral("QSQLITE"), connectionName);
 
@@ -1464,7 +2045,16 @@ void DatabaseInterface::initConnection(const QString &connectionName, const QStr
     } else {
         tracksDatabase.setDatabaseName(QStringLiteral("file:memdb1?mode=memory"));
     }
-    tracksDatabase.setConnectOptions(QStringLiteral("foreign_keys = ON;locking_mode = EXCLUSIVE;QSQLITE_OPEN_URI;QSQLITE_BUSY_TIMEOUT=500000"));
+
+    // file based databases use the write-ahead log and normal locking so that read-only
+    // connections in other threads can run queries while the indexer is writing
+    if (mode == ConnectionMode::ReadOnly) {
+        tracksDatabase.setConnectOptions(QStringLiteral("QSQLITE_OPEN_READONLY;QSQLITE_OPEN_URI;QSQLITE_BUSY_TIMEOUT=500000"));
+    } else if (!databaseFileName.isEmpty()) {
+        tracksDatabase.setConnectOptions(QStringLiteral("foreign_keys = ON;QSQLITE_OPEN_URI;QSQLITE_BUSY_TIMEOUT=500000"));
+    } else {
+        tracksDatabase.setConnectOptions(QStringLiteral("foreign_keys = ON;locking_mode = EXCLUSIVE;QSQLITE_OPEN_URI;QSQLITE_BUSY_TIMEOUT=500000"));
+    }
 
     auto result = tracksDatabase.open();
     if (result) {
@@ -1476,6 +2066,19 @@ void DatabaseInterface::initConnection(const QString &connectionName, const QStr
 
     QSqlQuery{u"PRAGMA foreign_keys = ON;"_s, tracksDatabase}.exec();
 
+    if (mode == ConnectionMode::ReadWrite && !databaseFileName.isEmpty()) {
+        QSqlQuery journalModeQuery{tracksDatabase};
+        if (!journalModeQuery.exec(u"PRAGMA journal_mode = WAL;"_s)) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initConnection" << journalModeQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initConnection" << journalModeQuery.lastError();
+        } else if (journalModeQuery.next()) {
+            qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::initConnection" << "journal mode" << journalModeQuery.value(0);
+        }
+        journalModeQuery.finish();
+
+        QSqlQuery{u"PRAGMA synchronous = NORMAL;"_s, tracksDatabase}.exec();
+    }
+
     d = std::make_unique<DatabaseInterfacePrivate>(tracksDatabase, connectionName, databaseFileName);
 }
 
@@ -3553,69 +4156,563 @@ void DatabaseInterface::upgradeDatabaseV17()
 {
 }
 
-DatabaseInterface::DatabaseState DatabaseInterface::checkDatabaseSchema() const
+void DatabaseInterface::upgradeDatabaseV18()
 {
-    const auto tables = d->mExpectedTableNamesAndFields;
-    const bool isInBadState = std::any_of(tables.cbegin(), tables.cend(), [this](const auto &table) {
-        return checkTable(table.name, table.fields) == DatabaseState::BadState;
-    });
-    return isInBadState ? DatabaseState::BadState : DatabaseState::GoodState;
-}
+    qCInfo(orgKdeElisaDatabase) << __FUNCTION__ << "begin update to v18 of database schema";
 
-DatabaseInterface::DatabaseState DatabaseInterface::checkTable(const QString &tableName, const QStringList &expectedColumns) const
-{
-    const auto columnsList = d->mTracksDatabase.record(tableName);
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
 
-    if (columnsList.count() != expectedColumns.count()) {
-        qCInfo(orgKdeElisaDatabase()) << tableName << "table has wrong number of columns" << columnsList.count() << "expected" << expectedColumns.count();
-        return DatabaseState::BadState;
-    }
+        const auto &result = createSchemaQuery.exec(
+            uR"(
+CREATE TABLE IF NOT EXISTS `AlbumAggregates` (
+`AlbumId` INTEGER PRIMARY KEY NOT NULL, 
+`TracksCount` INTEGER NOT NULL DEFAULT 0, 
+`DiscsCount` INTEGER NOT NULL DEFAULT 0, 
+`HighestRating` INTEGER, 
+`Years` TEXT, 
+`ArtistsCount` INTEGER NOT NULL DEFAULT 0, 
+`AllArtists` TEXT, 
+`AllGenres` TEXT, 
+`EmbeddedCoverFileName` VARCHAR(255), 
+CONSTRAINT fk_aggregates_album FOREIGN KEY (`AlbumId`) REFERENCES `Albums`(`ID`) 
+ON DELETE CASCADE)
+)"_s);
 
-    for (const auto &oneField : expectedColumns) {
-        if (!columnsList.contains(oneField)) {
-            qCInfo(orgKdeElisaDatabase()) << tableName << "table has missing column" << oneField;
-            return DatabaseState::BadState;
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << createSchemaQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
         }
     }
 
-    return DatabaseState::GoodState;
-}
-
-bool DatabaseInterface::resetDatabase()
-{
-    qCInfo(orgKdeElisaDatabase()) << "Full reset of database due to corrupted database";
+    {
+        QSqlQuery fillAggregatesQuery(d->mTracksDatabase);
 
-    const auto connectionName = d->mConnectionName;
-    const auto databaseFileName = d->mDatabaseFileName;
+        const auto &result = fillAggregatesQuery.exec(
+            uR"(
+INSERT OR REPLACE INTO `AlbumAggregates` 
+(`AlbumId`, `TracksCount`, `DiscsCount`, `HighestRating`, `Years`, 
+`ArtistsCount`, `AllArtists`, `AllGenres`, `EmbeddedCoverFileName`) 
+SELECT 
+album.`ID`, 
+COUNT(tracks.`ID`), 
+COUNT(DISTINCT tracks.`DiscNumber`), 
+MAX(tracks.`Rating`), 
+GROUP_CONCAT(tracks.`Year`, ', '), 
+COUNT(DISTINCT tracks.`ArtistName`), 
+GROUP_CONCAT(tracks.`ArtistName`, ', '), 
+GROUP_CONCAT(genres.`Name`, ', '), 
+MIN(CASE WHEN tracks.`HasEmbeddedCover` = 1 THEN tracks.`FileName` END) 
+FROM 
+`Albums` album, 
+`Tracks` tracks LEFT JOIN 
+`Genre` genres ON tracks.`Genre` = genres.`Name` 
+WHERE 
+tracks.`AlbumTitle` = album.`Title` AND 
+(tracks.`AlbumArtistName` = album.`ArtistName` OR 
+(tracks.`AlbumArtistName` IS NULL AND 
+album.`ArtistName` IS NULL
+) 
+) AND 
+tracks.`AlbumPath` = album.`AlbumPath` 
+GROUP BY album.`ID`
+)"_s);
 
-    d->mTracksDatabase.close();
-    d.reset();
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << fillAggregatesQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << fillAggregatesQuery.lastError();
 
-    auto dbFile = QFile(databaseFileName);
-    if (!dbFile.remove()) {
-        qCCritical(orgKdeElisaDatabase()) << "Database file could not be deleted" << dbFile.errorString();
-        return false;
+            Q_EMIT databaseError();
+        }
     }
 
-    initConnection(connectionName, databaseFileName);
-    return true;
+    qCInfo(orgKdeElisaDatabase) << __FUNCTION__ << "finished update to v18 of database schema";
 }
 
-DatabaseInterface::DatabaseVersion DatabaseInterface::currentDatabaseVersion()
+void DatabaseInterface::upgradeDatabaseV19()
 {
-    int version = 0;
+    qCInfo(orgKdeElisaDatabase) << __FUNCTION__ << "begin update to v19 of database schema";
 
-    auto listTables = d->mTracksDatabase.tables();
+    {
+        QSqlQuery createIndexQuery(d->mTracksDatabase);
 
-    if (listTables.contains(QLatin1String("DatabaseVersion"))) {
-        initDatabaseVersionQueries();
+        // indexes chosen from EXPLAIN QUERY PLAN of the prepared browse queries:
+        // the NOCASE ones let the sorted lists be read in index order, the others
+        // turn the per-genre/composer/lyricist and per-album lookups into searches
+        const QStringList sqlIndexes =
+            uR"(
+CREATE INDEX IF NOT EXISTS `TracksGenreIndex` ON `Tracks` (`Genre`);
+CREATE INDEX IF NOT EXISTS `TracksComposerIndex` ON `Tracks` (`Composer`);
+CREATE INDEX IF NOT EXISTS `TracksLyricistIndex` ON `Tracks` (`Lyricist`);
+CREATE INDEX IF NOT EXISTS `TracksAlbumDiscIndex` ON `Tracks` (`AlbumTitle`, `AlbumArtistName`, `AlbumPath`, `DiscNumber`, `TrackNumber`);
+CREATE INDEX IF NOT EXISTS `TracksTitlePriorityIndex` ON `Tracks` (`Title`, `ArtistName`, `AlbumTitle`, `AlbumArtistName`, `AlbumPath`, `Priority`);
+CREATE INDEX IF NOT EXISTS `AlbumsTitleNoCaseIndex` ON `Albums` (`Title` COLLATE NOCASE);
+CREATE INDEX IF NOT EXISTS `ArtistsNameNoCaseIndex` ON `Artists` (`Name` COLLATE NOCASE);
+CREATE INDEX IF NOT EXISTS `GenreNameNoCaseIndex` ON `Genre` (`Name` COLLATE NOCASE);
+CREATE INDEX IF NOT EXISTS `ComposerNameNoCaseIndex` ON `Composer` (`Name` COLLATE NOCASE);
+CREATE INDEX IF NOT EXISTS `LyricistNameNoCaseIndex` ON `Lyricist` (`Name` COLLATE NOCASE);
+CREATE INDEX IF NOT EXISTS `TracksDataLastPlayDateIndex` ON `TracksData` (`LastPlayDate`);
+CREATE INDEX IF NOT EXISTS `TracksDataPlayCounterIndex` ON `TracksData` (`PlayCounter`);
+DROP INDEX IF EXISTS `TracksAlbumIndex`
+)"_s.split(QStringLiteral(";"));
 
-        auto queryResult = execQuery(d->mSelectDatabaseVersionQuery);
-        if (!queryResult) {
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseToLatestVersion" << d->mUpdateDatabaseVersionQuery.lastQuery();
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseToLatestVersion" << d->mUpdateDatabaseVersionQuery.lastError();
+        for (const QString &oneSqlIndex : sqlIndexes) {
+            if (!createIndexQuery.exec(oneSqlIndex)) {
+                qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << createIndexQuery.lastQuery();
+                qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << createIndexQuery.lastError();
 
-            Q_EMIT databaseError();
+                Q_EMIT databaseError();
+            }
+        }
+    }
+
+    qCInfo(orgKdeElisaDatabase) << __FUNCTION__ << "finished update to v19 of database schema";
+}
+
+void DatabaseInterface::upgradeDatabaseV20()
+{
+    qCInfo(orgKdeElisaDatabase) << __FUNCTION__ << "begin update to v20 of database schema";
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        const auto &result = createSchemaQuery.exec(
+            uR"(
+CREATE VIRTUAL TABLE IF NOT EXISTS `TracksSearch` USING fts5(
+`Title`,
+`ArtistName`,
+`AlbumTitle`,
+`AlbumArtistName`,
+`Genre`,
+`Composer`,
+`Lyricist`,
+tokenize = 'unicode61 remove_diacritics 2')
+)"_s);
+
+        if (!result) {
+            // SQLite may be built without FTS5: searching then falls back to a substring match
+            qCInfo(orgKdeElisaDatabase) << __FUNCTION__ << "full-text search index is not available" << createSchemaQuery.lastError();
+
+            qCInfo(orgKdeElisaDatabase) << __FUNCTION__ << "finished update to v20 of database schema";
+            return;
+        }
+    }
+
+    createTracksSearchTriggers();
+
+    fillTracksSearchIndex();
+
+    qCInfo(orgKdeElisaDatabase) << __FUNCTION__ << "finished update to v20 of database schema";
+}
+
+void DatabaseInterface::upgradeDatabaseV21()
+{
+    qCInfo(orgKdeElisaDatabase) << __FUNCTION__ << "begin update to v21 of database schema";
+
+    {
+        QSqlQuery alterSchemaQuery(d->mTracksDatabase);
+
+        const QStringList sqlColumns =
+            uR"(
+ALTER TABLE `Tracks` ADD COLUMN `AlbumId` INTEGER;
+ALTER TABLE `Tracks` ADD COLUMN `ArtistId` INTEGER;
+ALTER TABLE `Tracks` ADD COLUMN `AlbumArtistId` INTEGER;
+ALTER TABLE `Tracks` ADD COLUMN `GenreId` INTEGER
+)"_s.split(QStringLiteral(";"));
+
+        for (const QString &oneSqlColumn : sqlColumns) {
+            if (!alterSchemaQuery.exec(oneSqlColumn)) {
+                qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << alterSchemaQuery.lastQuery();
+                qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << alterSchemaQuery.lastError();
+
+                Q_EMIT databaseError();
+            }
+        }
+    }
+
+    {
+        QSqlQuery fillIdsQuery(d->mTracksDatabase);
+
+        // an album with the same artist is preferred, then one where either side has no album artist
+        const auto &result = fillIdsQuery.exec(
+            uR"(
+UPDATE `Tracks` 
+SET 
+`AlbumId` = COALESCE(
+(SELECT album.`ID` 
+FROM `Albums` album 
+WHERE 
+album.`Title` = `Tracks`.`AlbumTitle` AND 
+album.`AlbumPath` = `Tracks`.`AlbumPath` AND 
+album.`ArtistName` IS `Tracks`.`AlbumArtistName`), 
+(SELECT MIN(album.`ID`) 
+FROM `Albums` album 
+WHERE 
+album.`Title` = `Tracks`.`AlbumTitle` AND 
+album.`AlbumPath` = `Tracks`.`AlbumPath` AND 
+(album.`ArtistName` IS NULL OR `Tracks`.`AlbumArtistName` IS NULL))), 
+`ArtistId` = (SELECT artists.`ID` FROM `Artists` artists WHERE artists.`Name` = `Tracks`.`ArtistName`), 
+`AlbumArtistId` = (SELECT artists.`ID` FROM `Artists` artists WHERE artists.`Name` = `Tracks`.`AlbumArtistName`), 
+`GenreId` = (SELECT genres.`ID` FROM `Genre` genres WHERE genres.`Name` = `Tracks`.`Genre`)
+)"_s);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << fillIdsQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << fillIdsQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        QSqlQuery createIndexQuery(d->mTracksDatabase);
+
+        // the album tracks are now found from the album id instead of its title, artist and path
+        const QStringList sqlIndexes =
+            uR"(
+CREATE INDEX IF NOT EXISTS `TracksAlbumIdIndex` ON `Tracks` (`AlbumId`, `DiscNumber`, `TrackNumber`);
+CREATE INDEX IF NOT EXISTS `TracksArtistIdIndex` ON `Tracks` (`ArtistId`);
+CREATE INDEX IF NOT EXISTS `TracksAlbumArtistIdIndex` ON `Tracks` (`AlbumArtistId`);
+CREATE INDEX IF NOT EXISTS `TracksGenreIdIndex` ON `Tracks` (`GenreId`);
+DROP INDEX IF EXISTS `TracksAlbumDiscIndex`
+)"_s.split(QStringLiteral(";"));
+
+        for (const QString &oneSqlIndex : sqlIndexes) {
+            if (!createIndexQuery.exec(oneSqlIndex)) {
+                qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << createIndexQuery.lastQuery();
+                qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << createIndexQuery.lastError();
+
+                Q_EMIT databaseError();
+            }
+        }
+    }
+
+    qCInfo(orgKdeElisaDatabase) << __FUNCTION__ << "finished update to v21 of database schema";
+}
+
+void DatabaseInterface::upgradeDatabaseV22()
+{
+    qCInfo(orgKdeElisaDatabase) << __FUNCTION__ << "begin update to v22 of database schema";
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        // the state of each scanned directory: a startup scan skips the files of the directories that did not change
+        const auto &result = createSchemaQuery.exec(
+            uR"(
+CREATE TABLE IF NOT EXISTS `DirectoryFingerprints` (
+`DirectoryPath` VARCHAR(255) PRIMARY KEY NOT NULL, 
+`ModifiedTime` DATETIME NOT NULL, 
+`EntriesCount` INTEGER NOT NULL, 
+`NamesHash` BLOB NOT NULL)
+)"_s);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << createSchemaQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    qCInfo(orgKdeElisaDatabase) << __FUNCTION__ << "finished update to v22 of database schema";
+}
+
+void DatabaseInterface::upgradeDatabaseV23()
+{
+    qCInfo(orgKdeElisaDatabase) << __FUNCTION__ << "begin update to v23 of database schema";
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        // the root paths whose scan did not finish: the next start resumes their scan
+        const auto &result = createSchemaQuery.exec(
+            uR"(
+CREATE TABLE IF NOT EXISTS `ScanCheckpoints` (
+`RootPath` VARCHAR(255) PRIMARY KEY NOT NULL)
+)"_s);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << createSchemaQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    qCInfo(orgKdeElisaDatabase) << __FUNCTION__ << "finished update to v23 of database schema";
+}
+
+void DatabaseInterface::upgradeDatabaseV24()
+{
+    qCInfo(orgKdeElisaDatabase) << __FUNCTION__ << "begin update to v24 of database schema";
+
+    {
+        QSqlQuery createSchemaQuery(d->mTracksDatabase);
+
+        // the directories finished by the interrupted scan of a root path: the resumed scan skips their files
+        const auto &result = createSchemaQuery.exec(
+            uR"(
+CREATE TABLE IF NOT EXISTS `ScanCheckpointDirectories` (
+`DirectoryPath` VARCHAR(255) PRIMARY KEY NOT NULL, 
+`RootPath` VARCHAR(255) NOT NULL)
+)"_s);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << createSchemaQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << createSchemaQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    qCInfo(orgKdeElisaDatabase) << __FUNCTION__ << "finished update to v24 of database schema";
+}
+
+void DatabaseInterface::createTracksSearchTriggers()
+{
+    QSqlQuery createTriggerQuery(d->mTracksDatabase);
+
+    // the index follows every change of the tracks, including the deletions
+    // cascading from TracksData
+    const QStringList sqlTriggers = {
+        uR"(
+CREATE TRIGGER IF NOT EXISTS `TracksSearchInsert` AFTER INSERT ON `Tracks`
+BEGIN
+INSERT INTO `TracksSearch` (`rowid`, `Title`, `ArtistName`, `AlbumTitle`,
+`AlbumArtistName`, `Genre`, `Composer`, `Lyricist`)
+VALUES (new.`ID`, new.`Title`, new.`ArtistName`, new.`AlbumTitle`,
+new.`AlbumArtistName`, new.`Genre`, new.`Composer`, new.`Lyricist`);
+END
+)"_s,
+        uR"(
+CREATE TRIGGER IF NOT EXISTS `TracksSearchDelete` AFTER DELETE ON `Tracks`
+BEGIN
+DELETE FROM `TracksSearch` WHERE `rowid` = old.`ID`;
+END
+)"_s,
+        uR"(
+CREATE TRIGGER IF NOT EXISTS `TracksSearchUpdate` AFTER UPDATE OF
+`Title`, `ArtistName`, `AlbumTitle`, `AlbumArtistName`, `Genre`, `Composer`, `Lyricist`
+ON `Tracks`
+BEGIN
+UPDATE `TracksSearch` SET
+`Title` = new.`Title`,
+`ArtistName` = new.`ArtistName`,
+`AlbumTitle` = new.`AlbumTitle`,
+`AlbumArtistName` = new.`AlbumArtistName`,
+`Genre` = new.`Genre`,
+`Composer` = new.`Composer`,
+`Lyricist` = new.`Lyricist`
+WHERE `rowid` = new.`ID`;
+END
+)"_s,
+    };
+
+    for (const QString &oneSqlTrigger : sqlTriggers) {
+        if (!createTriggerQuery.exec(oneSqlTrigger)) {
+            qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << createTriggerQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << createTriggerQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+}
+
+void DatabaseInterface::fillTracksSearchIndex()
+{
+    QSqlQuery clearSearchIndexQuery(d->mTracksDatabase);
+
+    if (!clearSearchIndexQuery.exec(u"DELETE FROM `TracksSearch`"_s)) {
+        qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << clearSearchIndexQuery.lastQuery();
+        qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << clearSearchIndexQuery.lastError();
+
+        Q_EMIT databaseError();
+    }
+
+    QSqlQuery fillSearchIndexQuery(d->mTracksDatabase);
+
+    const auto &result = fillSearchIndexQuery.exec(
+        uR"(
+INSERT INTO `TracksSearch` (`rowid`, `Title`, `ArtistName`, `AlbumTitle`,
+`AlbumArtistName`, `Genre`, `Composer`, `Lyricist`)
+SELECT
+tracks.`ID`,
+tracks.`Title`,
+tracks.`ArtistName`,
+tracks.`AlbumTitle`,
+tracks.`AlbumArtistName`,
+tracks.`Genre`,
+tracks.`Composer`,
+tracks.`Lyricist`
+FROM
+`Tracks` tracks
+)"_s);
+
+    if (!result) {
+        qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << fillSearchIndexQuery.lastQuery();
+        qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << fillSearchIndexQuery.lastError();
+
+        Q_EMIT databaseError();
+    }
+}
+
+void DatabaseInterface::dropDeferredIndexes()
+{
+    QSqlQuery dropIndexQuery(d->mTracksDatabase);
+
+    // the lookups done while importing tracks still need the other indexes
+    const QStringList sqlStatements =
+        uR"(
+DROP INDEX IF EXISTS `TracksGenreIndex`;
+DROP INDEX IF EXISTS `TracksGenreIdIndex`;
+DROP INDEX IF EXISTS `TracksComposerIndex`;
+DROP INDEX IF EXISTS `TracksLyricistIndex`;
+DROP INDEX IF EXISTS `TracksDataLastPlayDateIndex`;
+DROP INDEX IF EXISTS `TracksDataPlayCounterIndex`;
+DROP TRIGGER IF EXISTS `TracksSearchInsert`;
+DROP TRIGGER IF EXISTS `TracksSearchDelete`;
+DROP TRIGGER IF EXISTS `TracksSearchUpdate`
+)"_s.split(QStringLiteral(";"));
+
+    for (const QString &oneSqlStatement : sqlStatements) {
+        if (!dropIndexQuery.exec(oneSqlStatement)) {
+            qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << dropIndexQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << dropIndexQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+}
+
+void DatabaseInterface::restoreDeferredIndexes()
+{
+    {
+        QSqlQuery createIndexQuery(d->mTracksDatabase);
+
+        const QStringList sqlIndexes =
+            uR"(
+CREATE INDEX IF NOT EXISTS `TracksGenreIndex` ON `Tracks` (`Genre`);
+CREATE INDEX IF NOT EXISTS `TracksGenreIdIndex` ON `Tracks` (`GenreId`);
+CREATE INDEX IF NOT EXISTS `TracksComposerIndex` ON `Tracks` (`Composer`);
+CREATE INDEX IF NOT EXISTS `TracksLyricistIndex` ON `Tracks` (`Lyricist`);
+CREATE INDEX IF NOT EXISTS `TracksDataLastPlayDateIndex` ON `TracksData` (`LastPlayDate`);
+CREATE INDEX IF NOT EXISTS `TracksDataPlayCounterIndex` ON `TracksData` (`PlayCounter`)
+)"_s.split(QStringLiteral(";"));
+
+        for (const QString &oneSqlIndex : sqlIndexes) {
+            if (!createIndexQuery.exec(oneSqlIndex)) {
+                qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << createIndexQuery.lastQuery();
+                qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << createIndexQuery.lastError();
+
+                Q_EMIT databaseError();
+            }
+        }
+    }
+
+    if (!d->mHasSearchIndex) {
+        return;
+    }
+
+    QSqlQuery selectTriggerQuery(d->mTracksDatabase);
+
+    const auto result = selectTriggerQuery.exec(
+        uR"(
+SELECT 
+1 
+FROM 
+`sqlite_master` 
+WHERE 
+`type` = 'trigger' AND 
+`name` = 'TracksSearchInsert'
+)"_s);
+
+    if (!result) {
+        qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << selectTriggerQuery.lastQuery();
+        qCCritical(orgKdeElisaDatabase) << __FUNCTION__ << selectTriggerQuery.lastError();
+
+        Q_EMIT databaseError();
+
+        return;
+    }
+
+    const auto hasSearchTriggers = selectTriggerQuery.next();
+
+    selectTriggerQuery.finish();
+
+    // an interrupted bulk import leaves the search index without its triggers
+    if (!hasSearchTriggers) {
+        createTracksSearchTriggers();
+
+        fillTracksSearchIndex();
+    }
+}
+
+DatabaseInterface::DatabaseState DatabaseInterface::checkDatabaseSchema() const
+{
+    const auto tables = d->mExpectedTableNamesAndFields;
+    const bool isInBadState = std::any_of(tables.cbegin(), tables.cend(), [this](const auto &table) {
+        return checkTable(table.name, table.fields) == DatabaseState::BadState;
+    });
+    return isInBadState ? DatabaseState::BadState : DatabaseState::GoodState;
+}
+
+DatabaseInterface::DatabaseState DatabaseInterface::checkTable(const QString &tableName, const QStringList &expectedColumns) const
+{
+    const auto columnsList = d->mTracksDatabase.record(tableName);
+
+    if (columnsList.count() != expectedColumns.count()) {
+        qCInfo(orgKdeElisaDatabase()) << tableName << "table has wrong number of columns" << columnsList.count() << "expected" << expectedColumns.count();
+        return DatabaseState::BadState;
+    }
+
+    for (const auto &oneField : expectedColumns) {
+        if (!columnsList.contains(oneField)) {
+            qCInfo(orgKdeElisaDatabase()) << tableName << "table has missing column" << oneField;
+            return DatabaseState::BadState;
+        }
+    }
+
+    return DatabaseState::GoodState;
+}
+
+bool DatabaseInterface::resetDatabase()
+{
+    qCInfo(orgKdeElisaDatabase()) << "Full reset of database due to corrupted database";
+
+    const auto connectionName = d->mConnectionName;
+    const auto databaseFileName = d->mDatabaseFileName;
+
+    d->mTracksDatabase.close();
+    d.reset();
+
+    auto dbFile = QFile(databaseFileName);
+    if (!dbFile.remove()) {
+        qCCritical(orgKdeElisaDatabase()) << "Database file could not be deleted" << dbFile.errorString();
+        return false;
+    }
+
+    initConnection(connectionName, databaseFileName);
+    return true;
+}
+
+DatabaseInterface::DatabaseVersion DatabaseInterface::currentDatabaseVersion()
+{
+    int version = 0;
+
+    auto listTables = d->mTracksDatabase.tables();
+
+    if (listTables.contains(QLatin1String("DatabaseVersion"))) {
+        initDatabaseVersionQueries();
+
+        auto queryResult = execQuery(d->mSelectDatabaseVersionQuery);
+        if (!queryResult) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseToLatestVersion" << d->mUpdateDatabaseVersionQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::upgradeDatabaseToLatestVersion" << d->mUpdateDatabaseVersionQuery.lastError();
+
+            Q_EMIT databaseError();
         }
 
         if(d->mSelectDatabaseVersionQuery.next()) {
@@ -3785,6 +4882,27 @@ void DatabaseInterface::callUpgradeFunctionForVersion(DatabaseVersion databaseVe
     case DatabaseInterface::V17:
         upgradeDatabaseV17();
         break;
+    case DatabaseInterface::V18:
+        upgradeDatabaseV18();
+        break;
+    case DatabaseInterface::V19:
+        upgradeDatabaseV19();
+        break;
+    case DatabaseInterface::V20:
+        upgradeDatabaseV20();
+        break;
+    case DatabaseInterface::V21:
+        upgradeDatabaseV21();
+        break;
+    case DatabaseInterface::V22:
+        upgradeDatabaseV22();
+        break;
+    case DatabaseInterface::V23:
+        upgradeDatabaseV23();
+        break;
+    case DatabaseInterface::V24:
+        upgradeDatabaseV24();
+        break;
     }
 }
 
@@ -3886,13 +5004,7 @@ COUNT(*)
 FROM 
 `Tracks` tracks3 
 WHERE 
-tracks3.`AlbumTitle` = album.`Title` AND 
-(tracks3.`AlbumArtistName` = album.`ArtistName` OR 
-(tracks3.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL
-)
-) AND 
-tracks3.`AlbumPath` = album.`AlbumPath` 
+tracks3.`AlbumId` = album.`ID` 
 ) as `TracksCount`, 
 (
 SELECT 
@@ -3900,13 +5012,7 @@ COUNT(DISTINCT tracks2.DiscNumber) <= 1
 FROM 
 `Tracks` tracks2 
 WHERE 
-tracks2.`AlbumTitle` = album.`Title` AND 
-(tracks2.`AlbumArtistName` = album.`ArtistName` OR 
-(tracks2.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL
-)
-) AND 
-tracks2.`AlbumPath` = album.`AlbumPath` 
+tracks2.`AlbumId` = album.`ID` 
 ) as `IsSingleDiscAlbum`, 
 COUNT(DISTINCT tracks.`ArtistName`) as ArtistsCount, 
 GROUP_CONCAT(tracks.`ArtistName`, ', ') as AllArtists, 
@@ -3918,28 +5024,14 @@ FROM
 `Tracks` tracksCover 
 WHERE 
 tracksCover.`HasEmbeddedCover` = 1 AND 
-tracksCover.`AlbumTitle` = album.`Title` AND 
-(tracksCover.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksCover.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksCover.`AlbumPath` = album.`AlbumPath` 
+tracksCover.`AlbumId` = album.`ID` 
 ) as EmbeddedCover 
 FROM 
 `Albums` album LEFT JOIN 
 `Tracks` tracks ON 
-tracks.`AlbumTitle` = album.`Title` AND 
-(
-tracks.`AlbumArtistName` = album.`ArtistName` OR 
-(
-tracks.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL
-)
-) AND 
-tracks.`AlbumPath` = album.`AlbumPath`
+tracks.`AlbumId` = album.`ID`
 LEFT JOIN 
-`Genre` genres ON tracks.`Genre` = genres.`Name` 
+`Genre` genres ON genres.`ID` = tracks.`GenreId` 
 WHERE 
 album.`ID` = :albumId 
 GROUP BY album.`ID`
@@ -3984,52 +5076,16 @@ album.`Title`,
 album.`ArtistName` as SecondaryText, 
 album.`CoverFileName`, 
 album.`ArtistName`, 
-GROUP_CONCAT(tracks.`Year`, ', ') as Year, 
-COUNT(DISTINCT tracks.`ArtistName`) as ArtistsCount, 
-GROUP_CONCAT(tracks.`ArtistName`, ', ') as AllArtists, 
-MAX(tracks.`Rating`) as HighestRating, 
-GROUP_CONCAT(genres.`Name`, ', ') as AllGenres, 
-(
-SELECT 
-COUNT(DISTINCT tracks2.DiscNumber) <= 1 
-FROM 
-`Tracks` tracks2 
-WHERE 
-tracks2.`AlbumTitle` = album.`Title` AND 
-(tracks2.`AlbumArtistName` = album.`ArtistName` OR 
-(tracks2.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL
-)
-) AND 
-tracks2.`AlbumPath` = album.`AlbumPath` 
-) as `IsSingleDiscAlbum`, 
-( 
-SELECT tracksCover.`FileName` 
-FROM 
-`Tracks` tracksCover 
-WHERE 
-tracksCover.`HasEmbeddedCover` = 1 AND 
-tracksCover.`AlbumTitle` = album.`Title` AND 
-(tracksCover.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksCover.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksCover.`AlbumPath` = album.`AlbumPath` 
-) as EmbeddedCover 
+aggregates.`Years` as Year, 
+aggregates.`ArtistsCount`, 
+aggregates.`AllArtists`, 
+aggregates.`HighestRating`, 
+aggregates.`AllGenres`, 
+aggregates.`DiscsCount` <= 1 as `IsSingleDiscAlbum`, 
+aggregates.`EmbeddedCoverFileName` as EmbeddedCover 
 FROM 
-`Albums` album, 
-`Tracks` tracks LEFT JOIN 
-`Genre` genres ON tracks.`Genre` = genres.`Name` 
-WHERE 
-tracks.`AlbumTitle` = album.`Title` AND 
-(tracks.`AlbumArtistName` = album.`ArtistName` OR 
-(tracks.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL
-) 
-) AND 
-tracks.`AlbumPath` = album.`AlbumPath` 
-GROUP BY album.`ID`, album.`Title`, album.`AlbumPath` 
+`Albums` album INNER JOIN 
+`AlbumAggregates` aggregates ON aggregates.`AlbumId` = album.`ID` 
 ORDER BY album.`Title` COLLATE NOCASE
 )"_s;
 
@@ -4063,13 +5119,7 @@ COUNT(DISTINCT tracks2.DiscNumber) <= 1
 FROM 
 `Tracks` tracks2 
 WHERE 
-tracks2.`AlbumTitle` = album.`Title` AND 
-(tracks2.`AlbumArtistName` = album.`ArtistName` OR 
-(tracks2.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL
-)
-) AND 
-tracks2.`AlbumPath` = album.`AlbumPath` 
+tracks2.`AlbumId` = album.`ID` 
 ) as `IsSingleDiscAlbum`, 
 ( 
 SELECT tracksCover.`FileName` 
@@ -4077,21 +5127,15 @@ FROM
 `Tracks` tracksCover 
 WHERE 
 tracksCover.`HasEmbeddedCover` = 1 AND 
-tracksCover.`AlbumTitle` = album.`Title` AND 
-(tracksCover.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksCover.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksCover.`AlbumPath` = album.`AlbumPath` 
+tracksCover.`AlbumId` = album.`ID` 
 ) as EmbeddedCover, 
 ( 
 SELECT COUNT(tracksCount.`ID`) 
 FROM 
 `Tracks` tracksCount 
 WHERE 
-tracksCount.`Genre` = genres.`Name` AND 
-tracksCount.`AlbumTitle` = album.`Title` AND 
+tracksCount.`GenreId` = genres.`ID` AND 
+tracksCount.`AlbumId` = album.`ID` AND 
 (tracksCount.`AlbumArtistName` = :artistFilter OR 
 (tracksCount.`ArtistName` = :artistFilter 
 ) 
@@ -4111,28 +5155,16 @@ tracksCount.`Title` = tracks2.`Title` AND
 FROM 
 `Albums` album, 
 `Tracks` tracks LEFT JOIN 
-`Genre` genres ON tracks.`Genre` = genres.`Name` 
+`Genre` genres ON genres.`ID` = tracks.`GenreId` 
 WHERE 
-tracks.`AlbumTitle` = album.`Title` AND 
-(tracks.`AlbumArtistName` = album.`ArtistName` OR 
-(tracks.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL
-)
-) AND 
-tracks.`AlbumPath` = album.`AlbumPath` AND 
-EXISTS (
-  SELECT tracks2.`Genre` 
+tracks.`AlbumId` = album.`ID` AND 
+album.`ID` IN (
+  SELECT tracks2.`AlbumId` 
   FROM 
   `Tracks` tracks2, 
   `Genre` genre2 
   WHERE 
-  tracks2.`AlbumTitle` = album.`Title` AND 
-  (tracks2.`AlbumArtistName` = album.`ArtistName` OR 
-   (tracks2.`AlbumArtistName` IS NULL AND 
-    album.`ArtistName` IS NULL
-   )
-  ) AND 
-  tracks2.`Genre` = genre2.`Name` AND 
+  tracks2.`GenreId` = genre2.`ID` AND 
   genre2.`Name` = :genreFilter AND 
   (tracks2.`ArtistName` = :artistFilter OR tracks2.`AlbumArtistName` = :artistFilter) 
 ) 
@@ -4170,13 +5202,7 @@ COUNT(DISTINCT tracks2.DiscNumber) <= 1
 FROM 
 `Tracks` tracks2 
 WHERE 
-tracks2.`AlbumTitle` = album.`Title` AND 
-(tracks2.`AlbumArtistName` = album.`ArtistName` OR 
-(tracks2.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL
-)
-) AND 
-tracks2.`AlbumPath` = album.`AlbumPath` 
+tracks2.`AlbumId` = album.`ID` 
 ) as `IsSingleDiscAlbum`, 
 ( 
 SELECT tracksCover.`FileName` 
@@ -4184,20 +5210,14 @@ FROM
 `Tracks` tracksCover 
 WHERE 
 tracksCover.`HasEmbeddedCover` = 1 AND 
-tracksCover.`AlbumTitle` = album.`Title` AND 
-(tracksCover.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksCover.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksCover.`AlbumPath` = album.`AlbumPath` 
+tracksCover.`AlbumId` = album.`ID` 
 ) as EmbeddedCover, 
 ( 
 SELECT COUNT(tracksCount.`ID`) 
 FROM 
 `Tracks` tracksCount 
 WHERE 
-tracksCount.`AlbumTitle` = album.`Title` AND 
+tracksCount.`AlbumId` = album.`ID` AND 
 (tracksCount.`AlbumArtistName` = :artistFilter OR 
 (tracksCount.`ArtistName` = :artistFilter 
 ) 
@@ -4217,29 +5237,15 @@ tracksCount.`Title` = tracks2.`Title` AND
 FROM 
 `Albums` album, 
 `Tracks` tracks LEFT JOIN 
-`Genre` genres ON tracks.`Genre` = genres.`Name` 
+`Genre` genres ON genres.`ID` = tracks.`GenreId` 
 WHERE 
-tracks.`AlbumTitle` = album.`Title` AND 
-(tracks.`AlbumArtistName` = album.`ArtistName` OR 
-(tracks.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL
-)
-) AND 
-tracks.`AlbumPath` = album.`AlbumPath` AND 
-EXISTS (
-  SELECT tracks2.`Genre` 
+tracks.`AlbumId` = album.`ID` AND 
+album.`ID` IN (
+  SELECT tracks2.`AlbumId` 
   FROM 
   `Tracks` tracks2 
   WHERE 
-  tracks2.`AlbumTitle` = album.`Title` AND 
-  ( 
-    tracks2.`AlbumArtistName` = album.`ArtistName` OR 
-    ( 
-      tracks2.`AlbumArtistName` IS NULL AND 
-      album.`ArtistName` IS NULL 
-    )
-  ) AND 
-  (tracks2.`ArtistName` = :artistFilter OR tracks2.`AlbumArtistName` = :artistFilter) 
+  tracks2.`ArtistName` = :artistFilter OR tracks2.`AlbumArtistName` = :artistFilter 
 ) 
 GROUP BY album.`ID`, album.`Title`, album.`AlbumPath` 
 ORDER BY album.`Title` COLLATE NOCASE
@@ -4260,11 +5266,15 @@ ORDER BY album.`Title` COLLATE NOCASE
             uR"(
 SELECT artists.`ID`, 
 artists.`Name`, 
-GROUP_CONCAT(genres.`Name`, ', ') as AllGenres 
-FROM `Artists` artists  LEFT JOIN 
-`Tracks` tracks ON artists.`Name` = tracks.`ArtistName` LEFT JOIN 
-`Genre` genres ON tracks.`Genre` = genres.`Name` 
-GROUP BY artists.`ID` 
+( 
+SELECT GROUP_CONCAT(genres.`Name`, ', ') 
+FROM 
+`Tracks` tracks LEFT JOIN 
+`Genre` genres ON genres.`ID` = tracks.`GenreId` 
+WHERE 
+tracks.`ArtistId` = artists.`ID` 
+) as AllGenres 
+FROM `Artists` artists 
 ORDER BY artists.`Name` COLLATE NOCASE
 )"_s;
 
@@ -4289,7 +5299,7 @@ SELECT COUNT(tracksCount.`ID`)
 FROM 
 `Tracks` tracksCount 
 WHERE 
-(tracksCount.`ArtistName` IS NULL OR tracksCount.`ArtistName` = artists.`Name`) AND 
+(tracksCount.`ArtistId` IS NULL OR tracksCount.`ArtistId` = artists.`ID`) AND 
 tracksCount.`Genre` = :genreFilter  AND 
 tracksCount.`Priority` = ( 
 SELECT 
@@ -4304,17 +5314,24 @@ tracksCount.`Title` = tracks2.`Title` AND
 ) 
 ) as TracksCount 
 FROM `Artists` artists  LEFT JOIN 
-`Tracks` tracks ON tracks.`Genre` IS NOT NULL AND (tracks.`ArtistName` = artists.`Name` OR tracks.`AlbumArtistName` = artists.`Name`) LEFT JOIN 
-`Genre` genres ON tracks.`Genre` = genres.`Name` 
+`Tracks` tracks ON tracks.`Genre` IS NOT NULL AND (tracks.`ArtistId` = artists.`ID` OR tracks.`AlbumArtistId` = artists.`ID`) LEFT JOIN 
+`Genre` genres ON genres.`ID` = tracks.`GenreId` 
 WHERE 
-EXISTS (
-  SELECT tracks2.`Genre` 
+artists.`ID` IN (
+  SELECT tracks2.`ArtistId` 
+  FROM 
+  `Tracks` tracks2, 
+  `Genre` genre2 
+  WHERE 
+  tracks2.`GenreId` = genre2.`ID` AND 
+  genre2.`Name` = :genreFilter 
+  UNION ALL 
+  SELECT tracks2.`AlbumArtistId` 
   FROM 
   `Tracks` tracks2, 
   `Genre` genre2 
   WHERE 
-  (tracks2.`ArtistName` = artists.`Name` OR tracks2.`AlbumArtistName` = artists.`Name`) AND 
-  tracks2.`Genre` = genre2.`Name` AND 
+  tracks2.`GenreId` = genre2.`ID` AND 
   genre2.`Name` = :genreFilter 
 ) 
 GROUP BY artists.`ID` 
@@ -4336,8 +5353,8 @@ ORDER BY artists.`Name` COLLATE NOCASE
             uR"(
 SELECT artists.`ID` 
 FROM `Artists` artists  LEFT JOIN 
-`Tracks` tracks ON (tracks.`ArtistName` = artists.`Name` OR tracks.`AlbumArtistName` = artists.`Name`) LEFT JOIN 
-`Genre` genres ON tracks.`Genre` = genres.`Name` 
+`Tracks` tracks ON (tracks.`ArtistId` = artists.`ID` OR tracks.`AlbumArtistId` = artists.`ID`) LEFT JOIN 
+`Genre` genres ON genres.`ID` = tracks.`GenreId` 
 WHERE 
 EXISTS (
   SELECT tracks2.`Genre` 
@@ -4345,8 +5362,8 @@ EXISTS (
   `Tracks` tracks2, 
   `Genre` genre2 
   WHERE 
-  (tracks2.`ArtistName` = artists.`Name` OR tracks2.`AlbumArtistName` = artists.`Name`) AND 
-  tracks2.`Genre` = genre2.`Name` AND 
+  (tracks2.`ArtistId` = artists.`ID` OR tracks2.`AlbumArtistId` = artists.`ID`) AND 
+  tracks2.`GenreId` = genre2.`ID` AND 
   genre2.`Name` = :genreFilter 
 ) AND 
 artists.`ID` = :databaseId
@@ -4400,9 +5417,9 @@ ORDER BY `Name` COLLATE NOCASE
         }
     }
 
-    {
-        auto selectAllTracksText =
-            uR"(
+    // the pages of tracks read the same columns and skip the same duplicates as the list of all the tracks
+    const auto selectAllTracksBaseText =
+        uR"(
 SELECT 
 tracks.`ID`, 
 tracks.`Title`, 
@@ -4414,13 +5431,7 @@ COUNT(DISTINCT tracksFromAlbum1.`ArtistName`)
 FROM 
 `Tracks` tracksFromAlbum1 
 WHERE 
-tracksFromAlbum1.`AlbumTitle` = album.`Title` AND 
-(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksFromAlbum1.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` 
+tracksFromAlbum1.`AlbumId` = album.`ID` 
 ) AS ArtistsCount, 
 ( 
 SELECT 
@@ -4428,13 +5439,7 @@ GROUP_CONCAT(tracksFromAlbum2.`ArtistName`)
 FROM 
 `Tracks` tracksFromAlbum2 
 WHERE 
-tracksFromAlbum2.`AlbumTitle` = album.`Title` AND 
-(tracksFromAlbum2.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksFromAlbum2.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksFromAlbum2.`AlbumPath` = album.`AlbumPath` 
+tracksFromAlbum2.`AlbumId` = album.`ID` 
 ) AS AllArtists, 
 tracks.`AlbumArtistName`, 
 tracksMapping.`FileName`, 
@@ -4451,13 +5456,7 @@ COUNT(DISTINCT tracks2.DiscNumber) <= 1
 FROM 
 `Tracks` tracks2 
 WHERE 
-tracks2.`AlbumTitle` = album.`Title` AND 
-(tracks2.`AlbumArtistName` = album.`ArtistName` OR 
-(tracks2.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL
-)
-) AND 
-tracks2.`AlbumPath` = album.`AlbumPath` 
+tracks2.`AlbumId` = album.`ID` 
 ) as `IsSingleDiscAlbum`, 
 trackGenre.`Name`, 
 trackComposer.`Name`, 
@@ -4482,13 +5481,7 @@ tracksCover.`HasEmbeddedCover` = 1 AND
 (tracksCover.`AlbumTitle` IS NULL AND 
 tracksCover.`FileName` = tracks.`FileName` ) OR 
 ( 
-tracksCover.`AlbumTitle` = album.`Title` AND 
-(tracksCover.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksCover.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksCover.`AlbumPath` = album.`AlbumPath` 
+tracksCover.`AlbumId` = album.`ID` 
 ) 
 ) 
 ) as EmbeddedCover 
@@ -4501,14 +5494,14 @@ tracksMapping.`FileName` = tracks.`FileName`
 LEFT JOIN 
 `Albums` album 
 ON 
-tracks.`AlbumTitle` = album.`Title` AND 
-(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND 
-tracks.`AlbumPath` = album.`AlbumPath` 
-LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` 
+tracks.`AlbumId` = album.`ID` 
+LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreId` 
 LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` 
 LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` 
-WHERE 
-tracks.`Title` IS NULL OR 
+)"_s;
+
+    const auto highestPriorityTrackText =
+        uR"(
 tracks.`Priority` = (
      SELECT 
      MIN(`Priority`) 
@@ -4521,9 +5514,15 @@ tracks.`Priority` = (
      (tracks.`AlbumArtistName` IS NULL OR tracks.`AlbumArtistName` = tracks2.`AlbumArtistName`) AND 
      (tracks.`AlbumPath` IS NULL OR tracks.`AlbumPath` = tracks2.`AlbumPath`)
 )
-
 )"_s;
 
+    {
+        auto selectAllTracksText = selectAllTracksBaseText +
+            uR"(
+WHERE 
+tracks.`Title` IS NULL OR 
+)"_s + highestPriorityTrackText;
+
         auto result = prepareQuery(d->mSelectAllTracksQuery, selectAllTracksText);
 
         if (!result) {
@@ -4534,6 +5533,27 @@ tracks.`Priority` = (
         }
     }
 
+    {
+        auto selectAllTracksPageText = selectAllTracksBaseText +
+            uR"(
+WHERE 
+tracks.`ID` > :afterDatabaseId AND 
+)"_s + highestPriorityTrackText +
+            uR"(
+ORDER BY tracks.`ID` 
+LIMIT :maximumResults
+)"_s;
+
+        auto result = prepareQuery(d->mSelectAllTracksPageQuery, selectAllTracksPageText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllTracksPageQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllTracksPageQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
     {
         auto selectAllRadiosText =
             uR"(
@@ -4575,13 +5595,7 @@ COUNT(DISTINCT tracksFromAlbum1.`ArtistName`)
 FROM 
 `Tracks` tracksFromAlbum1 
 WHERE 
-tracksFromAlbum1.`AlbumTitle` = album.`Title` AND 
-(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksFromAlbum1.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` 
+tracksFromAlbum1.`AlbumId` = album.`ID` 
 ) AS ArtistsCount, 
 ( 
 SELECT 
@@ -4589,13 +5603,7 @@ GROUP_CONCAT(tracksFromAlbum2.`ArtistName`)
 FROM 
 `Tracks` tracksFromAlbum2 
 WHERE 
-tracksFromAlbum2.`AlbumTitle` = album.`Title` AND 
-(tracksFromAlbum2.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksFromAlbum2.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksFromAlbum2.`AlbumPath` = album.`AlbumPath` 
+tracksFromAlbum2.`AlbumId` = album.`ID` 
 ) AS AllArtists, 
 tracks.`AlbumArtistName`, 
 tracksMapping.`FileName`, 
@@ -4612,13 +5620,7 @@ COUNT(DISTINCT tracks2.DiscNumber) <= 1
 FROM 
 `Tracks` tracks2 
 WHERE 
-tracks2.`AlbumTitle` = album.`Title` AND 
-(tracks2.`AlbumArtistName` = album.`ArtistName` OR 
-(tracks2.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL
-)
-) AND 
-tracks2.`AlbumPath` = album.`AlbumPath` 
+tracks2.`AlbumId` = album.`ID` 
 ) as `IsSingleDiscAlbum`, 
 trackGenre.`Name`, 
 trackComposer.`Name`, 
@@ -4643,13 +5645,7 @@ tracksCover.`HasEmbeddedCover` = 1 AND
 (tracksCover.`AlbumTitle` IS NULL AND 
 tracksCover.`FileName` = tracks.`FileName` ) OR 
 ( 
-tracksCover.`AlbumTitle` = album.`Title` AND 
-(tracksCover.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksCover.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksCover.`AlbumPath` = album.`AlbumPath` 
+tracksCover.`AlbumId` = album.`ID` 
 ) 
 ) 
 ) as EmbeddedCover 
@@ -4659,10 +5655,8 @@ FROM
 LEFT JOIN 
 `Albums` album 
 ON 
-tracks.`AlbumTitle` = album.`Title` AND 
-(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND 
-tracks.`AlbumPath` = album.`AlbumPath` 
-LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` 
+tracks.`AlbumId` = album.`ID` 
+LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreId` 
 LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` 
 LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` 
 WHERE 
@@ -4708,13 +5702,7 @@ COUNT(DISTINCT tracksFromAlbum1.`ArtistName`)
 FROM 
 `Tracks` tracksFromAlbum1 
 WHERE 
-tracksFromAlbum1.`AlbumTitle` = album.`Title` AND 
-(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksFromAlbum1.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` 
+tracksFromAlbum1.`AlbumId` = album.`ID` 
 ) AS ArtistsCount, 
 ( 
 SELECT 
@@ -4722,13 +5710,7 @@ GROUP_CONCAT(tracksFromAlbum2.`ArtistName`)
 FROM 
 `Tracks` tracksFromAlbum2 
 WHERE 
-tracksFromAlbum2.`AlbumTitle` = album.`Title` AND 
-(tracksFromAlbum2.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksFromAlbum2.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksFromAlbum2.`AlbumPath` = album.`AlbumPath` 
+tracksFromAlbum2.`AlbumId` = album.`ID` 
 ) AS AllArtists, 
 tracks.`AlbumArtistName`, 
 tracksMapping.`FileName`, 
@@ -4745,13 +5727,7 @@ COUNT(DISTINCT tracks2.DiscNumber) <= 1
 FROM 
 `Tracks` tracks2 
 WHERE 
-tracks2.`AlbumTitle` = album.`Title` AND 
-(tracks2.`AlbumArtistName` = album.`ArtistName` OR 
-(tracks2.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL
-)
-) AND 
-tracks2.`AlbumPath` = album.`AlbumPath` 
+tracks2.`AlbumId` = album.`ID` 
 ) as `IsSingleDiscAlbum`, 
 trackGenre.`Name`, 
 trackComposer.`Name`, 
@@ -4776,13 +5752,7 @@ tracksCover.`HasEmbeddedCover` = 1 AND
 (tracksCover.`AlbumTitle` IS NULL AND 
 tracksCover.`FileName` = tracks.`FileName` ) OR 
 ( 
-tracksCover.`AlbumTitle` = album.`Title` AND 
-(tracksCover.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksCover.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksCover.`AlbumPath` = album.`AlbumPath` 
+tracksCover.`AlbumId` = album.`ID` 
 ) 
 ) 
 ) as EmbeddedCover 
@@ -4792,10 +5762,8 @@ FROM
 LEFT JOIN 
 `Albums` album 
 ON 
-tracks.`AlbumTitle` = album.`Title` AND 
-(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND 
-tracks.`AlbumPath` = album.`AlbumPath` 
-LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` 
+tracks.`AlbumId` = album.`ID` 
+LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreId` 
 LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` 
 LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` 
 WHERE 
@@ -4892,6 +5860,45 @@ LIMIT :maximumResults
         }
     }
 
+    {
+        auto clearDirectoryFingerprintsTableText = QStringLiteral("DELETE FROM `DirectoryFingerprints`");
+
+        auto result = prepareQuery(d->mClearDirectoryFingerprintsTable, clearDirectoryFingerprintsTableText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mClearDirectoryFingerprintsTable.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mClearDirectoryFingerprintsTable.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto clearScanCheckpointsTableText = QStringLiteral("DELETE FROM `ScanCheckpoints`");
+
+        auto result = prepareQuery(d->mClearScanCheckpointsTable, clearScanCheckpointsTableText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mClearScanCheckpointsTable.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mClearScanCheckpointsTable.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto clearScanCheckpointDirectoriesTableText = QStringLiteral("DELETE FROM `ScanCheckpointDirectories`");
+
+        auto result = prepareQuery(d->mClearScanCheckpointDirectoriesTable, clearScanCheckpointDirectoriesTableText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mClearScanCheckpointDirectoriesTable.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mClearScanCheckpointDirectoriesTable.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
     {
         auto clearTracksDataTableText = QStringLiteral("DELETE FROM `TracksData`");
 
@@ -4932,13 +5939,7 @@ COUNT(DISTINCT tracksFromAlbum1.`ArtistName`)
 FROM 
 `Tracks` tracksFromAlbum1 
 WHERE 
-tracksFromAlbum1.`AlbumTitle` = album.`Title` AND 
-(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksFromAlbum1.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` 
+tracksFromAlbum1.`AlbumId` = album.`ID` 
 ) AS ArtistsCount, 
 ( 
 SELECT 
@@ -4946,13 +5947,7 @@ GROUP_CONCAT(tracksFromAlbum2.`ArtistName`)
 FROM 
 `Tracks` tracksFromAlbum2 
 WHERE 
-tracksFromAlbum2.`AlbumTitle` = album.`Title` AND 
-(tracksFromAlbum2.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksFromAlbum2.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksFromAlbum2.`AlbumPath` = album.`AlbumPath` 
+tracksFromAlbum2.`AlbumId` = album.`ID` 
 ) AS AllArtists, 
 tracks.`AlbumArtistName`, 
 tracks.`Duration`, 
@@ -4965,9 +5960,7 @@ FROM
 LEFT JOIN 
 `Albums` album 
 ON 
-tracks.`AlbumTitle` = album.`Title` AND 
-(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND 
-tracks.`AlbumPath` = album.`AlbumPath` 
+tracks.`AlbumId` = album.`ID` 
 
 )"_s;
 
@@ -5137,34 +6130,8 @@ tracks.`ID`,
 tracks.`Title`, 
 album.`ID`, 
 tracks.`ArtistName`, 
-( 
-SELECT 
-COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) 
-FROM 
-`Tracks` tracksFromAlbum1 
-WHERE 
-tracksFromAlbum1.`AlbumTitle` = album.`Title` AND 
-(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksFromAlbum1.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` 
-) AS ArtistsCount, 
-( 
-SELECT 
-GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) 
-FROM 
-`Tracks` tracksFromAlbum2 
-WHERE 
-tracksFromAlbum2.`AlbumTitle` = album.`Title` AND 
-(tracksFromAlbum2.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksFromAlbum2.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksFromAlbum2.`AlbumPath` = album.`AlbumPath` 
-) AS AllArtists, 
+aggregates.`ArtistsCount`, 
+aggregates.`AllArtists`, 
 tracks.`AlbumArtistName`, 
 tracksMapping.`FileName`, 
 tracksMapping.`FileModifiedTime`, 
@@ -5174,20 +6141,7 @@ tracks.`Duration`,
 tracks.`AlbumTitle`, 
 tracks.`Rating`, 
 album.`CoverFileName`, 
-(
-SELECT 
-COUNT(DISTINCT tracks2.DiscNumber) <= 1 
-FROM 
-`Tracks` tracks2 
-WHERE 
-tracks2.`AlbumTitle` = album.`Title` AND 
-(tracks2.`AlbumArtistName` = album.`ArtistName` OR 
-(tracks2.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL
-)
-) AND 
-tracks2.`AlbumPath` = album.`AlbumPath` 
-) as `IsSingleDiscAlbum`, 
+aggregates.`DiscsCount` <= 1 as `IsSingleDiscAlbum`, 
 trackGenre.`Name`, 
 trackComposer.`Name`, 
 trackLyricist.`Name`, 
@@ -5201,26 +6155,7 @@ tracksMapping.`ImportDate`,
 tracksMapping.`FirstPlayDate`, 
 tracksMapping.`LastPlayDate`, 
 tracksMapping.`PlayCounter`, 
-( 
-SELECT tracksCover.`FileName` 
-FROM 
-`Tracks` tracksCover 
-WHERE 
-tracksCover.`HasEmbeddedCover` = 1 AND 
-( 
-(tracksCover.`AlbumTitle` IS NULL AND 
-tracksCover.`FileName` = tracks.`FileName` ) OR 
-( 
-tracksCover.`AlbumTitle` = album.`Title` AND 
-(tracksCover.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksCover.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksCover.`AlbumPath` = album.`AlbumPath` 
-) 
-) 
-) as EmbeddedCover 
+aggregates.`EmbeddedCoverFileName` as EmbeddedCover 
 FROM 
 `Tracks` tracks, 
 `TracksData` tracksMapping 
@@ -5228,12 +6163,12 @@ LEFT JOIN
 `Albums` album 
 ON 
 album.`ID` = :albumId AND 
-tracks.`AlbumTitle` = album.`Title` AND 
-(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND 
-tracks.`AlbumPath` = album.`AlbumPath` 
+tracks.`AlbumId` = album.`ID` 
+LEFT JOIN 
+`AlbumAggregates` aggregates ON aggregates.`AlbumId` = album.`ID` 
 LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` 
 LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` 
-LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` 
+LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreId` 
 WHERE 
 tracksMapping.`FileName` = tracks.`FileName` AND 
 album.`ID` = :albumId AND 
@@ -5275,9 +6210,7 @@ LEFT JOIN
 `Albums` album 
 ON 
 album.`ID` = :albumId AND 
-tracks.`AlbumTitle` = album.`Title` AND 
-(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND 
-tracks.`AlbumPath` = album.`AlbumPath` 
+tracks.`AlbumId` = album.`ID` 
 WHERE 
 tracksMapping.`FileName` = tracks.`FileName` AND 
 album.`ID` = :albumId AND 
@@ -5321,13 +6254,7 @@ COUNT(DISTINCT tracksFromAlbum1.`ArtistName`)
 FROM 
 `Tracks` tracksFromAlbum1 
 WHERE 
-tracksFromAlbum1.`AlbumTitle` = album.`Title` AND 
-(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksFromAlbum1.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` 
+tracksFromAlbum1.`AlbumId` = album.`ID` 
 ) AS ArtistsCount, 
 ( 
 SELECT 
@@ -5335,13 +6262,7 @@ GROUP_CONCAT(tracksFromAlbum2.`ArtistName`)
 FROM 
 `Tracks` tracksFromAlbum2 
 WHERE 
-tracksFromAlbum2.`AlbumTitle` = album.`Title` AND 
-(tracksFromAlbum2.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksFromAlbum2.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksFromAlbum2.`AlbumPath` = album.`AlbumPath` 
+tracksFromAlbum2.`AlbumId` = album.`ID` 
 ) AS AllArtists, 
 tracks.`AlbumArtistName`, 
 tracksMapping.`FileName`, 
@@ -5358,13 +6279,7 @@ COUNT(DISTINCT tracks2.DiscNumber) <= 1
 FROM 
 `Tracks` tracks2 
 WHERE 
-tracks2.`AlbumTitle` = album.`Title` AND 
-(tracks2.`AlbumArtistName` = album.`ArtistName` OR 
-(tracks2.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL
-)
-) AND 
-tracks2.`AlbumPath` = album.`AlbumPath` 
+tracks2.`AlbumId` = album.`ID` 
 ) as `IsSingleDiscAlbum`, 
 trackGenre.`Name`, 
 trackComposer.`Name`, 
@@ -5389,13 +6304,7 @@ tracksCover.`HasEmbeddedCover` = 1 AND
 (tracksCover.`AlbumTitle` IS NULL AND 
 tracksCover.`FileName` = tracks.`FileName` ) OR 
 ( 
-tracksCover.`AlbumTitle` = album.`Title` AND 
-(tracksCover.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksCover.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksCover.`AlbumPath` = album.`AlbumPath` 
+tracksCover.`AlbumId` = album.`ID` 
 ) 
 ) 
 ) as EmbeddedCover 
@@ -5405,12 +6314,10 @@ FROM
 LEFT JOIN 
 `Albums` album 
 ON 
-tracks.`AlbumTitle` = album.`Title` AND 
-(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND 
-tracks.`AlbumPath` = album.`AlbumPath` 
+tracks.`AlbumId` = album.`ID` 
 LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` 
 LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` 
-LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` 
+LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreId` 
 WHERE 
 tracks.`ID` = :trackId AND 
 tracksMapping.`FileName` = tracks.`FileName`
@@ -5441,13 +6348,7 @@ COUNT(DISTINCT tracksFromAlbum1.`ArtistName`)
 FROM 
 `Tracks` tracksFromAlbum1 
 WHERE 
-tracksFromAlbum1.`AlbumTitle` = album.`Title` AND 
-(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksFromAlbum1.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` 
+tracksFromAlbum1.`AlbumId` = album.`ID` 
 ) AS ArtistsCount, 
 ( 
 SELECT 
@@ -5455,13 +6356,7 @@ GROUP_CONCAT(tracksFromAlbum2.`ArtistName`)
 FROM 
 `Tracks` tracksFromAlbum2 
 WHERE 
-tracksFromAlbum2.`AlbumTitle` = album.`Title` AND 
-(tracksFromAlbum2.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksFromAlbum2.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksFromAlbum2.`AlbumPath` = album.`AlbumPath` 
+tracksFromAlbum2.`AlbumId` = album.`ID` 
 ) AS AllArtists, 
 tracks.`AlbumArtistName`, 
 tracksMapping.`FileName`, 
@@ -5478,13 +6373,7 @@ COUNT(DISTINCT tracks2.DiscNumber) <= 1
 FROM 
 `Tracks` tracks2 
 WHERE 
-tracks2.`AlbumTitle` = album.`Title` AND 
-(tracks2.`AlbumArtistName` = album.`ArtistName` OR 
-(tracks2.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL
-)
-) AND 
-tracks2.`AlbumPath` = album.`AlbumPath` 
+tracks2.`AlbumId` = album.`ID` 
 ) as `IsSingleDiscAlbum`, 
 trackGenre.`Name`, 
 trackComposer.`Name`, 
@@ -5509,13 +6398,7 @@ tracksCover.`HasEmbeddedCover` = 1 AND
 (tracksCover.`AlbumTitle` IS NULL AND 
 tracksCover.`FileName` = tracks.`FileName` ) OR 
 ( 
-tracksCover.`AlbumTitle` = album.`Title` AND 
-(tracksCover.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksCover.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksCover.`AlbumPath` = album.`AlbumPath` 
+tracksCover.`AlbumId` = album.`ID` 
 ) 
 ) 
 ) as EmbeddedCover 
@@ -5525,12 +6408,10 @@ FROM
 LEFT JOIN 
 `Albums` album 
 ON 
-tracks.`AlbumTitle` = album.`Title` AND 
-(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND 
-tracks.`AlbumPath` = album.`AlbumPath` 
+tracks.`AlbumId` = album.`ID` 
 LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` 
 LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` 
-LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` 
+LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreId` 
 WHERE 
 tracks.`ID` = :trackId AND 
 tracksMapping.`FileName` = tracks.`FileName` AND 
@@ -5603,10 +6484,8 @@ FROM
 LEFT JOIN 
 `Albums` album 
 ON 
-tracks.`AlbumTitle` = album.`Title` AND 
-(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND 
-tracks.`AlbumPath` = album.`AlbumPath` 
-LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` 
+tracks.`AlbumId` = album.`ID` 
+LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreId` 
 WHERE 
 album.`ArtistName` = :artistName
 )"_s;
@@ -5630,10 +6509,8 @@ FROM
 LEFT JOIN 
 `Albums` album 
 ON 
-tracks.`AlbumTitle` = album.`Title` AND 
-(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND 
-tracks.`AlbumPath` = album.`AlbumPath` 
-LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` 
+tracks.`AlbumId` = album.`ID` 
+LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreId` 
 WHERE 
 album.`ID` = :albumId
 )"_s;
@@ -5657,9 +6534,7 @@ FROM
 `Albums` album 
 LEFT JOIN `Composer` albumComposer ON albumComposer.`Name` = tracks.`Composer` 
 WHERE 
-(tracks.`AlbumTitle` = album.`Title` OR tracks.`AlbumTitle` IS NULL ) AND 
-(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND 
-(tracks.`AlbumPath` = album.`AlbumPath` OR tracks.`AlbumPath` IS NULL ) AND 
+tracks.`AlbumId` = album.`ID` AND 
 albumComposer.`Name` = :artistName
 )"_s;
 
@@ -5682,9 +6557,7 @@ FROM
 `Albums` album 
 LEFT JOIN `Lyricist` albumLyricist ON albumLyricist.`Name` = tracks.`Lyricist` 
 WHERE 
-(tracks.`AlbumTitle` = album.`Title` OR tracks.`AlbumTitle` IS NULL ) AND 
-(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND 
-(tracks.`AlbumPath` = album.`AlbumPath` OR tracks.`AlbumPath` IS NULL ) AND 
+tracks.`AlbumId` = album.`ID` AND 
 albumLyricist.`Name` = :artistName
 )"_s;
 
@@ -5901,13 +6774,7 @@ COUNT(DISTINCT tracksFromAlbum1.`ArtistName`)
 FROM 
 `Tracks` tracksFromAlbum1 
 WHERE 
-tracksFromAlbum1.`AlbumTitle` = album.`Title` AND 
-(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksFromAlbum1.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` 
+tracksFromAlbum1.`AlbumId` = album.`ID` 
 ) AS ArtistsCount, 
 ( 
 SELECT 
@@ -5915,13 +6782,7 @@ GROUP_CONCAT(tracksFromAlbum2.`ArtistName`)
 FROM 
 `Tracks` tracksFromAlbum2 
 WHERE 
-tracksFromAlbum2.`AlbumTitle` = album.`Title` AND 
-(tracksFromAlbum2.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksFromAlbum2.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksFromAlbum2.`AlbumPath` = album.`AlbumPath` 
+tracksFromAlbum2.`AlbumId` = album.`ID` 
 ) AS AllArtists, 
 tracks.`AlbumArtistName`, 
 '' as FileName, 
@@ -5938,13 +6799,7 @@ COUNT(DISTINCT tracks2.DiscNumber) <= 1
 FROM 
 `Tracks` tracks2 
 WHERE 
-tracks2.`AlbumTitle` = album.`Title` AND 
-(tracks2.`AlbumArtistName` = album.`ArtistName` OR 
-(tracks2.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL
-)
-) AND 
-tracks2.`AlbumPath` = album.`AlbumPath` 
+tracks2.`AlbumId` = album.`ID` 
 ) as `IsSingleDiscAlbum`, 
 trackGenre.`Name`, 
 trackComposer.`Name`, 
@@ -5969,13 +6824,7 @@ tracksCover.`HasEmbeddedCover` = 1 AND
 (tracksCover.`AlbumTitle` IS NULL AND 
 tracksCover.`FileName` = tracks.`FileName` ) OR 
 ( 
-tracksCover.`AlbumTitle` = album.`Title` AND 
-(tracksCover.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksCover.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksCover.`AlbumPath` = album.`AlbumPath` 
+tracksCover.`AlbumId` = album.`ID` 
 ) 
 ) 
 ) as EmbeddedCover 
@@ -5985,12 +6834,10 @@ FROM
 LEFT JOIN 
 `Albums` album 
 ON 
-tracks.`AlbumTitle` = album.`Title` AND 
-(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND 
-tracks.`AlbumPath` = album.`AlbumPath` 
+tracks.`AlbumId` = album.`ID` 
 LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` 
 LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` 
-LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` 
+LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreId` 
 WHERE 
 tracks.`FileName` = tracksMapping.`FileName` AND 
 tracks.`FileName` NOT IN (SELECT tracksMapping2.`FileName` FROM `TracksData` tracksMapping2)
@@ -6124,6 +6971,174 @@ FROM
         }
     }
 
+    {
+        auto selectAllDirectoryFingerprintsQueryText =
+            uR"(
+SELECT 
+fingerprints.`DirectoryPath`, 
+fingerprints.`ModifiedTime`, 
+fingerprints.`EntriesCount`, 
+fingerprints.`NamesHash` 
+FROM 
+`DirectoryFingerprints` fingerprints
+)"_s;
+
+        auto result = prepareQuery(d->mSelectAllDirectoryFingerprintsQuery, selectAllDirectoryFingerprintsQueryText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllDirectoryFingerprintsQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllDirectoryFingerprintsQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto insertDirectoryFingerprintQueryText =
+            uR"(
+INSERT OR REPLACE INTO `DirectoryFingerprints` 
+(`DirectoryPath`, `ModifiedTime`, `EntriesCount`, `NamesHash`) 
+VALUES (:directoryPath, :modifiedTime, :entriesCount, :namesHash)
+)"_s;
+
+        auto result = prepareQuery(d->mInsertDirectoryFingerprintQuery, insertDirectoryFingerprintQueryText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mInsertDirectoryFingerprintQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mInsertDirectoryFingerprintQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto removeDirectoryFingerprintQueryText =
+            uR"(
+DELETE FROM `DirectoryFingerprints` 
+WHERE 
+`DirectoryPath` = :directoryPath
+)"_s;
+
+        auto result = prepareQuery(d->mRemoveDirectoryFingerprintQuery, removeDirectoryFingerprintQueryText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveDirectoryFingerprintQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveDirectoryFingerprintQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectAllScanCheckpointsQueryText =
+            uR"(
+SELECT 
+checkpoints.`RootPath` 
+FROM 
+`ScanCheckpoints` checkpoints
+)"_s;
+
+        auto result = prepareQuery(d->mSelectAllScanCheckpointsQuery, selectAllScanCheckpointsQueryText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllScanCheckpointsQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllScanCheckpointsQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto insertScanCheckpointQueryText =
+            uR"(
+INSERT OR REPLACE INTO `ScanCheckpoints` 
+(`RootPath`) 
+VALUES (:rootPath)
+)"_s;
+
+        auto result = prepareQuery(d->mInsertScanCheckpointQuery, insertScanCheckpointQueryText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mInsertScanCheckpointQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mInsertScanCheckpointQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto removeScanCheckpointQueryText =
+            uR"(
+DELETE FROM `ScanCheckpoints` 
+WHERE 
+`RootPath` = :rootPath
+)"_s;
+
+        auto result = prepareQuery(d->mRemoveScanCheckpointQuery, removeScanCheckpointQueryText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveScanCheckpointQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveScanCheckpointQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectAllScanCheckpointDirectoriesQueryText =
+            uR"(
+SELECT 
+directories.`DirectoryPath` 
+FROM 
+`ScanCheckpointDirectories` directories
+)"_s;
+
+        auto result = prepareQuery(d->mSelectAllScanCheckpointDirectoriesQuery, selectAllScanCheckpointDirectoriesQueryText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllScanCheckpointDirectoriesQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAllScanCheckpointDirectoriesQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto insertScanCheckpointDirectoryQueryText =
+            uR"(
+INSERT OR REPLACE INTO `ScanCheckpointDirectories` 
+(`DirectoryPath`, `RootPath`) 
+VALUES (:directoryPath, :rootPath)
+)"_s;
+
+        auto result = prepareQuery(d->mInsertScanCheckpointDirectoryQuery, insertScanCheckpointDirectoryQueryText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mInsertScanCheckpointDirectoryQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mInsertScanCheckpointDirectoryQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto removeScanCheckpointDirectoriesQueryText =
+            uR"(
+DELETE FROM `ScanCheckpointDirectories` 
+WHERE 
+`RootPath` = :rootPath
+)"_s;
+
+        auto result = prepareQuery(d->mRemoveScanCheckpointDirectoriesQuery, removeScanCheckpointDirectoriesQueryText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveScanCheckpointDirectoriesQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveScanCheckpointDirectoriesQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
     {
         auto insertMusicSourceQueryText =
             uR"(
@@ -6166,9 +7181,7 @@ FROM
 WHERE 
 tracks.`Title` = :title AND 
 album.`ID` = :album AND 
-(tracks.`AlbumTitle` = album.`Title` OR tracks.`AlbumTitle` IS NULL ) AND 
-(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND 
-(tracks.`AlbumPath` = album.`AlbumPath` OR tracks.`AlbumPath` IS NULL ) AND 
+tracks.`AlbumId` = album.`ID` AND 
 tracks.`ArtistName` = :artist AND 
 tracksMapping.`FileName` = tracks.`FileName` AND 
 tracks.`Priority` = (
@@ -6221,7 +7234,11 @@ INSERT INTO `Tracks`
 `Year`,  
 `Duration`, 
 `Rating`, 
-`HasEmbeddedCover`) 
+`HasEmbeddedCover`, 
+`AlbumId`, 
+`ArtistId`, 
+`AlbumArtistId`, 
+`GenreId`) 
 VALUES 
 (
 :trackId, 
@@ -6244,7 +7261,11 @@ VALUES
 :year, 
 :trackDuration, 
 :trackRating, 
-:hasEmbeddedCover)
+:hasEmbeddedCover, 
+:albumId, 
+:artistId, 
+:albumArtistId, 
+:genreId)
 )"_s;
 
         auto result = prepareQuery(d->mInsertTrackQuery, insertTrackQueryText);
@@ -6279,7 +7300,11 @@ SET
 `SampleRate` = :sampleRate, 
 `Year` = :year, 
  `Duration` = :trackDuration, 
-`Rating` = :trackRating 
+`Rating` = :trackRating, 
+`AlbumId` = :albumId, 
+`ArtistId` = :artistId, 
+`AlbumArtistId` = :albumArtistId, 
+`GenreId` = :genreId 
 WHERE 
 `ID` = :trackId
 )"_s;
@@ -6389,10 +7414,10 @@ WHERE
             uR"(
 UPDATE `Tracks` 
 SET 
-`AlbumArtistName` = :artistName 
+`AlbumArtistName` = :artistName, 
+`AlbumArtistId` = :artistId 
 WHERE 
-`AlbumTitle` = :albumTitle AND 
-`AlbumPath` = :albumPath AND 
+`AlbumId` = :albumId AND 
 `AlbumArtistName` IS NULL
 )"_s;
 
@@ -6545,8 +7570,7 @@ tracks.`ArtistName` = :artist
 SELECT 
 tracks.ID 
 FROM 
-`Tracks` tracks, 
-`Albums` albums 
+`Tracks` tracks 
 WHERE 
 tracks.`Title` = :title AND 
 tracks.`Priority` = :priority AND 
@@ -6619,9 +7643,7 @@ ELSE track.`FileName` END) AS CoverFileName,
 album.`CoverFileName` IS '') AS IsTrackCover 
 FROM 
 `Tracks` track LEFT OUTER JOIN `Albums` album ON 
-album.`Title` = track.`AlbumTitle` AND 
-album.`ArtistName` = track.`AlbumArtistName` AND 
-album.`AlbumPath` = track.`AlbumPath` 
+album.`ID` = track.`AlbumId` 
 WHERE 
 (track.`HasEmbeddedCover` = 1 OR 
 (album.`CoverFileName` IS NOT NULL AND 
@@ -6657,13 +7679,7 @@ COUNT(DISTINCT tracksFromAlbum1.`ArtistName`)
 FROM 
 `Tracks` tracksFromAlbum1 
 WHERE 
-tracksFromAlbum1.`AlbumTitle` = album.`Title` AND 
-(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksFromAlbum1.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` 
+tracksFromAlbum1.`AlbumId` = album.`ID` 
 ) AS ArtistsCount, 
 ( 
 SELECT 
@@ -6671,13 +7687,7 @@ GROUP_CONCAT(tracksFromAlbum2.`ArtistName`)
 FROM 
 `Tracks` tracksFromAlbum2 
 WHERE 
-tracksFromAlbum2.`AlbumTitle` = album.`Title` AND 
-(tracksFromAlbum2.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksFromAlbum2.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksFromAlbum2.`AlbumPath` = album.`AlbumPath` 
+tracksFromAlbum2.`AlbumId` = album.`ID` 
 ) AS AllArtists, 
 tracks.`AlbumArtistName`, 
 tracksMapping.`FileName`, 
@@ -6694,13 +7704,7 @@ COUNT(DISTINCT tracks2.DiscNumber) <= 1
 FROM 
 `Tracks` tracks2 
 WHERE 
-tracks2.`AlbumTitle` = album.`Title` AND 
-(tracks2.`AlbumArtistName` = album.`ArtistName` OR 
-(tracks2.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL
-)
-) AND 
-tracks2.`AlbumPath` = album.`AlbumPath` 
+tracks2.`AlbumId` = album.`ID` 
 ) as `IsSingleDiscAlbum`, 
 trackGenre.`Name`, 
 trackComposer.`Name`, 
@@ -6725,13 +7729,7 @@ tracksCover.`HasEmbeddedCover` = 1 AND
 (tracksCover.`AlbumTitle` IS NULL AND 
 tracksCover.`FileName` = tracks.`FileName` ) OR 
 ( 
-tracksCover.`AlbumTitle` = album.`Title` AND 
-(tracksCover.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksCover.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksCover.`AlbumPath` = album.`AlbumPath` 
+tracksCover.`AlbumId` = album.`ID` 
 ) 
 ) 
 ) as EmbeddedCover 
@@ -6741,12 +7739,10 @@ FROM
 LEFT JOIN 
 `Albums` album 
 ON 
-tracks.`AlbumTitle` = album.`Title` AND 
-(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND 
-tracks.`AlbumPath` = album.`AlbumPath` 
+tracks.`AlbumId` = album.`ID` 
 LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` 
 LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` 
-LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` 
+LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreId` 
 WHERE 
 (tracks.`ArtistName` = :artistName OR tracks.`AlbumArtistName` = :artistName) AND 
 tracksMapping.`FileName` = tracks.`FileName` AND 
@@ -6794,13 +7790,7 @@ COUNT(DISTINCT tracksFromAlbum1.`ArtistName`)
 FROM 
 `Tracks` tracksFromAlbum1 
 WHERE 
-tracksFromAlbum1.`AlbumTitle` = album.`Title` AND 
-(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksFromAlbum1.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` 
+tracksFromAlbum1.`AlbumId` = album.`ID` 
 ) AS ArtistsCount, 
 ( 
 SELECT 
@@ -6808,13 +7798,7 @@ GROUP_CONCAT(tracksFromAlbum2.`ArtistName`)
 FROM 
 `Tracks` tracksFromAlbum2 
 WHERE 
-tracksFromAlbum2.`AlbumTitle` = album.`Title` AND 
-(tracksFromAlbum2.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksFromAlbum2.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksFromAlbum2.`AlbumPath` = album.`AlbumPath` 
+tracksFromAlbum2.`AlbumId` = album.`ID` 
 ) AS AllArtists, 
 tracks.`AlbumArtistName`, 
 tracksMapping.`FileName`, 
@@ -6831,13 +7815,7 @@ COUNT(DISTINCT tracks2.DiscNumber) <= 1
 FROM 
 `Tracks` tracks2 
 WHERE 
-tracks2.`AlbumTitle` = album.`Title` AND 
-(tracks2.`AlbumArtistName` = album.`ArtistName` OR 
-(tracks2.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL
-)
-) AND 
-tracks2.`AlbumPath` = album.`AlbumPath` 
+tracks2.`AlbumId` = album.`ID` 
 ) as `IsSingleDiscAlbum`, 
 trackGenre.`Name`, 
 trackComposer.`Name`, 
@@ -6862,13 +7840,7 @@ tracksCover.`HasEmbeddedCover` = 1 AND
 (tracksCover.`AlbumTitle` IS NULL AND 
 tracksCover.`FileName` = tracks.`FileName` ) OR 
 ( 
-tracksCover.`AlbumTitle` = album.`Title` AND 
-(tracksCover.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksCover.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksCover.`AlbumPath` = album.`AlbumPath` 
+tracksCover.`AlbumId` = album.`ID` 
 ) 
 ) 
 ) as EmbeddedCover 
@@ -6878,12 +7850,10 @@ FROM
 LEFT JOIN 
 `Albums` album 
 ON 
-tracks.`AlbumTitle` = album.`Title` AND 
-(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND 
-tracks.`AlbumPath` = album.`AlbumPath` 
+tracks.`AlbumId` = album.`ID` 
 LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` 
 LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` 
-LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` 
+LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreId` 
 WHERE 
 tracks.`Genre` = :genre AND 
 tracksMapping.`FileName` = tracks.`FileName` AND 
@@ -6931,13 +7901,7 @@ COUNT(DISTINCT tracksFromAlbum1.`ArtistName`)
 FROM 
 `Tracks` tracksFromAlbum1 
 WHERE 
-tracksFromAlbum1.`AlbumTitle` = album.`Title` AND 
-(tracksFromAlbum1.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksFromAlbum1.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksFromAlbum1.`AlbumPath` = album.`AlbumPath` 
+tracksFromAlbum1.`AlbumId` = album.`ID` 
 ) AS ArtistsCount, 
 ( 
 SELECT 
@@ -6945,13 +7909,7 @@ GROUP_CONCAT(tracksFromAlbum2.`ArtistName`)
 FROM 
 `Tracks` tracksFromAlbum2 
 WHERE 
-tracksFromAlbum2.`AlbumTitle` = album.`Title` AND 
-(tracksFromAlbum2.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksFromAlbum2.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksFromAlbum2.`AlbumPath` = album.`AlbumPath` 
+tracksFromAlbum2.`AlbumId` = album.`ID` 
 ) AS AllArtists, 
 tracks.`AlbumArtistName`, 
 tracksMapping.`FileName`, 
@@ -6968,13 +7926,7 @@ COUNT(DISTINCT tracks2.DiscNumber) <= 1
 FROM 
 `Tracks` tracks2 
 WHERE 
-tracks2.`AlbumTitle` = album.`Title` AND 
-(tracks2.`AlbumArtistName` = album.`ArtistName` OR 
-(tracks2.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL
-)
-) AND 
-tracks2.`AlbumPath` = album.`AlbumPath` 
+tracks2.`AlbumId` = album.`ID` 
 ) as `IsSingleDiscAlbum`, 
 trackGenre.`Name`, 
 trackComposer.`Name`, 
@@ -6999,13 +7951,7 @@ tracksCover.`HasEmbeddedCover` = 1 AND
 (tracksCover.`AlbumTitle` IS NULL AND 
 tracksCover.`FileName` = tracks.`FileName` ) OR 
 ( 
-tracksCover.`AlbumTitle` = album.`Title` AND 
-(tracksCover.`AlbumArtistName` = album.`ArtistName` OR 
-(tracksCover.`AlbumArtistName` IS NULL AND 
-album.`ArtistName` IS NULL 
-) 
-) AND 
-tracksCover.`AlbumPath` = album.`AlbumPath` 
+tracksCover.`AlbumId` = album.`ID` 
 ) 
 ) 
 ) as EmbeddedCover 
@@ -7015,12 +7961,10 @@ FROM
 LEFT JOIN 
 `Albums` album 
 ON 
-tracks.`AlbumTitle` = album.`Title` AND 
-(tracks.`AlbumArtistName` = album.`ArtistName` OR tracks.`AlbumArtistName` IS NULL ) AND 
-tracks.`AlbumPath` = album.`AlbumPath` 
+tracks.`AlbumId` = album.`ID` 
 LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` 
 LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` 
-LEFT JOIN `Genre` trackGenre ON trackGenre.`Name` = tracks.`Genre` 
+LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreId` 
 WHERE 
 tracks.`Genre` = :genre AND 
 (tracks.`ArtistName` = :artistName OR tracks.`AlbumArtistName` = :artistName) AND 
@@ -7254,213 +8198,465 @@ WHERE
     }
 
     {
-        const auto removeArtistQueryText =
+        // json_each needs the JSON1 extension and RETURNING needs SQLite 3.35: the ids are
+        // otherwise checked one at a time
+        d->mHasSetBasedPruning = hasSetBasedPruning();
+
+        const auto pruneArtistsQueryText = d->mHasSetBasedPruning ?
             uR"(
 DELETE FROM `Artists` 
 WHERE 
-`ID` = :artistId
+`ID` IN (SELECT candidates.`value` FROM json_each(:artistIds) candidates) AND 
+NOT EXISTS (SELECT 1 FROM `Tracks` tracks WHERE tracks.`ArtistId` = `Artists`.`ID`) AND 
+NOT EXISTS (SELECT 1 FROM `Tracks` tracks WHERE tracks.`AlbumArtistId` = `Artists`.`ID`) 
+RETURNING `ID`
+)"_s :
+            uR"(
+DELETE FROM `Artists` 
+WHERE 
+`ID` = :artistIds AND 
+NOT EXISTS (SELECT 1 FROM `Tracks` tracks WHERE tracks.`ArtistId` = `Artists`.`ID`) AND 
+NOT EXISTS (SELECT 1 FROM `Tracks` tracks WHERE tracks.`AlbumArtistId` = `Artists`.`ID`)
 )"_s;
 
-        auto result = prepareQuery(d->mRemoveArtistQuery, removeArtistQueryText);
+        const auto result = prepareQuery(d->mPruneArtistsQuery, pruneArtistsQueryText);
 
         if (!result) {
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveArtistQuery.lastQuery();
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveArtistQuery.lastError();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mPruneArtistsQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mPruneArtistsQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto removeGenreQueryText =
+        const auto pruneGenresQueryText = d->mHasSetBasedPruning ?
             uR"(
 DELETE FROM `Genre` 
 WHERE 
-`ID` = :genreId
+`ID` IN (SELECT candidates.`value` FROM json_each(:genreIds) candidates) AND 
+NOT EXISTS (SELECT 1 FROM `Tracks` tracks WHERE tracks.`GenreId` = `Genre`.`ID`) 
+RETURNING `ID`
+)"_s :
+            uR"(
+DELETE FROM `Genre` 
+WHERE 
+`ID` = :genreIds AND 
+NOT EXISTS (SELECT 1 FROM `Tracks` tracks WHERE tracks.`GenreId` = `Genre`.`ID`)
 )"_s;
 
-        auto result = prepareQuery(d->mRemoveGenreQuery, removeGenreQueryText);
+        const auto result = prepareQuery(d->mPruneGenresQuery, pruneGenresQueryText);
 
         if (!result) {
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveGenreQuery.lastQuery();
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveGenreQuery.lastError();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mPruneGenresQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mPruneGenresQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto removeComposerQueryText =
+        const auto pruneComposersQueryText = d->mHasSetBasedPruning ?
             uR"(
 DELETE FROM `Composer` 
 WHERE 
-`ID` = :composerId
+`ID` IN (SELECT candidates.`value` FROM json_each(:composerIds) candidates) AND 
+NOT EXISTS (SELECT 1 FROM `Tracks` tracks WHERE tracks.`Composer` = `Composer`.`Name`) 
+RETURNING `ID`
+)"_s :
+            uR"(
+DELETE FROM `Composer` 
+WHERE 
+`ID` = :composerIds AND 
+NOT EXISTS (SELECT 1 FROM `Tracks` tracks WHERE tracks.`Composer` = `Composer`.`Name`)
 )"_s;
 
-        auto result = prepareQuery(d->mRemoveComposerQuery, removeComposerQueryText);
+        const auto result = prepareQuery(d->mPruneComposersQuery, pruneComposersQueryText);
 
         if (!result) {
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveComposerQuery.lastQuery();
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveComposerQuery.lastError();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mPruneComposersQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mPruneComposersQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        auto removeLyricistQueryText =
+        const auto pruneLyricistsQueryText = d->mHasSetBasedPruning ?
             uR"(
 DELETE FROM `Lyricist` 
 WHERE 
-`ID` = :lyricistId
+`ID` IN (SELECT candidates.`value` FROM json_each(:lyricistIds) candidates) AND 
+NOT EXISTS (SELECT 1 FROM `Tracks` tracks WHERE tracks.`Lyricist` = `Lyricist`.`Name`) 
+RETURNING `ID`
+)"_s :
+            uR"(
+DELETE FROM `Lyricist` 
+WHERE 
+`ID` = :lyricistIds AND 
+NOT EXISTS (SELECT 1 FROM `Tracks` tracks WHERE tracks.`Lyricist` = `Lyricist`.`Name`)
 )"_s;
 
-        auto result = prepareQuery(d->mRemoveLyricistQuery, removeLyricistQueryText);
+        const auto result = prepareQuery(d->mPruneLyricistsQuery, pruneLyricistsQueryText);
 
         if (!result) {
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveLyricistQuery.lastQuery();
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveLyricistQuery.lastError();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mPruneLyricistsQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mPruneLyricistsQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        const auto artistHasTracks =
+        auto removeAlbumAggregatesQueryText =
             uR"(
-SELECT EXISTS(SELECT 1 
-FROM `Tracks` 
-INNER JOIN `Artists` artists on 
-(`ArtistName` = artists.`Name` 
-OR `AlbumArtistName` = artists.`Name`) 
-WHERE artists.`ID` = :artistId)
+DELETE FROM `AlbumAggregates` 
+WHERE 
+`AlbumId` = :albumId
 )"_s;
 
-        const auto result = prepareQuery(d->mArtistHasTracksQuery, artistHasTracks);
+        auto result = prepareQuery(d->mRemoveAlbumAggregatesQuery, removeAlbumAggregatesQueryText);
 
         if (!result) {
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mArtistHasTracksQuery.lastQuery();
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mArtistHasTracksQuery.lastError();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveAlbumAggregatesQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mRemoveAlbumAggregatesQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
     {
-        const auto genreHasTracks =
+        auto updateAlbumAggregatesQueryText =
             uR"(
-SELECT EXISTS(SELECT 1 
-FROM `Tracks` 
-INNER JOIN `Genre` genres on 
-`Genre` = genres.`Name` 
-WHERE genres.`ID` = :genreId)
+INSERT INTO `AlbumAggregates` 
+(`AlbumId`, `TracksCount`, `DiscsCount`, `HighestRating`, `Years`, 
+`ArtistsCount`, `AllArtists`, `AllGenres`, `EmbeddedCoverFileName`) 
+SELECT 
+album.`ID`, 
+COUNT(tracks.`ID`), 
+COUNT(DISTINCT tracks.`DiscNumber`), 
+MAX(tracks.`Rating`), 
+GROUP_CONCAT(tracks.`Year`, ', '), 
+COUNT(DISTINCT tracks.`ArtistName`), 
+GROUP_CONCAT(tracks.`ArtistName`, ', '), 
+GROUP_CONCAT(genres.`Name`, ', '), 
+MIN(CASE WHEN tracks.`HasEmbeddedCover` = 1 THEN tracks.`FileName` END) 
+FROM 
+`Albums` album, 
+`Tracks` tracks LEFT JOIN 
+`Genre` genres ON genres.`ID` = tracks.`GenreId` 
+WHERE 
+album.`ID` = :albumId AND 
+tracks.`AlbumId` = album.`ID` 
+GROUP BY album.`ID`
 )"_s;
 
-        const auto result = prepareQuery(d->mGenreHasTracksQuery, genreHasTracks);
+        auto result = prepareQuery(d->mUpdateAlbumAggregatesQuery, updateAlbumAggregatesQueryText);
 
         if (!result) {
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mGenreHasTracksQuery.lastQuery();
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mGenreHasTracksQuery.lastError();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mUpdateAlbumAggregatesQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mUpdateAlbumAggregatesQuery.lastError();
 
             Q_EMIT databaseError();
         }
     }
 
-    {
-        const auto composerHasTracks =
-            uR"(
-SELECT EXISTS(SELECT 1 
-FROM `Tracks` 
-INNER JOIN `Composer` composers on 
-`Composer` = composers.`Name` 
-WHERE composers.`ID` = :composerId)
-)"_s;
-
-        const auto result = prepareQuery(d->mComposerHasTracksQuery, composerHasTracks);
-
-        if (!result) {
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mComposerHasTracksQuery.lastQuery();
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mComposerHasTracksQuery.lastError();
+    d->mHasSearchIndex = d->mTracksDatabase.tables().contains(u"TracksSearch"_s);
 
-            Q_EMIT databaseError();
-        }
-    }
+    // ids of the tracks matching :searchText, from the full-text index when available
+    const auto searchedTracksText = d->mHasSearchIndex ?
+        uR"(
+SELECT search.`rowid` 
+FROM `TracksSearch` search 
+WHERE `TracksSearch` MATCH :searchText
+)"_s :
+        uR"(
+SELECT likeTracks.`ID` 
+FROM `Tracks` likeTracks 
+WHERE 
+likeTracks.`Title` LIKE :searchText OR 
+likeTracks.`ArtistName` LIKE :searchText OR 
+likeTracks.`AlbumTitle` LIKE :searchText OR 
+likeTracks.`AlbumArtistName` LIKE :searchText OR 
+likeTracks.`Genre` LIKE :searchText OR 
+likeTracks.`Composer` LIKE :searchText OR 
+likeTracks.`Lyricist` LIKE :searchText
+)"_s;
 
     {
-        const auto lyricistHasTracks =
+        auto selectTracksFromSearchText =
             uR"(
-SELECT EXISTS(SELECT 1 
-FROM `Tracks` 
-INNER JOIN `Lyricist` lyricists on 
-`Lyricist` = lyricists.`Name` 
-WHERE lyricists.`ID` = :lyricistId)
-)"_s;
-
-        const auto result = prepareQuery(d->mLyricistHasTracksQuery, lyricistHasTracks);
-
-        if (!result) {
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mLyricistHasTracksQuery.lastQuery();
-            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDatabaseVersionQueries" << d->mLyricistHasTracksQuery.lastError();
-
-            Q_EMIT databaseError();
-        }
-    }
-
-    finishTransaction();
-
-    d->mInitFinished = true;
-    Q_EMIT requestsInitDone();
-}
-
-void DatabaseInterface::initChangesTrackers()
-{
-    d->mInsertedTracks.clear();
-    d->mInsertedRadios.clear();
-    d->mInsertedAlbums.clear();
-    d->mInsertedArtists.clear();
-    d->mInsertedGenres.clear();
-    d->mInsertedComposers.clear();
-    d->mInsertedLyricists.clear();
-
-    d->mModifiedTrackIds.clear();
-    d->mModifiedRadioIds.clear();
-    d->mModifiedAlbumIds.clear();
-
-    d->mPossiblyRemovedArtistIds.clear();
-    d->mPossiblyRemovedGenreIds.clear();
-    d->mPossiblyRemovedComposerIds.clear();
-    d->mPossiblyRemovedLyricistsIds.clear();
-
-    d->mRemovedTrackIds.clear();
-    d->mRemovedRadioIds.clear();
-    d->mRemovedAlbumIds.clear();
-    d->mRemovedArtistIds.clear();
-    d->mRemovedGenreIds.clear();
-    d->mRemovedComposerIds.clear();
-    d->mRemovedLyricistIds.clear();
-}
-
-void DatabaseInterface::emitTrackerChanges()
-{
-    d->mModifiedAlbumIds.subtract(d->mRemovedAlbumIds);
-    for (const auto modifiedAlbumId : std::as_const(d->mModifiedAlbumIds)) {
-        Q_EMIT albumModified({{DataTypes::DatabaseIdRole, modifiedAlbumId}}, modifiedAlbumId);
-    }
-
-    for (const auto removedTrackId : std::as_const(d->mRemovedTrackIds)) {
-        Q_EMIT trackRemoved(removedTrackId);
-    }
-    for (const auto removedRadioId : std::as_const(d->mRemovedRadioIds)) {
-        Q_EMIT radioRemoved(removedRadioId);
-    }
-    for (const auto removedAlbumId : std::as_const(d->mRemovedAlbumIds)) {
-        Q_EMIT albumRemoved(removedAlbumId);
-    }
-    for (const auto removedArtistId : std::as_const(d->mRemovedArtistIds)) {
-        Q_EMIT artistRemoved(removedArtistId);
-    }
-    for (const auto removedGenreId : std::as_const(d->mRemovedGenreIds)) {
-        Q_EMIT genreRemoved(removedGenreId);
+SELECT 
+tracks.`ID`, 
+tracks.`Title`, 
+album.`ID`, 
+tracks.`ArtistName`, 
+( 
+SELECT 
+COUNT(DISTINCT tracksFromAlbum1.`ArtistName`) 
+FROM 
+`Tracks` tracksFromAlbum1 
+WHERE 
+tracksFromAlbum1.`AlbumId` = album.`ID` 
+) AS ArtistsCount, 
+( 
+SELECT 
+GROUP_CONCAT(tracksFromAlbum2.`ArtistName`) 
+FROM 
+`Tracks` tracksFromAlbum2 
+WHERE 
+tracksFromAlbum2.`AlbumId` = album.`ID` 
+) AS AllArtists, 
+tracks.`AlbumArtistName`, 
+tracksMapping.`FileName`, 
+tracksMapping.`FileModifiedTime`, 
+tracks.`TrackNumber`, 
+tracks.`DiscNumber`, 
+tracks.`Duration`, 
+tracks.`AlbumTitle`, 
+tracks.`Rating`, 
+album.`CoverFileName`, 
+(
+SELECT 
+COUNT(DISTINCT tracks2.DiscNumber) <= 1 
+FROM 
+`Tracks` tracks2 
+WHERE 
+tracks2.`AlbumId` = album.`ID` 
+) as `IsSingleDiscAlbum`, 
+trackGenre.`Name`, 
+trackComposer.`Name`, 
+trackLyricist.`Name`, 
+tracks.`Comment`, 
+tracks.`Year`, 
+tracks.`Channels`, 
+tracks.`BitRate`, 
+tracks.`SampleRate`, 
+tracks.`HasEmbeddedCover`, 
+tracksMapping.`ImportDate`, 
+tracksMapping.`FirstPlayDate`, 
+tracksMapping.`LastPlayDate`, 
+tracksMapping.`PlayCounter`, 
+( 
+SELECT tracksCover.`FileName` 
+FROM 
+`Tracks` tracksCover 
+WHERE 
+tracksCover.`HasEmbeddedCover` = 1 AND 
+( 
+(tracksCover.`AlbumTitle` IS NULL AND 
+tracksCover.`FileName` = tracks.`FileName` ) OR 
+( 
+tracksCover.`AlbumId` = album.`ID` 
+) 
+) 
+) as EmbeddedCover 
+FROM 
+`Tracks` tracks 
+INNER JOIN 
+`TracksData` tracksMapping 
+ON 
+tracksMapping.`FileName` = tracks.`FileName` 
+LEFT JOIN 
+`Albums` album 
+ON 
+tracks.`AlbumId` = album.`ID` 
+LEFT JOIN `Genre` trackGenre ON trackGenre.`ID` = tracks.`GenreId` 
+LEFT JOIN `Composer` trackComposer ON trackComposer.`Name` = tracks.`Composer` 
+LEFT JOIN `Lyricist` trackLyricist ON trackLyricist.`Name` = tracks.`Lyricist` 
+WHERE 
+tracks.`ID` IN (%1) AND 
+tracks.`ID` > :afterDatabaseId AND 
+tracks.`Priority` = (
+     SELECT 
+     MIN(`Priority`) 
+     FROM 
+     `Tracks` tracks2 
+     WHERE 
+     tracks.`Title` = tracks2.`Title` AND 
+     (tracks.`ArtistName` IS NULL OR tracks.`ArtistName` = tracks2.`ArtistName`) AND 
+     (tracks.`AlbumTitle` IS NULL OR tracks.`AlbumTitle` = tracks2.`AlbumTitle`) AND 
+     (tracks.`AlbumArtistName` IS NULL OR tracks.`AlbumArtistName` = tracks2.`AlbumArtistName`) AND 
+     (tracks.`AlbumPath` IS NULL OR tracks.`AlbumPath` = tracks2.`AlbumPath`)
+) 
+ORDER BY tracks.`ID` 
+LIMIT :maximumResults
+)"_s.arg(searchedTracksText);
+
+        auto result = prepareQuery(d->mSelectTracksFromSearchQuery, selectTracksFromSearchText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTracksFromSearchQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectTracksFromSearchQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectAlbumsFromSearchText =
+            uR"(
+SELECT 
+album.`ID`, 
+album.`Title`, 
+album.`ArtistName` as SecondaryText, 
+album.`CoverFileName`, 
+album.`ArtistName`, 
+aggregates.`Years` as Year, 
+aggregates.`ArtistsCount`, 
+aggregates.`AllArtists`, 
+aggregates.`HighestRating`, 
+aggregates.`AllGenres`, 
+aggregates.`DiscsCount` <= 1 as `IsSingleDiscAlbum`, 
+aggregates.`EmbeddedCoverFileName` as EmbeddedCover 
+FROM 
+`Albums` album INNER JOIN 
+`AlbumAggregates` aggregates ON aggregates.`AlbumId` = album.`ID` 
+WHERE 
+album.`ID` IN (
+  SELECT tracks.`AlbumId` 
+  FROM 
+  `Tracks` tracks 
+  WHERE 
+  tracks.`ID` IN (%1)
+) AND 
+album.`ID` > :afterDatabaseId 
+ORDER BY album.`ID` 
+LIMIT :maximumResults
+)"_s.arg(searchedTracksText);
+
+        auto result = prepareQuery(d->mSelectAlbumsFromSearchQuery, selectAlbumsFromSearchText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAlbumsFromSearchQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAlbumsFromSearchQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectArtistsFromSearchText =
+            uR"(
+SELECT artists.`ID`, 
+artists.`Name`, 
+GROUP_CONCAT(genres.`Name`, ', ') as AllGenres 
+FROM `Artists` artists  LEFT JOIN 
+`Tracks` tracks ON artists.`ID` = tracks.`ArtistId` LEFT JOIN 
+`Genre` genres ON genres.`ID` = tracks.`GenreId` 
+WHERE 
+artists.`Name` LIKE :searchText ESCAPE '\' AND 
+artists.`ID` > :afterDatabaseId 
+GROUP BY artists.`ID` 
+ORDER BY artists.`ID` 
+LIMIT :maximumResults
+)"_s;
+
+        auto result = prepareQuery(d->mSelectArtistsFromSearchQuery, selectArtistsFromSearchText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectArtistsFromSearchQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectArtistsFromSearchQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    {
+        auto selectAlbumsFromTitleAndPathText =
+            uR"(
+SELECT 
+album.`ID`, 
+album.`ArtistName`, 
+album.`CoverFileName`, 
+EXISTS (
+SELECT 
+1 
+FROM 
+`Tracks` tracks 
+WHERE 
+tracks.`AlbumId` = album.`ID` AND 
+tracks.`AlbumArtistName` IS NULL 
+) as HasTracksWithoutAlbumArtist 
+FROM 
+`Albums` album 
+WHERE 
+album.`Title` = :title AND 
+album.`AlbumPath` = :albumPath 
+ORDER BY album.`ArtistName`
+)"_s;
+
+        auto result = prepareQuery(d->mSelectAlbumsFromTitleAndPathQuery, selectAlbumsFromTitleAndPathText);
+
+        if (!result) {
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAlbumsFromTitleAndPathQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::initDataQueries" << d->mSelectAlbumsFromTitleAndPathQuery.lastError();
+
+            Q_EMIT databaseError();
+        }
+    }
+
+    finishTransaction();
+
+    d->mInitFinished = true;
+    Q_EMIT requestsInitDone();
+}
+
+void DatabaseInterface::initChangesTrackers()
+{
+    d->mInsertedTracks.clear();
+    d->mInsertedRadios.clear();
+    d->mInsertedAlbums.clear();
+    d->mInsertedArtists.clear();
+    d->mInsertedGenres.clear();
+    d->mInsertedComposers.clear();
+    d->mInsertedLyricists.clear();
+
+    d->mModifiedTrackIds.clear();
+    d->mModifiedRadioIds.clear();
+    d->mModifiedAlbumIds.clear();
+
+    d->mPossiblyRemovedArtistIds.clear();
+    d->mPossiblyRemovedGenreIds.clear();
+    d->mPossiblyRemovedComposerIds.clear();
+    d->mPossiblyRemovedLyricistsIds.clear();
+
+    d->mRemovedTrackIds.clear();
+    d->mRemovedRadioIds.clear();
+    d->mRemovedAlbumIds.clear();
+    d->mRemovedArtistIds.clear();
+    d->mRemovedGenreIds.clear();
+    d->mRemovedComposerIds.clear();
+    d->mRemovedLyricistIds.clear();
+
+    d->mAlbumsWithStaleAggregates.clear();
+}
+
+void DatabaseInterface::emitTrackerChanges()
+{
+    if (!d->mChangesNotificationEnabled) {
+        return;
+    }
+
+    d->mModifiedAlbumIds.subtract(d->mRemovedAlbumIds);
+    for (const auto modifiedAlbumId : std::as_const(d->mModifiedAlbumIds)) {
+        Q_EMIT albumModified({{DataTypes::DatabaseIdRole, modifiedAlbumId}}, modifiedAlbumId);
+    }
+
+    for (const auto removedTrackId : std::as_const(d->mRemovedTrackIds)) {
+        Q_EMIT trackRemoved(removedTrackId);
+    }
+    for (const auto removedRadioId : std::as_const(d->mRemovedRadioIds)) {
+        Q_EMIT radioRemoved(removedRadioId);
+    }
+    for (const auto removedAlbumId : std::as_const(d->mRemovedAlbumIds)) {
+        Q_EMIT albumRemoved(removedAlbumId);
+    }
+    for (const auto removedArtistId : std::as_const(d->mRemovedArtistIds)) {
+        Q_EMIT artistRemoved(removedArtistId);
+    }
+    for (const auto removedGenreId : std::as_const(d->mRemovedGenreIds)) {
+        Q_EMIT genreRemoved(removedGenreId);
     }
     for (const auto removedComposerId : std::as_const(d->mRemovedComposerIds)) {
         Q_EMIT composerRemoved(removedComposerId);
@@ -7470,84 +8666,540 @@ void DatabaseInterface::emitTrackerChanges()
     }
 }
 
-void DatabaseInterface::recordModifiedTrack(qulonglong trackId)
-{
-    d->mModifiedTrackIds.insert(trackId);
-}
+void DatabaseInterface::recordModifiedTrack(qulonglong trackId)
+{
+    d->mModifiedTrackIds.insert(trackId);
+}
+
+void DatabaseInterface::recordModifiedAlbum(qulonglong albumId)
+{
+    d->mModifiedAlbumIds.insert(albumId);
+}
+
+void DatabaseInterface::updateAlbumAggregates()
+{
+    for (const auto albumId : std::as_const(d->mAlbumsWithStaleAggregates)) {
+        d->mRemoveAlbumAggregatesQuery.bindValue(QStringLiteral(":albumId"), albumId);
+
+        auto result = execQuery(d->mRemoveAlbumAggregatesQuery);
+
+        if (!result || !d->mRemoveAlbumAggregatesQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumAggregates" << d->mRemoveAlbumAggregatesQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumAggregates" << d->mRemoveAlbumAggregatesQuery.boundValues();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumAggregates" << d->mRemoveAlbumAggregatesQuery.lastError();
+        }
+
+        d->mRemoveAlbumAggregatesQuery.finish();
+
+        // albums without tracks get no row at all and are not listed
+        d->mUpdateAlbumAggregatesQuery.bindValue(QStringLiteral(":albumId"), albumId);
+
+        result = execQuery(d->mUpdateAlbumAggregatesQuery);
+
+        if (!result || !d->mUpdateAlbumAggregatesQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumAggregates" << d->mUpdateAlbumAggregatesQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumAggregates" << d->mUpdateAlbumAggregatesQuery.boundValues();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::updateAlbumAggregates" << d->mUpdateAlbumAggregatesQuery.lastError();
+        }
+
+        d->mUpdateAlbumAggregatesQuery.finish();
+    }
+
+    d->mAlbumsWithStaleAggregates.clear();
+}
+
+void DatabaseInterface::internalInsertOneTrack(const DataTypes::TrackDataType &oneTrack)
+{
+    d->mSelectTracksMapping.bindValue(QStringLiteral(":fileName"), oneTrack.resourceURI());
+
+    auto result = execQuery(d->mSelectTracksMapping);
+
+    if (!result || !d->mSelectTracksMapping.isSelect() || !d->mSelectTracksMapping.isActive()) {
+        Q_EMIT databaseError();
+
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::insertTracksList" << d->mSelectTracksMapping.lastQuery();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::insertTracksList" << d->mSelectTracksMapping.boundValues();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::insertTracksList" << d->mSelectTracksMapping.lastError();
+
+        d->mSelectTracksMapping.finish();
+
+        rollBackTransaction();
+        return;
+    }
+
+    bool isNewTrack = !d->mSelectTracksMapping.next();
+
+    if (isNewTrack) {
+        insertTrackOrigin(oneTrack.resourceURI(), oneTrack.fileModificationTime(),
+                          QDateTime::currentDateTime());
+    } else if (!d->mSelectTracksMapping.record().value(0).isNull() && d->mSelectTracksMapping.record().value(0).toULongLong() != 0) {
+        updateTrackOrigin(oneTrack.resourceURI(), oneTrack.fileModificationTime());
+    }
+
+    d->mSelectTracksMapping.finish();
+
+    bool isInserted = false;
+
+    const auto insertedTrackId = internalInsertTrack(oneTrack, isInserted);
+
+    if (isInserted && insertedTrackId != 0) {
+        d->mInsertedTracks.insert(insertedTrackId);
+    }
+}
+
+void DatabaseInterface::internalInsertOneRadio(const DataTypes::TrackDataType &oneTrack)
+{
+    QSqlQuery &query = oneTrack.hasDatabaseId() ? d->mUpdateRadioQuery : d->mInsertRadioQuery;
+
+    query.bindValue(QStringLiteral(":httpAddress"), oneTrack.resourceURI());
+    query.bindValue(QStringLiteral(":radioId"), oneTrack.databaseId());
+    query.bindValue(QStringLiteral(":title"), oneTrack.title());
+    query.bindValue(QStringLiteral(":comment"), oneTrack.comment());
+    query.bindValue(QStringLiteral(":trackRating"), oneTrack.rating());
+    query.bindValue(QStringLiteral(":imageAddress"), oneTrack.albumCover());
+
+    auto result = execQuery(query);
+
+    if (!result || !query.isActive()) {
+        Q_EMIT databaseError();
+
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalInsertOneRadio" << query.lastQuery();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalInsertOneRadio" << query.boundValues();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalInsertOneRadio" << query.lastError();
+    } else {
+        if (!oneTrack.hasDatabaseId()) {
+            d->mInsertedRadios.insert(internalRadioIdFromHttpAddress(oneTrack.resourceURI().toString()));
+        } else {
+            d->mModifiedRadioIds.insert(oneTrack.databaseId());
+        }
+    }
+
+    query.finish();
+}
+
+namespace {
+
+struct BulkImportAlbum
+{
+    qulonglong mId = 0;
+
+    QString mArtistName;
+
+    QUrl mCoverFileName;
+
+    bool mHasTracksWithoutAlbumArtist = false;
+
+    bool mIsNew = false;
+};
+
+struct BulkImportTrackIdentity
+{
+    int mPriority = 1;
+
+    QString mArtistName;
+
+    QString mAlbumTitle;
+
+    QString mAlbumArtistName;
+
+    QString mAlbumPath;
+
+    std::optional<int> mTrackNumber;
+
+    std::optional<int> mDiscNumber;
+};
+
+// same rule as the duplicate track query: a NULL column matches any value
+bool matchesNullableColumn(const QString &storedValue, const QString &value)
+{
+    return storedValue.isNull() || (!value.isNull() && storedValue == value);
+}
+
+}
+
+std::optional<DataTypes::ListTrackDataType> DatabaseInterface::internalBulkInsertTracks(const DataTypes::ListTrackDataType &tracks)
+{
+    auto remainingTracks = DataTypes::ListTrackDataType{};
+
+    QUrl::FormattingOptions currentOptions = QUrl::PreferLocalFile |
+            QUrl::RemoveAuthority | QUrl::RemoveFilename | QUrl::RemoveFragment |
+            QUrl::RemovePassword | QUrl::RemovePort | QUrl::RemoveQuery |
+            QUrl::RemoveScheme | QUrl::RemoveUserInfo;
+
+    auto knownFiles = QSet<QUrl>{};
+
+    {
+        auto batchFiles = QList<QUrl>{};
+        for (const auto &oneTrack : tracks) {
+            if (oneTrack.elementType() == ElisaUtils::Track) {
+                batchFiles.push_back(oneTrack.resourceURI());
+            }
+        }
+
+        constexpr qsizetype maximumFilesCount = 500;
+
+        for (qsizetype firstFile = 0; firstFile < batchFiles.size(); firstFile += maximumFilesCount) {
+            const auto filesCount = std::min(maximumFilesCount, batchFiles.size() - firstFile);
+
+            QSqlQuery selectKnownFilesQuery(d->mTracksDatabase);
+
+            const auto selectKnownFilesText =
+                uR"(
+SELECT 
+tracksData.`FileName` 
+FROM 
+`TracksData` tracksData 
+WHERE 
+tracksData.`FileName` IN (%1)
+)"_s.arg(QStringList(filesCount, QStringLiteral("?")).join(QStringLiteral(", ")));
+
+            auto result = prepareQuery(selectKnownFilesQuery, selectKnownFilesText);
+
+            if (result) {
+                for (qsizetype fileIndex = firstFile; fileIndex < firstFile + filesCount; ++fileIndex) {
+                    selectKnownFilesQuery.addBindValue(batchFiles.at(fileIndex));
+                }
+
+                result = execQuery(selectKnownFilesQuery);
+            }
+
+            if (!result || !selectKnownFilesQuery.isSelect() || !selectKnownFilesQuery.isActive()) {
+                Q_EMIT databaseError();
+
+                qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalBulkInsertTracks" << selectKnownFilesQuery.lastQuery();
+                qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalBulkInsertTracks" << selectKnownFilesQuery.boundValues();
+                qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalBulkInsertTracks" << selectKnownFilesQuery.lastError();
+
+                selectKnownFilesQuery.finish();
+
+                // without knowing which files are new, everything goes through the track by track path
+                return tracks;
+            }
+
+            while (selectKnownFilesQuery.next()) {
+                knownFiles.insert(selectKnownFilesQuery.record().value(0).toUrl());
+            }
+
+            selectKnownFilesQuery.finish();
+        }
+    }
+
+    auto artistIds = QHash<QString, qulonglong>{};
+    auto genreIds = QHash<QString, qulonglong>{};
+    auto composerIds = QHash<QString, qulonglong>{};
+    auto lyricistIds = QHash<QString, qulonglong>{};
+
+    auto newArtists = QVariantList{};
+    auto newGenres = QVariantList{};
+    auto newComposers = QVariantList{};
+    auto newLyricists = QVariantList{};
+
+    const auto bulkNameId = [this](QHash<QString, qulonglong> &knownNames, QVariantList &newRows, qulonglong &nextId,
+                                   QSet<qulonglong> &insertedIds, qulonglong (DatabaseInterface::*idFromName)(const QString &),
+                                   const QString &name) {
+        if (name.isEmpty()) {
+            return false;
+        }
+
+        if (knownNames.contains(name)) {
+            return true;
+        }
+
+        auto nameId = (this->*idFromName)(name);
+
+        if (nameId == 0) {
+            nameId = nextId++;
+            newRows << nameId << name;
+            insertedIds.insert(nameId);
+        }
+
+        knownNames.insert(name, nameId);
+
+        return true;
+    };
+
+    using AlbumKey = std::pair<QString, QString>;
+
+    auto albums = QHash<AlbumKey, QList<BulkImportAlbum>>{};
+    auto albumsWithTrackByTrackPath = QSet<AlbumKey>{};
+
+    const auto albumCandidates = [this, &albums](const AlbumKey &albumKey) -> QList<BulkImportAlbum> & {
+        auto itAlbums = albums.find(albumKey);
+
+        if (itAlbums != albums.end()) {
+            return itAlbums.value();
+        }
+
+        auto &candidates = albums[albumKey];
+
+        d->mSelectAlbumsFromTitleAndPathQuery.bindValue(QStringLiteral(":title"), albumKey.first);
+        d->mSelectAlbumsFromTitleAndPathQuery.bindValue(QStringLiteral(":albumPath"), albumKey.second);
+
+        auto queryResult = execQuery(d->mSelectAlbumsFromTitleAndPathQuery);
+
+        if (!queryResult || !d->mSelectAlbumsFromTitleAndPathQuery.isSelect() || !d->mSelectAlbumsFromTitleAndPathQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalBulkInsertTracks" << d->mSelectAlbumsFromTitleAndPathQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalBulkInsertTracks" << d->mSelectAlbumsFromTitleAndPathQuery.boundValues();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalBulkInsertTracks" << d->mSelectAlbumsFromTitleAndPathQuery.lastError();
+
+            d->mSelectAlbumsFromTitleAndPathQuery.finish();
+
+            return candidates;
+        }
+
+        while (d->mSelectAlbumsFromTitleAndPathQuery.next()) {
+            const auto &currentRecord = d->mSelectAlbumsFromTitleAndPathQuery.record();
+
+            candidates.push_back({currentRecord.value(0).toULongLong(), currentRecord.value(1).toString(),
+                                  currentRecord.value(2).toUrl(), currentRecord.value(3).toBool(), false});
+        }
+
+        d->mSelectAlbumsFromTitleAndPathQuery.finish();
+
+        return candidates;
+    };
+
+    auto newTrackIdentities = QHash<QString, QList<BulkImportTrackIdentity>>{};
+
+    auto newTracksData = QVariantList{};
+    auto newTracks = QVariantList{};
+
+    const auto importDate = QDateTime::currentDateTime().toMSecsSinceEpoch();
+
+    for (const auto &oneTrack : tracks) {
+        if (oneTrack.elementType() != ElisaUtils::Track || !oneTrack.isValid() || knownFiles.contains(oneTrack.resourceURI())) {
+            remainingTracks.push_back(oneTrack);
+            continue;
+        }
+
+        const auto &trackPath = oneTrack.resourceURI().toString(currentOptions);
+        const auto trackTitle = !oneTrack.title().isEmpty() ? oneTrack.title() : oneTrack.resourceURI().fileName();
+        const auto albumCover = oneTrack.hasEmbeddedCover() ? QUrl{} : oneTrack.albumCover();
+        const auto albumArtist = oneTrack.hasAlbumArtist() ? oneTrack.albumArtist() : QString();
+        const auto albumKey = AlbumKey{oneTrack.album(), trackPath};
 
-void DatabaseInterface::recordModifiedAlbum(qulonglong albumId)
-{
-    d->mModifiedAlbumIds.insert(albumId);
-}
+        auto albumId = qulonglong{0};
 
-void DatabaseInterface::internalInsertOneTrack(const DataTypes::TrackDataType &oneTrack)
-{
-    d->mSelectTracksMapping.bindValue(QStringLiteral(":fileName"), oneTrack.resourceURI());
+        if (!oneTrack.album().isEmpty()) {
+            if (albumsWithTrackByTrackPath.contains(albumKey)) {
+                remainingTracks.push_back(oneTrack);
+                continue;
+            }
 
-    auto result = execQuery(d->mSelectTracksMapping);
+            auto &candidates = albumCandidates(albumKey);
 
-    if (!result || !d->mSelectTracksMapping.isSelect() || !d->mSelectTracksMapping.isActive()) {
-        Q_EMIT databaseError();
+            auto itAlbum = std::find_if(candidates.begin(), candidates.end(), [&albumArtist](const auto &oneAlbum) {
+                return albumArtist.isEmpty() || oneAlbum.mArtistName.isEmpty() || oneAlbum.mArtistName == albumArtist;
+            });
 
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::insertTracksList" << d->mSelectTracksMapping.lastQuery();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::insertTracksList" << d->mSelectTracksMapping.boundValues();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::insertTracksList" << d->mSelectTracksMapping.lastError();
+            if (itAlbum != candidates.end()) {
+                const auto needsAlbumArtistUpdate = !albumArtist.isEmpty() &&
+                        (itAlbum->mArtistName.isEmpty() || itAlbum->mHasTracksWithoutAlbumArtist);
+                const auto needsCoverUpdate = albumCover.isValid() && albumCover != itAlbum->mCoverFileName;
 
-        d->mSelectTracksMapping.finish();
+                // modifying an album already in the database also modifies its tracks
+                if (needsAlbumArtistUpdate || (needsCoverUpdate && !itAlbum->mIsNew)) {
+                    albumsWithTrackByTrackPath.insert(albumKey);
+                    remainingTracks.push_back(oneTrack);
+                    continue;
+                }
 
-        rollBackTransaction();
-        Q_EMIT finishInsertingTracksList();
-        return;
-    }
+                if (needsCoverUpdate) {
+                    itAlbum->mCoverFileName = albumCover;
+                }
 
-    bool isNewTrack = !d->mSelectTracksMapping.next();
+                if (albumArtist.isEmpty()) {
+                    itAlbum->mHasTracksWithoutAlbumArtist = true;
+                }
 
-    if (isNewTrack) {
-        insertTrackOrigin(oneTrack.resourceURI(), oneTrack.fileModificationTime(),
-                          QDateTime::currentDateTime());
-    } else if (!d->mSelectTracksMapping.record().value(0).isNull() && d->mSelectTracksMapping.record().value(0).toULongLong() != 0) {
-        updateTrackOrigin(oneTrack.resourceURI(), oneTrack.fileModificationTime());
-    }
+                albumId = itAlbum->mId;
 
-    d->mSelectTracksMapping.finish();
+                if (!itAlbum->mIsNew) {
+                    recordModifiedAlbum(albumId);
+                }
+            } else {
+                albumId = d->mAlbumId++;
 
-    bool isInserted = false;
+                candidates.push_back({albumId, albumArtist, albumCover, albumArtist.isEmpty(), true});
 
-    const auto insertedTrackId = internalInsertTrack(oneTrack, isInserted);
+                bulkNameId(artistIds, newArtists, d->mArtistId, d->mInsertedArtists,
+                           &DatabaseInterface::internalArtistIdFromName, albumArtist);
 
-    if (isInserted && insertedTrackId != 0) {
-        d->mInsertedTracks.insert(insertedTrackId);
+                d->mInsertedAlbums.insert(albumId);
+            }
+
+            d->mAlbumsWithStaleAggregates.insert(albumId);
+        }
+
+        const auto hasArtist = bulkNameId(artistIds, newArtists, d->mArtistId, d->mInsertedArtists,
+                                          &DatabaseInterface::internalArtistIdFromName, oneTrack.artist());
+        const auto hasGenre = bulkNameId(genreIds, newGenres, d->mGenreId, d->mInsertedGenres,
+                                         &DatabaseInterface::internalGenreIdFromName, oneTrack.genre());
+        const auto hasComposer = bulkNameId(composerIds, newComposers, d->mComposerId, d->mInsertedComposers,
+                                            &DatabaseInterface::internalComposerIdFromName, oneTrack.composer());
+        const auto hasLyricist = bulkNameId(lyricistIds, newLyricists, d->mLyricistId, d->mInsertedLyricists,
+                                            &DatabaseInterface::internalLyricistIdFromName, oneTrack.lyricist());
+
+        auto albumArtistId = qulonglong{0};
+        if (!albumArtist.isEmpty()) {
+            albumArtistId = artistIds.value(albumArtist);
+
+            if (albumArtistId == 0) {
+                albumArtistId = internalArtistIdFromName(albumArtist);
+
+                if (albumArtistId != 0) {
+                    artistIds.insert(albumArtist, albumArtistId);
+                }
+            }
+        }
+
+        auto &sameTitleTracks = newTrackIdentities[trackTitle];
+
+        const auto hasNewDuplicate = [&sameTitleTracks, &oneTrack, &trackPath](int priority) {
+            return std::any_of(sameTitleTracks.cbegin(), sameTitleTracks.cend(), [&oneTrack, &trackPath, priority](const auto &oneIdentity) {
+                return oneIdentity.mPriority == priority &&
+                        matchesNullableColumn(oneIdentity.mArtistName, oneTrack.artist()) &&
+                        matchesNullableColumn(oneIdentity.mAlbumTitle, oneTrack.album()) &&
+                        matchesNullableColumn(oneIdentity.mAlbumArtistName, oneTrack.albumArtist()) &&
+                        matchesNullableColumn(oneIdentity.mAlbumPath, trackPath) &&
+                        (!oneIdentity.mTrackNumber || *oneIdentity.mTrackNumber == oneTrack.trackNumber()) &&
+                        (!oneIdentity.mDiscNumber || *oneIdentity.mDiscNumber == oneTrack.discNumber());
+            });
+        };
+
+        int priority = 1;
+        while (hasNewDuplicate(priority) ||
+               getDuplicateTrackIdFromTitleAlbumTrackDiscNumber(trackTitle, oneTrack.artist(), oneTrack.album(), oneTrack.albumArtist(),
+                                                                trackPath, oneTrack.trackNumber(), oneTrack.discNumber(), priority) != 0) {
+            ++priority;
+        }
+
+        sameTitleTracks.push_back({priority,
+                                   hasArtist ? oneTrack.artist() : QString(),
+                                   oneTrack.hasAlbum() ? oneTrack.album() : QString(),
+                                   oneTrack.hasAlbumArtist() ? oneTrack.albumArtist() : QString(),
+                                   trackPath,
+                                   oneTrack.hasTrackNumber() ? std::optional<int>(oneTrack.trackNumber()) : std::nullopt,
+                                   oneTrack.hasDiscNumber() ? std::optional<int>(oneTrack.discNumber()) : std::nullopt});
+
+        const auto trackId = d->mTrackId++;
+
+        newTracksData << oneTrack.resourceURI() << oneTrack.fileModificationTime() << importDate << 0;
+
+        newTracks << trackId
+                  << oneTrack.resourceURI()
+                  << priority
+                  << trackTitle
+                  << (hasArtist ? oneTrack.artist() : QVariant{})
+                  << (oneTrack.hasAlbum() ? oneTrack.album() : QVariant{})
+                  << (oneTrack.hasAlbumArtist() ? oneTrack.albumArtist() : QVariant{})
+                  << trackPath
+                  << (hasGenre ? oneTrack.genre() : QVariant{})
+                  << (hasComposer ? oneTrack.composer() : QVariant{})
+                  << (hasLyricist ? oneTrack.lyricist() : QVariant{})
+                  << (oneTrack.hasComment() ? oneTrack.comment() : QVariant{})
+                  << (oneTrack.hasTrackNumber() ? oneTrack.trackNumber() : QVariant{})
+                  << (oneTrack.hasDiscNumber() ? oneTrack.discNumber() : QVariant{})
+                  << (oneTrack.hasChannels() ? oneTrack.channels() : QVariant{})
+                  << (oneTrack.hasBitRate() ? oneTrack.bitRate() : QVariant{})
+                  << (oneTrack.hasSampleRate() ? oneTrack.sampleRate() : QVariant{})
+                  << (oneTrack.hasYear() ? oneTrack.year() : QVariant{})
+                  << QVariant::fromValue<qlonglong>(oneTrack.duration().msecsSinceStartOfDay())
+                  << oneTrack.rating()
+                  << oneTrack.hasEmbeddedCover()
+                  << (albumId != 0 ? albumId : QVariant{})
+                  << (hasArtist ? artistIds.value(oneTrack.artist()) : QVariant{})
+                  << (albumArtistId != 0 ? albumArtistId : QVariant{})
+                  << (hasGenre ? genreIds.value(oneTrack.genre()) : QVariant{});
+
+        knownFiles.insert(oneTrack.resourceURI());
+
+        d->mInsertedTracks.insert(trackId);
+    }
+
+    auto newAlbums = QVariantList{};
+    for (auto itAlbums = albums.cbegin(); itAlbums != albums.cend(); ++itAlbums) {
+        for (const auto &oneAlbum : itAlbums.value()) {
+            if (oneAlbum.mIsNew) {
+                newAlbums << oneAlbum.mId
+                          << itAlbums.key().first
+                          << (oneAlbum.mArtistName.isEmpty() ? QVariant{} : QVariant{oneAlbum.mArtistName})
+                          << itAlbums.key().second
+                          << oneAlbum.mCoverFileName;
+            }
+        }
+    }
+
+    // parents first to satisfy the foreign keys of the tracks
+    const auto insertResult =
+        execMultiRowInsert(u"INSERT INTO `Artists` (`ID`, `Name`) VALUES "_s, 2, newArtists) &&
+        execMultiRowInsert(u"INSERT INTO `Genre` (`ID`, `Name`) VALUES "_s, 2, newGenres) &&
+        execMultiRowInsert(u"INSERT INTO `Composer` (`ID`, `Name`) VALUES "_s, 2, newComposers) &&
+        execMultiRowInsert(u"INSERT INTO `Lyricist` (`ID`, `Name`) VALUES "_s, 2, newLyricists) &&
+        execMultiRowInsert(u"INSERT INTO `Albums` (`ID`, `Title`, `ArtistName`, `AlbumPath`, `CoverFileName`) VALUES "_s, 5, newAlbums) &&
+        execMultiRowInsert(u"INSERT INTO `TracksData` (`FileName`, `FileModifiedTime`, `ImportDate`, `PlayCounter`) VALUES "_s, 4, newTracksData) &&
+        execMultiRowInsert(uR"(
+INSERT INTO `Tracks` 
+(`ID`, `FileName`, `Priority`, `Title`, `ArtistName`, `AlbumTitle`, `AlbumArtistName`, `AlbumPath`, 
+`Genre`, `Composer`, `Lyricist`, `Comment`, `TrackNumber`, `DiscNumber`, `Channels`, `BitRate`, 
+`SampleRate`, `Year`, `Duration`, `Rating`, `HasEmbeddedCover`, `AlbumId`, `ArtistId`, `AlbumArtistId`, `GenreId`) 
+VALUES 
+)"_s, 25, newTracks);
+
+    if (!insertResult) {
+        d->mAlbumsWithStaleAggregates.clear();
+
+        return std::nullopt;
     }
+
+    return remainingTracks;
 }
 
-void DatabaseInterface::internalInsertOneRadio(const DataTypes::TrackDataType &oneTrack)
+bool DatabaseInterface::execMultiRowInsert(const QString &insertQueryText, int columnsCount, const QVariantList &values)
 {
-    QSqlQuery &query = oneTrack.hasDatabaseId() ? d->mUpdateRadioQuery : d->mInsertRadioQuery;
+    // stay below the default SQLITE_MAX_VARIABLE_NUMBER of SQLite before 3.32
+    const auto maximumRowsCount = std::max(1, 999 / columnsCount);
+    const auto rowText = u"(%1)"_s.arg(QStringList(columnsCount, QStringLiteral("?")).join(QStringLiteral(", ")));
+    const auto rowsCount = values.size() / columnsCount;
 
-    query.bindValue(QStringLiteral(":httpAddress"), oneTrack.resourceURI());
-    query.bindValue(QStringLiteral(":radioId"), oneTrack.databaseId());
-    query.bindValue(QStringLiteral(":title"), oneTrack.title());
-    query.bindValue(QStringLiteral(":comment"), oneTrack.comment());
-    query.bindValue(QStringLiteral(":trackRating"), oneTrack.rating());
-    query.bindValue(QStringLiteral(":imageAddress"), oneTrack.albumCover());
+    for (qsizetype firstRow = 0; firstRow < rowsCount; firstRow += maximumRowsCount) {
+        const auto currentRowsCount = std::min<qsizetype>(maximumRowsCount, rowsCount - firstRow);
 
-    auto result = execQuery(query);
+        QSqlQuery insertQuery(d->mTracksDatabase);
 
-    if (!result || !query.isActive()) {
-        Q_EMIT databaseError();
+        auto result = prepareQuery(insertQuery, insertQueryText + QStringList(currentRowsCount, rowText).join(QStringLiteral(", ")));
 
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalInsertOneRadio" << query.lastQuery();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalInsertOneRadio" << query.boundValues();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalInsertOneRadio" << query.lastError();
-    } else {
-        if (!oneTrack.hasDatabaseId()) {
-            d->mInsertedRadios.insert(internalRadioIdFromHttpAddress(oneTrack.resourceURI().toString()));
-        } else {
-            d->mModifiedRadioIds.insert(oneTrack.databaseId());
+        if (result) {
+            const auto firstValue = firstRow * columnsCount;
+            for (qsizetype valueIndex = firstValue; valueIndex < firstValue + currentRowsCount * columnsCount; ++valueIndex) {
+                insertQuery.addBindValue(values.at(valueIndex));
+            }
+
+            result = execQuery(insertQuery);
+        }
+
+        if (!result || !insertQuery.isActive()) {
+            Q_EMIT databaseError();
+
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::execMultiRowInsert" << insertQuery.lastQuery();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::execMultiRowInsert" << insertQuery.boundValues();
+            qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::execMultiRowInsert" << insertQuery.lastError();
+
+            insertQuery.finish();
+
+            return false;
         }
+
+        insertQuery.finish();
     }
 
-    query.finish();
+    return true;
 }
 
 qulonglong DatabaseInterface::insertAlbum(const QString &title, const QString &albumArtist,
@@ -7584,7 +9236,7 @@ qulonglong DatabaseInterface::insertAlbum(const QString &title, const QString &a
 
         if (!albumArtist.isEmpty()) {
             const auto similarAlbum = internalOneAlbumPartialData(result);
-            updateAlbumArtist(result, title, trackPath, albumArtist);
+            updateAlbumArtist(result, albumArtist);
             if (updateAlbumCover(result, albumArtURI)) {
                 recordModifiedAlbum(result);
             }
@@ -7639,7 +9291,7 @@ bool DatabaseInterface::updateAlbumFromId(qulonglong albumId, const QUrl &albumA
     modifiedAlbum = updateAlbumCover(albumId, albumArtUri);
 
     if (!isValidArtist(albumId) && currentTrack.hasAlbum() && (currentTrack.hasAlbumArtist() || currentTrack.hasArtist())) {
-        updateAlbumArtist(albumId, currentTrack.album(), albumPath, currentTrack.albumArtist());
+        updateAlbumArtist(albumId, currentTrack.albumArtist());
 
         modifiedAlbum = true;
     }
@@ -7890,7 +9542,13 @@ qulonglong DatabaseInterface::internalInsertTrack(const DataTypes::TrackDataType
 
         auto newTrack = oneTrack;
         newTrack[DataTypes::ColumnsRoles::DatabaseIdRole] = resultId;
-        updateTrackInDatabase(newTrack, trackPath);
+        updateTrackInDatabase(newTrack, trackPath, albumId);
+        if (albumId != 0) {
+            d->mAlbumsWithStaleAggregates.insert(albumId);
+        }
+        if (oldAlbumId != 0) {
+            d->mAlbumsWithStaleAggregates.insert(oldAlbumId);
+        }
         updateTrackOrigin(oneTrack.resourceURI(), oneTrack.fileModificationTime());
         auto albumIsModified = updateAlbumFromId(albumId, albumCover, oneTrack, trackPath);
 
@@ -7985,12 +9643,19 @@ qulonglong DatabaseInterface::internalInsertTrack(const DataTypes::TrackDataType
 
     d->mInsertTrackQuery.bindValue(QStringLiteral(":hasEmbeddedCover"), oneTrack.hasEmbeddedCover());
 
+    d->mInsertTrackQuery.bindValue(QStringLiteral(":albumId"), albumId != 0 ? albumId : QVariant{});
+
+    const auto albumArtistId = oneTrack.hasAlbumArtist() ? internalArtistIdFromName(oneTrack.albumArtist()) : 0;
+    d->mInsertTrackQuery.bindValue(QStringLiteral(":albumArtistId"), albumArtistId != 0 ? albumArtistId : QVariant{});
+
     // TODO: port Artist, Composer, Genre, Lyricist to use association tables
-    const auto oneArtist = insertArtist(oneTrack.artist()) != 0 ? oneTrack.artist() : QVariant{};
-    d->mInsertTrackQuery.bindValue(QStringLiteral(":artistName"), oneArtist);
+    const auto artistId = insertArtist(oneTrack.artist());
+    d->mInsertTrackQuery.bindValue(QStringLiteral(":artistName"), artistId != 0 ? oneTrack.artist() : QVariant{});
+    d->mInsertTrackQuery.bindValue(QStringLiteral(":artistId"), artistId != 0 ? artistId : QVariant{});
 
-    const auto oneGenre = insertGenre(oneTrack.genre()) != 0 ? oneTrack.genre() : QVariant{};
-    d->mInsertTrackQuery.bindValue(QStringLiteral(":genre"), oneGenre);
+    const auto genreId = insertGenre(oneTrack.genre());
+    d->mInsertTrackQuery.bindValue(QStringLiteral(":genre"), genreId != 0 ? oneTrack.genre() : QVariant{});
+    d->mInsertTrackQuery.bindValue(QStringLiteral(":genreId"), genreId != 0 ? genreId : QVariant{});
 
     const auto oneComposer = insertComposer(oneTrack.composer()) != 0 ? oneTrack.composer() : QVariant{};
     d->mInsertTrackQuery.bindValue(QStringLiteral(":composer"), oneComposer);
@@ -8020,6 +9685,7 @@ qulonglong DatabaseInterface::internalInsertTrack(const DataTypes::TrackDataType
     updateTrackOrigin(oneTrack.resourceURI(), oneTrack.fileModificationTime());
 
     if (albumId != 0) {
+        d->mAlbumsWithStaleAggregates.insert(albumId);
         if (updateAlbumFromId(albumId, albumCover, oneTrack, trackPath)) {
             const auto modifiedTracks = fetchTrackIds(albumId);
             for (auto oneModifiedTrack : modifiedTracks) {
@@ -8044,19 +9710,19 @@ DataTypes::TrackDataType DatabaseInterface::buildTrackDataFromDatabaseRecord(con
     result[DataTypes::TrackDataType::key_type::DatabaseIdRole] = trackRecord.value(DatabaseInterfacePrivate::TrackId);
     result[DataTypes::TrackDataType::key_type::TitleRole] = trackRecord.value(DatabaseInterfacePrivate::TrackTitle);
     if (!trackRecord.value(DatabaseInterfacePrivate::TrackAlbumTitle).isNull()) {
-        result[DataTypes::TrackDataType::key_type::AlbumRole] = trackRecord.value(DatabaseInterfacePrivate::TrackAlbumTitle);
+        result[DataTypes::TrackDataType::key_type::AlbumRole] = StringPool::intern(trackRecord.value(DatabaseInterfacePrivate::TrackAlbumTitle).toString());
         result[DataTypes::TrackDataType::key_type::AlbumIdRole] = trackRecord.value(DatabaseInterfacePrivate::TrackAlbumId);
     }
 
     if (!trackRecord.value(DatabaseInterfacePrivate::TrackAlbumArtistName).isNull()) {
         result[DataTypes::TrackDataType::key_type::IsValidAlbumArtistRole] = true;
-        result[DataTypes::TrackDataType::key_type::AlbumArtistRole] = trackRecord.value(DatabaseInterfacePrivate::TrackAlbumArtistName);
+        result[DataTypes::TrackDataType::key_type::AlbumArtistRole] = StringPool::intern(trackRecord.value(DatabaseInterfacePrivate::TrackAlbumArtistName).toString());
     } else {
         result[DataTypes::TrackDataType::key_type::IsValidAlbumArtistRole] = false;
         if (trackRecord.value(DatabaseInterfacePrivate::TrackArtistsCount).toInt() == 1) {
-            result[DataTypes::TrackDataType::key_type::AlbumArtistRole] = trackRecord.value(DatabaseInterfacePrivate::TrackArtistName);
+            result[DataTypes::TrackDataType::key_type::AlbumArtistRole] = StringPool::intern(trackRecord.value(DatabaseInterfacePrivate::TrackArtistName).toString());
         } else if (trackRecord.value(DatabaseInterfacePrivate::TrackArtistsCount).toInt() > 1) {
-            result[DataTypes::TrackDataType::key_type::AlbumArtistRole] = i18nc("@item:intable", "Various Artists");
+            result[DataTypes::TrackDataType::key_type::AlbumArtistRole] = StringPool::intern(i18nc("@item:intable", "Various Artists"));
         }
     }
 
@@ -8103,16 +9769,16 @@ DataTypes::TrackDataType DatabaseInterface::buildTrackDataFromDatabaseRecord(con
 
     // TODO: port Artist, Composer, Genre, Lyricist to use association tables
     if (!trackRecord.value(DatabaseInterfacePrivate::TrackArtistName).isNull()) {
-        result[DataTypes::TrackDataType::key_type::ArtistRole] = trackRecord.value(DatabaseInterfacePrivate::TrackArtistName);
+        result[DataTypes::TrackDataType::key_type::ArtistRole] = StringPool::intern(trackRecord.value(DatabaseInterfacePrivate::TrackArtistName).toString());
     }
     if (!trackRecord.value(DatabaseInterfacePrivate::TrackGenreName).isNull()) {
-        result[DataTypes::TrackDataType::key_type::GenreRole] = trackRecord.value(DatabaseInterfacePrivate::TrackGenreName);
+        result[DataTypes::TrackDataType::key_type::GenreRole] = StringPool::intern(trackRecord.value(DatabaseInterfacePrivate::TrackGenreName).toString());
     }
     if (!trackRecord.value(DatabaseInterfacePrivate::TrackComposerName).isNull()) {
-        result[DataTypes::TrackDataType::key_type::ComposerRole] = trackRecord.value(DatabaseInterfacePrivate::TrackComposerName);
+        result[DataTypes::TrackDataType::key_type::ComposerRole] = StringPool::intern(trackRecord.value(DatabaseInterfacePrivate::TrackComposerName).toString());
     }
     if (!trackRecord.value(DatabaseInterfacePrivate::TrackLyricistName).isNull()) {
-        result[DataTypes::TrackDataType::key_type::LyricistRole] = trackRecord.value(DatabaseInterfacePrivate::TrackLyricistName);
+        result[DataTypes::TrackDataType::key_type::LyricistRole] = StringPool::intern(trackRecord.value(DatabaseInterfacePrivate::TrackLyricistName).toString());
     }
 
     return result;
@@ -8161,6 +9827,7 @@ void DatabaseInterface::internalRemoveTracksList(const QList<QUrl> &removedTrack
         if (modifiedAlbumId) {
             recordModifiedAlbum(modifiedAlbumId);
             modifiedAlbums.insert(modifiedAlbumId);
+            d->mAlbumsWithStaleAggregates.insert(modifiedAlbumId);
         }
 
         d->mPossiblyRemovedArtistIds.insert(internalArtistIdFromName(oneRemovedTrack.artist()));
@@ -8395,6 +10062,91 @@ QHash<QUrl, QDateTime> DatabaseInterface::internalAllFileName()
     return allFileNames;
 }
 
+DataTypes::DirectoryFingerprints DatabaseInterface::internalAllDirectoryFingerprints()
+{
+    auto allFingerprints = DataTypes::DirectoryFingerprints{};
+
+    auto queryResult = execQuery(d->mSelectAllDirectoryFingerprintsQuery);
+
+    if (!queryResult || !d->mSelectAllDirectoryFingerprintsQuery.isSelect() || !d->mSelectAllDirectoryFingerprintsQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalAllDirectoryFingerprints" << d->mSelectAllDirectoryFingerprintsQuery.lastQuery();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalAllDirectoryFingerprints" << d->mSelectAllDirectoryFingerprintsQuery.boundValues();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalAllDirectoryFingerprints" << d->mSelectAllDirectoryFingerprintsQuery.lastError();
+
+        d->mSelectAllDirectoryFingerprintsQuery.finish();
+
+        return allFingerprints;
+    }
+
+    while(d->mSelectAllDirectoryFingerprintsQuery.next()) {
+        const auto &currentRecord = d->mSelectAllDirectoryFingerprintsQuery.record();
+
+        allFingerprints[currentRecord.value(0).toUrl()] = {currentRecord.value(1).toDateTime(),
+                                                            currentRecord.value(2).toInt(),
+                                                            currentRecord.value(3).toByteArray()};
+    }
+
+    d->mSelectAllDirectoryFingerprintsQuery.finish();
+
+    return allFingerprints;
+}
+
+QStringList DatabaseInterface::internalAllScanCheckpoints()
+{
+    auto allRootPaths = QStringList{};
+
+    auto queryResult = execQuery(d->mSelectAllScanCheckpointsQuery);
+
+    if (!queryResult || !d->mSelectAllScanCheckpointsQuery.isSelect() || !d->mSelectAllScanCheckpointsQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalAllScanCheckpoints" << d->mSelectAllScanCheckpointsQuery.lastQuery();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalAllScanCheckpoints" << d->mSelectAllScanCheckpointsQuery.boundValues();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalAllScanCheckpoints" << d->mSelectAllScanCheckpointsQuery.lastError();
+
+        d->mSelectAllScanCheckpointsQuery.finish();
+
+        return allRootPaths;
+    }
+
+    while(d->mSelectAllScanCheckpointsQuery.next()) {
+        allRootPaths.push_back(d->mSelectAllScanCheckpointsQuery.record().value(0).toString());
+    }
+
+    d->mSelectAllScanCheckpointsQuery.finish();
+
+    return allRootPaths;
+}
+
+QList<QUrl> DatabaseInterface::internalAllScanCheckpointDirectories()
+{
+    auto allDirectories = QList<QUrl>{};
+
+    auto queryResult = execQuery(d->mSelectAllScanCheckpointDirectoriesQuery);
+
+    if (!queryResult || !d->mSelectAllScanCheckpointDirectoriesQuery.isSelect() || !d->mSelectAllScanCheckpointDirectoriesQuery.isActive()) {
+        Q_EMIT databaseError();
+
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalAllScanCheckpointDirectories" << d->mSelectAllScanCheckpointDirectoriesQuery.lastQuery();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalAllScanCheckpointDirectories" << d->mSelectAllScanCheckpointDirectoriesQuery.boundValues();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::internalAllScanCheckpointDirectories" << d->mSelectAllScanCheckpointDirectoriesQuery.lastError();
+
+        d->mSelectAllScanCheckpointDirectoriesQuery.finish();
+
+        return allDirectories;
+    }
+
+    while(d->mSelectAllScanCheckpointDirectoriesQuery.next()) {
+        allDirectories.push_back(d->mSelectAllScanCheckpointDirectoriesQuery.record().value(0).toUrl());
+    }
+
+    d->mSelectAllScanCheckpointDirectoriesQuery.finish();
+
+    return allDirectories;
+}
+
 qulonglong DatabaseInterface::internalGenericIdFromName(QSqlQuery &query)
 {
     qulonglong result = 0;
@@ -8463,7 +10215,7 @@ void DatabaseInterface::removeTrackInDatabase(qulonglong trackId)
     d->mRemoveTrackQuery.finish();
 }
 
-void DatabaseInterface::updateTrackInDatabase(const DataTypes::TrackDataType &oneTrack, const QString &albumPath)
+void DatabaseInterface::updateTrackInDatabase(const DataTypes::TrackDataType &oneTrack, const QString &albumPath, qulonglong albumId)
 {
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":fileName"), oneTrack.resourceURI());
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":trackId"), oneTrack.databaseId());
@@ -8475,6 +10227,11 @@ void DatabaseInterface::updateTrackInDatabase(const DataTypes::TrackDataType &on
 
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":albumPath"), albumPath);
 
+    d->mUpdateTrackQuery.bindValue(QStringLiteral(":albumId"), albumId != 0 ? albumId : QVariant{});
+
+    const auto albumArtistId = oneTrack.hasAlbumArtist() ? internalArtistIdFromName(oneTrack.albumArtist()) : 0;
+    d->mUpdateTrackQuery.bindValue(QStringLiteral(":albumArtistId"), albumArtistId != 0 ? albumArtistId : QVariant{});
+
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":trackNumber"), oneTrack.hasTrackNumber() ? oneTrack.trackNumber() : QVariant{});
 
     d->mUpdateTrackQuery.bindValue(QStringLiteral(":discNumber"), oneTrack.hasDiscNumber() ? oneTrack.discNumber() : QVariant{});
@@ -8495,17 +10252,21 @@ void DatabaseInterface::updateTrackInDatabase(const DataTypes::TrackDataType &on
 
     // TODO: port Artist, Composer, Genre, Lyricist to use association tables
     if (oneTrack.hasArtist()) {
-        const auto oneArtist = insertArtist(oneTrack.artist()) != 0 ? oneTrack.artist() : QVariant{};
-        d->mUpdateTrackQuery.bindValue(QStringLiteral(":artistName"), oneArtist);
+        const auto artistId = insertArtist(oneTrack.artist());
+        d->mUpdateTrackQuery.bindValue(QStringLiteral(":artistName"), artistId != 0 ? oneTrack.artist() : QVariant{});
+        d->mUpdateTrackQuery.bindValue(QStringLiteral(":artistId"), artistId != 0 ? artistId : QVariant{});
     } else {
         d->mUpdateTrackQuery.bindValue(QStringLiteral(":artistName"), {});
+        d->mUpdateTrackQuery.bindValue(QStringLiteral(":artistId"), {});
     }
 
     if (oneTrack.hasGenre()) {
-        const auto oneGenre = insertGenre(oneTrack.genre()) != 0 ? oneTrack.genre() : QVariant{};
-        d->mUpdateTrackQuery.bindValue(QStringLiteral(":genre"), oneGenre);
+        const auto genreId = insertGenre(oneTrack.genre());
+        d->mUpdateTrackQuery.bindValue(QStringLiteral(":genre"), genreId != 0 ? oneTrack.genre() : QVariant{});
+        d->mUpdateTrackQuery.bindValue(QStringLiteral(":genreId"), genreId != 0 ? genreId : QVariant{});
     } else {
         d->mUpdateTrackQuery.bindValue(QStringLiteral(":genre"), {});
+        d->mUpdateTrackQuery.bindValue(QStringLiteral(":genreId"), {});
     }
 
     if (oneTrack.hasComposer()) {
@@ -8571,74 +10332,6 @@ void DatabaseInterface::removeAlbumInDatabase(qulonglong albumId)
     d->mRemoveAlbumQuery.finish();
 }
 
-void DatabaseInterface::removeArtistInDatabase(qulonglong artistId)
-{
-    d->mRemoveArtistQuery.bindValue(QStringLiteral(":artistId"), artistId);
-
-    auto result = execQuery(d->mRemoveArtistQuery);
-
-    if (!result || !d->mRemoveArtistQuery.isActive()) {
-        Q_EMIT databaseError();
-
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeArtistInDatabase" << d->mRemoveArtistQuery.lastQuery();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeArtistInDatabase" << d->mRemoveArtistQuery.boundValues();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeArtistInDatabase" << d->mRemoveArtistQuery.lastError();
-    }
-
-    d->mRemoveArtistQuery.finish();
-}
-
-void DatabaseInterface::removeGenreInDatabase(qulonglong genreId)
-{
-    d->mRemoveGenreQuery.bindValue(QStringLiteral(":genreId"), genreId);
-
-    auto result = execQuery(d->mRemoveGenreQuery);
-
-    if (!result || !d->mRemoveGenreQuery.isActive()) {
-        Q_EMIT databaseError();
-
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeGenreInDatabase" << d->mRemoveGenreQuery.lastQuery();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeGenreInDatabase" << d->mRemoveGenreQuery.boundValues();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeGenreInDatabase" << d->mRemoveGenreQuery.lastError();
-    }
-
-    d->mRemoveGenreQuery.finish();
-}
-
-void DatabaseInterface::removeComposerInDatabase(qulonglong composerId)
-{
-    d->mRemoveComposerQuery.bindValue(QStringLiteral(":composerId"), composerId);
-
-    auto result = execQuery(d->mRemoveComposerQuery);
-
-    if (!result || !d->mRemoveComposerQuery.isActive()) {
-        Q_EMIT databaseError();
-
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeComposerInDatabase" << d->mRemoveComposerQuery.lastQuery();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeComposerInDatabase" << d->mRemoveComposerQuery.boundValues();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeComposerInDatabase" << d->mRemoveComposerQuery.lastError();
-    }
-
-    d->mRemoveComposerQuery.finish();
-}
-
-void DatabaseInterface::removeLyricistInDatabase(qulonglong lyricistId)
-{
-    d->mRemoveLyricistQuery.bindValue(QStringLiteral(":lyricistId"), lyricistId);
-
-    auto result = execQuery(d->mRemoveLyricistQuery);
-
-    if (!result || !d->mRemoveLyricistQuery.isActive()) {
-        Q_EMIT databaseError();
-
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeLyricistInDatabase" << d->mRemoveLyricistQuery.lastQuery();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeLyricistInDatabase" << d->mRemoveLyricistQuery.boundValues();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::removeLyricistInDatabase" << d->mRemoveLyricistQuery.lastError();
-    }
-
-    d->mRemoveLyricistQuery.finish();
-}
-
 void DatabaseInterface::reloadExistingDatabase()
 {
     qCDebug(orgKdeElisaDatabase) << "DatabaseInterface::reloadExistingDatabase";
@@ -9078,6 +10771,27 @@ DataTypes::ListTrackDataType DatabaseInterface::internalTracksFromAuthorAndGenre
     return allTracks;
 }
 
+void DatabaseInterface::bindSearchValues(QSqlQuery &query, const QString &searchText, qulonglong afterDatabaseId, int count) const
+{
+    const auto simplifiedText = searchText.simplified();
+
+    if (d->mHasSearchIndex) {
+        // every word is a quoted prefix query: FTS5 operators typed by the user stay plain words
+        auto allTerms = QStringList{};
+        const auto allWords = simplifiedText.split(QLatin1Char(' '), Qt::SkipEmptyParts);
+        for (const auto &oneWord : allWords) {
+            allTerms.push_back(QString{u'"' + QString{oneWord}.replace(u"\""_s, u"\"\""_s) + u"\"*"_s});
+        }
+
+        query.bindValue(QStringLiteral(":searchText"), allTerms.join(QLatin1Char(' ')));
+    } else {
+        query.bindValue(QStringLiteral(":searchText"), QString{u'%' + simplifiedText + u'%'});
+    }
+
+    query.bindValue(QStringLiteral(":afterDatabaseId"), afterDatabaseId);
+    query.bindValue(QStringLiteral(":maximumResults"), count);
+}
+
 QList<qulonglong> DatabaseInterface::internalAlbumIdsFromAuthor(const QString &ArtistName)
 {
     auto allAlbumIds = QList<qulonglong>();
@@ -9164,7 +10878,7 @@ DataTypes::ListAlbumDataType DatabaseInterface::internalAllAlbumsPartialData(QSq
         newData[DataTypes::AllArtistsRole] = QVariant::fromValue(allArtists);
         if (!currentRecord.value(DatabaseInterfacePrivate::AlbumsArtistName).isNull()) {
             newData[DataTypes::IsValidAlbumArtistRole] = true;
-            newData[DataTypes::SecondaryTextRole] = currentRecord.value(DatabaseInterfacePrivate::AlbumsArtistName);
+            newData[DataTypes::SecondaryTextRole] = StringPool::intern(currentRecord.value(DatabaseInterfacePrivate::AlbumsArtistName).toString());
         } else {
             newData[DataTypes::IsValidAlbumArtistRole] = false;
             if (currentRecord.value(DatabaseInterfacePrivate::AlbumsArtistsCount).toInt() == 1) {
@@ -9199,6 +10913,11 @@ DataTypes::ListTrackDataType DatabaseInterface::internalOneAlbumData(qulonglong
 {
     DataTypes::ListTrackDataType result;
 
+    // the album tracks query reads the album aggregates: they have to be up to date inside of an insertion or removal
+    if (d->mAlbumsWithStaleAggregates.contains(databaseId)) {
+        updateAlbumAggregates();
+    }
+
     d->mSelectTrackQuery.bindValue(QStringLiteral(":albumId"), databaseId);
 
     auto queryResult = execQuery(d->mSelectTrackQuery);
@@ -9249,7 +10968,7 @@ DataTypes::AlbumDataType DatabaseInterface::internalOneAlbumPartialData(qulonglo
 
         if (!currentRecord.value(DatabaseInterfacePrivate::SingleAlbumArtistName).isNull()) {
             result[DataTypes::IsValidAlbumArtistRole] = true;
-            result[DataTypes::SecondaryTextRole] = currentRecord.value(DatabaseInterfacePrivate::SingleAlbumArtistName);
+            result[DataTypes::SecondaryTextRole] = StringPool::intern(currentRecord.value(DatabaseInterfacePrivate::SingleAlbumArtistName).toString());
         } else {
             result[DataTypes::IsValidAlbumArtistRole] = false;
             if (currentRecord.value(DatabaseInterfacePrivate::SingleAlbumArtistsCount).toInt() == 1) {
@@ -9596,12 +11315,10 @@ DataTypes::ListArtistDataType DatabaseInterface::internalAllLyricistsPartialData
     return result;
 }
 
-void DatabaseInterface::updateAlbumArtist(qulonglong albumId, const QString &title,
-                                          const QString &albumPath,
-                                          const QString &artistName)
+void DatabaseInterface::updateAlbumArtist(qulonglong albumId, const QString &artistName)
 {
     d->mUpdateAlbumArtistQuery.bindValue(QStringLiteral(":albumId"), albumId);
-    insertArtist(artistName);
+    const auto artistId = insertArtist(artistName);
     d->mUpdateAlbumArtistQuery.bindValue(QStringLiteral(":artistName"), artistName);
 
     auto queryResult = execQuery(d->mUpdateAlbumArtistQuery);
@@ -9620,9 +11337,9 @@ void DatabaseInterface::updateAlbumArtist(qulonglong albumId, const QString &tit
 
     d->mUpdateAlbumArtistQuery.finish();
 
-    d->mUpdateAlbumArtistInTracksQuery.bindValue(QStringLiteral(":albumTitle"), title);
-    d->mUpdateAlbumArtistInTracksQuery.bindValue(QStringLiteral(":albumPath"), albumPath);
+    d->mUpdateAlbumArtistInTracksQuery.bindValue(QStringLiteral(":albumId"), albumId);
     d->mUpdateAlbumArtistInTracksQuery.bindValue(QStringLiteral(":artistName"), artistName);
+    d->mUpdateAlbumArtistInTracksQuery.bindValue(QStringLiteral(":artistId"), artistId != 0 ? artistId : QVariant{});
 
     queryResult = execQuery(d->mUpdateAlbumArtistInTracksQuery);
 
@@ -9773,50 +11490,90 @@ void DatabaseInterface::updateTrackFinishedStatistics(const QUrl &fileName, cons
     d->mUpdateTrackFirstPlayStatistics.finish();
 }
 
-bool DatabaseInterface::execHasRowQuery(QSqlQuery &query)
+bool DatabaseInterface::hasSetBasedPruning()
 {
-    if (!execQuery(query) || !query.isActive()) {
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::execHasRowQuery" << query.lastQuery();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::execHasRowQuery" << query.boundValues();
-        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::execHasRowQuery" << query.lastError();
+    QSqlQuery checkQuery(d->mTracksDatabase);
 
-        Q_EMIT databaseError();
-
-        query.finish();
+    // json_each is unknown when SQLite is built without the JSON1 extension
+    if (!checkQuery.exec(u"SELECT sqlite_version(), COUNT(*) FROM json_each('[0]')"_s) || !checkQuery.next()) {
+        qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::hasSetBasedPruning" << "no JSON1 extension" << checkQuery.lastError();
 
         return false;
     }
 
-    bool result = false;
-    if (query.next()) {
-        result = query.value(0).toBool();
+    const auto sqliteVersion = QVersionNumber::fromString(checkQuery.value(0).toString());
+
+    checkQuery.finish();
+
+    if (sqliteVersion < QVersionNumber(3, 35)) {
+        qCInfo(orgKdeElisaDatabase) << "DatabaseInterface::hasSetBasedPruning" << "no RETURNING clause in SQLite" << sqliteVersion;
+
+        return false;
     }
-    query.finish();
-    return result;
-}
 
-bool DatabaseInterface::artistHasTracks(qulonglong artistId)
-{
-    d->mArtistHasTracksQuery.bindValue(u":artistId"_s, artistId);
-    return execHasRowQuery(d->mArtistHasTracksQuery);
+    return true;
 }
 
-bool DatabaseInterface::genreHasTracks(qulonglong genreId)
+void DatabaseInterface::execPruneQuery(QSqlQuery &query, const QString &idsParameter, QSet<qulonglong> &possiblyRemovedIds, QSet<qulonglong> &removedIds)
 {
-    d->mGenreHasTracksQuery.bindValue(u":genreId"_s, genreId);
-    return execHasRowQuery(d->mGenreHasTracksQuery);
-}
+    // Remove invalid ID
+    possiblyRemovedIds.remove(0);
 
-bool DatabaseInterface::composerHasTracks(qulonglong composerId)
-{
-    d->mComposerHasTracksQuery.bindValue(u":composerId"_s, composerId);
-    return execHasRowQuery(d->mComposerHasTracksQuery);
-}
+    if (possiblyRemovedIds.isEmpty()) {
+        return;
+    }
 
-bool DatabaseInterface::lyricistHasTracks(qulonglong lyricistId)
-{
-    d->mLyricistHasTracksQuery.bindValue(u":lyricistId"_s, lyricistId);
-    return execHasRowQuery(d->mLyricistHasTracksQuery);
+    if (!d->mHasSetBasedPruning) {
+        for (const auto oneId : std::as_const(possiblyRemovedIds)) {
+            query.bindValue(idsParameter, oneId);
+
+            auto result = execQuery(query);
+
+            if (!result || !query.isActive()) {
+                Q_EMIT databaseError();
+
+                qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::execPruneQuery" << query.lastQuery();
+                qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::execPruneQuery" << query.boundValues();
+                qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::execPruneQuery" << query.lastError();
+            } else if (query.numRowsAffected() > 0) {
+                removedIds.insert(oneId);
+            }
+
+            query.finish();
+        }
+        possiblyRemovedIds.clear();
+
+        return;
+    }
+
+    auto candidateIds = QStringList{};
+    candidateIds.reserve(possiblyRemovedIds.size());
+    for (const auto oneId : std::as_const(possiblyRemovedIds)) {
+        candidateIds.push_back(QString::number(oneId));
+    }
+    possiblyRemovedIds.clear();
+
+    query.bindValue(idsParameter, QString{u"["_s + candidateIds.join(u',') + u"]"_s});
+
+    auto result = execQuery(query);
+
+    if (!result || !query.isActive()) {
+        Q_EMIT databaseError();
+
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::execPruneQuery" << query.lastQuery();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::execPruneQuery" << query.boundValues();
+        qCCritical(orgKdeElisaDatabase) << "DatabaseInterface::execPruneQuery" << query.lastError();
+
+        query.finish();
+
+        return;
+    }
+
+    while (query.next()) {
+        removedIds.insert(query.value(0).toULongLong());
+    }
+
+    query.finish();
 }
 
 void DatabaseInterface::pruneCollections()
@@ -9829,58 +11586,22 @@ void DatabaseInterface::pruneCollections()
 
 void DatabaseInterface::pruneArtists()
 {
-    // Remove invalid ID
-    d->mPossiblyRemovedArtistIds.remove(0);
-
-    for (const auto artistId : std::as_const(d->mPossiblyRemovedArtistIds)) {
-        if (!artistHasTracks(artistId)) {
-            removeArtistInDatabase(artistId);
-            d->mRemovedArtistIds.insert(artistId);
-        }
-    }
-    d->mPossiblyRemovedArtistIds.clear();
+    execPruneQuery(d->mPruneArtistsQuery, u":artistIds"_s, d->mPossiblyRemovedArtistIds, d->mRemovedArtistIds);
 }
 
 void DatabaseInterface::pruneGenres()
 {
-    // Remove invalid ID
-    d->mPossiblyRemovedGenreIds.remove(0);
-
-    for (const auto genreId : std::as_const(d->mPossiblyRemovedGenreIds)) {
-        if (!genreHasTracks(genreId)) {
-            removeGenreInDatabase(genreId);
-            d->mRemovedGenreIds.insert(genreId);
-        }
-    }
-    d->mPossiblyRemovedGenreIds.clear();
+    execPruneQuery(d->mPruneGenresQuery, u":genreIds"_s, d->mPossiblyRemovedGenreIds, d->mRemovedGenreIds);
 }
 
 void DatabaseInterface::pruneComposers()
 {
-    // Remove invalid ID
-    d->mPossiblyRemovedComposerIds.remove(0);
-
-    for (const auto composerId : std::as_const(d->mPossiblyRemovedComposerIds)) {
-        if (!composerHasTracks(composerId)) {
-            removeComposerInDatabase(composerId);
-            d->mRemovedComposerIds.insert(composerId);
-        }
-    }
-    d->mPossiblyRemovedComposerIds.clear();
+    execPruneQuery(d->mPruneComposersQuery, u":composerIds"_s, d->mPossiblyRemovedComposerIds, d->mRemovedComposerIds);
 }
 
 void DatabaseInterface::pruneLyricists()
 {
-    // Remove invalid ID
-    d->mPossiblyRemovedLyricistsIds.remove(0);
-
-    for (const auto lyricistId : std::as_const(d->mPossiblyRemovedLyricistsIds)) {
-        if (!lyricistHasTracks(lyricistId)) {
-            removeLyricistInDatabase(lyricistId);
-            d->mRemovedLyricistIds.insert(lyricistId);
-        }
-    }
-    d->mPossiblyRemovedLyricistsIds.clear();
+    execPruneQuery(d->mPruneLyricistsQuery, u":lyricistIds"_s, d->mPossiblyRemovedLyricistsIds, d->mRemovedLyricistIds);
 }
 
 #include "moc_databaseinterface.cpp"
@@ -46,6 +46,13 @@ public:
         V15 = 15,
         V16 = 16,
         V17 = 17,
+        V18 = 18,
+        V19 = 19,
+        V20 = 20,
+        V21 = 21, // integer album, artist and genre keys of the tracks
+        V22 = 22, // DirectoryFingerprints
+        V23 = 23, // ScanCheckpoints
+        V24 = 24, // ScanCheckpointDirectories
     };
 
     explicit DatabaseInterface(QObject *parent = nullptr);
@@ -54,10 +61,33 @@ public:
 
     Q_INVOKABLE void init(const QString &dbName, const QString &databaseFileName = {});
 
+    /**
+     * Send the changes of the collection with the signals used by the models, enabled by default
+     * An import without any model does not need to read back the inserted data.
+     * It must be called before init().
+     */
+    void setChangesNotificationEnabled(bool enabled);
+
+    /**
+     * Open an additional read-only connection to an existing database file.
+     * The schema is neither created nor upgraded: the read-write connection
+     * owning the file must have been initialized before.
+     * Only useful for file based databases opened in WAL journal mode where
+     * readers are not blocked by the writer.
+     */
+    Q_INVOKABLE void initReadOnly(const QString &dbName, const QString &databaseFileName);
+
     qulonglong albumIdFromTitleAndArtist(const QString &title, const QString &artist, const QString &albumPath);
 
     DataTypes::ListTrackDataType allTracksData();
 
+    /**
+     * Read one page of the tracks returned by allTracksData(), ordered by database id:
+     * only tracks with an id greater than afterDatabaseId are returned, at most count of them.
+     * A page shorter than count is the last one.
+     */
+    DataTypes::ListTrackDataType allTracksDataPage(qulonglong afterDatabaseId, int count);
+
     DataTypes::ListRadioDataType allRadiosData();
 
     DataTypes::ListTrackDataType recentlyPlayedTracksData(int count);
@@ -92,6 +122,19 @@ public:
 
     DataTypes::ListTrackDataType tracksDataFromGenreAndAuthor(const QString &genre, const QString &artistName);
 
+    /**
+     * Search the full-text index of the tracks (title, artist, album, album artist,
+     * genre, composer and lyricist) for words starting with the words of searchText.
+     * Results are ordered by database id and paged: only results with an id greater
+     * than afterDatabaseId are returned, at most count of them.
+     * Falls back to a substring match when SQLite has no FTS5 support.
+     */
+    DataTypes::ListTrackDataType tracksDataFromSearch(const QString &searchText, qulonglong afterDatabaseId, int count);
+
+    DataTypes::ListAlbumDataType albumsDataFromSearch(const QString &searchText, qulonglong afterDatabaseId, int count);
+
+    DataTypes::ListArtistDataType artistsDataFromSearch(const QString &searchText, qulonglong afterDatabaseId, int count);
+
     DataTypes::TrackDataType trackDataFromDatabaseId(qulonglong id);
 
     DataTypes::TrackDataType trackDataFromDatabaseIdAndUrl(qulonglong id, const QUrl &trackUrl);
@@ -106,6 +149,12 @@ public:
 
     void applicationAboutToQuit();
 
+    /**
+     * Text of the prepared queries used to browse the collection, by name
+     * Used by the autotests to check their query plans against the indexes of the schema.
+     */
+    [[nodiscard]] QHash<QString, QString> browseQueriesText() const;
+
 Q_SIGNALS:
 
     void tracksAdded(const DataTypes::ListTrackDataType &allTracks);
@@ -134,9 +183,22 @@ Q_SIGNALS:
 
     void restoredTracks(const QHash<QUrl, QDateTime> &allFiles);
 
+    /**
+     * Emitted by askRestoredTracks() just before restoredTracks()
+     */
+    void restoredDirectoryFingerprints(const DataTypes::DirectoryFingerprints &fingerprints);
+
+    /**
+     * Emitted by askScanCheckpoints() with the root paths whose scan did not finish and the directories that scan finished
+     */
+    void restoredScanCheckpoints(const QStringList &rootPaths, const QList<QUrl> &finishedDirectories);
+
     void cleanedDatabase();
 
-    void finishInsertingTracksList();
+    /**
+     * Emitted at the end of each insertTracksList() with the object whose signal asked for it, nullptr for a direct call
+     */
+    void finishInsertingTracksList(QObject *tracksSender);
 
     void finishRemovingTracksList();
 
@@ -148,6 +210,22 @@ public Q_SLOTS:
 
     void askRestoredTracks();
 
+    void insertDirectoryFingerprints(const DataTypes::DirectoryFingerprints &fingerprints);
+
+    void removeDirectoryFingerprints(const QList<QUrl> &directories);
+
+    void askScanCheckpoints();
+
+    void insertScanCheckpoint(const QString &rootPath);
+
+    void removeScanCheckpoint(const QString &rootPath);
+
+    /**
+     * Record directories whose files have all been inserted by the scan of this root path
+     * They are ignored if an insertion failed since the checkpoint was added.
+     */
+    void insertScanCheckpointDirectories(const QString &rootPath, const QList<QUrl> &finishedDirectories);
+
     void trackHasStartedPlaying(const QUrl &fileName, const QDateTime &time);
 
     void trackHasFinishedPlaying(const QUrl &fileName, const QDateTime &time);
@@ -156,6 +234,18 @@ public Q_SLOTS:
 
     void removeRadio(qulonglong radioId);
 
+    /**
+     * Switch insertTracksList to the bulk import path used for the first scan of a
+     * collection: artists, genres, composers, lyricists and albums are deduplicated
+     * in memory for each batch and written with multi-row inserts, while the
+     * maintenance of the secondary indexes, of the search index and the pruning of
+     * collections are deferred until endBulkImport. The bulk import also ends when
+     * the scan checkpoint of a root path is removed, once its batches are committed.
+     */
+    void beginBulkImport();
+
+    void endBulkImport();
+
 private:
 
     enum class DatabaseState {
@@ -163,9 +253,15 @@ private:
         BadState,
     };
 
+    enum class ConnectionMode {
+        ReadWrite,
+        ReadOnly,
+    };
+
     /********* Init and upgrade methods *********/
 
-    void initConnection(const QString &connectionName, const QString &databaseFileName);
+    void initConnection(const QString &connectionName, const QString &databaseFileName,
+                        ConnectionMode mode = ConnectionMode::ReadWrite);
 
     bool initDatabase();
 
@@ -187,6 +283,28 @@ private:
 
     void upgradeDatabaseV17();
 
+    void upgradeDatabaseV18();
+
+    void upgradeDatabaseV19();
+
+    void upgradeDatabaseV20();
+
+    void upgradeDatabaseV21();
+
+    void upgradeDatabaseV22();
+
+    void upgradeDatabaseV23();
+
+    void upgradeDatabaseV24();
+
+    void createTracksSearchTriggers();
+
+    void fillTracksSearchIndex();
+
+    void dropDeferredIndexes();
+
+    void restoreDeferredIndexes();
+
     [[nodiscard]] DatabaseState checkDatabaseSchema() const;
 
     [[nodiscard]] DatabaseState checkTable(const QString &tableName, const QStringList &expectedColumns) const;
@@ -229,6 +347,8 @@ private:
 
     void recordModifiedAlbum(qulonglong albumId);
 
+    void updateAlbumAggregates();
+
     QList<qulonglong> fetchTrackIds(qulonglong albumId);
 
     qulonglong internalAlbumIdFromTitleAndArtist(const QString &title, const QString &artist, const QString &albumPath);
@@ -252,6 +372,8 @@ private:
 
     DataTypes::ListTrackDataType internalTracksFromAuthorAndGenre(const QString &artistName, const QString &genre);
 
+    void bindSearchValues(QSqlQuery &query, const QString &searchText, qulonglong afterDatabaseId, int count) const;
+
     QList<qulonglong> internalAlbumIdsFromAuthor(const QString &artistName);
 
     qulonglong insertAlbum(const QString &title, const QString &albumArtist,
@@ -274,14 +396,10 @@ private:
     qulonglong internalComposerIdFromName(const QString &name);
     qulonglong internalLyricistIdFromName(const QString &name);
 
-    void updateTrackInDatabase(const DataTypes::TrackDataType &oneTrack, const QString &albumPath);
+    void updateTrackInDatabase(const DataTypes::TrackDataType &oneTrack, const QString &albumPath, qulonglong albumId);
 
     void removeTrackInDatabase(qulonglong trackId);
     void removeAlbumInDatabase(qulonglong albumId);
-    void removeArtistInDatabase(qulonglong artistId);
-    void removeGenreInDatabase(qulonglong genreId);
-    void removeComposerInDatabase(qulonglong composerId);
-    void removeLyricistInDatabase(qulonglong lyricistId);
 
     void reloadExistingDatabase();
 
@@ -307,6 +425,12 @@ private:
 
     QHash<QUrl, QDateTime> internalAllFileName();
 
+    DataTypes::DirectoryFingerprints internalAllDirectoryFingerprints();
+
+    QStringList internalAllScanCheckpoints();
+
+    QList<QUrl> internalAllScanCheckpointDirectories();
+
     bool internalGenericPartialData(QSqlQuery &query);
 
     DataTypes::ListArtistDataType internalAllArtistsPartialData(QSqlQuery &artistsQuery);
@@ -341,8 +465,7 @@ private:
 
     DataTypes::ListArtistDataType internalAllLyricistsPartialData();
 
-    void updateAlbumArtist(qulonglong albumId, const QString &title, const QString &albumPath,
-                           const QString &artistName);
+    void updateAlbumArtist(qulonglong albumId, const QString &artistName);
 
     bool updateAlbumCover(qulonglong albumId, const QUrl &albumArtUri);
 
@@ -357,14 +480,25 @@ private:
     void internalInsertOneRadio(const DataTypes::TrackDataType &oneTrack);
 
     /**
-     * Execute a query that checks whether there is at least 1 matching row
+     * Insert the new tracks of a batch with multi-row statements
+     * @returns the tracks that need the track by track path: radios, already known
+     * files, tracks without metadata and tracks modifying an existing album,
+     * or nothing when the insertion failed and the transaction has to be rolled back
      */
-    bool execHasRowQuery(QSqlQuery &query);
+    std::optional<DataTypes::ListTrackDataType> internalBulkInsertTracks(const DataTypes::ListTrackDataType &tracks);
+
+    bool execMultiRowInsert(const QString &insertQueryText, int columnsCount, const QVariantList &values);
 
-    bool artistHasTracks(qulonglong artistId);
-    bool genreHasTracks(qulonglong genreId);
-    bool composerHasTracks(qulonglong composerId);
-    bool lyricistHasTracks(qulonglong lyricistId);
+    /**
+     * Check that SQLite has the JSON1 extension and the RETURNING clause used to prune in one statement
+     */
+    bool hasSetBasedPruning();
+
+    /**
+     * Delete the ids of possiblyRemovedIds that are no longer used by any track, in one statement
+     * when hasSetBasedPruning() or one id at a time otherwise, and add the deleted ids to removedIds
+     */
+    void execPruneQuery(QSqlQuery &query, const QString &idsParameter, QSet<qulonglong> &possiblyRemovedIds, QSet<qulonglong> &removedIds);
 
     void pruneCollections();
     void pruneArtists();
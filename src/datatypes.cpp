@@ -7,6 +7,8 @@
 
 #include "datatypes.h"
 
+#include "stringpool.h"
+
 bool DataTypes::TrackDataType::albumInfoIsSame(const TrackDataType &other) const
 {
     return hasAlbum() == other.hasAlbum() && album() == other.album() &&
@@ -34,5 +36,229 @@ bool DataTypes::TrackDataType::isSameTrack(const TrackDataType& other) const
            hasSampleRate() == other.hasSampleRate() && (hasSampleRate() ? sampleRate() == other.sampleRate() : true);
 }
 
+namespace
+{
+
+// roles stored in the typed members of a TrackRecord
+constexpr DataTypes::ColumnsRoles trackRecordRoles[] = {
+    DataTypes::TitleRole, DataTypes::ArtistRole, DataTypes::AlbumRole, DataTypes::AlbumArtistRole,
+    DataTypes::GenreRole, DataTypes::ComposerRole, DataTypes::LyricistRole, DataTypes::CommentRole,
+    DataTypes::ResourceRole, DataTypes::ImageUrlRole, DataTypes::FileModificationTime, DataTypes::FirstPlayDate,
+    DataTypes::LastPlayDate, DataTypes::DatabaseIdRole, DataTypes::AlbumIdRole, DataTypes::DurationRole,
+    DataTypes::TrackNumberRole, DataTypes::DiscNumberRole, DataTypes::YearRole, DataTypes::ChannelsRole,
+    DataTypes::BitRateRole, DataTypes::SampleRateRole, DataTypes::RatingRole, DataTypes::PlayCounter,
+    DataTypes::ElementTypeRole, DataTypes::IsValidAlbumArtistRole, DataTypes::IsSingleDiscAlbumRole, DataTypes::HasEmbeddedCover,
+};
+
+quint64 trackRecordRoleBit(DataTypes::ColumnsRoles role)
+{
+    const auto bitIndex = static_cast<int>(role) - static_cast<int>(DataTypes::TitleRole);
+
+    if (bitIndex < 0 || bitIndex >= 64) {
+        return 0;
+    }
+
+    return quint64{1} << bitIndex;
+}
+
+}
+
+DataTypes::TrackRecord::TrackRecord(const TrackDataType &trackData)
+{
+    for (auto itData = trackData.cbegin(); itData != trackData.cend(); ++itData) {
+        const auto &value = itData.value();
+
+        switch (itData.key())
+        {
+        case TitleRole:
+            mTitle = value.toString();
+            break;
+        case ArtistRole:
+            mArtist = StringPool::intern(value.toString());
+            break;
+        case AlbumRole:
+            mAlbum = StringPool::intern(value.toString());
+            break;
+        case AlbumArtistRole:
+            mAlbumArtist = StringPool::intern(value.toString());
+            break;
+        case GenreRole:
+            mGenre = StringPool::intern(value.toString());
+            break;
+        case ComposerRole:
+            mComposer = StringPool::intern(value.toString());
+            break;
+        case LyricistRole:
+            mLyricist = StringPool::intern(value.toString());
+            break;
+        case CommentRole:
+            mComment = value.toString();
+            break;
+        case ResourceRole:
+            mResourceURI = value.toUrl();
+            break;
+        case ImageUrlRole:
+            mAlbumCover = value.toUrl();
+            break;
+        case FileModificationTime:
+            mFileModificationTime = value.toDateTime();
+            break;
+        case FirstPlayDate:
+            mFirstPlayDate = value.toDateTime();
+            break;
+        case LastPlayDate:
+            mLastPlayDate = value.toDateTime();
+            break;
+        case DatabaseIdRole:
+            mDatabaseId = value.toULongLong();
+            break;
+        case AlbumIdRole:
+            mAlbumId = value.toULongLong();
+            break;
+        case DurationRole:
+        {
+            const auto duration = value.toTime();
+            mDurationMSecs = duration.isValid() ? duration.msecsSinceStartOfDay() : -1;
+            break;
+        }
+        case TrackNumberRole:
+            mTrackNumber = value.toInt();
+            break;
+        case DiscNumberRole:
+            mDiscNumber = value.toInt();
+            break;
+        case YearRole:
+            mYear = value.toInt();
+            break;
+        case ChannelsRole:
+            mChannels = value.toInt();
+            break;
+        case BitRateRole:
+            mBitRate = value.toInt();
+            break;
+        case SampleRateRole:
+            mSampleRate = value.toInt();
+            break;
+        case RatingRole:
+            mRating = value.toInt();
+            break;
+        case PlayCounter:
+            mPlayCounter = value.toInt();
+            break;
+        case ElementTypeRole:
+            mElementType = value.value<ElisaUtils::PlayListEntryType>();
+            break;
+        case IsValidAlbumArtistRole:
+            mIsValidAlbumArtist = value.toBool();
+            break;
+        case IsSingleDiscAlbumRole:
+            mIsSingleDiscAlbum = value.toBool();
+            break;
+        case HasEmbeddedCover:
+            mHasEmbeddedCover = value.toBool();
+            break;
+        default:
+            mOtherData.insert(itData.key(), value);
+            continue;
+        }
+
+        setRole(itData.key());
+    }
+}
+
+DataTypes::TrackDataType DataTypes::TrackRecord::toTrackData() const
+{
+    auto result = TrackDataType{};
+    result.insert(mOtherData);
+
+    for (const auto oneRole : trackRecordRoles) {
+        if (mPresentRoles & trackRecordRoleBit(oneRole)) {
+            result[oneRole] = data(oneRole);
+        }
+    }
+
+    return result;
+}
+
+bool DataTypes::TrackRecord::hasRole(ColumnsRoles role) const
+{
+    return (mPresentRoles & trackRecordRoleBit(role)) || mOtherData.contains(role);
+}
+
+QVariant DataTypes::TrackRecord::data(ColumnsRoles role) const
+{
+    if (!(mPresentRoles & trackRecordRoleBit(role))) {
+        return mOtherData.value(role);
+    }
+
+    switch (role)
+    {
+    case TitleRole:
+        return mTitle;
+    case ArtistRole:
+        return mArtist;
+    case AlbumRole:
+        return mAlbum;
+    case AlbumArtistRole:
+        return mAlbumArtist;
+    case GenreRole:
+        return mGenre;
+    case ComposerRole:
+        return mComposer;
+    case LyricistRole:
+        return mLyricist;
+    case CommentRole:
+        return mComment;
+    case ResourceRole:
+        return mResourceURI;
+    case ImageUrlRole:
+        return mAlbumCover;
+    case FileModificationTime:
+        return mFileModificationTime;
+    case FirstPlayDate:
+        return mFirstPlayDate;
+    case LastPlayDate:
+        return mLastPlayDate;
+    case DatabaseIdRole:
+        return mDatabaseId;
+    case AlbumIdRole:
+        return mAlbumId;
+    case DurationRole:
+        return duration();
+    case TrackNumberRole:
+        return mTrackNumber;
+    case DiscNumberRole:
+        return mDiscNumber;
+    case YearRole:
+        return mYear;
+    case ChannelsRole:
+        return mChannels;
+    case BitRateRole:
+        return mBitRate;
+    case SampleRateRole:
+        return mSampleRate;
+    case RatingRole:
+        return mRating;
+    case PlayCounter:
+        return mPlayCounter;
+    case ElementTypeRole:
+        return QVariant::fromValue(mElementType);
+    case IsValidAlbumArtistRole:
+        return mIsValidAlbumArtist;
+    case IsSingleDiscAlbumRole:
+        return mIsSingleDiscAlbum;
+    case HasEmbeddedCover:
+        return mHasEmbeddedCover;
+    default:
+        break;
+    }
+
+    return mOtherData.value(role);
+}
+
+void DataTypes::TrackRecord::setRole(ColumnsRoles role)
+{
+    mPresentRoles |= trackRecordRoleBit(role);
+}
 
 #include "moc_datatypes.cpp"
@@ -20,6 +20,8 @@
 #include <QUrl>
 #include <QDateTime>
 #include <QMap>
+#include <QHash>
+#include <QByteArray>
 
 class ELISALIB_EXPORT DataTypes : public QObject
 {
@@ -336,6 +338,130 @@ public:
 
     using ListRadioDataType = QList<TrackDataType>;
 
+    /**
+     * Fixed layout copy of a TrackDataType used to hold large lists of tracks.
+     *
+     * The roles always set on a track from the database are typed members and
+     * a bitmask records which of them are present. Artist, album, genre,
+     * composer and lyricist strings are taken from the StringPool. Any other
+     * role is kept as is.
+     */
+    class TrackRecord
+    {
+    public:
+
+        TrackRecord() = default;
+
+        explicit TrackRecord(const TrackDataType &trackData);
+
+        [[nodiscard]] TrackDataType toTrackData() const;
+
+        [[nodiscard]] bool hasRole(ColumnsRoles role) const;
+
+        [[nodiscard]] QVariant data(ColumnsRoles role) const;
+
+        [[nodiscard]] qulonglong databaseId() const
+        {
+            return mDatabaseId;
+        }
+
+        [[nodiscard]] QString title() const
+        {
+            return mTitle;
+        }
+
+        [[nodiscard]] QString album() const
+        {
+            return mAlbum;
+        }
+
+        [[nodiscard]] int trackNumber() const
+        {
+            return mTrackNumber;
+        }
+
+        [[nodiscard]] int discNumber() const
+        {
+            return mDiscNumber;
+        }
+
+        [[nodiscard]] QTime duration() const
+        {
+            return mDurationMSecs < 0 ? QTime{} : QTime::fromMSecsSinceStartOfDay(mDurationMSecs);
+        }
+
+        [[nodiscard]] QUrl resourceURI() const
+        {
+            return mResourceURI;
+        }
+
+    private:
+
+        void setRole(ColumnsRoles role);
+
+        QString mTitle;
+
+        QString mArtist;
+
+        QString mAlbum;
+
+        QString mAlbumArtist;
+
+        QString mGenre;
+
+        QString mComposer;
+
+        QString mLyricist;
+
+        QString mComment;
+
+        QUrl mResourceURI;
+
+        QUrl mAlbumCover;
+
+        QDateTime mFileModificationTime;
+
+        QDateTime mFirstPlayDate;
+
+        QDateTime mLastPlayDate;
+
+        DataType mOtherData;
+
+        qulonglong mDatabaseId = 0;
+
+        qulonglong mAlbumId = 0;
+
+        quint64 mPresentRoles = 0;
+
+        int mDurationMSecs = -1;
+
+        int mTrackNumber = 0;
+
+        int mDiscNumber = 0;
+
+        int mYear = 0;
+
+        int mChannels = 0;
+
+        int mBitRate = 0;
+
+        int mSampleRate = 0;
+
+        int mRating = 0;
+
+        int mPlayCounter = 0;
+
+        ElisaUtils::PlayListEntryType mElementType = ElisaUtils::Unknown;
+
+        bool mIsValidAlbumArtist = false;
+
+        bool mIsSingleDiscAlbum = false;
+
+        bool mHasEmbeddedCover = false;
+    };
+
+    using ListTrackRecord = QList<TrackRecord>;
+
     class AlbumDataType : public MusicDataType
     {
     public:
@@ -433,6 +559,21 @@ public:
     };
     using EntryDataList = QList<EntryData>;
 
+    /**
+     * State of a scanned directory: an unchanged fingerprint means that no entry was added, removed or renamed
+     */
+    struct DirectoryFingerprint {
+        QDateTime mModifiedTime;
+        int mEntriesCount = 0;
+        QByteArray mNamesHash;
+
+        bool operator==(const DirectoryFingerprint &other) const
+        {
+            return mModifiedTime == other.mModifiedTime && mEntriesCount == other.mEntriesCount && mNamesHash == other.mNamesHash;
+        }
+    };
+    using DirectoryFingerprints = QHash<QUrl, DirectoryFingerprint>;
+
 };
 
 Q_DECLARE_METATYPE(DataTypes::MusicDataType)
@@ -449,4 +590,7 @@ Q_DECLARE_METATYPE(DataTypes::ListGenreDataType)
 Q_DECLARE_METATYPE(DataTypes::EntryData)
 Q_DECLARE_METATYPE(DataTypes::EntryDataList)
 
+Q_DECLARE_METATYPE(DataTypes::DirectoryFingerprint)
+Q_DECLARE_METATYPE(DataTypes::DirectoryFingerprints)
+
 #endif // DATATYPES_H
@@ -10,14 +10,22 @@
 #include "elisaimportapplication.h"
 #include "elisa_settings.h"
 
+#include <KLocalizedString>
+
 #include <QCoreApplication>
 #include <QCommandLineParser>
 #include <QStandardPaths>
+#include <QDir>
+#include <QFileInfo>
+#include <QTextStream>
+#include <QUrl>
 
 int main(int argc, char *argv[])
 {
     QCoreApplication app(argc, argv);
 
+    KLocalizedString::setApplicationDomain(QByteArrayLiteral("elisa"));
+
     qRegisterMetaType<QHash<QString,QUrl>>("QHash<QString,QUrl>");
     qRegisterMetaType<QList<qulonglong>>("QList<qulonglong>");
     qRegisterMetaType<QHash<qulonglong,int>>("QHash<qulonglong,int>");
@@ -25,18 +33,111 @@ int main(int argc, char *argv[])
     qRegisterMetaType<QMap<QString,int>>("QMap<QString,int>");
     qRegisterMetaType<QHash<QUrl,QDateTime>>("QHash<QUrl,QDateTime>");
     qRegisterMetaType<DataTypes::ListTrackDataType>("DataTypes::ListTrackDataType");
+    qRegisterMetaType<DataTypes::DirectoryFingerprints>("DataTypes::DirectoryFingerprints");
 
     QCommandLineParser parser;
     parser.addHelpOption();
     parser.addVersionOption();
+
+    const QCommandLineOption batchOption(QStringLiteral("batch"),
+                                         i18nc("@info:shell", "Index the collection and quit, without the rest of the application. Implied by the other options."));
+    const QCommandLineOption rootPathOption({QStringLiteral("r"), QStringLiteral("root-path")},
+                                           i18nc("@info:shell", "Index this directory instead of the configured ones. Can be repeated."),
+                                           i18nc("@info:shell value name of a command line option", "path"));
+    const QCommandLineOption databaseOption({QStringLiteral("d"), QStringLiteral("database")},
+                                            i18nc("@info:shell", "Database file to create or update."),
+                                            i18nc("@info:shell value name of a command line option", "file"));
+    const QCommandLineOption workersOption({QStringLiteral("w"), QStringLiteral("workers")},
+                                           i18nc("@info:shell", "Number of threads reading the metadata of the files, 0 for one per core."),
+                                           i18nc("@info:shell value name of a command line option", "count"));
+    const QCommandLineOption batchSizeOption(QStringLiteral("batch-size"),
+                                             i18nc("@info:shell", "Number of tracks inserted in one transaction, 0 to adapt it to the speed of the database."),
+                                             i18nc("@info:shell value name of a command line option", "count"));
+
+    parser.addOptions({batchOption, rootPathOption, databaseOption, workersOption, batchSizeOption});
     parser.process(app);
 
-    MusicListenersManager myMusicManager;
-    ElisaImportApplication myApplication;
+    const auto batchMode = parser.isSet(batchOption) || parser.isSet(rootPathOption) || parser.isSet(databaseOption) ||
+            parser.isSet(workersOption) || parser.isSet(batchSizeOption);
+
+    if (!batchMode) {
+        MusicListenersManager myMusicManager;
+        ElisaImportApplication myApplication;
+
+        QObject::connect(&myMusicManager, &MusicListenersManager::indexerBusyChanged,
+                &myApplication, &ElisaImportApplication::indexingChanged);
+
+        return app.exec();
+    }
+
+    QTextStream errorOutput(stderr);
+
+    const auto countValue = [&parser, &errorOutput](const QCommandLineOption &option, int &value) {
+        if (!parser.isSet(option)) {
+            return true;
+        }
+
+        auto conversionResult = false;
+        value = parser.value(option).toInt(&conversionResult);
+        if (!conversionResult || value < 0) {
+            errorOutput << i18nc("@info:shell %1 is a command line option, %2 its value", "Invalid value for --%1: %2",
+                                 option.names().constLast(), parser.value(option)) << Qt::endl;
+            return false;
+        }
 
-    QObject::connect(&myMusicManager, &MusicListenersManager::indexerBusyChanged,
-            &myApplication, &ElisaImportApplication::indexingChanged);
+        return true;
+    };
+
+    auto workersCount = Elisa::ElisaConfiguration::self()->indexerWorkersCount();
+    auto batchSize = 0;
+    if (!countValue(workersOption, workersCount) || !countValue(batchSizeOption, batchSize)) {
+        return 1;
+    }
+
+    const auto inputRootPaths = parser.isSet(rootPathOption) ? parser.values(rootPathOption) : Elisa::ElisaConfiguration::rootPath();
+
+    // the root paths are resolved like the configured ones
+    QStringList allRootPaths;
+    for (const auto &onePath : inputRootPaths) {
+        auto workPath = onePath;
+        if (workPath.startsWith(QLatin1String("file:/"))) {
+            workPath = QUrl{workPath}.toLocalFile();
+        }
+
+        auto directoryPath = QFileInfo(workPath).canonicalFilePath();
+        if (directoryPath.isEmpty() || !QFileInfo(directoryPath).isDir()) {
+            errorOutput << i18nc("@info:shell", "Not a directory: %1", onePath) << Qt::endl;
+            return 1;
+        }
+
+        if (!directoryPath.endsWith(QLatin1Char('/'))) {
+            directoryPath.append(QLatin1Char('/'));
+        }
+        allRootPaths.push_back(directoryPath);
+    }
+
+    if (allRootPaths.isEmpty()) {
+        errorOutput << i18nc("@info:shell", "No directory to index") << Qt::endl;
+        return 1;
+    }
+
+    auto databaseFileName = QString();
+    if (parser.isSet(databaseOption)) {
+        databaseFileName = QFileInfo(parser.value(databaseOption)).absoluteFilePath();
+    } else {
+        const auto &localDataPaths = QStandardPaths::standardLocations(QStandardPaths::AppDataLocation);
+        if (!localDataPaths.isEmpty()) {
+            databaseFileName = localDataPaths.first() + QStringLiteral("/elisaDatabase.db");
+        }
+    }
+
+    if (databaseFileName.isEmpty() || !QDir().mkpath(QFileInfo(databaseFileName).absolutePath())) {
+        errorOutput << i18nc("@info:shell", "Cannot create the database file %1", databaseFileName) << Qt::endl;
+        return 1;
+    }
+
+    ElisaImportApplication myApplication;
+    myApplication.startBatchIndexing(allRootPaths, databaseFileName, workersCount, batchSize);
 
     return app.exec();
 }
-
@@ -6,10 +6,82 @@
 
 #include "elisaimportapplication.h"
 
+#include "databaseinterface.h"
+#include "file/filelistener.h"
+#include "abstractfile/abstractfilelisting.h"
+#include "elisa_settings.h"
+
+#include <KLocalizedString>
+
 #include <QCoreApplication>
+#include <QElapsedTimer>
+#include <QLocale>
+#include <QTextStream>
+#include <QThread>
+
+class ElisaImportApplicationPrivate
+{
+public:
+
+    QThread mDatabaseThread;
+
+    std::unique_ptr<DatabaseInterface> mDatabaseInterface;
+
+    std::unique_ptr<FileListener> mFileListener;
+
+    QStringList mRootPaths;
+
+    QString mDatabaseFileName;
+
+    int mBatchSize = 0;
+
+    int mDatabaseErrorsCount = 0;
+
+    QElapsedTimer mIndexingTime;
 
-ElisaImportApplication::ElisaImportApplication(QObject *parent) : QObject(parent)
+    bool mBatchIndexingFinished = false;
+
+};
+
+ElisaImportApplication::ElisaImportApplication(QObject *parent) : QObject(parent), d(std::make_unique<ElisaImportApplicationPrivate>())
+{
+}
+
+ElisaImportApplication::~ElisaImportApplication()
 {
+    d->mFileListener.reset();
+
+    d->mDatabaseThread.quit();
+    d->mDatabaseThread.wait();
+}
+
+void ElisaImportApplication::startBatchIndexing(const QStringList &rootPaths, const QString &databaseFileName, int workersCount, int batchSize)
+{
+    d->mRootPaths = rootPaths;
+    d->mDatabaseFileName = databaseFileName;
+    d->mBatchSize = batchSize;
+    d->mIndexingTime.start();
+
+    // only changed in memory: the configuration of the application is not saved
+    Elisa::ElisaConfiguration::self()->setScanAtStartup(true);
+    Elisa::ElisaConfiguration::self()->setIndexerWorkersCount(workersCount);
+
+    d->mDatabaseInterface = std::make_unique<DatabaseInterface>();
+
+    // no model reads the changes of the collection
+    d->mDatabaseInterface->setChangesNotificationEnabled(false);
+    d->mDatabaseInterface->moveToThread(&d->mDatabaseThread);
+
+    connect(d->mDatabaseInterface.get(), &DatabaseInterface::requestsInitDone,
+            this, &ElisaImportApplication::databaseReady);
+    connect(d->mDatabaseInterface.get(), &DatabaseInterface::databaseError, this, [this]() {
+        ++d->mDatabaseErrorsCount;
+    });
+
+    d->mDatabaseThread.start();
+
+    QMetaObject::invokeMethod(d->mDatabaseInterface.get(), "init", Qt::QueuedConnection,
+                              Q_ARG(QString, QStringLiteral("batchImport")), Q_ARG(QString, databaseFileName));
 }
 
 void ElisaImportApplication::indexingChanged()
@@ -23,5 +95,74 @@ void ElisaImportApplication::indexingChanged()
     }
 }
 
+void ElisaImportApplication::databaseReady()
+{
+    if (d->mFileListener) {
+        return;
+    }
+
+    d->mFileListener = std::make_unique<FileListener>();
+    d->mFileListener->setDatabaseInterface(d->mDatabaseInterface.get());
+    d->mFileListener->setAllRootPaths(d->mRootPaths);
+    d->mFileListener->fileListing()->setInsertionBatchSize(d->mBatchSize);
+    // the application quits at the end of the scan: the changes of the files are never indexed
+    d->mFileListener->fileListing()->setFileSystemWatchingEnabled(false);
+
+    connect(d->mFileListener.get(), &FileListener::indexingFinished,
+            this, &ElisaImportApplication::batchIndexingFinished);
+
+    QMetaObject::invokeMethod(d->mFileListener->fileListing(), "init", Qt::QueuedConnection);
+}
+
+void ElisaImportApplication::batchIndexingFinished()
+{
+    if (d->mBatchIndexingFinished) {
+        return;
+    }
+
+    d->mBatchIndexingFinished = true;
+
+    // the database handles this call after the batches sent before the end of the scan
+    QMetaObject::invokeMethod(d->mDatabaseInterface.get(), [this]() {
+        QMetaObject::invokeMethod(this, [this]() {
+            printStatistics();
+            QCoreApplication::exit(d->mDatabaseErrorsCount == 0 ? 0 : 1);
+        }, Qt::QueuedConnection);
+    }, Qt::QueuedConnection);
+}
+
+void ElisaImportApplication::printStatistics()
+{
+    const auto statistics = d->mFileListener->fileListing()->insertionStatistics();
+    const auto elapsedTime = d->mIndexingTime.elapsed();
+    const auto tracksPerSecond = elapsedTime > 0 ? 1000. * static_cast<double>(statistics.mInsertedTracks) / static_cast<double>(elapsedTime) : 0.;
+
+    QTextStream output(stdout);
+    const QLocale locale;
+
+    // the statistics are read by the user, not parsed: they are translated
+    output << i18nc("@info:shell %1 is a list of directories, %2 is a file", "Indexed %1 into %2", d->mRootPaths.join(QStringLiteral(", ")), d->mDatabaseFileName)
+           << Qt::endl;
+    output << i18ncp("@info:shell %2 is a duration in seconds",
+                     "%1 track in %2 s: %3 tracks/s",
+                     "%1 tracks in %2 s: %3 tracks/s",
+                     statistics.mInsertedTracks,
+                     locale.toString(static_cast<double>(elapsedTime) / 1000., 'f', 1),
+                     locale.toString(tracksPerSecond, 'f', 0))
+           << Qt::endl;
+    output << i18ncp("@info:shell %1 is a number of tracks per second, %3 is a duration in milliseconds",
+                     "Database: %1 tracks/s, batches of %2 track, last batch inserted in %3 ms",
+                     "Database: %1 tracks/s, batches of %2 tracks, last batch inserted in %3 ms",
+                     statistics.mBatchSize,
+                     locale.toString(statistics.mTracksPerSecond, 'f', 0),
+                     statistics.mLastBatchLatency)
+           << Qt::endl;
+    output << i18nc("@info:shell %1 is a duration in milliseconds", "Scan waited %1 ms for the database", statistics.mWaitingTime) << Qt::endl;
+
+    if (d->mDatabaseErrorsCount > 0) {
+        output << i18ncp("@info:shell", "%1 database error", "%1 database errors", d->mDatabaseErrorsCount) << Qt::endl;
+    }
+}
+
 
 #include "moc_elisaimportapplication.cpp"
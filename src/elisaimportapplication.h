@@ -8,6 +8,11 @@
 #define ELISAIMPORTAPPLICATION_H
 
 #include <QObject>
+#include <QStringList>
+
+#include <memory>
+
+class ElisaImportApplicationPrivate;
 
 class ElisaImportApplication : public QObject
 {
@@ -15,12 +20,33 @@ class ElisaImportApplication : public QObject
 public:
     explicit ElisaImportApplication(QObject *parent = nullptr);
 
+    ~ElisaImportApplication() override;
+
+    /**
+     * Index the root paths into the database file with only the file indexer and the database,
+     * then print the throughput of the import and quit
+     * A workers count of 0 uses one worker per core, a batch size of 0 sizes the batches by the insertion latency.
+     */
+    void startBatchIndexing(const QStringList &rootPaths, const QString &databaseFileName, int workersCount, int batchSize);
+
 Q_SIGNALS:
 
 public Q_SLOTS:
 
     void indexingChanged();
 
+private Q_SLOTS:
+
+    void databaseReady();
+
+    void batchIndexingFinished();
+
+private:
+
+    void printStatistics();
+
+    std::unique_ptr<ElisaImportApplicationPrivate> d;
+
 };
 
 #endif // ELISAIMPORTAPPLICATION_H
@@ -57,7 +57,7 @@ void LocalFileListing::triggerRefreshOfContent()
 
     const auto &rootPaths = allRootPaths();
     for (const auto &onePath : rootPaths) {
-        scanDirectoryTree(onePath);
+        scanRootDirectoryTree(onePath);
     }
 
     setWaitEndTrackRemoval(false);
@@ -73,15 +73,13 @@ void LocalFileListing::triggerStop()
     AbstractFileListing::triggerStop();
 }
 
-DataTypes::TrackDataType LocalFileListing::scanOneFile(const QUrl &scanFile, const QFileInfo &scanFileInfo, FileSystemWatchingModes watchForFileSystemChanges)
+DataTypes::TrackDataType LocalFileListing::scannedOneFile(const QUrl &scanFile, const DataTypes::TrackDataType &scannedTrack)
 {
-    auto trackData = AbstractFileListing::scanOneFile(scanFile, scanFileInfo, watchForFileSystemChanges);
-
-    if (!trackData.isValid()) {
-        qCDebug(orgKdeElisaIndexer()) << "LocalFileListing::scanOneFile" << scanFile << "invalid track";
+    if (!scannedTrack.isValid()) {
+        qCDebug(orgKdeElisaIndexer()) << "LocalFileListing::scannedOneFile" << scanFile << "invalid track";
     }
 
-    return trackData;
+    return scannedTrack;
 }
 
 
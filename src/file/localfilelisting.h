@@ -35,7 +35,7 @@ private:
 
     void triggerStop() override;
 
-    DataTypes::TrackDataType scanOneFile(const QUrl &scanFile, const QFileInfo &scanFileInfo, FileSystemWatchingModes watchForFileSystemChanges) override;
+    DataTypes::TrackDataType scannedOneFile(const QUrl &scanFile, const DataTypes::TrackDataType &scannedTrack) override;
 
     std::unique_ptr<LocalFileListingPrivate> d;
 
@@ -10,8 +10,12 @@
 
 #include "abstractfile/indexercommon.h"
 
+#include "coverfilecache.h"
+#include "stringpool.h"
+
 #if KFFileMetaData_FOUND
 
+#include <KFileMetaData/EmbeddedImageData>
 #include <KFileMetaData/Extractor>
 #include <KFileMetaData/ExtractorCollection>
 #include <KFileMetaData/MimeUtils>
@@ -26,6 +30,10 @@
 #include <QHash>
 #include <QLocale>
 #include <QMimeDatabase>
+#include <QRegularExpression>
+
+#include <algorithm>
+#include <iterator>
 
 QStringList buildCoverFileNames(const QStringList &fileNames, const QStringList &fileExtensions)
 {
@@ -38,6 +46,77 @@ QStringList buildCoverFileNames(const QStringList &fileNames, const QStringList
     return covers;
 }
 
+namespace
+{
+QList<QRegularExpression> buildCoverFileMatchers(const QStringList &patterns)
+{
+    QList<QRegularExpression> matchers;
+    matchers.reserve(patterns.size());
+    for (const auto &pattern : patterns) {
+        // same matching as the name filters of QDir
+        matchers.push_back(QRegularExpression{QRegularExpression::wildcardToRegularExpression(pattern, QRegularExpression::NonPathWildcardConversion),
+                                              QRegularExpression::CaseInsensitiveOption});
+    }
+    return matchers;
+}
+
+QStringList matchingFileNames(const QStringList &fileNames, const QList<QRegularExpression> &matchers)
+{
+    QStringList result;
+    std::copy_if(fileNames.cbegin(), fileNames.cend(), std::back_inserter(result), [&matchers](const auto &fileName) {
+        return std::any_of(matchers.cbegin(), matchers.cend(), [&fileName](const auto &matcher) {
+            return matcher.match(fileName).hasMatch();
+        });
+    });
+    return result;
+}
+}
+
+#if KFFileMetaData_FOUND
+namespace
+{
+// values repeated by many tracks of a collection
+bool isPooledRole(DataTypes::ColumnsRoles role)
+{
+    switch (role)
+    {
+    case DataTypes::ArtistRole:
+    case DataTypes::AlbumRole:
+    case DataTypes::AlbumArtistRole:
+    case DataTypes::GenreRole:
+    case DataTypes::ComposerRole:
+    case DataTypes::LyricistRole:
+        return true;
+    default:
+        return false;
+    }
+}
+
+// keep the tags but only remember if the file has embedded pictures
+class TagsAndCoverExtractionResult : public KFileMetaData::SimpleExtractionResult
+{
+public:
+    TagsAndCoverExtractionResult(const QString &url, const QString &mimetype, Flags flags)
+        : KFileMetaData::SimpleExtractionResult(url, mimetype, flags)
+    {
+    }
+
+    void addImageData(QMap<KFileMetaData::EmbeddedImageData::ImageType, QByteArray> &&images) override
+    {
+        mHasEmbeddedCover = mHasEmbeddedCover || !images.isEmpty();
+    }
+
+    [[nodiscard]] bool hasEmbeddedCover() const
+    {
+        return mHasEmbeddedCover;
+    }
+
+private:
+    bool mHasEmbeddedCover = false;
+};
+}
+#endif
+
 class FileScannerPrivate
 {
 public:
@@ -97,6 +176,10 @@ public:
     const QStringList coverFileAllImages = buildCoverFileNames({QStringLiteral("*")}, constCoverExtensions);
     const QStringList coverFileNames = buildCoverFileNames(constCoverNames, constCoverExtensions);
     const QStringList coverFileGlobs = buildCoverFileNames(constCoverGlobs, constCoverExtensions);
+
+    const QList<QRegularExpression> coverFileAllImagesMatchers = buildCoverFileMatchers(coverFileAllImages);
+    const QList<QRegularExpression> coverFileNamesMatchers = buildCoverFileMatchers(coverFileNames);
+    const QList<QRegularExpression> coverFileGlobsMatchers = buildCoverFileMatchers(coverFileGlobs);
 };
 
 FileScanner::FileScanner() : d(std::make_unique<FileScannerPrivate>())
@@ -135,6 +218,7 @@ DataTypes::TrackDataType FileScanner::scanOneFile(const QUrl &scanFile, const QF
     const auto fileMimeType = KFileMetaData::MimeUtils::strictMimeType(localFileName, d->mMimeDb);
     const auto mimetype = fileMimeType.name();
     if (!mimetype.startsWith(QLatin1String("audio/"))) {
+        qCDebug(orgKdeElisaIndexer()) << "FileScanner::scanOneFile" << scanFile << "invalid mime type" << mimetype;
         return newTrack;
     }
 
@@ -155,15 +239,16 @@ DataTypes::TrackDataType FileScanner::scanOneFile(const QUrl &scanFile, const QF
         return newTrack;
     }
 
+    // one parse of the file gives the tags and tells if there are embedded pictures
     KFileMetaData::Extractor* ex = exList.first();
-    KFileMetaData::SimpleExtractionResult result(localFileName, mimetype,
-                                                 KFileMetaData::ExtractionResult::ExtractMetaData);
+    TagsAndCoverExtractionResult result(localFileName, mimetype,
+                                        KFileMetaData::ExtractionResult::ExtractMetaData | KFileMetaData::ExtractionResult::ExtractImageData);
 
     ex->extract(&result);
 
     d->mAllProperties = result.properties();
 
-    scanProperties(localFileName, newTrack);
+    scanProperties(localFileName, mimetype, result.hasEmbeddedCover(), newTrack);
 
     qCDebug(orgKdeElisaIndexer()) << "scanOneFile" << scanFile << "using KFileMetaData" << newTrack;
 #else
@@ -186,7 +271,8 @@ DataTypes::TrackDataType FileScanner::scanOneFile(const QUrl &scanFile)
     }
 }
 
-void FileScanner::scanProperties(const QString &localFileName, DataTypes::TrackDataType &trackData)
+void FileScanner::scanProperties(const QString &localFileName, const QString &mimeType, bool hasEmbeddedCover,
+                                 DataTypes::TrackDataType &trackData)
 {
 #if KFFileMetaData_FOUND
     if (d->mAllProperties.isEmpty()) {
@@ -211,11 +297,13 @@ void FileScanner::scanProperties(const QString &localFileName, DataTypes::TrackD
         } else {
             value = (*rangeBegin).second;
         }
-        if (d->propertyTranslation.contains(key)) {
-            const auto &translatedKey = d->propertyTranslation.find(key);
+        const auto translatedKey = d->propertyTranslation.constFind(key);
+        if (translatedKey != d->propertyTranslation.cend()) {
             if (translatedKey.value() == DataTypes::DurationRole) {
                 trackData.insert(translatedKey.value(), QTime::fromMSecsSinceStartOfDay(int(1000 * (*rangeBegin).second.toDouble())));
-            } else if (translatedKey != d->propertyTranslation.end()) {
+            } else if (isPooledRole(translatedKey.value())) {
+                trackData.insert(translatedKey.value(), StringPool::intern((*rangeBegin).second.toString()));
+            } else {
                 trackData.insert(translatedKey.value(), (*rangeBegin).second);
             }
         }
@@ -226,7 +314,7 @@ void FileScanner::scanProperties(const QString &localFileName, DataTypes::TrackD
         return;
     }
 
-    if (checkEmbeddedCoverImage(localFileName)) {
+    if (hasEmbeddedCover || checkEmbeddedCoverImage(localFileName, mimeType)) {
         trackData[DataTypes::HasEmbeddedCover] = true;
         trackData[DataTypes::ImageUrlRole] = QUrl(QLatin1String("image://cover/") + localFileName);
     } else {
@@ -249,6 +337,8 @@ void FileScanner::scanProperties(const QString &localFileName, DataTypes::TrackD
 
 #else
     Q_UNUSED(localFileName)
+    Q_UNUSED(mimeType)
+    Q_UNUSED(hasEmbeddedCover)
     Q_UNUSED(trackData)
 #endif
 }
@@ -256,73 +346,82 @@ void FileScanner::scanProperties(const QString &localFileName, DataTypes::TrackD
 QUrl FileScanner::searchForCoverFile(const QString &localFileName)
 {
     const QFileInfo trackFilePath(localFileName);
-    QDir trackFileDir = trackFilePath.absoluteDir();
+    const auto directoryPath = trackFilePath.absoluteDir().path();
 
-    static QHash<QString, QUrl> directoryCache;
-    if (directoryCache.contains(trackFileDir.path())) {
-        return directoryCache.value(trackFileDir.path());
+    if (const auto cachedCoverFile = CoverFileCache::find(directoryPath)) {
+        return *cachedCoverFile;
     }
 
-    trackFileDir.setFilter(QDir::Files);
-    trackFileDir.setNameFilters(d->coverFileAllImages);
-    QFileInfoList coverFiles = trackFileDir.entryInfoList();
+    const QDir trackFileDir(directoryPath);
 
-    if (coverFiles.isEmpty()) {
-        directoryCache.insert(trackFileDir.path(), QUrl());
-        return QUrl();
+    return cacheCoverFile(directoryPath, trackFileDir.entryList(QDir::Files));
+}
+
+QUrl FileScanner::cacheCoverFile(const QString &directoryPath, const QStringList &directoryFileNames)
+{
+    const auto coverFile = coverFileFromListing(directoryPath, directoryFileNames);
+
+    CoverFileCache::insert(directoryPath, coverFile);
+
+    return coverFile;
+}
+
+QUrl FileScanner::coverFileFromListing(const QString &directoryPath, const QStringList &directoryFileNames) const
+{
+    const auto allImages = matchingFileNames(directoryFileNames, d->coverFileAllImagesMatchers);
+
+    if (allImages.isEmpty()) {
+        return {};
     }
 
-    if (coverFiles.length() != 1) {
-        trackFileDir.setNameFilters(d->coverFileNames);
-        coverFiles = trackFileDir.entryInfoList();
+    auto coverFiles = allImages;
+
+    if (coverFiles.size() != 1) {
+        coverFiles = matchingFileNames(allImages, d->coverFileNamesMatchers);
     }
 
     if (coverFiles.isEmpty()) {
-        trackFileDir.setNameFilters(d->coverFileGlobs);
-        coverFiles = trackFileDir.entryInfoList();
+        coverFiles = matchingFileNames(allImages, d->coverFileGlobsMatchers);
     }
 
+    const QDir trackFileDir(directoryPath);
+
     if (coverFiles.isEmpty()) {
         const QString dirNamePattern = QLatin1String("*") + trackFileDir.dirName() + QLatin1String("*");
         const QString dirNameNoSpaces = QLatin1String("*") + trackFileDir.dirName().remove(QLatin1Char(' ')) + QLatin1String("*");
-        auto filters = buildCoverFileNames({dirNamePattern, dirNameNoSpaces}, d->constCoverExtensions);
-        trackFileDir.setNameFilters(filters);
-        coverFiles = trackFileDir.entryInfoList();
+        const auto filters = buildCoverFileNames({dirNamePattern, dirNameNoSpaces}, d->constCoverExtensions);
+        coverFiles = matchingFileNames(allImages, buildCoverFileMatchers(filters));
     }
 
     if (coverFiles.isEmpty()) {
-        trackFileDir.setNameFilters(d->coverFileAllImages);
-        coverFiles = trackFileDir.entryInfoList();
+        coverFiles = allImages;
     }
 
-    if (coverFiles.isEmpty()) {
-        directoryCache.insert(trackFileDir.path(), QUrl());
-        return QUrl();
-    }
+    // first file in the order QDir sorts names: ignoring case
+    const auto itCoverFile = std::min_element(coverFiles.cbegin(), coverFiles.cend(), [](const auto &fileName1, const auto &fileName2) {
+        return fileName1.compare(fileName2, Qt::CaseInsensitive) < 0;
+    });
 
-    const QUrl url = QUrl::fromLocalFile(coverFiles.first().absoluteFilePath());
-    directoryCache.insert(trackFileDir.path(), url);
-
-    return url;
+    return QUrl::fromLocalFile(trackFileDir.absoluteFilePath(*itCoverFile));
 }
 
-bool FileScanner::checkEmbeddedCoverImage(const QString &localFileName)
+bool FileScanner::checkEmbeddedCoverImage(const QString &localFileName, const QString &mimeType)
 {
 #if KFFileMetaData_FOUND
-    const auto fileMimeType = KFileMetaData::MimeUtils::strictMimeType(localFileName, d->mMimeDb);
-    const auto mimeType = fileMimeType.name();
     const auto extractors = d->mAllExtractors.fetchExtractors(mimeType);
 
-    for (const auto &extractor : extractors) {
-        KFileMetaData::SimpleExtractionResult result(localFileName, mimeType, KFileMetaData::ExtractionResult::ExtractImageData);
+    // the first extractor already looked for pictures while reading the tags
+    for (const auto &extractor : extractors.mid(1)) {
+        TagsAndCoverExtractionResult result(localFileName, mimeType, KFileMetaData::ExtractionResult::ExtractImageData);
         extractor->extract(&result);
-        if (!result.imageData().isEmpty()) {
+        if (result.hasEmbeddedCover()) {
             return true;
         }
     }
 
 #else
     Q_UNUSED(localFileName)
+    Q_UNUSED(mimeType)
 #endif
 
     return false;
@@ -11,6 +11,8 @@
 
 #include "datatypes.h"
 
+#include <QStringList>
+
 #include <memory>
 
 class QFileInfo;
@@ -33,11 +35,20 @@ public:
 
     QUrl searchForCoverFile(const QString &localFileName);
 
+    /**
+     * Find the cover file of a directory from the names of its files and remember it
+     * for the tracks of this directory
+     */
+    QUrl cacheCoverFile(const QString &directoryPath, const QStringList &directoryFileNames);
+
 private:
 
-    void scanProperties(const QString &localFileName, DataTypes::TrackDataType &trackData);
+    [[nodiscard]] QUrl coverFileFromListing(const QString &directoryPath, const QStringList &directoryFileNames) const;
+
+    void scanProperties(const QString &localFileName, const QString &mimeType, bool hasEmbeddedCover,
+                        DataTypes::TrackDataType &trackData);
 
-    bool checkEmbeddedCoverImage(const QString &localFileName);
+    bool checkEmbeddedCoverImage(const QString &localFileName, const QString &mimeType);
 
     std::unique_ptr<FileScannerPrivate> d;
 
@@ -26,14 +26,219 @@
 #endif
 
 #include <algorithm>
+#include <numeric>
 
 using namespace Qt::Literals::StringLiterals;
 
+namespace
+{
+
+/**
+ * Sums of the first values of a list in O(log n), also updated in O(log n) when one value changes
+ */
+class PrefixSums
+{
+public:
+
+    void assign(QList<qint64> values)
+    {
+        // each node also sums the values of the nodes that precede it and end at its position
+        for (qsizetype position = 1; position <= values.size(); ++position) {
+            const auto parentPosition = position + (position & -position);
+            if (parentPosition <= values.size()) {
+                values[parentPosition - 1] += values[position - 1];
+            }
+        }
+
+        mTree = std::move(values);
+    }
+
+    void add(qsizetype position, qint64 delta)
+    {
+        for (auto node = position + 1; node <= mTree.size(); node += node & -node) {
+            mTree[node - 1] += delta;
+        }
+    }
+
+    /**
+     * Sum of the values before position
+     */
+    [[nodiscard]] qint64 sumBefore(qsizetype position) const
+    {
+        qint64 result = 0;
+
+        for (auto node = std::min(position, mTree.size()); node > 0; node -= node & -node) {
+            result += mTree[node - 1];
+        }
+
+        return result;
+    }
+
+private:
+
+    QList<qint64> mTree;
+
+};
+
+/**
+ * Shuffled order of the rows [0, count) computed on demand from a seed, O(1) in memory
+ * A balanced Feistel network permutes the smallest power of 4 not below the rows count: the values
+ * outside of the rows are sent again through the network until they fall inside (cycle walking).
+ * The source row shown first can be chosen, it is swapped with the row it would otherwise be at.
+ */
+class LazyShuffle
+{
+public:
+
+    void reset(int rowsCount, quint64 seed, int firstSourceRow)
+    {
+        mRowsCount = rowsCount;
+        mSeed = seed;
+
+        mHalfBits = 1;
+        while ((quint64{1} << (2 * mHalfBits)) < static_cast<quint64>(rowsCount)) {
+            ++mHalfBits;
+        }
+        mHalfMask = (quint64{1} << mHalfBits) - 1;
+
+        mSwappedSourceRow = permute(0);
+        mFirstSourceRow = firstSourceRow >= 0 && firstSourceRow < rowsCount ? firstSourceRow : mSwappedSourceRow;
+        mSwappedProxyRow = unpermute(mFirstSourceRow);
+    }
+
+    void clear()
+    {
+        mRowsCount = 0;
+    }
+
+    [[nodiscard]] bool isActive() const
+    {
+        return mRowsCount > 0;
+    }
+
+    [[nodiscard]] int rowsCount() const
+    {
+        return mRowsCount;
+    }
+
+    [[nodiscard]] quint64 seed() const
+    {
+        return mSeed;
+    }
+
+    [[nodiscard]] int firstSourceRow() const
+    {
+        return mFirstSourceRow;
+    }
+
+    [[nodiscard]] int sourceRow(int proxyRow) const
+    {
+        if (proxyRow < 0 || proxyRow >= mRowsCount) {
+            return -1;
+        }
+        if (proxyRow == 0) {
+            return mFirstSourceRow;
+        }
+        if (proxyRow == mSwappedProxyRow) {
+            return mSwappedSourceRow;
+        }
+        return permute(proxyRow);
+    }
+
+    [[nodiscard]] int proxyRow(int sourceRow) const
+    {
+        if (sourceRow < 0 || sourceRow >= mRowsCount) {
+            return -1;
+        }
+        if (sourceRow == mFirstSourceRow) {
+            return 0;
+        }
+        if (sourceRow == mSwappedSourceRow) {
+            return mSwappedProxyRow;
+        }
+        return unpermute(sourceRow);
+    }
+
+private:
+
+    [[nodiscard]] quint64 roundValue(int round, quint64 halfValue) const
+    {
+        // splitmix64 finalizer
+        auto value = mSeed ^ (static_cast<quint64>(round) << 32) ^ halfValue;
+        value += 0x9e3779b97f4a7c15ULL;
+        value = (value ^ (value >> 30)) * 0xbf58476d1ce4e5b9ULL;
+        value = (value ^ (value >> 27)) * 0x94d049bb133111ebULL;
+        return (value ^ (value >> 31)) & mHalfMask;
+    }
+
+    [[nodiscard]] int permute(int row) const
+    {
+        auto value = static_cast<quint64>(row);
+
+        do {
+            auto left = value >> mHalfBits;
+            auto right = value & mHalfMask;
+            for (int round = 0; round < mRoundsCount; ++round) {
+                const auto newRight = left ^ roundValue(round, right);
+                left = right;
+                right = newRight;
+            }
+            value = (left << mHalfBits) | right;
+        } while (value >= static_cast<quint64>(mRowsCount));
+
+        return static_cast<int>(value);
+    }
+
+    [[nodiscard]] int unpermute(int row) const
+    {
+        auto value = static_cast<quint64>(row);
+
+        do {
+            auto left = value >> mHalfBits;
+            auto right = value & mHalfMask;
+            for (int round = mRoundsCount - 1; round >= 0; --round) {
+                const auto previousLeft = right ^ roundValue(round, left);
+                right = left;
+                left = previousLeft;
+            }
+            value = (left << mHalfBits) | right;
+        } while (value >= static_cast<quint64>(mRowsCount));
+
+        return static_cast<int>(value);
+    }
+
+    static constexpr int mRoundsCount = 4;
+
+    int mRowsCount = 0;
+
+    quint64 mSeed = 0;
+
+    int mHalfBits = 1;
+
+    quint64 mHalfMask = 1;
+
+    int mFirstSourceRow = 0;
+
+    int mSwappedProxyRow = 0;
+
+    int mSwappedSourceRow = 0;
+
+};
+
+struct EntryAggregate
+{
+    int mDuration = 0;
+
+    bool mIsRadio = false;
+};
+
+}
+
 class MediaPlayListProxyModelPrivate
 {
 public:
 
-    MediaPlayList* mPlayListModel;
+    MediaPlayList* mPlayListModel = nullptr;
 
     QPersistentModelIndex mPreviousTrack;
 
@@ -64,6 +269,80 @@ public:
     QUrl mLoadedPlayListUrl;
 
     QTimer mDurationChangedTimer;
+
+    // duration and type of the entries of the playlist, in the order of the source model
+    QList<EntryAggregate> mSourceEntries;
+
+    qint64 mTotalDuration = 0;
+
+    int mRadioCount = 0;
+
+    // durations in the order of the proxy: a cache of remainingTracksDuration(), that is const and rebuilds it
+    // on its next call after rows are added, removed or moved
+    mutable PrefixSums mProxyDurations;
+
+    mutable bool mProxyDurationsOutdated = true;
+
+    // proxy row of each source row when shuffled: a cache of the const mapRowFromSource(), that rebuilds it on
+    // its next call after mRandomMapping changes
+    mutable QList<int> mInverseRandomMapping;
+
+    mutable bool mInverseRandomMappingOutdated = true;
+
+    // order of the track shuffle until the rows of the playlist change, mRandomMapping is then built from it
+    LazyShuffle mLazyShuffle;
+
+    void materializeLazyShuffle()
+    {
+        if (!mLazyShuffle.isActive()) {
+            return;
+        }
+
+        mRandomMapping.resize(mLazyShuffle.rowsCount());
+        for (int proxyRow = 0; proxyRow < mRandomMapping.size(); ++proxyRow) {
+            mRandomMapping[proxyRow] = mLazyShuffle.sourceRow(proxyRow);
+        }
+
+        mLazyShuffle.clear();
+        randomMappingChanged();
+    }
+
+    // the seed is saved in the playlist state, that QML keeps as a JavaScript number: a double holds 53 bits exactly
+    [[nodiscard]] quint64 newShuffleSeed()
+    {
+        return mRandomGenerator.generate64() >> (64 - 53);
+    }
+
+    void randomMappingChanged()
+    {
+        mInverseRandomMappingOutdated = true;
+        mProxyDurationsOutdated = true;
+    }
+
+    [[nodiscard]] int proxyRowFromRandomMapping(int sourceRow) const
+    {
+        if (mInverseRandomMappingOutdated) {
+            // source rows may be missing while new rows are being inserted
+            const auto maximumSourceRow = mRandomMapping.isEmpty() ? -1 : *std::max_element(mRandomMapping.cbegin(), mRandomMapping.cend());
+
+            mInverseRandomMapping.fill(-1, maximumSourceRow + 1);
+            for (int proxyRow = 0; proxyRow < mRandomMapping.size(); ++proxyRow) {
+                mInverseRandomMapping[mRandomMapping[proxyRow]] = proxyRow;
+            }
+
+            mInverseRandomMappingOutdated = false;
+        }
+
+        return sourceRow >= 0 && sourceRow < mInverseRandomMapping.size() ? mInverseRandomMapping[sourceRow] : -1;
+    }
+
+    [[nodiscard]] EntryAggregate sourceEntryAggregate(int sourceRow) const
+    {
+        const auto sourceIndex = mPlayListModel->index(sourceRow, 0);
+
+        return {mPlayListModel->data(sourceIndex, MediaPlayList::DurationRole).toTime().msecsSinceStartOfDay(),
+                mPlayListModel->data(sourceIndex, MediaPlayList::ElementTypeRole).value<ElisaUtils::PlayListEntryType>() == ElisaUtils::Radio};
+    }
 };
 
 MediaPlayListProxyModel::MediaPlayListProxyModel(QObject *parent) : QAbstractProxyModel (parent),
@@ -131,7 +410,9 @@ QModelIndex MediaPlayListProxyModel::mapToSource(const QModelIndex &proxyIndex)
 
 int MediaPlayListProxyModel::mapRowToSource(const int proxyRow) const
 {
-    if (d->mRandomMapping.size() && d->mShuffleMode != MediaPlayListProxyModel::Shuffle::NoShuffle) {
+    if (d->mLazyShuffle.isActive() && d->mShuffleMode != MediaPlayListProxyModel::Shuffle::NoShuffle) {
+        return d->mLazyShuffle.sourceRow(proxyRow);
+    } else if (d->mRandomMapping.size() && d->mShuffleMode != MediaPlayListProxyModel::Shuffle::NoShuffle) {
         return d->mRandomMapping.at(proxyRow);
     } else {
         return proxyRow;
@@ -140,8 +421,10 @@ int MediaPlayListProxyModel::mapRowToSource(const int proxyRow) const
 
 int MediaPlayListProxyModel::mapRowFromSource(const int sourceRow) const
 {
-    if (d->mShuffleMode != MediaPlayListProxyModel::Shuffle::NoShuffle) {
-        return d->mRandomMapping.indexOf(sourceRow);
+    if (d->mLazyShuffle.isActive() && d->mShuffleMode != MediaPlayListProxyModel::Shuffle::NoShuffle) {
+        return d->mLazyShuffle.proxyRow(sourceRow);
+    } else if (d->mShuffleMode != MediaPlayListProxyModel::Shuffle::NoShuffle) {
+        return d->proxyRowFromRandomMapping(sourceRow);
     } else {
         return sourceRow;
     }
@@ -153,7 +436,7 @@ int MediaPlayListProxyModel::rowCount(const QModelIndex &parent) const
         if (parent.isValid()) {
             return 0;
         }
-        return d->mRandomMapping.count();
+        return d->mLazyShuffle.isActive() ? d->mLazyShuffle.rowsCount() : d->mRandomMapping.count();
     } else {
         return d->mPlayListModel->rowCount(parent);
     }
@@ -211,6 +494,8 @@ void MediaPlayListProxyModel::setPlayListModel(MediaPlayList *playListModel)
         connect(playListModel, &QAbstractItemModel::modelAboutToBeReset, this, &MediaPlayListProxyModel::sourceModelAboutToBeReset);
         connect(playListModel, &QAbstractItemModel::modelReset, this, &MediaPlayListProxyModel::sourceModelReset);
     }
+
+    resetEntryAggregates();
 }
 
 void MediaPlayListProxyModel::setSourceModel(QAbstractItemModel *sourceModel)
@@ -258,96 +543,58 @@ void MediaPlayListProxyModel::setShuffleMode(const MediaPlayListProxyModel::Shuf
         if (playListSize != 0) {
             Q_EMIT layoutAboutToBeChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
 
+            // only the persistent indexes are moved: toggling the track shuffle does not depend on the playlist size
+            const auto persistentSourceRows = persistentIndexSourceRows();
+            const auto currentSourceRow = d->mCurrentTrack.isValid() ? mapRowToSource(d->mCurrentTrack.row()) : -1;
+            const auto currentAlbumId = data(d->mCurrentTrack, MediaPlayList::AlbumIdRole).toInt();
+
             // first, reset playlist to non-random one if it's currently shuffled
-            if (!d->mRandomMapping.isEmpty()) {
-                Q_ASSERT(d->mShuffleMode != MediaPlayListProxyModel::Shuffle::NoShuffle);
-                QModelIndexList from;
-                from.reserve(playListSize);
-                QModelIndexList to;
-                to.reserve(playListSize);
-                for (int i = 0; i < playListSize; ++i) {
-                    to.append(index(d->mRandomMapping.at(i), 0));
-                    from.append(index(i, 0));
-                }
-                changePersistentIndexList(from, to);
+            d->mRandomMapping.clear();
+            d->mLazyShuffle.clear();
 
-                d->mRandomMapping.clear();
-            }
+            if (value == MediaPlayListProxyModel::Shuffle::Track) { // shuffle tracks
+                // the current track is kept first
+                d->mLazyShuffle.reset(playListSize, d->newShuffleSeed(), currentSourceRow);
+            } else if (value == MediaPlayListProxyModel::Shuffle::Album) { // album shuffle
+                QHash<int, QList<int>> indexPerAlbumId;
 
-            if (value != MediaPlayListProxyModel::Shuffle::NoShuffle) {
-                QModelIndexList from, to;
-                from.reserve(playListSize);
-                to.reserve(playListSize);
+                // Adding the album of the current track first
+                QList<int> albumIds = {currentAlbumId};
+                indexPerAlbumId[currentAlbumId] = {};
 
-                d->mRandomMapping.clear();
-                d->mRandomMapping.reserve(playListSize);
+                // This is used to generate fictive (negative) albumIds for
+                // tracks that don't belong to an album; this will allow to
+                // spread the loose tracks in between full albums rather
+                // than have them artificially grouped together
+                int fictiveAlbumId = -1;
 
                 for (int i = 0; i < playListSize; ++i) {
-                    d->mRandomMapping.append(i);
-                    to.append(index(i,0));
-                }
-
-                if (value == MediaPlayListProxyModel::Shuffle::Track) { // shuffle tracks
-                    // Adding the current track first if it is not the only one
-                    if (playListSize > 1) {
-                        if (currentTrackRow() != 0) {
-                            std::swap(d->mRandomMapping[0], d->mRandomMapping[currentTrackRow()]);
-                        }
-                        from.append(index(d->mRandomMapping.at(0), 0));
+                    int albumId = d->mPlayListModel->data(d->mPlayListModel->index(i, 0), MediaPlayList::AlbumIdRole).toInt();
+                    if (albumId == 0) {
+                        albumId = fictiveAlbumId;
+                        --fictiveAlbumId;
                     }
-                    // Fisher-Yates algorithm
-                    for (int i = 1;  i < playListSize - 1; ++i) {
-                        const int swapIndex = d->mRandomGenerator.bounded(i, playListSize);
-                        std::swap(d->mRandomMapping[i], d->mRandomMapping[swapIndex]);
-                        from.append(index(d->mRandomMapping.at(i), 0));
-                    }
-                    from.append(index(d->mRandomMapping.at(playListSize - 1), 0));
-                } else if (value == MediaPlayListProxyModel::Shuffle::Album) { // album shuffle
-                    QHash<int, QList<int>> indexPerAlbumId;
-                    int currentAlbumId = data(d->mCurrentTrack,  MediaPlayList::AlbumIdRole).toInt();
-
-                    // Adding the album of the current track first
-                    QList<int> albumIds = {currentAlbumId};
-                    indexPerAlbumId[currentAlbumId] = {};
-
-                    // This is used to generate fictive (negative) albumIds for
-                    // tracks that don't belong to an album; this will allow to
-                    // spread the loose tracks in between full albums rather
-                    // than have them artificially grouped together
-                    int fictiveAlbumId = -1;
-
-                    for (int i = 0; i < playListSize; ++i) {
-                        int albumId = data(index(i, 0), MediaPlayList::AlbumIdRole).toInt();
-                        if (albumId == 0) {
-                            albumId = fictiveAlbumId;
-                            --fictiveAlbumId;
-                        }
-                        if (indexPerAlbumId.contains(albumId)) {
-                            indexPerAlbumId[albumId].append(i);
-                        } else {
-                            albumIds.append(albumId);
-                            QList<int> tracks = { i };
-                            indexPerAlbumId[albumId] = tracks;
-                        }
+                    if (indexPerAlbumId.contains(albumId)) {
+                        indexPerAlbumId[albumId].append(i);
+                    } else {
+                        albumIds.append(albumId);
+                        QList<int> tracks = { i };
+                        indexPerAlbumId[albumId] = tracks;
                     }
+                }
 
-                    std::shuffle(++albumIds.begin(), albumIds.end(), d->mRandomGenerator);
+                std::shuffle(++albumIds.begin(), albumIds.end(), d->mRandomGenerator);
 
-                    QList<int> newRandomMapping;
-                    newRandomMapping.reserve(playListSize);
-                    for (int albumId : albumIds) {
-                        const auto &sourceRows = indexPerAlbumId[albumId];
-                        for (int sourceRow : sourceRows) {
-                            from.append(index(sourceRow, 0));
-                            newRandomMapping.append(sourceRow);
-                        }
-                    }
-                    d->mRandomMapping = newRandomMapping;
+                d->mRandomMapping.reserve(playListSize);
+                for (int albumId : albumIds) {
+                    d->mRandomMapping += indexPerAlbumId[albumId];
                 }
-                changePersistentIndexList(from, to);
             }
-            d->mCurrentPlayListPosition = d->mCurrentTrack.row();
+
             d->mShuffleMode = value;
+            d->randomMappingChanged();
+            changePersistentIndexSourceRows(persistentSourceRows);
+            d->mCurrentPlayListPosition = d->mCurrentTrack.row();
             Q_EMIT layoutChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
             determineAndNotifyPreviousAndNextTracks();
         } else {
@@ -380,17 +627,17 @@ void MediaPlayListProxyModel::sourceRowsAboutToBeInserted(const QModelIndex &par
 
 void MediaPlayListProxyModel::sourceRowsInserted(const QModelIndex &parent, int start, int end)
 {
+    insertEntryAggregates(start, end);
+    d->materializeLazyShuffle();
+
     if (d->mShuffleMode == MediaPlayListProxyModel::Shuffle::Track) { // track shuffle
         const auto newItemsCount = end - start + 1;
         d->mRandomMapping.reserve(rowCount() + newItemsCount);
 
         if (rowCount() == 0) {
             beginInsertRows(parent, start, end);
-            for (int i = 0; i < newItemsCount; ++i) {
-                //QRandomGenerator.bounded(int) is exclusive, thus + 1
-                const auto random = d->mRandomGenerator.bounded(d->mRandomMapping.count()+1);
-                d->mRandomMapping.insert(random, start + i);
-            }
+            d->mLazyShuffle.reset(newItemsCount, d->newShuffleSeed(), -1);
+            d->randomMappingChanged();
             endInsertRows();
         } else {
             if (start <= rowCount()) {
@@ -398,6 +645,7 @@ void MediaPlayListProxyModel::sourceRowsInserted(const QModelIndex &parent, int
                 std::transform(d->mRandomMapping.begin(), d->mRandomMapping.end(), d->mRandomMapping.begin(), [=](const int sourceRow) {
                     return sourceRow < start ? sourceRow : sourceRow + newItemsCount;
                 });
+                d->randomMappingChanged();
             }
 
             const bool enqueueAfterCurrentTrack = mapRowFromSource(start - 1) == d->mCurrentTrack.row();
@@ -409,18 +657,53 @@ void MediaPlayListProxyModel::sourceRowsInserted(const QModelIndex &parent, int
                 std::shuffle(shuffledSourceRows.begin(), shuffledSourceRows.end(), d->mRandomGenerator);
                 const int proxyStart = d->mCurrentTrack.row() + 1;
                 beginInsertRows(parent, proxyStart, proxyStart + newItemsCount - 1);
-                for (int sourceRow : shuffledSourceRows) {
-                    d->mRandomMapping.insert(proxyStart, sourceRow);
-                }
+                d->mRandomMapping.insert(proxyStart, newItemsCount, 0);
+                std::copy(shuffledSourceRows.cbegin(), shuffledSourceRows.cend(), d->mRandomMapping.begin() + proxyStart);
+                d->randomMappingChanged();
                 endInsertRows();
             } else {
-                const int lowerBound = d->mCurrentTrack.row() + 1;
-                for (int i = 0; i < newItemsCount; ++i) {
-                    //QRandomGenerator.bounded(int) is exclusive, thus + 1
-                    const auto random = d->mRandomGenerator.bounded(lowerBound, rowCount() + 1);
-                    beginInsertRows(parent, random, random);
-                    d->mRandomMapping.insert(random, start + i);
+                // a random interleaving of the shuffled new tracks with the tracks after the current one, the same
+                // order as inserting each new track at a random position, each range of consecutive new rows is
+                // inserted at once
+                QList<int> shuffledSourceRows(newItemsCount);
+                std::iota(shuffledSourceRows.begin(), shuffledSourceRows.end(), start);
+                std::shuffle(shuffledSourceRows.begin(), shuffledSourceRows.end(), d->mRandomGenerator);
+
+                int proxyRow = d->mCurrentTrack.row() + 1;
+                int remainingOldRows = rowCount() - proxyRow;
+                int firstNewRow = 0;
+
+                while (firstNewRow < newItemsCount) {
+                    // QRandomGenerator.bounded(int) is exclusive: the next row is an old one with a probability of
+                    // remainingOldRows / (remainingOldRows + remainingNewRows)
+                    while (d->mRandomGenerator.bounded(remainingOldRows + newItemsCount - firstNewRow) < remainingOldRows) {
+                        --remainingOldRows;
+                        ++proxyRow;
+                    }
+
+                    auto endNewRows = firstNewRow + 1;
+                    while (endNewRows < newItemsCount &&
+                           d->mRandomGenerator.bounded(remainingOldRows + newItemsCount - endNewRows) >= remainingOldRows) {
+                        ++endNewRows;
+                    }
+
+                    const auto insertedCount = endNewRows - firstNewRow;
+
+                    beginInsertRows(parent, proxyRow, proxyRow + insertedCount - 1);
+                    d->mRandomMapping.insert(proxyRow, insertedCount, 0);
+                    std::copy(shuffledSourceRows.cbegin() + firstNewRow, shuffledSourceRows.cbegin() + endNewRows,
+                              d->mRandomMapping.begin() + proxyRow);
+                    d->randomMappingChanged();
                     endInsertRows();
+
+                    proxyRow += insertedCount;
+                    firstNewRow = endNewRows;
+
+                    // the draw that ended the range picked an old row
+                    if (firstNewRow < newItemsCount) {
+                        --remainingOldRows;
+                        ++proxyRow;
+                    }
                 }
             }
         }
@@ -458,6 +741,7 @@ void MediaPlayListProxyModel::sourceRowsInserted(const QModelIndex &parent, int
             for (int albumId : newAlbumIds) {
                 d->mRandomMapping += newIndexPerAlbumId.take(albumId);
             }
+            d->randomMappingChanged();
             endInsertRows();
         } else {
             if (start <= rowCount()) {
@@ -465,6 +749,7 @@ void MediaPlayListProxyModel::sourceRowsInserted(const QModelIndex &parent, int
                 std::transform(d->mRandomMapping.begin(), d->mRandomMapping.end(), d->mRandomMapping.begin(), [=](const int sourceRow) {
                     return sourceRow < start ? sourceRow : sourceRow + newItemsCount;
                 });
+                d->randomMappingChanged();
             }
 
             const bool enqueueAfterCurrentTrack = mapRowFromSource(start - 1) == d->mCurrentTrack.row();
@@ -474,12 +759,14 @@ void MediaPlayListProxyModel::sourceRowsInserted(const QModelIndex &parent, int
                 std::shuffle(newAlbumIds.begin(), newAlbumIds.end(), d->mRandomGenerator);
                 int proxyRow = d->mCurrentTrack.row() + 1;
                 beginInsertRows(parent, proxyRow, proxyRow + newItemsCount - 1);
+                d->mRandomMapping.insert(proxyRow, newItemsCount, 0);
                 for (int albumId : newAlbumIds) {
                     const auto &sourceRows = newIndexPerAlbumId[albumId];
                     for (int sourceRow : sourceRows) {
-                        d->mRandomMapping.insert(proxyRow++, sourceRow);
+                        d->mRandomMapping[proxyRow++] = sourceRow;
                     }
                 }
+                d->randomMappingChanged();
                 endInsertRows();
             } else {
                 // Find all spots in the current shuffled playlist where the album
@@ -514,9 +801,9 @@ void MediaPlayListProxyModel::sourceRowsInserted(const QModelIndex &parent, int
                     const auto random = insertIndexes[d->mRandomGenerator.bounded(insertIndexes.count())];
 
                     beginInsertRows(parent, random, random + newAlbumTrackIds.count() - 1);
-                    for (int j = 0; j < newAlbumTrackIds.count(); ++j) {
-                        d->mRandomMapping.insert(random + j, newAlbumTrackIds[j]);
-                    }
+                    d->mRandomMapping.insert(random, newAlbumTrackIds.count(), 0);
+                    std::copy(newAlbumTrackIds.cbegin(), newAlbumTrackIds.cend(), d->mRandomMapping.begin() + random);
+                    d->randomMappingChanged();
                     endInsertRows();
 
                     // now update insertIndexes because by inserting an album
@@ -537,6 +824,9 @@ void MediaPlayListProxyModel::sourceRowsInserted(const QModelIndex &parent, int
         endInsertRows();
     }
 
+    // the shuffled order may have been read while the new rows were inserted one by one
+    d->randomMappingChanged();
+
     const auto url = index(mapRowFromSource(start), 0).data(MediaPlayList::ResourceRole).toUrl();
     if (d->mTriggerPlay == ElisaUtils::TriggerPlay && url.isValid()) {
         switchTo(mapRowFromSource(start));
@@ -560,26 +850,51 @@ void MediaPlayListProxyModel::sourceRowsInserted(const QModelIndex &parent, int
 void MediaPlayListProxyModel::sourceRowsAboutToBeRemoved(const QModelIndex &parent, int start, int end)
 {
     if (d->mShuffleMode != MediaPlayListProxyModel::Shuffle::NoShuffle) {
+        d->materializeLazyShuffle();
         if (end - start + 1 == rowCount()) {
             beginRemoveRows(parent, start, end);
             d->mRandomMapping.clear();
+            d->randomMappingChanged();
             endRemoveRows();
         }
-        int row = 0;
-        auto it = d->mRandomMapping.begin();
-        while (it != d->mRandomMapping.end()) {
-            if (*it >= start && *it <= end){
-                beginRemoveRows(parent, row, row);
-                it = d->mRandomMapping.erase(it);
-                endRemoveRows();
-            } else {
-                if (*it > end) {
-                    *it = *it - end + start - 1;
-                }
-                it++;
-                row++;
+
+        // one pass finds the proxy rows of the removed source rows
+        QList<int> removedProxyRows;
+        removedProxyRows.reserve(end - start + 1);
+        for (int proxyRow = 0; proxyRow < d->mRandomMapping.size(); ++proxyRow) {
+            const auto sourceRow = d->mRandomMapping[proxyRow];
+            if (sourceRow >= start && sourceRow <= end) {
+                removedProxyRows.push_back(proxyRow);
+            }
+        }
+
+        // each range of consecutive proxy rows is removed at once, from the last one: the rows of the other ranges do not move
+        auto endRange = removedProxyRows.size();
+        while (endRange > 0) {
+            auto firstRange = endRange - 1;
+            while (firstRange > 0 && removedProxyRows[firstRange - 1] == removedProxyRows[firstRange] - 1) {
+                --firstRange;
             }
+
+            const auto firstProxyRow = removedProxyRows[firstRange];
+            const auto lastProxyRow = removedProxyRows[endRange - 1];
+
+            beginRemoveRows(parent, firstProxyRow, lastProxyRow);
+            d->mRandomMapping.remove(firstProxyRow, lastProxyRow - firstProxyRow + 1);
+            d->randomMappingChanged();
+            endRemoveRows();
+
+            endRange = firstRange;
         }
+
+        // then the surviving source rows after the removed ones are moved down in one pass
+        const auto removedCount = end - start + 1;
+        for (auto &sourceRow : d->mRandomMapping) {
+            if (sourceRow > end) {
+                sourceRow -= removedCount;
+            }
+        }
+        d->randomMappingChanged();
     } else {
         d->mCurrentTrackWasValid = d->mCurrentTrack.isValid();
         beginRemoveRows(parent, start, end);
@@ -589,8 +904,9 @@ void MediaPlayListProxyModel::sourceRowsAboutToBeRemoved(const QModelIndex &pare
 void MediaPlayListProxyModel::sourceRowsRemoved(const QModelIndex &parent, int start, int end)
 {
     Q_UNUSED(parent);
-    Q_UNUSED(start);
-    Q_UNUSED(end);
+
+    removeEntryAggregates(start, end);
+
     if (d->mShuffleMode == MediaPlayListProxyModel::Shuffle::NoShuffle) {
         endRemoveRows();
     }
@@ -629,10 +945,16 @@ void MediaPlayListProxyModel::sourceRowsMoved(const QModelIndex &parent, int sta
 {
     Q_ASSERT(d->mShuffleMode == MediaPlayListProxyModel::Shuffle::NoShuffle);
     Q_UNUSED(parent);
-    Q_UNUSED(start);
-    Q_UNUSED(end);
     Q_UNUSED(destParent);
-    Q_UNUSED(destRow);
+
+    auto firstEntry = d->mSourceEntries.begin();
+    if (destRow > end) {
+        std::rotate(firstEntry + start, firstEntry + end + 1, firstEntry + destRow);
+    } else {
+        std::rotate(firstEntry + destRow, firstEntry + start, firstEntry + end + 1);
+    }
+    d->mProxyDurationsOutdated = true;
+
     endMoveRows();
     Q_EMIT remainingTracksChanged();
     Q_EMIT remainingTracksDurationChanged();
@@ -645,6 +967,7 @@ void MediaPlayListProxyModel::sourceModelAboutToBeReset()
 }
 void MediaPlayListProxyModel::sourceModelReset()
 {
+    resetEntryAggregates();
     endResetModel();
 }
 
@@ -652,6 +975,11 @@ void MediaPlayListProxyModel::sourceDataChanged(const QModelIndex &topLeft, cons
 {
     auto startSourceRow = topLeft.row();
     auto endSourceRow = bottomRight.row();
+
+    if (roles.isEmpty() || roles.contains(MediaPlayList::DurationRole) || roles.contains(MediaPlayList::ElementTypeRole)) {
+        updateEntryAggregates(startSourceRow, endSourceRow);
+    }
+
     for (int i = startSourceRow; i <= endSourceRow; i++) {
         const auto proxyRow = mapRowFromSource(i);
 
@@ -675,6 +1003,7 @@ void MediaPlayListProxyModel::sourceLayoutAboutToBeChanged()
 
 void MediaPlayListProxyModel::sourceLayoutChanged()
 {
+    resetEntryAggregates();
     Q_EMIT layoutChanged();
 }
 
@@ -685,20 +1014,41 @@ void MediaPlayListProxyModel::sourceHeaderDataChanged(Qt::Orientation orientatio
 
 int MediaPlayListProxyModel::totalTracksDuration() const
 {
-    int time = 0;
-    for (int i = 0; i < rowCount(); i++) {
-        time += d->mPlayListModel->data(index(i, 0), MediaPlayList::DurationRole).toTime().msecsSinceStartOfDay();
-    }
-    return time;
+    return static_cast<int>(d->mTotalDuration);
 }
 
 int MediaPlayListProxyModel::remainingTracksDuration() const
 {
-    int time = 0;
-    for (int i = d->mCurrentTrack.row(); i < rowCount(); i++) {
-        time += d->mPlayListModel->data(index(i, 0), MediaPlayList::DurationRole).toTime().msecsSinceStartOfDay();
+    const auto currentRow = d->mCurrentTrack.row();
+
+    // toggling the track shuffle keeps the current track first: the few rows before it are summed directly instead of
+    // mapping every row of the lazy shuffle to rebuild the durations
+    if (d->mProxyDurationsOutdated && currentRow <= rowCount() / 64) {
+        qint64 durationBefore = 0;
+
+        for (int proxyRow = 0; proxyRow < currentRow; ++proxyRow) {
+            const auto sourceRow = mapRowToSource(proxyRow);
+            durationBefore += sourceRow < d->mSourceEntries.size() ? d->mSourceEntries[sourceRow].mDuration : 0;
+        }
+
+        return static_cast<int>(d->mTotalDuration - durationBefore);
     }
-    return time;
+
+    // only the mutable cache of the durations is changed
+    if (d->mProxyDurationsOutdated) {
+        QList<qint64> proxyDurations;
+        proxyDurations.reserve(d->mSourceEntries.size());
+
+        for (int proxyRow = 0; proxyRow < rowCount(); ++proxyRow) {
+            const auto sourceRow = mapRowToSource(proxyRow);
+            proxyDurations.push_back(sourceRow < d->mSourceEntries.size() ? d->mSourceEntries[sourceRow].mDuration : 0);
+        }
+
+        d->mProxyDurations.assign(std::move(proxyDurations));
+        d->mProxyDurationsOutdated = false;
+    }
+
+    return static_cast<int>(d->mTotalDuration - d->mProxyDurations.sumBefore(currentRow));
 }
 
 int MediaPlayListProxyModel::remainingTracks() const
@@ -712,13 +1062,95 @@ int MediaPlayListProxyModel::remainingTracks() const
 
 int MediaPlayListProxyModel::radioCount() const
 {
-    int count = 0;
-    for (int i = 0; i < rowCount(); i++) {
-        if (d->mPlayListModel->data(index(i, 0), MediaPlayList::ElementTypeRole) == ElisaUtils::Radio) {
-            count++;
+    return d->mRadioCount;
+}
+
+void MediaPlayListProxyModel::insertEntryAggregates(int start, int end)
+{
+    const auto previousRadioCount = d->mRadioCount;
+
+    d->mSourceEntries.insert(start, end - start + 1, EntryAggregate{});
+
+    for (int sourceRow = start; sourceRow <= end; ++sourceRow) {
+        const auto newEntry = d->sourceEntryAggregate(sourceRow);
+
+        d->mTotalDuration += newEntry.mDuration;
+        d->mRadioCount += newEntry.mIsRadio ? 1 : 0;
+        d->mSourceEntries[sourceRow] = newEntry;
+    }
+
+    d->mProxyDurationsOutdated = true;
+
+    if (d->mRadioCount != previousRadioCount) {
+        Q_EMIT radioCountChanged();
+    }
+}
+
+void MediaPlayListProxyModel::removeEntryAggregates(int start, int end)
+{
+    const auto previousRadioCount = d->mRadioCount;
+
+    for (int sourceRow = start; sourceRow <= end && sourceRow < d->mSourceEntries.size(); ++sourceRow) {
+        d->mTotalDuration -= d->mSourceEntries[sourceRow].mDuration;
+        d->mRadioCount -= d->mSourceEntries[sourceRow].mIsRadio ? 1 : 0;
+    }
+
+    d->mSourceEntries.remove(start, std::min<qsizetype>(end - start + 1, d->mSourceEntries.size() - start));
+    d->mProxyDurationsOutdated = true;
+
+    if (d->mRadioCount != previousRadioCount) {
+        Q_EMIT radioCountChanged();
+    }
+}
+
+void MediaPlayListProxyModel::updateEntryAggregates(int start, int end)
+{
+    const auto previousRadioCount = d->mRadioCount;
+
+    for (int sourceRow = start; sourceRow <= end && sourceRow < d->mSourceEntries.size(); ++sourceRow) {
+        const auto newEntry = d->sourceEntryAggregate(sourceRow);
+        auto &oneEntry = d->mSourceEntries[sourceRow];
+        const auto durationDelta = newEntry.mDuration - oneEntry.mDuration;
+
+        d->mTotalDuration += durationDelta;
+        d->mRadioCount += (newEntry.mIsRadio ? 1 : 0) - (oneEntry.mIsRadio ? 1 : 0);
+
+        if (durationDelta != 0 && !d->mProxyDurationsOutdated) {
+            d->mProxyDurations.add(mapRowFromSource(sourceRow), durationDelta);
         }
+
+        oneEntry = newEntry;
+    }
+
+    if (d->mRadioCount != previousRadioCount) {
+        Q_EMIT radioCountChanged();
+    }
+}
+
+void MediaPlayListProxyModel::resetEntryAggregates()
+{
+    const auto previousRadioCount = d->mRadioCount;
+
+    d->mSourceEntries.clear();
+    d->mTotalDuration = 0;
+    d->mRadioCount = 0;
+
+    const auto sourceRowsCount = d->mPlayListModel ? d->mPlayListModel->rowCount() : 0;
+    d->mSourceEntries.reserve(sourceRowsCount);
+
+    for (int sourceRow = 0; sourceRow < sourceRowsCount; ++sourceRow) {
+        const auto newEntry = d->sourceEntryAggregate(sourceRow);
+
+        d->mTotalDuration += newEntry.mDuration;
+        d->mRadioCount += newEntry.mIsRadio ? 1 : 0;
+        d->mSourceEntries.push_back(newEntry);
+    }
+
+    d->mProxyDurationsOutdated = true;
+
+    if (d->mRadioCount != previousRadioCount) {
+        Q_EMIT radioCountChanged();
     }
-    return count;
 }
 
 int MediaPlayListProxyModel::tracksCount() const
@@ -853,8 +1285,10 @@ void MediaPlayListProxyModel::moveRow(int from, int to)
                                                     : (to <= d->mCurrentTrack.row() && d->mCurrentTrack.row() <= from);
 
     if (d->mShuffleMode != MediaPlayListProxyModel::Shuffle::NoShuffle) {
+        d->materializeLazyShuffle();
         beginMoveRows({}, from, from, {}, from < to ? to + 1 : to);
         d->mRandomMapping.move(from, to);
+        d->randomMappingChanged();
         endMoveRows();
     } else {
         d->mPlayListModel->moveRows({}, from, 1, {}, from < to ? to + 1 : to);
@@ -1040,6 +1474,10 @@ QVariantMap MediaPlayListProxyModel::persistentState() const
     currentState[QStringLiteral("playList")] = d->mPlayListModel->getEntriesForRestore();
     currentState[QStringLiteral("shuffleMode")] = d->mShuffleMode;
     currentState[QStringLiteral("randomMapping")] = getRandomMappingForRestore();
+    if (d->mLazyShuffle.isActive()) {
+        currentState[QStringLiteral("shuffleSeed")] = d->mLazyShuffle.seed();
+        currentState[QStringLiteral("shuffleFirstRow")] = d->mLazyShuffle.firstSourceRow();
+    }
     currentState[QStringLiteral("currentTrack")] = d->mCurrentPlayListPosition;
     currentState[QStringLiteral("repeatMode")] = d->mRepeatMode;
 
@@ -1057,7 +1495,12 @@ void MediaPlayListProxyModel::setPersistentState(const QVariantMap &persistentSt
 
     auto shuffleModeStoredValue = persistentStateValue.find(QStringLiteral("shuffleMode"));
     auto shuffleRandomMappingIt = persistentStateValue.find(QStringLiteral("randomMapping"));
-    if (shuffleModeStoredValue != persistentStateValue.end() && shuffleRandomMappingIt != persistentStateValue.end()) {
+    auto shuffleSeedIt = persistentStateValue.find(QStringLiteral("shuffleSeed"));
+    auto shuffleFirstRowIt = persistentStateValue.find(QStringLiteral("shuffleFirstRow"));
+    if (shuffleModeStoredValue != persistentStateValue.end() && shuffleSeedIt != persistentStateValue.end() &&
+            shuffleFirstRowIt != persistentStateValue.end()) {
+        restoreLazyShuffleMode(shuffleModeStoredValue->value<Shuffle>(), shuffleSeedIt->toULongLong(), shuffleFirstRowIt->toInt());
+    } else if (shuffleModeStoredValue != persistentStateValue.end() && shuffleRandomMappingIt != persistentStateValue.end()) {
         restoreShuffleMode(shuffleModeStoredValue->value<Shuffle>(), shuffleRandomMappingIt.value().toList());
     }
 
@@ -1087,7 +1530,8 @@ QVariantList MediaPlayListProxyModel::getRandomMappingForRestore() const
 {
     QVariantList randomMapping;
 
-    if (d->mShuffleMode != MediaPlayListProxyModel::Shuffle::NoShuffle) {
+    // a lazy track shuffle is saved from its seed
+    if (d->mShuffleMode != MediaPlayListProxyModel::Shuffle::NoShuffle && !d->mLazyShuffle.isActive()) {
         randomMapping.reserve(d->mRandomMapping.count());
         for (int i = 0; i < d->mRandomMapping.count(); ++i) {
             randomMapping.append(QVariant(d->mRandomMapping[i]));
@@ -1101,7 +1545,8 @@ void MediaPlayListProxyModel::restoreShuffleMode(MediaPlayListProxyModel::Shuffl
 {
     auto playListSize = rowCount();
 
-    if (mode != MediaPlayListProxyModel::Shuffle::NoShuffle && mapping.count() == playListSize && d->mRandomMapping.isEmpty()) {
+    if (mode != MediaPlayListProxyModel::Shuffle::NoShuffle && mapping.count() == playListSize && d->mRandomMapping.isEmpty() &&
+            !d->mLazyShuffle.isActive()) {
         Q_EMIT layoutAboutToBeChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
 
         QModelIndexList from, to;
@@ -1118,6 +1563,7 @@ void MediaPlayListProxyModel::restoreShuffleMode(MediaPlayListProxyModel::Shuffl
         changePersistentIndexList(from, to);
 
         d->mShuffleMode = mode;
+        d->randomMappingChanged();
 
         Q_EMIT layoutChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
 
@@ -1127,6 +1573,56 @@ void MediaPlayListProxyModel::restoreShuffleMode(MediaPlayListProxyModel::Shuffl
     }
 }
 
+void MediaPlayListProxyModel::restoreLazyShuffleMode(MediaPlayListProxyModel::Shuffle mode, quint64 seed, int firstSourceRow)
+{
+    auto playListSize = rowCount();
+
+    if (mode == MediaPlayListProxyModel::Shuffle::Track && playListSize > 0 && d->mRandomMapping.isEmpty() &&
+            !d->mLazyShuffle.isActive()) {
+        Q_EMIT layoutAboutToBeChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
+
+        const auto persistentSourceRows = persistentIndexSourceRows();
+
+        d->mLazyShuffle.reset(playListSize, seed, firstSourceRow);
+        d->mShuffleMode = mode;
+        d->randomMappingChanged();
+
+        changePersistentIndexSourceRows(persistentSourceRows);
+
+        Q_EMIT layoutChanged(QList<QPersistentModelIndex>(), QAbstractItemModel::VerticalSortHint);
+
+        Q_EMIT shuffleModeChanged();
+        Q_EMIT remainingTracksChanged();
+        Q_EMIT remainingTracksDurationChanged();
+    }
+}
+
+QList<int> MediaPlayListProxyModel::persistentIndexSourceRows() const
+{
+    const auto persistentIndexes = persistentIndexList();
+
+    QList<int> sourceRows;
+    sourceRows.reserve(persistentIndexes.size());
+    for (const auto &oneIndex : persistentIndexes) {
+        sourceRows.push_back(mapRowToSource(oneIndex.row()));
+    }
+
+    return sourceRows;
+}
+
+void MediaPlayListProxyModel::changePersistentIndexSourceRows(const QList<int> &sourceRows)
+{
+    const auto persistentIndexes = persistentIndexList();
+
+    QModelIndexList newIndexes;
+    newIndexes.reserve(persistentIndexes.size());
+    for (int i = 0; i < persistentIndexes.size(); ++i) {
+        newIndexes.push_back(index(mapRowFromSource(sourceRows.at(i)), persistentIndexes.at(i).column()));
+    }
+
+    changePersistentIndexList(persistentIndexes, newIndexes);
+}
+
 bool MediaPlayListProxyModel::partiallyLoaded() const
 {
     return d->mPartiallyLoaded;
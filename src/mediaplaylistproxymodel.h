@@ -322,10 +322,35 @@ private:
 
     void determineAndNotifyPreviousAndNextTracks();
 
+    /**
+     * Maintain the total duration, the radio count and the durations used by remainingTracksDuration()
+     * from the changes of the source model, the rows are rows of the source model
+     */
+    void insertEntryAggregates(int start, int end);
+
+    void removeEntryAggregates(int start, int end);
+
+    void updateEntryAggregates(int start, int end);
+
+    void resetEntryAggregates();
+
     QVariantList getRandomMappingForRestore() const;
 
     void restoreShuffleMode(Shuffle mode, QVariantList mapping);
 
+    /**
+     * Restore a track shuffle from the seed of its order, without building the mapping of its rows
+     */
+    void restoreLazyShuffleMode(Shuffle mode, quint64 seed, int firstSourceRow);
+
+    /**
+     * Source rows of the persistent indexes, to move them with changePersistentIndexSourceRows()
+     * after a change of the shuffled order
+     */
+    [[nodiscard]] QList<int> persistentIndexSourceRows() const;
+
+    void changePersistentIndexSourceRows(const QList<int> &sourceRows);
+
     void loadLocalFile(DataTypes::EntryDataList &newTracks, QSet<QString> &processedFiles, const QFileInfo &fileInfo);
 
     bool loadLocalPlayList(DataTypes::EntryDataList &newTracks, QSet<QString> &processedUFiles, const QUrl &fileName);
@@ -11,12 +11,25 @@
 
 #include <QFileInfo>
 
+namespace {
+
+constexpr int allTracksPageSize = 500;
+
+}
+
 class ModelDataLoaderPrivate
 {
 public:
 
+    [[nodiscard]] DatabaseInterface* readDatabase() const
+    {
+        return mReadDatabase ? mReadDatabase : mDatabase;
+    }
+
     DatabaseInterface *mDatabase = nullptr;
 
+    DatabaseInterface *mReadDatabase = nullptr;
+
     ElisaUtils::PlayListEntryType mModelType = ElisaUtils::Unknown;
 
     ModelDataLoader::FilterType mFilterType = ModelDataLoader::FilterType::UnknownFilter;
@@ -79,6 +92,11 @@ void ModelDataLoader::setDatabase(DatabaseInterface *database)
             this, &ModelDataLoader::clearedDatabase);
 }
 
+void ModelDataLoader::setReadDatabase(DatabaseInterface *database)
+{
+    d->mReadDatabase = database;
+}
+
 void ModelDataLoader::loadData(ElisaUtils::PlayListEntryType dataType)
 {
     if (!d->mDatabase) {
@@ -90,28 +108,44 @@ void ModelDataLoader::loadData(ElisaUtils::PlayListEntryType dataType)
     switch (dataType)
     {
     case ElisaUtils::Album:
-        Q_EMIT allAlbumsData(d->mDatabase->allAlbumsData());
+        Q_EMIT allAlbumsData(d->readDatabase()->allAlbumsData());
         break;
     case ElisaUtils::Artist:
-        Q_EMIT allArtistsData(d->mDatabase->allArtistsData());
+        Q_EMIT allArtistsData(d->readDatabase()->allArtistsData());
         break;
     case ElisaUtils::Composer:
         break;
     case ElisaUtils::Genre:
-        Q_EMIT allGenresData(d->mDatabase->allGenresData());
+        Q_EMIT allGenresData(d->readDatabase()->allGenresData());
         break;
     case ElisaUtils::Lyricist:
         break;
     case ElisaUtils::Track:
-        Q_EMIT allTracksData(d->mDatabase->allTracksData());
+    {
+        // stream the tracks in pages ordered by id: the model shows the first page
+        // while the next ones are still read from the database
+        auto lastDatabaseId = qulonglong{0};
+        auto onePage = DataTypes::ListTrackDataType{};
+
+        do {
+            onePage = d->readDatabase()->allTracksDataPage(lastDatabaseId, allTracksPageSize);
+
+            if (!onePage.isEmpty()) {
+                lastDatabaseId = onePage.constLast().databaseId();
+            }
+
+            Q_EMIT allTracksData(onePage);
+        } while (onePage.size() == allTracksPageSize);
+
         break;
+    }
     case ElisaUtils::FileName:
     case ElisaUtils::Unknown:
     case ElisaUtils::Container:
     case ElisaUtils::PlayList:
         break;
     case ElisaUtils::Radio:
-        Q_EMIT allRadiosData(d->mDatabase->allRadiosData());
+        Q_EMIT allRadiosData(d->readDatabase()->allRadiosData());
         break;
     }
 }
@@ -138,7 +172,7 @@ void ModelDataLoader::loadDataByAlbumId(ElisaUtils::PlayListEntryType dataType,
     case ElisaUtils::Lyricist:
         break;
     case ElisaUtils::Track:
-        Q_EMIT allTracksData(d->mDatabase->albumData(databaseId));
+        Q_EMIT allTracksData(d->readDatabase()->albumData(databaseId));
         break;
     case ElisaUtils::FileName:
     case ElisaUtils::Unknown:
@@ -161,10 +195,10 @@ void ModelDataLoader::loadDataByGenre(ElisaUtils::PlayListEntryType dataType, co
     switch (dataType)
     {
     case ElisaUtils::Artist:
-        Q_EMIT allArtistsData(d->mDatabase->allArtistsDataByGenre(genre));
+        Q_EMIT allArtistsData(d->readDatabase()->allArtistsDataByGenre(genre));
         break;
     case ElisaUtils::Track:
-        Q_EMIT allTracksData(d->mDatabase->tracksDataFromGenre(genre));
+        Q_EMIT allTracksData(d->readDatabase()->tracksDataFromGenre(genre));
         break;
     case ElisaUtils::Album:
     case ElisaUtils::Composer:
@@ -191,10 +225,10 @@ void ModelDataLoader::loadDataByArtist(ElisaUtils::PlayListEntryType dataType, c
     switch (dataType)
     {
     case ElisaUtils::Album:
-        Q_EMIT allAlbumsData(d->mDatabase->allAlbumsDataByArtist(artist));
+        Q_EMIT allAlbumsData(d->readDatabase()->allAlbumsDataByArtist(artist));
         break;
     case ElisaUtils::Track:
-        Q_EMIT allTracksData(d->mDatabase->tracksDataFromAuthor(artist));
+        Q_EMIT allTracksData(d->readDatabase()->tracksDataFromAuthor(artist));
         break;
     case ElisaUtils::Artist:
     case ElisaUtils::Composer:
@@ -222,10 +256,10 @@ void ModelDataLoader::loadDataByGenreAndArtist(ElisaUtils::PlayListEntryType dat
     switch (dataType)
     {
     case ElisaUtils::Album:
-        Q_EMIT allAlbumsData(d->mDatabase->allAlbumsDataByGenreAndArtist(genre, artist));
+        Q_EMIT allAlbumsData(d->readDatabase()->allAlbumsDataByGenreAndArtist(genre, artist));
         break;
     case ElisaUtils::Track:
-        Q_EMIT allTracksData(d->mDatabase->tracksDataFromGenreAndAuthor(genre, artist));
+        Q_EMIT allTracksData(d->readDatabase()->tracksDataFromGenreAndAuthor(genre, artist));
         break;
     case ElisaUtils::Artist:
     case ElisaUtils::Composer:
@@ -254,10 +288,10 @@ void ModelDataLoader::loadDataByDatabaseIdAndUrl(ElisaUtils::PlayListEntryType d
     {
     case ElisaUtils::FileName:
     case ElisaUtils::Track:
-        Q_EMIT allTrackData(d->mDatabase->trackDataFromDatabaseIdAndUrl(databaseId, url));
+        Q_EMIT allTrackData(d->readDatabase()->trackDataFromDatabaseIdAndUrl(databaseId, url));
         break;
     case ElisaUtils::Radio:
-        Q_EMIT allRadioData(d->mDatabase->radioDataFromDatabaseId(databaseId));
+        Q_EMIT allRadioData(d->readDatabase()->radioDataFromDatabaseId(databaseId));
         break;
     case ElisaUtils::Album:
     case ElisaUtils::Artist:
@@ -284,9 +318,9 @@ void ModelDataLoader::loadDataByUrl(ElisaUtils::PlayListEntryType dataType, cons
     case ElisaUtils::FileName:
     case ElisaUtils::Track:
     {
-        auto databaseId = d->mDatabase->trackIdFromFileName(url);
+        auto databaseId = d->readDatabase()->trackIdFromFileName(url);
         if (databaseId != 0) {
-            Q_EMIT allTrackData(d->mDatabase->trackDataFromDatabaseIdAndUrl(databaseId, url));
+            Q_EMIT allTrackData(d->readDatabase()->trackDataFromDatabaseIdAndUrl(databaseId, url));
         } else {
             auto result = d->mFileScanner.scanOneFile(url);
             Q_EMIT allTrackData(result);
@@ -295,9 +329,9 @@ void ModelDataLoader::loadDataByUrl(ElisaUtils::PlayListEntryType dataType, cons
     }
     case ElisaUtils::Radio:
     {
-        auto databaseId = d->mDatabase->radioIdFromFileName(url);
+        auto databaseId = d->readDatabase()->radioIdFromFileName(url);
         if (databaseId != 0) {
-            Q_EMIT allRadioData(d->mDatabase->radioDataFromDatabaseId(databaseId));
+            Q_EMIT allRadioData(d->readDatabase()->radioDataFromDatabaseId(databaseId));
         } else {
             auto result = d->mFileScanner.scanOneFile(url);
             Q_EMIT allRadioData(result);
@@ -327,7 +361,7 @@ void ModelDataLoader::loadRecentlyPlayedData(ElisaUtils::PlayListEntryType dataT
     switch (dataType)
     {
     case ElisaUtils::Track:
-        Q_EMIT allTracksData(d->mDatabase->recentlyPlayedTracksData(50));
+        Q_EMIT allTracksData(d->readDatabase()->recentlyPlayedTracksData(50));
         break;
     case ElisaUtils::Album:
     case ElisaUtils::Artist:
@@ -354,10 +388,43 @@ void ModelDataLoader::loadFrequentlyPlayedData(ElisaUtils::PlayListEntryType dat
     switch (dataType)
     {
     case ElisaUtils::Track:
-        Q_EMIT allTracksData(d->mDatabase->frequentlyPlayedTracksData(50));
+        Q_EMIT allTracksData(d->readDatabase()->frequentlyPlayedTracksData(50));
+        break;
+    case ElisaUtils::Album:
+    case ElisaUtils::Artist:
+    case ElisaUtils::Composer:
+    case ElisaUtils::Genre:
+    case ElisaUtils::Lyricist:
+    case ElisaUtils::FileName:
+    case ElisaUtils::Unknown:
+    case ElisaUtils::Radio:
+    case ElisaUtils::Container:
+    case ElisaUtils::PlayList:
         break;
+    }
+}
+
+void ModelDataLoader::loadDataBySearch(ElisaUtils::PlayListEntryType dataType, const QString &searchText,
+                                       qulonglong afterDatabaseId, int count)
+{
+    if (!d->mDatabase) {
+        return;
+    }
+
+    // new data from the database is not matched against the search text
+    d->mFilterType = ModelDataLoader::FilterType::UnknownFilter;
+
+    switch (dataType)
+    {
     case ElisaUtils::Album:
+        Q_EMIT albumsSearchData(searchText, d->readDatabase()->albumsDataFromSearch(searchText, afterDatabaseId, count));
+        break;
     case ElisaUtils::Artist:
+        Q_EMIT artistsSearchData(searchText, d->readDatabase()->artistsDataFromSearch(searchText, afterDatabaseId, count));
+        break;
+    case ElisaUtils::Track:
+        Q_EMIT tracksSearchData(searchText, d->readDatabase()->tracksDataFromSearch(searchText, afterDatabaseId, count));
+        break;
     case ElisaUtils::Composer:
     case ElisaUtils::Genre:
     case ElisaUtils::Lyricist:
@@ -405,7 +472,7 @@ void ModelDataLoader::databaseArtistsAdded(const ListArtistDataType &newData)
     {
         auto filteredData = newData;
         auto new_end = std::remove_if(filteredData.begin(), filteredData.end(),
-                                      [&](const auto &oneArtist){return !d->mDatabase->internalArtistMatchGenre(oneArtist.databaseId(), d->mGenre);});
+                                      [&](const auto &oneArtist){return !d->readDatabase()->internalArtistMatchGenre(oneArtist.databaseId(), d->mGenre);});
         filteredData.erase(new_end, filteredData.end());
 
         Q_EMIT artistsAdded(filteredData);
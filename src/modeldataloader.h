@@ -43,6 +43,13 @@ public:
 
     void setDatabase(DatabaseInterface *database);
 
+    /**
+     * Use a read-only connection for the browse queries. Change notifications and
+     * writes still go through the database given to setDatabase().
+     * The read-only connection must live in the same thread as this loader.
+     */
+    void setReadDatabase(DatabaseInterface *database);
+
 Q_SIGNALS:
 
     void allAlbumsData(const ModelDataLoader::ListAlbumDataType &allData);
@@ -91,6 +98,12 @@ Q_SIGNALS:
 
     void clearedDatabase();
 
+    void tracksSearchData(const QString &searchText, const ModelDataLoader::ListTrackDataType &foundData);
+
+    void albumsSearchData(const QString &searchText, const ModelDataLoader::ListAlbumDataType &foundData);
+
+    void artistsSearchData(const QString &searchText, const ModelDataLoader::ListArtistDataType &foundData);
+
 public Q_SLOTS:
 
     void loadData(ElisaUtils::PlayListEntryType dataType);
@@ -116,6 +129,14 @@ public Q_SLOTS:
 
     void loadFrequentlyPlayedData(ElisaUtils::PlayListEntryType dataType);
 
+    /**
+     * Load one page of the data matching searchText from the search index.
+     * The results carry the search text so that a model can drop pages of an
+     * outdated search.
+     */
+    void loadDataBySearch(ElisaUtils::PlayListEntryType dataType, const QString &searchText,
+                          qulonglong afterDatabaseId, int count);
+
     void updateFileMetaData(const DataTypes::TrackDataType &trackDataType, const QUrl &url);
 
     void updateSingleFileMetaData(const QUrl &url, DataTypes::ColumnsRoles role, const QVariant &data);
@@ -7,6 +7,7 @@
 
 #include "abstractmediaproxymodel.h"
 
+#include "datamodel.h"
 #include "mediaplaylistproxymodel.h"
 
 #include <QWriteLocker>
@@ -45,12 +46,24 @@ void AbstractMediaProxyModel::setFilterText(const QString &filterText)
 
     mFilterText = filterText;
 
-    mFilterExpression.setPattern(mFilterText.normalized(QString::NormalizationForm_KC));
+    // unfiltered lists of tracks, albums and artists are searched by the database
+    auto searchableModel = qobject_cast<DataModel*>(sourceModel());
+    if (searchableModel && !searchableModel->isSearchable()) {
+        searchableModel = nullptr;
+    }
+
+    mFilterExpression.setPattern(searchableModel ? QString{} : mFilterText.normalized(QString::NormalizationForm_KC));
     mFilterExpression.setPatternOptions(QRegularExpression::CaseInsensitiveOption);
     mFilterExpression.optimize();
 
     invalidate();
 
+    writeLocker.unlock();
+
+    if (searchableModel) {
+        searchableModel->setSearchText(mFilterText);
+    }
+
     Q_EMIT filterTextChanged(mFilterText);
 }
 
@@ -11,13 +11,43 @@
 
 #include "models/modelLogging.h"
 
+#include <QSet>
+
 #include <algorithm>
 
+namespace
+{
+// rows requested from the search index each time the view needs more of them
+constexpr int searchPageSize = 500;
+
+template<typename LeftTrack, typename RightTrack>
+bool isBeforeInAlbum(const LeftTrack &leftTrack, const RightTrack &rightTrack)
+{
+    if (leftTrack.discNumber() != rightTrack.discNumber()) {
+        return leftTrack.discNumber() < rightTrack.discNumber();
+    }
+
+    return leftTrack.trackNumber() < rightTrack.trackNumber();
+}
+
+// each word of the search text has to be found in one of the values, as in the search of the database
+bool matchesSearchText(const QString &searchText, const QStringList &values)
+{
+    const auto searchWords = searchText.simplified().split(QLatin1Char(' '), Qt::SkipEmptyParts);
+
+    return std::all_of(searchWords.cbegin(), searchWords.cend(), [&values](const auto &oneWord) {
+        return std::any_of(values.cbegin(), values.cend(), [&oneWord](const auto &oneValue) {
+            return oneValue.contains(oneWord, Qt::CaseInsensitive);
+        });
+    });
+}
+}
+
 class DataModelPrivate
 {
 public:
 
-    DataModel::ListTrackDataType mAllTrackData;
+    DataTypes::ListTrackRecord mAllTrackData;
 
     DataModel::ListRadioDataType mAllRadiosData;
 
@@ -43,8 +73,195 @@ public:
 
     qulonglong mDatabaseId = 0;
 
+    QString mSearchText;
+
+    qulonglong mLastSearchResultId = 0;
+
+    bool mHasMoreSearchResults = false;
+
+    bool mIsWaitingForSearchResults = false;
+
     bool mIsBusy = false;
 
+    // row plus mRowsOffset of the elements shown by the model, the rows from mFirstUnindexedRow are indexed on the next lookup
+    QHash<qulonglong, qsizetype> mRowsByDatabaseId;
+
+    qsizetype mFirstUnindexedRow = 0;
+
+    // changing it moves all indexed rows at once: a change near the head of the list only reindexes the rows before it
+    qsizetype mRowsOffset = 0;
+
+    // the database does not reuse the ids until it is cleared
+    QSet<qulonglong> mRemovedDatabaseIds;
+
+    [[nodiscard]] qsizetype elementsCount() const
+    {
+        switch (mModelType)
+        {
+        case ElisaUtils::Track:
+            return mAllTrackData.size();
+        case ElisaUtils::Radio:
+            return mAllRadiosData.size();
+        case ElisaUtils::Album:
+            return mAllAlbumData.size();
+        case ElisaUtils::Artist:
+            return mAllArtistData.size();
+        case ElisaUtils::Genre:
+            return mAllGenreData.size();
+        case ElisaUtils::Lyricist:
+        case ElisaUtils::Composer:
+        case ElisaUtils::FileName:
+        case ElisaUtils::Container:
+        case ElisaUtils::Unknown:
+        case ElisaUtils::PlayList:
+            break;
+        }
+
+        return 0;
+    }
+
+    [[nodiscard]] qulonglong databaseIdAt(qsizetype row) const
+    {
+        switch (mModelType)
+        {
+        case ElisaUtils::Track:
+            return mAllTrackData[row].databaseId();
+        case ElisaUtils::Radio:
+            return mAllRadiosData[row].databaseId();
+        case ElisaUtils::Album:
+            return mAllAlbumData[row].databaseId();
+        case ElisaUtils::Artist:
+            return mAllArtistData[row].databaseId();
+        case ElisaUtils::Genre:
+            return mAllGenreData[row].databaseId();
+        case ElisaUtils::Lyricist:
+        case ElisaUtils::Composer:
+        case ElisaUtils::FileName:
+        case ElisaUtils::Container:
+        case ElisaUtils::Unknown:
+        case ElisaUtils::PlayList:
+            break;
+        }
+
+        return 0;
+    }
+
+    [[nodiscard]] qsizetype indexedRow(qulonglong databaseId) const
+    {
+        const auto itRow = mRowsByDatabaseId.constFind(databaseId);
+
+        if (itRow == mRowsByDatabaseId.cend() || itRow.value() - mRowsOffset >= mFirstUnindexedRow) {
+            return -1;
+        }
+
+        return itRow.value() - mRowsOffset;
+    }
+
+    void indexRows(qsizetype firstRow, qsizetype endRow)
+    {
+        for (auto row = firstRow; row < endRow; ++row) {
+            mRowsByDatabaseId[databaseIdAt(row)] = row + mRowsOffset;
+        }
+    }
+
+    int rowFromDatabaseId(qulonglong databaseId)
+    {
+        const auto count = elementsCount();
+
+        // entries at or after the first unindexed row are stale: going backward keeps the first row of an id
+        for (auto row = count - 1; row >= mFirstUnindexedRow; --row) {
+            const auto rowDatabaseId = databaseIdAt(row);
+            const auto itRow = mRowsByDatabaseId.find(rowDatabaseId);
+
+            if (itRow == mRowsByDatabaseId.end() || itRow.value() - mRowsOffset >= mFirstUnindexedRow) {
+                mRowsByDatabaseId[rowDatabaseId] = row + mRowsOffset;
+            }
+        }
+
+        mFirstUnindexedRow = count;
+
+        return static_cast<int>(indexedRow(databaseId));
+    }
+
+    // called once the rows are in the list
+    void rowsInserted(qsizetype firstRow, qsizetype insertedCount)
+    {
+        if (firstRow >= mFirstUnindexedRow) {
+            return;
+        }
+
+        if (firstRow >= mFirstUnindexedRow - firstRow) {
+            mFirstUnindexedRow = firstRow;
+            return;
+        }
+
+        // the rows after the new ones move with the offset, the rows before them and the new ones are indexed again
+        mRowsOffset -= insertedCount;
+        mFirstUnindexedRow += insertedCount;
+        indexRows(0, firstRow + insertedCount);
+    }
+
+    // called once the row is out of the list
+    void rowRemoved(qsizetype row, qulonglong databaseId)
+    {
+        const auto itRow = mRowsByDatabaseId.find(databaseId);
+        if (itRow != mRowsByDatabaseId.end() &&
+                (itRow.value() - mRowsOffset == row || itRow.value() - mRowsOffset >= mFirstUnindexedRow)) {
+            mRowsByDatabaseId.erase(itRow);
+        }
+
+        if (row >= mFirstUnindexedRow) {
+            return;
+        }
+
+        if (row >= mFirstUnindexedRow - 1 - row) {
+            mFirstUnindexedRow = row;
+            return;
+        }
+
+        // the rows after the removed one move with the offset, the rows before it are indexed again
+        ++mRowsOffset;
+        --mFirstUnindexedRow;
+        indexRows(0, row);
+    }
+
+    // drop the data added to the collection during a search when it does not match, is already shown,
+    // or will be part of a page of search results that is not received yet
+    template<typename ListDataType, typename SearchPredicate>
+    void keepNewSearchResults(ListDataType &newData, SearchPredicate isMatching)
+    {
+        const auto pagesPending = mIsWaitingForSearchResults || mHasMoreSearchResults;
+
+        newData.removeIf([this, pagesPending, &isMatching](const auto &oneData) {
+            const auto databaseId = oneData.databaseId();
+            return (pagesPending && databaseId > mLastSearchResultId) ||
+                    isKnownRow(databaseId) ||
+                    !isMatching(oneData);
+        });
+    }
+
+    // the data is loaded from a reader connection while the changes are notified by the writer:
+    // a snapshot can hold rows already added by a notification, or rows removed before it is received
+    [[nodiscard]] bool isKnownRow(qulonglong databaseId)
+    {
+        return mRemovedDatabaseIds.contains(databaseId) || rowFromDatabaseId(databaseId) != -1;
+    }
+
+    template<typename ListDataType>
+    void dropKnownRows(ListDataType &newData)
+    {
+        newData.removeIf([this](const auto &oneData) {
+            return isKnownRow(oneData.databaseId());
+        });
+    }
+
+    void clearRowsIndex()
+    {
+        mRowsByDatabaseId.clear();
+        mFirstUnindexedRow = 0;
+        mRowsOffset = 0;
+    }
+
 };
 
 DataModel::DataModel(QObject *parent) : QAbstractListModel(parent), d(std::make_unique<DataModelPrivate>())
@@ -133,9 +350,9 @@ QVariant DataModel::data(const QModelIndex &index, int role) const
         switch(d->mModelType)
         {
         case ElisaUtils::Track:
-            result = d->mAllTrackData[index.row()][TrackDataType::key_type::TitleRole];
+            result = d->mAllTrackData[index.row()].title();
             if (result.toString().isEmpty()) {
-                result = d->mAllTrackData[index.row()][TrackDataType::key_type::ResourceRole].toUrl().fileName();
+                result = d->mAllTrackData[index.row()].resourceURI().fileName();
             }
             break;
         case ElisaUtils::Album:
@@ -165,7 +382,7 @@ QVariant DataModel::data(const QModelIndex &index, int role) const
         {
         case ElisaUtils::Track:
         {
-            auto trackDuration = d->mAllTrackData[index.row()][TrackDataType::key_type::DurationRole].toTime();
+            auto trackDuration = d->mAllTrackData[index.row()].duration();
             if (trackDuration.hour() == 0) {
                 result = QLocale().toString(trackDuration, QStringLiteral("mm:ss"));
             } else {
@@ -192,7 +409,7 @@ QVariant DataModel::data(const QModelIndex &index, int role) const
         switch (d->mModelType)
         {
         case ElisaUtils::Track:
-            result = d->mAllTrackData[index.row()][TrackDataType::key_type::IsSingleDiscAlbumRole];
+            result = d->mAllTrackData[index.row()].data(TrackDataType::key_type::IsSingleDiscAlbumRole);
             break;
         case ElisaUtils::Radio:
             result = false;
@@ -218,11 +435,11 @@ QVariant DataModel::data(const QModelIndex &index, int role) const
         {
         case ElisaUtils::Track:
         {
-            auto itArtist = d->mAllTrackData[index.row()].find(TrackDataType::key_type::ArtistRole);
-            if (itArtist != d->mAllTrackData[index.row()].end()) {
-                result = d->mAllTrackData[index.row()][TrackDataType::key_type::ArtistRole];
+            const auto &oneTrack = d->mAllTrackData[index.row()];
+            if (oneTrack.hasRole(TrackDataType::key_type::ArtistRole)) {
+                result = oneTrack.data(TrackDataType::key_type::ArtistRole);
             } else {
-                result = d->mAllTrackData[index.row()][TrackDataType::key_type::AlbumArtistRole];
+                result = oneTrack.data(TrackDataType::key_type::AlbumArtistRole);
             }
             break;
         }
@@ -252,7 +469,7 @@ QVariant DataModel::data(const QModelIndex &index, int role) const
         switch (d->mModelType)
         {
         case ElisaUtils::Track:
-            result = QVariant::fromValue(static_cast<DataTypes::MusicDataType>(d->mAllTrackData[index.row()]));
+            result = QVariant::fromValue(static_cast<DataTypes::MusicDataType>(d->mAllTrackData[index.row()].toTrackData()));
             break;
         case ElisaUtils::Radio:
             result = QVariant::fromValue(static_cast<DataTypes::MusicDataType>(d->mAllRadiosData[index.row()]));
@@ -281,7 +498,7 @@ QVariant DataModel::data(const QModelIndex &index, int role) const
         {
         case ElisaUtils::Track:
         case ElisaUtils::FileName:
-            result = d->mAllTrackData[index.row()][TrackDataType::key_type::ResourceRole];
+            result = d->mAllTrackData[index.row()].resourceURI();
             break;
         case ElisaUtils::Radio:
             result = d->mAllRadiosData[index.row()][TrackDataType::key_type::ResourceRole];
@@ -325,7 +542,7 @@ QVariant DataModel::data(const QModelIndex &index, int role) const
         switch(d->mModelType)
         {
         case ElisaUtils::Track:
-            result = d->mAllTrackData[index.row()][static_cast<TrackDataType::key_type>(role)];
+            result = d->mAllTrackData[index.row()].data(static_cast<TrackDataType::key_type>(role));
             break;
         case ElisaUtils::Album:
             result = d->mAllAlbumData[index.row()][static_cast<AlbumDataType::key_type>(role)];
@@ -393,6 +610,90 @@ bool DataModel::isBusy() const
     return d->mIsBusy;
 }
 
+QString DataModel::searchText() const
+{
+    return d->mSearchText;
+}
+
+bool DataModel::isSearchable() const
+{
+    if (d->mFilterType != ElisaUtils::NoFilter) {
+        return false;
+    }
+
+    switch (d->mModelType)
+    {
+    case ElisaUtils::Track:
+    case ElisaUtils::Album:
+    case ElisaUtils::Artist:
+        return true;
+    case ElisaUtils::Genre:
+    case ElisaUtils::Lyricist:
+    case ElisaUtils::Composer:
+    case ElisaUtils::FileName:
+    case ElisaUtils::Container:
+    case ElisaUtils::Radio:
+    case ElisaUtils::PlayList:
+    case ElisaUtils::Unknown:
+        break;
+    }
+
+    return false;
+}
+
+bool DataModel::canFetchMore(const QModelIndex &parent) const
+{
+    if (parent.isValid()) {
+        return false;
+    }
+
+    return isSearching() && d->mHasMoreSearchResults && !d->mIsWaitingForSearchResults;
+}
+
+void DataModel::fetchMore(const QModelIndex &parent)
+{
+    if (!canFetchMore(parent)) {
+        return;
+    }
+
+    askSearchData();
+}
+
+void DataModel::setSearchText(const QString &searchText)
+{
+    if (d->mSearchText == searchText) {
+        return;
+    }
+
+    const auto wasSearching = isSearching();
+
+    d->mSearchText = searchText;
+    Q_EMIT searchTextChanged();
+
+    if (!isSearchable() || (!wasSearching && !isSearching())) {
+        return;
+    }
+
+    beginResetModel();
+    d->mAllTrackData.clear();
+    d->mAllAlbumData.clear();
+    d->mAllArtistData.clear();
+    d->clearRowsIndex();
+    endResetModel();
+
+    d->mLastSearchResultId = 0;
+    d->mHasMoreSearchResults = false;
+    d->mIsWaitingForSearchResults = false;
+
+    setBusy(true);
+
+    if (isSearching()) {
+        askSearchData();
+    } else {
+        askModelData();
+    }
+}
+
 void DataModel::initializeByData(MusicListenersManager *manager, DatabaseInterface *database,
                                  ElisaUtils::PlayListEntryType modelType, ElisaUtils::FilterType filter,
                                  const DataTypes::DataType &dataFilter)
@@ -471,7 +772,11 @@ void DataModel::initializeModel(MusicListenersManager *manager, DatabaseInterfac
 
     setBusy(true);
 
-    askModelData();
+    if (isSearching()) {
+        askSearchData();
+    } else {
+        askModelData();
+    }
 }
 
 void DataModel::askModelData()
@@ -505,20 +810,39 @@ void DataModel::askModelData()
     }
 }
 
-int DataModel::indexFromId(qulonglong id) const
+void DataModel::askSearchData()
 {
-    int result;
-    DataModel::ListTrackDataType mAllData = d->mModelType == ElisaUtils::Radio ? d->mAllRadiosData: d->mAllTrackData;
+    d->mIsWaitingForSearchResults = true;
 
-    for (result = 0; result < mAllData.size(); ++result) {
-        if (mAllData[result].databaseId() == id) {
-            return result;
-        }
+    Q_EMIT needDataBySearch(d->mModelType, d->mSearchText, d->mLastSearchResultId, searchPageSize);
+}
+
+bool DataModel::isSearching() const
+{
+    return isSearchable() && !d->mSearchText.simplified().isEmpty();
+}
+
+bool DataModel::searchPageReceived(const QString &searchText, qsizetype pageSize, qulonglong lastDatabaseId)
+{
+    // pages for a previous search text may still arrive after the text has changed
+    if (!isSearching() || searchText != d->mSearchText) {
+        return false;
     }
 
-    result = -1;
+    d->mIsWaitingForSearchResults = false;
+    d->mHasMoreSearchResults = pageSize == searchPageSize;
+    if (pageSize > 0) {
+        d->mLastSearchResultId = lastDatabaseId;
+    }
 
-    return result;
+    setBusy(false);
+
+    return pageSize > 0;
+}
+
+int DataModel::indexFromId(qulonglong id) const
+{
+    return d->rowFromDatabaseId(id);
 }
 
 void DataModel::connectModel(DatabaseInterface *database)
@@ -562,10 +886,37 @@ void DataModel::connectModel(DatabaseInterface *database)
             this, &DataModel::radioRemoved);
     connect(d->mDataLoader, &ModelDataLoader::clearedDatabase,
             this, &DataModel::cleanedDatabase);
+    connect(this, &DataModel::needDataBySearch,
+            d->mDataLoader, &ModelDataLoader::loadDataBySearch);
+    connect(d->mDataLoader, &ModelDataLoader::tracksSearchData,
+            this, &DataModel::tracksFound);
+    connect(d->mDataLoader, &ModelDataLoader::albumsSearchData,
+            this, &DataModel::albumsFound);
+    connect(d->mDataLoader, &ModelDataLoader::artistsSearchData,
+            this, &DataModel::artistsFound);
 }
 
 void DataModel::tracksAdded(ListTrackDataType newData)
 {
+    if (isSearching()) {
+        if (d->mModelType != ElisaUtils::Track) {
+            return;
+        }
+
+        d->keepNewSearchResults(newData, [this](const DataTypes::TrackDataType &oneTrack) {
+            return matchesSearchText(d->mSearchText, {oneTrack.title(), oneTrack.artist(), oneTrack.album(), oneTrack.albumArtist(),
+                                                      oneTrack.genre(), oneTrack.composer(), oneTrack.lyricist()});
+        });
+
+        if (!newData.isEmpty()) {
+            beginInsertRows({}, d->mAllTrackData.size(), d->mAllTrackData.size() + newData.size() - 1);
+            appendTrackRecords(newData);
+            endInsertRows();
+        }
+
+        return;
+    }
+
     if (newData.isEmpty() && d->mModelType == ElisaUtils::Track) {
         setBusy(false);
     }
@@ -575,53 +926,83 @@ void DataModel::tracksAdded(ListTrackDataType newData)
     }
 
     if (d->mFilterType == ElisaUtils::FilterById && !d->mAllTrackData.isEmpty()) {
-        for (const auto &newTrack : newData) {
-            auto trackIndex = indexFromId(newTrack.databaseId());
+        insertTracksInAlbumOrder(std::move(newData));
+    } else {
+        const auto wasEmpty = d->mAllTrackData.isEmpty();
 
-            if (trackIndex != -1) {
-                continue;
+        // a track added to the collection while the pages of tracks are loaded is
+        // received from the database and again in one of the next pages
+        d->dropKnownRows(newData);
+
+        if (newData.isEmpty()) {
+            if (wasEmpty) {
+                setBusy(false);
             }
+            return;
+        }
 
-            bool trackInserted = false;
-            for (int trackIndex = 0; trackIndex < d->mAllTrackData.count(); ++trackIndex) {
-                const auto &oneTrack = d->mAllTrackData[trackIndex];
+        beginInsertRows({}, d->mAllTrackData.size(), d->mAllTrackData.size() + newData.size() - 1);
+        appendTrackRecords(newData);
+        endInsertRows();
 
-                if (oneTrack.discNumber() >= newTrack.discNumber() && oneTrack.trackNumber() > newTrack.trackNumber()) {
-                    beginInsertRows({}, trackIndex, trackIndex);
-                    d->mAllTrackData.insert(trackIndex, newTrack);
-                    endInsertRows();
+        if (wasEmpty) {
+            setBusy(false);
+        }
+    }
+}
 
-                    if (d->mAllTrackData.size() == 1) {
-                        setBusy(false);
-                    }
+void DataModel::insertTracksInAlbumOrder(ListTrackDataType newData)
+{
+    QSet<qulonglong> newTracksIds;
+    newData.removeIf([this, &newTracksIds](const auto &newTrack) {
+        const auto newTrackId = newTrack.databaseId();
 
-                    trackInserted = true;
-                    break;
-                }
-            }
+        if (d->isKnownRow(newTrackId) || newTracksIds.contains(newTrackId)) {
+            return true;
+        }
 
-            if (!trackInserted) {
-                beginInsertRows({}, d->mAllTrackData.count(), d->mAllTrackData.count());
-                d->mAllTrackData.insert(d->mAllTrackData.count(), newTrack);
-                endInsertRows();
+        newTracksIds.insert(newTrackId);
+        return false;
+    });
 
-                if (d->mAllTrackData.size() == 1) {
-                    setBusy(false);
-                }
-            }
+    std::stable_sort(newData.begin(), newData.end(), isBeforeInAlbum<TrackDataType, TrackDataType>);
+
+    // the shown tracks are in album order: one walk over both lists finds the ranges of new rows
+    qsizetype insertionRow = 0;
+    qsizetype firstNewTrack = 0;
+
+    while (firstNewTrack < newData.size()) {
+        while (insertionRow < d->mAllTrackData.size() && !isBeforeInAlbum(newData[firstNewTrack], d->mAllTrackData[insertionRow])) {
+            ++insertionRow;
         }
-    } else {
-        if (d->mAllTrackData.isEmpty()) {
-            beginInsertRows({}, 0, newData.size() - 1);
-            d->mAllTrackData.swap(newData);
-            endInsertRows();
 
-            setBusy(false);
-        } else {
-            beginInsertRows({}, d->mAllTrackData.size(), d->mAllTrackData.size() + newData.size() - 1);
-            d->mAllTrackData.append(newData);
-            endInsertRows();
+        auto endNewTracks = firstNewTrack + 1;
+        while (endNewTracks < newData.size() &&
+               (insertionRow == d->mAllTrackData.size() || isBeforeInAlbum(newData[endNewTracks], d->mAllTrackData[insertionRow]))) {
+            ++endNewTracks;
         }
+
+        const auto insertedCount = endNewTracks - firstNewTrack;
+
+        beginInsertRows({}, insertionRow, insertionRow + insertedCount - 1);
+        d->mAllTrackData.insert(insertionRow, insertedCount, DataTypes::TrackRecord{});
+        for (auto newTrackIndex = firstNewTrack; newTrackIndex < endNewTracks; ++newTrackIndex) {
+            d->mAllTrackData[insertionRow + newTrackIndex - firstNewTrack] = DataTypes::TrackRecord{newData[newTrackIndex]};
+        }
+        d->rowsInserted(insertionRow, insertedCount);
+        endInsertRows();
+
+        insertionRow += insertedCount;
+        firstNewTrack = endNewTracks;
+    }
+}
+
+void DataModel::appendTrackRecords(const ListTrackDataType &newData)
+{
+    d->mAllTrackData.reserve(d->mAllTrackData.size() + newData.size());
+
+    for (const auto &oneTrack : newData) {
+        d->mAllTrackData.push_back(DataTypes::TrackRecord{oneTrack});
     }
 }
 
@@ -650,6 +1031,7 @@ void DataModel::radiosAdded(ListRadioDataType newData)
                 if (oneTrack.trackNumber() > newTrack.trackNumber()) {
                     beginInsertRows({}, trackIndex, trackIndex);
                     d->mAllRadiosData.insert(trackIndex, newTrack);
+                    d->rowsInserted(trackIndex, 1);
                     endInsertRows();
 
                     if (d->mAllRadiosData.size() == 1) {
@@ -692,35 +1074,18 @@ void DataModel::trackModified(const TrackDataType &modifiedTrack)
         return;
     }
 
-    if (!d->mAlbumTitle.isEmpty() && !d->mAlbumArtist.isEmpty()) {
-        if (modifiedTrack.album() != d->mAlbumTitle) {
-            return;
-        }
-
-        auto trackIndex = indexFromId(modifiedTrack.databaseId());
-
-        if (trackIndex == -1) {
-            return;
-        }
-
-        d->mAllTrackData[trackIndex] = modifiedTrack;
-        Q_EMIT dataChanged(index(trackIndex, 0), index(trackIndex, 0));
-    } else {
-        auto itTrack = std::find_if(d->mAllTrackData.begin(), d->mAllTrackData.end(),
-                                    [modifiedTrack](auto track) {
-            return track.databaseId() == modifiedTrack.databaseId();
-        });
-
-        if (itTrack == d->mAllTrackData.end()) {
-            return;
-        }
-
-        auto position = itTrack - d->mAllTrackData.begin();
+    if (!d->mAlbumTitle.isEmpty() && !d->mAlbumArtist.isEmpty() && modifiedTrack.album() != d->mAlbumTitle) {
+        return;
+    }
 
-        d->mAllTrackData[position] = modifiedTrack;
+    auto trackIndex = indexFromId(modifiedTrack.databaseId());
 
-        Q_EMIT dataChanged(index(position, 0), index(position, 0));
+    if (trackIndex == -1) {
+        return;
     }
+
+    d->mAllTrackData[trackIndex] = DataTypes::TrackRecord{modifiedTrack};
+    Q_EMIT dataChanged(index(trackIndex, 0), index(trackIndex, 0));
 }
 
 void DataModel::radioModified(const TrackDataType &modifiedRadio)
@@ -745,30 +1110,18 @@ void DataModel::trackRemoved(qulonglong removedTrackId)
         return;
     }
 
-    if (!d->mAlbumTitle.isEmpty() && !d->mAlbumArtist.isEmpty()) {
-        auto trackIndex = indexFromId(removedTrackId);
+    d->mRemovedDatabaseIds.insert(removedTrackId);
 
-        if (trackIndex == -1) {
-            return;
-        }
-
-        beginRemoveRows({}, trackIndex, trackIndex);
-        d->mAllTrackData.removeAt(trackIndex);
-        endRemoveRows();
-    } else {
-        const auto itTrack = std::find_if(d->mAllTrackData.cbegin(), d->mAllTrackData.cend(),
-                                         [removedTrackId](auto track) {return track.databaseId() == removedTrackId;});
-
-        if (itTrack == d->mAllTrackData.cend()) {
-            return;
-        }
+    auto trackIndex = indexFromId(removedTrackId);
 
-        auto position = itTrack - d->mAllTrackData.cbegin();
-
-        beginRemoveRows({}, position, position);
-        d->mAllTrackData.erase(itTrack);
-        endRemoveRows();
+    if (trackIndex == -1) {
+        return;
     }
+
+    beginRemoveRows({}, trackIndex, trackIndex);
+    d->mAllTrackData.removeAt(trackIndex);
+    d->rowRemoved(trackIndex, removedTrackId);
+    endRemoveRows();
 }
 
 void DataModel::radioRemoved(qulonglong removedRadioId)
@@ -777,18 +1130,15 @@ void DataModel::radioRemoved(qulonglong removedRadioId)
         return;
     }
 
+    auto radioIndex = indexFromId(removedRadioId);
 
-    const auto itRadio = std::find_if(d->mAllRadiosData.cbegin(), d->mAllRadiosData.cend(),
-                                      [removedRadioId](auto track) {return track.databaseId() == removedRadioId;});
-
-    if (itRadio == d->mAllRadiosData.cend()) {
+    if (radioIndex == -1) {
         return;
     }
 
-    auto position = itRadio - d->mAllRadiosData.cbegin();
-
-    beginRemoveRows({}, position, position);
-    d->mAllRadiosData.erase(itRadio);
+    beginRemoveRows({}, radioIndex, radioIndex);
+    d->mAllRadiosData.removeAt(radioIndex);
+    d->rowRemoved(radioIndex, removedRadioId);
     endRemoveRows();
 }
 
@@ -811,6 +1161,7 @@ void DataModel::removeRadios()
 
     beginRemoveRows({}, 0, d->mAllRadiosData.size());
     d->mAllRadiosData.clear();
+    d->clearRowsIndex();
     endRemoveRows();
 }
 
@@ -824,6 +1175,15 @@ void DataModel::genresAdded(DataModel::ListGenreDataType newData)
         return;
     }
 
+    d->dropKnownRows(newData);
+
+    if (newData.isEmpty()) {
+        if (d->mAllGenreData.isEmpty()) {
+            setBusy(false);
+        }
+        return;
+    }
+
     if (d->mAllGenreData.isEmpty()) {
         beginInsertRows({}, d->mAllGenreData.size(), newData.size() - 1);
         d->mAllGenreData.swap(newData);
@@ -843,25 +1203,43 @@ void DataModel::genreRemoved(qulonglong removedDatabaseId)
         return;
     }
 
-    const auto removedDataIterator = std::find_if(d->mAllGenreData.cbegin(), d->mAllGenreData.cend(), [removedDatabaseId](const auto &genre) {
-        return genre.databaseId() == removedDatabaseId;
-    });
+    d->mRemovedDatabaseIds.insert(removedDatabaseId);
+
+    auto dataIndex = indexFromId(removedDatabaseId);
 
-    if (removedDataIterator == d->mAllGenreData.cend()) {
+    if (dataIndex == -1) {
         return;
     }
 
-    int dataIndex = removedDataIterator - d->mAllGenreData.cbegin();
-
     beginRemoveRows({}, dataIndex, dataIndex);
 
-    d->mAllGenreData.erase(removedDataIterator);
+    d->mAllGenreData.removeAt(dataIndex);
+    d->rowRemoved(dataIndex, removedDatabaseId);
 
     endRemoveRows();
 }
 
 void DataModel::artistsAdded(DataModel::ListArtistDataType newData)
 {
+    if (isSearching()) {
+        if (d->mModelType != ElisaUtils::Artist) {
+            return;
+        }
+
+        // the database searches the name of the artists for the whole text
+        d->keepNewSearchResults(newData, [this](const DataTypes::ArtistDataType &oneArtist) {
+            return oneArtist.name().contains(d->mSearchText.simplified(), Qt::CaseInsensitive);
+        });
+
+        if (!newData.isEmpty()) {
+            beginInsertRows({}, d->mAllArtistData.size(), d->mAllArtistData.size() + newData.size() - 1);
+            d->mAllArtistData.append(newData);
+            endInsertRows();
+        }
+
+        return;
+    }
+
     if (newData.isEmpty() && d->mModelType == ElisaUtils::Artist) {
         setBusy(false);
     }
@@ -870,6 +1248,15 @@ void DataModel::artistsAdded(DataModel::ListArtistDataType newData)
         return;
     }
 
+    d->dropKnownRows(newData);
+
+    if (newData.isEmpty()) {
+        if (d->mAllArtistData.isEmpty()) {
+            setBusy(false);
+        }
+        return;
+    }
+
     if (d->mAllArtistData.isEmpty()) {
         beginInsertRows({}, d->mAllArtistData.size(), newData.size() - 1);
         d->mAllArtistData.swap(newData);
@@ -889,24 +1276,43 @@ void DataModel::artistRemoved(qulonglong removedDatabaseId)
         return;
     }
 
-    const auto removedDataIterator = std::find_if(d->mAllArtistData.cbegin(), d->mAllArtistData.cend(),
-                                                  [removedDatabaseId](auto album) {return album.databaseId() == removedDatabaseId;});
+    d->mRemovedDatabaseIds.insert(removedDatabaseId);
+
+    auto dataIndex = indexFromId(removedDatabaseId);
 
-    if (removedDataIterator == d->mAllArtistData.cend()) {
+    if (dataIndex == -1) {
         return;
     }
 
-    int dataIndex = removedDataIterator - d->mAllArtistData.cbegin();
-
     beginRemoveRows({}, dataIndex, dataIndex);
 
-    d->mAllArtistData.erase(removedDataIterator);
+    d->mAllArtistData.removeAt(dataIndex);
+    d->rowRemoved(dataIndex, removedDatabaseId);
 
     endRemoveRows();
 }
 
 void DataModel::albumsAdded(DataModel::ListAlbumDataType newData)
 {
+    if (isSearching()) {
+        if (d->mModelType != ElisaUtils::Album) {
+            return;
+        }
+
+        d->keepNewSearchResults(newData, [this](const DataTypes::AlbumDataType &oneAlbum) {
+            return matchesSearchText(d->mSearchText, QStringList{oneAlbum.title(), oneAlbum.artist()} +
+                                                     oneAlbum[DataTypes::AllArtistsRole].toStringList() + oneAlbum.genres());
+        });
+
+        if (!newData.isEmpty()) {
+            beginInsertRows({}, d->mAllAlbumData.size(), d->mAllAlbumData.size() + newData.size() - 1);
+            d->mAllAlbumData.append(newData);
+            endInsertRows();
+        }
+
+        return;
+    }
+
     if (newData.isEmpty() && d->mModelType == ElisaUtils::Album) {
         setBusy(false);
     }
@@ -915,6 +1321,15 @@ void DataModel::albumsAdded(DataModel::ListAlbumDataType newData)
         return;
     }
 
+    d->dropKnownRows(newData);
+
+    if (newData.isEmpty()) {
+        if (d->mAllAlbumData.isEmpty()) {
+            setBusy(false);
+        }
+        return;
+    }
+
     if (d->mAllAlbumData.isEmpty()) {
         beginInsertRows({}, d->mAllAlbumData.size(), newData.size() - 1);
         d->mAllAlbumData.swap(newData);
@@ -934,20 +1349,18 @@ void DataModel::albumRemoved(qulonglong removedDatabaseId)
         return;
     }
 
-    auto removedDataIterator = d->mAllAlbumData.cend();
+    d->mRemovedDatabaseIds.insert(removedDatabaseId);
 
-    removedDataIterator = std::find_if(d->mAllAlbumData.cbegin(), d->mAllAlbumData.cend(),
-                                       [removedDatabaseId](auto album) {return album.databaseId() == removedDatabaseId;});
+    auto dataIndex = indexFromId(removedDatabaseId);
 
-    if (removedDataIterator == d->mAllAlbumData.cend()) {
+    if (dataIndex == -1) {
         return;
     }
 
-    int dataIndex = removedDataIterator - d->mAllAlbumData.cbegin();
-
     beginRemoveRows({}, dataIndex, dataIndex);
 
-    d->mAllAlbumData.erase(removedDataIterator);
+    d->mAllAlbumData.removeAt(dataIndex);
+    d->rowRemoved(dataIndex, removedDatabaseId);
 
     endRemoveRows();
 }
@@ -958,20 +1371,51 @@ void DataModel::albumModified(const DataModel::AlbumDataType &modifiedAlbum)
         return;
     }
 
-    auto modifiedAlbumIterator = std::find_if(d->mAllAlbumData.begin(), d->mAllAlbumData.end(),
-                                              [modifiedAlbum](auto album) {
-        return album.databaseId() == modifiedAlbum.databaseId();
-    });
+    auto albumIndex = indexFromId(modifiedAlbum.databaseId());
 
-    if (modifiedAlbumIterator == d->mAllAlbumData.end()) {
+    if (albumIndex == -1) {
         return;
     }
 
-    auto albumIndex = modifiedAlbumIterator - d->mAllAlbumData.begin();
-
     Q_EMIT dataChanged(index(albumIndex, 0), index(albumIndex, 0));
 }
 
+void DataModel::tracksFound(const QString &searchText, DataModel::ListTrackDataType newData)
+{
+    if (d->mModelType != ElisaUtils::Track ||
+        !searchPageReceived(searchText, newData.size(), newData.isEmpty() ? 0 : newData.constLast().databaseId())) {
+        return;
+    }
+
+    beginInsertRows({}, d->mAllTrackData.size(), d->mAllTrackData.size() + newData.size() - 1);
+    appendTrackRecords(newData);
+    endInsertRows();
+}
+
+void DataModel::albumsFound(const QString &searchText, DataModel::ListAlbumDataType newData)
+{
+    if (d->mModelType != ElisaUtils::Album ||
+        !searchPageReceived(searchText, newData.size(), newData.isEmpty() ? 0 : newData.constLast().databaseId())) {
+        return;
+    }
+
+    beginInsertRows({}, d->mAllAlbumData.size(), d->mAllAlbumData.size() + newData.size() - 1);
+    d->mAllAlbumData.append(newData);
+    endInsertRows();
+}
+
+void DataModel::artistsFound(const QString &searchText, DataModel::ListArtistDataType newData)
+{
+    if (d->mModelType != ElisaUtils::Artist ||
+        !searchPageReceived(searchText, newData.size(), newData.isEmpty() ? 0 : newData.constLast().databaseId())) {
+        return;
+    }
+
+    beginInsertRows({}, d->mAllArtistData.size(), d->mAllArtistData.size() + newData.size() - 1);
+    d->mAllArtistData.append(newData);
+    endInsertRows();
+}
+
 void DataModel::initialize(MusicListenersManager *manager, DatabaseInterface *database,
                            ElisaUtils::PlayListEntryType modelType, ElisaUtils::FilterType filter,
                            const QString &genre, const QString &artist, qulonglong databaseId,
@@ -995,6 +1439,8 @@ void DataModel::cleanedDatabase()
     d->mAllGenreData.clear();
     d->mAllTrackData.clear();
     d->mAllArtistData.clear();
+    d->clearRowsIndex();
+    d->mRemovedDatabaseIds.clear();
     endResetModel();
 }
 
@@ -39,6 +39,11 @@ class ELISALIB_EXPORT DataModel : public QAbstractListModel
 
     Q_PROPERTY(bool isBusy READ isBusy NOTIFY isBusyChanged)
 
+    Q_PROPERTY(QString searchText
+               READ searchText
+               WRITE setSearchText
+               NOTIFY searchTextChanged)
+
 public:
 
     using ListRadioDataType = DataTypes::ListRadioDataType;
@@ -77,12 +82,25 @@ public:
 
     [[nodiscard]] QModelIndex parent(const QModelIndex &child) const override;
 
+    [[nodiscard]] bool canFetchMore(const QModelIndex &parent) const override;
+
+    void fetchMore(const QModelIndex &parent) override;
+
     [[nodiscard]] QString title() const;
 
     [[nodiscard]] QString author() const;
 
     [[nodiscard]] bool isBusy() const;
 
+    [[nodiscard]] QString searchText() const;
+
+    /**
+     * True when the search text is matched by the database search index instead
+     * of being filtered by a proxy model: only the unfiltered lists of tracks,
+     * albums and artists are searched this way.
+     */
+    [[nodiscard]] bool isSearchable() const;
+
 Q_SIGNALS:
 
     void titleChanged();
@@ -104,8 +122,13 @@ Q_SIGNALS:
 
     void needFrequentlyPlayedData(ElisaUtils::PlayListEntryType dataType);
 
+    void needDataBySearch(ElisaUtils::PlayListEntryType dataType, const QString &searchText,
+                          qulonglong afterDatabaseId, int count);
+
     void isBusyChanged();
 
+    void searchTextChanged();
+
 public Q_SLOTS:
 
     void tracksAdded(DataModel::ListTrackDataType newData);
@@ -132,6 +155,14 @@ public Q_SLOTS:
 
     void albumModified(const DataModel::AlbumDataType &modifiedAlbum);
 
+    void tracksFound(const QString &searchText, DataModel::ListTrackDataType newData);
+
+    void albumsFound(const QString &searchText, DataModel::ListAlbumDataType newData);
+
+    void artistsFound(const QString &searchText, DataModel::ListArtistDataType newData);
+
+    void setSearchText(const QString &searchText);
+
     void initialize(MusicListenersManager *manager, DatabaseInterface *database,
                     ElisaUtils::PlayListEntryType modelType, ElisaUtils::FilterType filter,
                     const QString &genre, const QString &artist, qulonglong databaseId,
@@ -153,6 +184,14 @@ private:
 
     [[nodiscard]] int indexFromId(qulonglong id) const;
 
+    /**
+     * Insert the tracks that are not yet shown at their position in the album, sorted by disc and track numbers
+     * Each range of consecutive new rows is inserted at once.
+     */
+    void insertTracksInAlbumOrder(ListTrackDataType newData);
+
+    void appendTrackRecords(const ListTrackDataType &newData);
+
     void connectModel(DatabaseInterface *database);
 
     void setBusy(bool value);
@@ -162,6 +201,12 @@ private:
 
     void askModelData();
 
+    void askSearchData();
+
+    [[nodiscard]] bool isSearching() const;
+
+    [[nodiscard]] bool searchPageReceived(const QString &searchText, qsizetype pageSize, qulonglong lastDatabaseId);
+
     void removeRadios();
 
     std::unique_ptr<DataModelPrivate> d;
@@ -35,7 +35,19 @@
 #include <QCoreApplication>
 #include <QFileSystemWatcher>
 
+#include <algorithm>
 #include <list>
+#include <vector>
+
+class DatabaseReader
+{
+public:
+
+    QThread mThread;
+
+    DatabaseInterface mDatabaseInterface;
+
+};
 
 class MusicListenersManagerPrivate
 {
@@ -57,6 +69,11 @@ public:
 
     DatabaseInterface mDatabaseInterface;
 
+    // read-only connections used by the models, each one in its own thread
+    std::vector<std::unique_ptr<DatabaseReader>> mDatabaseReaders;
+
+    size_t mNextDatabaseReader = 0;
+
     std::unique_ptr<TracksListener> mTracksListener;
 
     QFileSystemWatcher mConfigFileWatcher;
@@ -117,6 +134,19 @@ MusicListenersManager::MusicListenersManager(QObject *parent)
     QMetaObject::invokeMethod(&d->mDatabaseInterface, "init", Qt::QueuedConnection,
                               Q_ARG(QString, QStringLiteral("listeners")), Q_ARG(QString, databaseFileName));
 
+    // the read-only connections need the schema created by the read-write one: their threads
+    // are only started in databaseReady() and the queued init is the first event they handle
+    if (!databaseFileName.isEmpty()) {
+        const auto readersCount = std::clamp(QThread::idealThreadCount() / 2, 1, 4);
+        for (int i = 0; i < readersCount; ++i) {
+            auto newReader = std::make_unique<DatabaseReader>();
+            newReader->mDatabaseInterface.moveToThread(&newReader->mThread);
+            QMetaObject::invokeMethod(&newReader->mDatabaseInterface, "initReadOnly", Qt::QueuedConnection,
+                                      Q_ARG(QString, QStringLiteral("reader") + QString::number(i)), Q_ARG(QString, databaseFileName));
+            d->mDatabaseReaders.push_back(std::move(newReader));
+        }
+    }
+
     qCInfo(orgKdeElisaIndexersManager) << "Local file system indexer is inactive";
 }
 
@@ -125,6 +155,11 @@ MusicListenersManager::~MusicListenersManager()
     d->mListenerThread.quit();
     d->mListenerThread.wait();
 
+    for (const auto &oneReader : d->mDatabaseReaders) {
+        oneReader->mThread.quit();
+        oneReader->mThread.wait();
+    }
+
     d->mDatabaseThread.quit();
     d->mDatabaseThread.wait();
 }
@@ -196,6 +231,12 @@ auto MusicListenersManager::initializeRootPath()
 
 void MusicListenersManager::databaseReady()
 {
+    for (const auto &oneReader : d->mDatabaseReaders) {
+        if (!oneReader->mThread.isRunning()) {
+            oneReader->mThread.start();
+        }
+    }
+
     auto initialRootPath = Elisa::ElisaConfiguration::rootPath();
     if (initialRootPath.isEmpty()) {
         initializeRootPath();
@@ -212,6 +253,11 @@ void MusicListenersManager::applicationAboutToQuit()
 
     Q_EMIT applicationIsTerminating();
 
+    for (const auto &oneReader : d->mDatabaseReaders) {
+        oneReader->mThread.exit();
+        oneReader->mThread.wait();
+    }
+
     d->mDatabaseThread.exit();
     d->mDatabaseThread.wait();
 
@@ -268,7 +314,17 @@ void MusicListenersManager::deleteElementById(ElisaUtils::PlayListEntryType entr
 
 void MusicListenersManager::connectModel(ModelDataLoader *dataLoader)
 {
-    dataLoader->moveToThread(&d->mDatabaseThread);
+    if (d->mDatabaseReaders.empty()) {
+        dataLoader->moveToThread(&d->mDatabaseThread);
+        return;
+    }
+
+    // spread the models over the read-only connections
+    const auto &reader = d->mDatabaseReaders[d->mNextDatabaseReader];
+    d->mNextDatabaseReader = (d->mNextDatabaseReader + 1) % d->mDatabaseReaders.size();
+
+    dataLoader->setReadDatabase(&reader->mDatabaseInterface);
+    dataLoader->moveToThread(&reader->mThread);
 }
 
 void MusicListenersManager::scanCollection(CollectionScan scantype)
@@ -0,0 +1,140 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) Elisa contributors
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#include "stringpool.h"
+
+#include <QAtomicInteger>
+#include <QReadWriteLock>
+#include <QSet>
+
+#include <algorithm>
+
+namespace
+{
+
+struct StringPoolData
+{
+    QReadWriteLock mLock;
+
+    QSet<QString> mStrings;
+
+    qint64 mPoolBytes = 0;
+
+    qsizetype mCleanupSize = 0;
+
+    QAtomicInteger<qint64> mLookupsCount = 0;
+
+    QAtomicInteger<qint64> mSharedCount = 0;
+
+    QAtomicInteger<qint64> mSavedBytes = 0;
+};
+
+StringPoolData &stringPoolData()
+{
+    static StringPoolData poolData;
+
+    return poolData;
+}
+
+qint64 stringBytes(const QString &value)
+{
+    return value.size() * qint64(sizeof(QChar));
+}
+
+constexpr qsizetype minimumCleanupSize = 4096;
+
+// drop the strings no longer used outside of the pool: it then keeps the values
+// of the tracks still loaded instead of every value seen since the start
+void removeUnusedStrings(StringPoolData &poolData)
+{
+    for (auto itString = poolData.mStrings.begin(); itString != poolData.mStrings.end();) {
+        if (!itString->data_ptr().isShared()) {
+            poolData.mPoolBytes -= stringBytes(*itString);
+            itString = poolData.mStrings.erase(itString);
+        } else {
+            ++itString;
+        }
+    }
+
+    // cleaning up when the pool has doubled keeps the cost of an insertion constant
+    poolData.mCleanupSize = std::max(minimumCleanupSize, 2 * poolData.mStrings.size());
+}
+
+}
+
+QString StringPool::intern(const QString &value)
+{
+    if (value.isEmpty()) {
+        return value;
+    }
+
+    auto &poolData = stringPoolData();
+
+    poolData.mLookupsCount.fetchAndAddRelaxed(1);
+
+    const auto sharedString = [&poolData, &value](const QString &pooledString) {
+        // a string already sharing the pooled buffer does not save anything
+        if (pooledString.constData() != value.constData()) {
+            poolData.mSharedCount.fetchAndAddRelaxed(1);
+            poolData.mSavedBytes.fetchAndAddRelaxed(stringBytes(value));
+        }
+
+        return pooledString;
+    };
+
+    {
+        QReadLocker readLocker(&poolData.mLock);
+
+        const auto itString = poolData.mStrings.constFind(value);
+        if (itString != poolData.mStrings.cend()) {
+            return sharedString(*itString);
+        }
+    }
+
+    QWriteLocker writeLocker(&poolData.mLock);
+
+    // another thread may have added it while the lock was released
+    const auto itString = poolData.mStrings.constFind(value);
+    if (itString != poolData.mStrings.cend()) {
+        return sharedString(*itString);
+    }
+
+    if (poolData.mStrings.size() >= std::max(minimumCleanupSize, poolData.mCleanupSize)) {
+        removeUnusedStrings(poolData);
+    }
+
+    poolData.mStrings.insert(value);
+    poolData.mPoolBytes += stringBytes(value);
+
+    return value;
+}
+
+StringPool::Statistics StringPool::statistics()
+{
+    auto &poolData = stringPoolData();
+
+    auto result = Statistics{};
+
+    result.mLookupsCount = poolData.mLookupsCount.loadRelaxed();
+    result.mSharedCount = poolData.mSharedCount.loadRelaxed();
+    result.mSavedBytes = poolData.mSavedBytes.loadRelaxed();
+
+    QReadLocker readLocker(&poolData.mLock);
+
+    result.mStringsCount = poolData.mStrings.size();
+    result.mPoolBytes = poolData.mPoolBytes;
+
+    return result;
+}
+
+void StringPool::resetStatistics()
+{
+    auto &poolData = stringPoolData();
+
+    poolData.mLookupsCount.storeRelaxed(0);
+    poolData.mSharedCount.storeRelaxed(0);
+    poolData.mSavedBytes.storeRelaxed(0);
+}
@@ -0,0 +1,50 @@
+/*
+   SPDX-FileCopyrightText: 2026 (c) Elisa contributors
+
+   SPDX-License-Identifier: LGPL-3.0-or-later
+ */
+
+#ifndef STRINGPOOL_H
+#define STRINGPOOL_H
+
+#include "elisaLib_export.h"
+
+#include <QString>
+
+/**
+ * Process wide pool of the strings repeated across many tracks (artists,
+ * albums, genres, composers, lyricists).
+ *
+ * intern() returns a copy sharing the buffer of the first equal string given
+ * to the pool so that each distinct value is stored once whatever the number
+ * of tracks referencing it. It can be called from any thread.
+ *
+ * The strings no longer referenced outside of the pool are released each time
+ * the pool doubles in size, so that it does not grow with every value seen.
+ */
+class ELISALIB_EXPORT StringPool
+{
+public:
+
+    struct Statistics
+    {
+        qint64 mLookupsCount = 0;
+
+        qint64 mSharedCount = 0;
+
+        qint64 mSavedBytes = 0;
+
+        qint64 mStringsCount = 0;
+
+        qint64 mPoolBytes = 0;
+    };
+
+    [[nodiscard]] static QString intern(const QString &value);
+
+    [[nodiscard]] static Statistics statistics();
+
+    static void resetStatistics();
+
+};
+
+#endif // STRINGPOOL_H